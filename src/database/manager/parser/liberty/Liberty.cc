@@ -649,6 +649,56 @@ double LibertyPowerTableModel::gatePower(TransType trans_type, double slew, std:
   return table->findValue(slew, load.value_or(0.0));
 }
 
+/**
+ * @brief compile the when expr to postfix order.
+ *
+ * @param expr
+ * @param cell
+ * @return std::unique_ptr<LibertyWhenExpr> nullptr if the port is not found.
+ */
+std::unique_ptr<LibertyWhenExpr> LibertyWhenExpr::compile(LibertyExpr* expr, LibertyCell* cell)
+{
+  auto when_expr = std::make_unique<LibertyWhenExpr>();
+  if (!expr || !when_expr->compileExpr(expr, cell, 1) || when_expr->_max_depth > kMaxStackDepth) {
+    return nullptr;
+  }
+  return when_expr;
+}
+
+bool LibertyWhenExpr::compileExpr(LibertyExpr* expr, LibertyCell* cell, int depth)
+{
+  _max_depth = std::max(_max_depth, depth);
+  auto op = expr->get_op();
+  switch (op) {
+    case LibertyExpr::Operator::kBuffer: {
+      // the bus without bit ports can not be resolved to the instance pin.
+      auto* port = cell->get_cell_port_or_port_bus(expr->get_port());
+      if (!port || port->isLibertyPortBus()) {
+        return false;
+      }
+      _instrs.push_back({op, port});
+      return true;
+    }
+    case LibertyExpr::Operator::kOne:
+    case LibertyExpr::Operator::kZero:
+      _instrs.push_back({op, nullptr});
+      return true;
+    case LibertyExpr::Operator::kNot:
+      if (!compileExpr(expr->get_left(), cell, depth)) {
+        return false;
+      }
+      _instrs.push_back({op, nullptr});
+      return true;
+    default:
+      // the left operand stays on the stack when evaluating the right.
+      if (!compileExpr(expr->get_left(), cell, depth) || !compileExpr(expr->get_right(), cell, depth + 1)) {
+        return false;
+      }
+      _instrs.push_back({op, nullptr});
+      return true;
+  }
+}
+
 LibertyPort::LibertyPort(const char* port_name) : _port_name(port_name)
 {
 }
@@ -865,6 +915,7 @@ LibertyLeakagePower::LibertyLeakagePower() : _owner_cell(nullptr)
 LibertyLeakagePower::LibertyLeakagePower(LibertyLeakagePower&& other) noexcept
     : _related_pg_port(std::move(other._related_pg_port)),
       _when(std::move(other._when)),
+      _when_expr(std::move(other._when_expr)),
       _value(std::move(other._value)),
       _owner_cell(other._owner_cell)
 {
@@ -875,6 +926,7 @@ LibertyLeakagePower& LibertyLeakagePower::operator=(LibertyLeakagePower&& rhs) n
   if (this != &rhs) {
     _related_pg_port = std::move(rhs._related_pg_port);
     _when = std::move(rhs._when);
+    _when_expr = std::move(rhs._when_expr);
     _value = std::move(rhs._value);
     _owner_cell = rhs._owner_cell;
 
@@ -1270,6 +1322,47 @@ LibertyPort* LibertyCell::get_cell_port_or_port_bus(const char* port_name)
   return nullptr;
 }
 
+/**
+ * @brief compile the when of the internal powers and the leakage powers, so
+ * that power analysis does not parse the when string for every instance.
+ *
+ */
+void LibertyCell::compileWhenExprs()
+{
+  auto compile_when = [this](const std::string& when) -> std::unique_ptr<LibertyWhenExpr> {
+    if (when.empty()) {
+      return nullptr;
+    }
+    LibertyExprBuilder expr_builder(nullptr, when.c_str());
+    expr_builder.execute();
+    std::unique_ptr<LibertyExpr> expr(expr_builder.get_result_expr());
+    return LibertyWhenExpr::compile(expr.get(), this);
+  };
+
+  auto compile_port_when = [&compile_when](LibertyPort* port) {
+    for (auto& internal_power : port->get_internal_powers()) {
+      internal_power->set_when_expr(compile_when(internal_power->get_when()));
+    }
+  };
+  for (auto& port : _cell_ports) {
+    compile_port_when(port.get());
+  }
+  for (auto& port_bus : _cell_port_buses) {
+    compile_port_when(port_bus.get());
+  }
+
+  for (auto& power_arc_set : _cell_power_arcs) {
+    for (auto& power_arc : power_arc_set->get_power_arcs()) {
+      auto& internal_power_info = power_arc->get_internal_power_info();
+      internal_power_info->set_when_expr(compile_when(internal_power_info->get_when()));
+    }
+  }
+
+  for (auto& leakage_power : _leakage_power_list) {
+    leakage_power->set_when_expr(compile_when(leakage_power->get_when()));
+  }
+}
+
 /**
  * @brief Find the liberty arc match from port name and to port name.
  *
@@ -2018,6 +2111,7 @@ unsigned LibertyReader::visitCell(LibertyStmt* group)
     }
   }
 
+  lib_cell->compileWhenExprs();
   lib->addLibertyCell(std::move(lib_cell));
 
   return 1;
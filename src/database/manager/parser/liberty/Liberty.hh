@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <array>
 #include <map>
 #include <memory>
 #include <optional>
@@ -48,6 +49,7 @@ namespace ista {
 
 class LibertyType;
 class LibertyCell;
+class LibertyPort;
 class LibertyLibrary;
 class LibertyAttrValue;
 class LibertyAxis;
@@ -451,6 +453,82 @@ class LibertyPowerTableModel final : public LibertyTableModel
   DISALLOW_COPY_AND_ASSIGN(LibertyPowerTableModel);
 };
 
+/**
+ * @brief The compiled when condition of the power, the expression in postfix
+ * order with the ports resolved to the cell ports when the library is loaded.
+ * Evaluating the condition on the signal probability of the instance pins does
+ * not parse the when string or allocate.
+ *
+ */
+class LibertyWhenExpr
+{
+ public:
+  struct Instr
+  {
+    LibertyExpr::Operator op;
+    LibertyPort* port;  //!< The operand of kBuffer.
+  };
+
+  static constexpr int kMaxStackDepth = 64;
+
+  // return nullptr if a port of the expr is not found in the cell.
+  static std::unique_ptr<LibertyWhenExpr> compile(LibertyExpr* expr, LibertyCell* cell);
+
+  auto& get_instrs() const { return _instrs; }
+  int get_max_depth() const { return _max_depth; }
+
+  /**
+   * @brief Calc the signal probability of the condition, port_sp(port) is the
+   * signal probability of the port.
+   */
+  template <typename PortSP>
+  double calcSP(PortSP&& port_sp) const
+  {
+    std::array<double, kMaxStackDepth> stack;
+    int top = -1;
+    for (const auto& instr : _instrs) {
+      switch (instr.op) {
+        case LibertyExpr::Operator::kBuffer:
+          stack[++top] = port_sp(instr.port);
+          break;
+        case LibertyExpr::Operator::kOne:
+          stack[++top] = 1.0;
+          break;
+        case LibertyExpr::Operator::kZero:
+          stack[++top] = 0.0;
+          break;
+        case LibertyExpr::Operator::kNot:
+          stack[top] = 1.0 - stack[top];
+          break;
+        case LibertyExpr::Operator::kOr: {
+          double right = stack[top--];
+          stack[top] = 1.0 - (1.0 - stack[top]) * (1.0 - right);
+          break;
+        }
+        case LibertyExpr::Operator::kMult:
+        case LibertyExpr::Operator::kAnd: {
+          double right = stack[top--];
+          stack[top] = stack[top] * right;
+          break;
+        }
+        case LibertyExpr::Operator::kPlus:
+        case LibertyExpr::Operator::kXor: {
+          double right = stack[top--];
+          stack[top] = stack[top] * (1.0 - right) + (1.0 - stack[top]) * right;
+          break;
+        }
+      }
+    }
+    return stack[top];
+  }
+
+ private:
+  bool compileExpr(LibertyExpr* expr, LibertyCell* cell, int depth);
+
+  std::vector<Instr> _instrs;
+  int _max_depth = 0;
+};
+
 /**
  * @brief class for internal power information
  *
@@ -464,6 +542,9 @@ class LibertyInternalPowerInfo
   void set_when(const char* when) { _when = when; }
   auto& get_when() { return _when; }
 
+  void set_when_expr(std::unique_ptr<LibertyWhenExpr>&& when_expr) { _when_expr = std::move(when_expr); }
+  LibertyWhenExpr* get_when_expr() { return _when_expr.get(); }
+
   void set_power_table_model(std::unique_ptr<LibertyTableModel>&& power_table_model) { _power_table_model = std::move(power_table_model); }
   LibertyTableModel* get_power_table_model() { return _power_table_model.get(); }
 
@@ -475,6 +556,7 @@ class LibertyInternalPowerInfo
  private:
   std::string _related_pg_port;                           //!< The liberty power arc related pg port.
   std::string _when;                                      //!< The liberty power arc related pg port.
+  std::unique_ptr<LibertyWhenExpr> _when_expr;            //!< The compiled when, nullptr if no when.
   std::unique_ptr<LibertyTableModel> _power_table_model;  //!< The pin power table model.
 };
 
@@ -700,11 +782,15 @@ class LibertyLeakagePower : public LibertyObject
   auto& get_when() { return _when; }
   double get_value() { return _value; }
 
+  void set_when_expr(std::unique_ptr<LibertyWhenExpr>&& when_expr) { _when_expr = std::move(when_expr); }
+  LibertyWhenExpr* get_when_expr() { return _when_expr.get(); }
+
  private:
-  std::string _related_pg_port;  //!< The related pg pin of the leakage power.
-  std::string _when;             //!< The when of the leakage power.
-  double _value;                 //!< The value of the leakage power.
-  LibertyCell* _owner_cell;      //!< The cell owner the port.
+  std::string _related_pg_port;                 //!< The related pg pin of the leakage power.
+  std::string _when;                            //!< The when of the leakage power.
+  std::unique_ptr<LibertyWhenExpr> _when_expr;  //!< The compiled when, nullptr if no when.
+  double _value;                                //!< The value of the leakage power.
+  LibertyCell* _owner_cell;                     //!< The cell owner the port.
 
   DISALLOW_COPY_AND_ASSIGN(LibertyLeakagePower);
 };
@@ -1028,6 +1114,7 @@ class LibertyCell : public LibertyObject
   }
 
   LibertyPort* get_cell_port_or_port_bus(const char* port_name);
+  void compileWhenExprs();
   unsigned get_num_port() { return _cell_ports.size(); }
 
   auto& get_str2ports() { return _str2ports; }
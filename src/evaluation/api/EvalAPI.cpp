@@ -380,6 +380,12 @@ void EvalAPI::reportCongestion(const string& plot_path, const string& output_fil
   congestion_eval.mapNetCoord2Grid();
   congestion_eval.reportCongestion(plot_path, output_file_name);
 }
+
+std::unique_ptr<CongestionSession> EvalAPI::createCongSession(RUDY_TYPE rudy_type, DIRECTION direction)
+{
+  return std::make_unique<CongestionSession>(_congestion_eval_inst->get_cong_grid(), _congestion_eval_inst->get_cong_inst_list(),
+                                             _congestion_eval_inst->get_cong_net_list(), rudy_type, direction);
+}
 /******************************Congestion Eval: END******************************/
 
 /****************************** Timing Eval: START ******************************/
@@ -17,10 +17,12 @@
 #ifndef SRC_EVALUATION_API_EVALAPI_HPP_
 #define SRC_EVALUATION_API_EVALAPI_HPP_
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "CongestionEval.hpp"
+#include "CongestionSession.hpp"
 #include "TimingEval.hpp"
 #include "WirelengthEval.hpp"
 #include "ids.hpp"
@@ -94,6 +96,8 @@ class EvalAPI
   void plotOverflow(const string& plot_path, const string& output_file_name);
   void reportCongestion(const string& plot_path, const string& output_file_name, const vector<CongNet*>& net_list, CongGrid* grid,
                         const vector<CongInst*>& inst_list);
+  // incremental maps on the data of initCongDataFromIDB
+  std::unique_ptr<CongestionSession> createCongSession(RUDY_TYPE rudy_type, DIRECTION direction = DIRECTION::kNone);
   /****************************** Congestion Eval: END *******************************/
 
   /****************************** Timing Eval: START ******************************/
@@ -17,6 +17,7 @@
 #ifndef SRC_EVALUATOR_SOURCE_CONGESTION_DATABASE_CONGBIN_HPP_
 #define SRC_EVALUATOR_SOURCE_CONGESTION_DATABASE_CONGBIN_HPP_
 
+#include <algorithm>
 #include <memory>
 
 #include "CongInst.hpp"
@@ -62,6 +63,9 @@ class CongBin
 
   void add_inst(CongInst* inst) { _inst_list.push_back(inst); }
   void add_net(CongNet* net) { _net_list.push_back(net); }
+  // returns false if the instance or net is not in the bin
+  bool remove_inst(CongInst* inst) { return removeFrom(_inst_list, inst); }
+  bool remove_net(CongNet* net) { return removeFrom(_net_list, net); }
   void increPinNum() { _pin_num++; }
   void increNetCong(const double& net_cong) { _net_cong += net_cong; }
   void reset();
@@ -84,6 +88,17 @@ class CongBin
 
   std::vector<CongInst*> _inst_list;
   std::vector<CongNet*> _net_list;
+
+  template <typename T>
+  static bool removeFrom(std::vector<T*>& list, T* obj)
+  {
+    auto iter = std::find(list.begin(), list.end(), obj);
+    if (iter == list.end()) {
+      return false;
+    }
+    list.erase(iter);
+    return true;
+  }
 };
 
 inline void CongBin::reset()
@@ -23,29 +23,35 @@ namespace eval {
 void WLNet::add_pin(const int64_t& x, const int64_t& y)
 {
   WLPin* pin = new WLPin();
+  pin->set_net(this);
   pin->set_x(x);
   pin->set_y(y);
   _pin_list.push_back(pin);
+  invalidateSteiner();
 }
 
 void WLNet::add_driver_pin(const int64_t& x, const int64_t& y, const std::string& name)
 {
   WLPin* pin = new WLPin();
+  pin->set_net(this);
   pin->set_x(x);
   pin->set_y(y);
   pin->set_name(name);
   _driver_pin = pin;
   _pin_list.push_back(pin);
+  invalidateSteiner();
 }
 
 void WLNet::add_sink_pin(const int64_t& x, const int64_t& y, const std::string& name)
 {
   WLPin* pin = new WLPin();
+  pin->set_net(this);
   pin->set_x(x);
   pin->set_y(y);
   pin->set_name(name);
   _sink_pin_list.push_back(pin);
   _pin_list.push_back(pin);
+  invalidateSteiner();
 }
 
 int64_t WLNet::wireLoadModel()
@@ -277,8 +283,25 @@ int64_t WLNet::B2B()
   return B2B;
 }
 
+void WLNet::movePin(WLPin* pin, const Point<int64_t>& coord)
+{
+  pin->set_coord(coord);
+  invalidateSteiner();
+}
+
+void WLPin::invalidateNetSteiner()
+{
+  if (_net) {
+    _net->invalidateSteiner();
+  }
+}
+
 int64_t WLNet::FluteWL()
 {
+  if (_is_steiner_valid) {
+    return _steiner_wl;
+  }
+
   double total_StWL = 0.0;
 
   int num_pin = _pin_list.size();
@@ -326,7 +349,9 @@ int64_t WLNet::FluteWL()
     }
     free(flutetree.branch);
   }
-  return total_StWL;
+  _steiner_wl = total_StWL;
+  _is_steiner_valid = true;
+  return _steiner_wl;
 }
 
 
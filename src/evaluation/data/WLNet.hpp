@@ -43,16 +43,43 @@ class WLNet
   // setter
   void set_name(const std::string& name) { _name = name; }
   void set_type(const NET_TYPE& type) { _type = type; }
-  void set_driver_pin(WLPin* pin) { _driver_pin = pin; }
-  void set_pin_list(const std::vector<WLPin*>& pin_list) { _pin_list = pin_list; }
+  void set_driver_pin(WLPin* pin)
+  {
+    _driver_pin = pin;
+    pin->set_net(this);
+    invalidateSteiner();
+  }
+  void set_pin_list(const std::vector<WLPin*>& pin_list)
+  {
+    _pin_list = pin_list;
+    for (auto* pin : _pin_list) {
+      pin->set_net(this);
+    }
+    invalidateSteiner();
+  }
   void set_real_wirelength(const int64_t& wirelength) { _real_wirelength = wirelength; }
 
   // adder
   void add_pin(const int64_t& x, const int64_t& y);
   void add_driver_pin(const int64_t& x, const int64_t& y, const std::string& name);
   void add_sink_pin(const int64_t& x, const int64_t& y, const std::string& name);
-  void add_sink_pin(WLPin* pin) { _sink_pin_list.push_back(pin); }
-  void add_pin(WLPin* pin) { _pin_list.push_back(pin); }
+  void add_sink_pin(WLPin* pin)
+  {
+    _sink_pin_list.push_back(pin);
+    pin->set_net(this);
+    invalidateSteiner();
+  }
+  void add_pin(WLPin* pin)
+  {
+    _pin_list.push_back(pin);
+    pin->set_net(this);
+    invalidateSteiner();
+  }
+
+  // steiner cache, the flute wirelength is kept until a pin of the net is moved, the pin coord setters drop it too
+  void movePin(WLPin* pin, const Point<int64_t>& coord);
+  void invalidateSteiner() { _is_steiner_valid = false; }
+  bool isSteinerValid() const { return _is_steiner_valid; }
 
   // compute net_wirelength
   int64_t wireLoadModel();
@@ -75,6 +102,8 @@ class WLNet
   std::vector<WLPin*> _sink_pin_list;
   std::vector<WLPin*> _pin_list;
   int64_t _real_wirelength;
+  int64_t _steiner_wl = 0;
+  bool _is_steiner_valid = false;
 };
 }  // namespace eval
 
@@ -22,6 +22,8 @@
 
 namespace eval {
 
+class WLNet;
+
 class WLPin
 {
  public:
@@ -35,15 +37,30 @@ class WLPin
   int64_t get_y() const { return _coord.get_y(); }
   PIN_TYPE get_type() const { return _type; }
   PIN_IO_TYPE get_io_type() const { return _io_type; }
+  WLNet* get_net() const { return _net; }
   // int32_t get_layer_thickness() const { return _layer_thickness; }
 
   // setter
   void set_name(const std::string& name) { _name = name; }
-  void set_coord(const Point<int64_t>& coord) { _coord = coord; }
-  void set_x(const int64_t& x) { _coord.set_x(x); }
-  void set_y(const int64_t& y) { _coord.set_y(y); }
+  // moving the pin drops the steiner cache of its net
+  void set_coord(const Point<int64_t>& coord)
+  {
+    _coord = coord;
+    invalidateNetSteiner();
+  }
+  void set_x(const int64_t& x)
+  {
+    _coord.set_x(x);
+    invalidateNetSteiner();
+  }
+  void set_y(const int64_t& y)
+  {
+    _coord.set_y(y);
+    invalidateNetSteiner();
+  }
   void set_type(const PIN_TYPE& type) { _type = type; }
   void set_io_type(const PIN_IO_TYPE& io_type) { _io_type = io_type; }
+  void set_net(WLNet* net) { _net = net; }
   // void set_layer_thickness(int32_t thickness) { _layer_thickness = thickness; }
 
   // pin type
@@ -61,7 +78,10 @@ class WLPin
   Point<int64_t> _coord;
   PIN_TYPE _type;
   PIN_IO_TYPE _io_type;
+  WLNet* _net = nullptr;
   // int32_t _layer_thickness;
+
+  void invalidateNetSteiner();
 };
 
 }  // namespace eval
@@ -21,6 +21,10 @@
 #include <cmath>
 #include <fstream>
 #include <regex>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
 
 #include "../manager.hpp"
 #include "EvalLog.hpp"
@@ -499,6 +503,143 @@ vector<pair<string, pair<int32_t, int32_t>>> CongestionEval::evalNetSize()
 }
 
 void CongestionEval::evalNetCong(RUDY_TYPE rudy_type, DIRECTION direction)
+{
+  const auto& bin_list = _cong_grid->get_bin_list();
+  for (auto& bin : bin_list) {
+    bin->set_net_cong(0.0);
+  }
+  if (rudy_type != RUDY_TYPE::kRUDY && rudy_type != RUDY_TYPE::kPinRUDY && rudy_type != RUDY_TYPE::kLUTRUDY) {
+    return;
+  }
+  int net_num = _cong_net_list.size();
+
+  int thread_num = omp_get_max_threads();
+  if (rudy_type == RUDY_TYPE::kPinRUDY) {
+    // (bin index, congestion) of the bins with pins
+    std::vector<std::vector<std::pair<int, double>>> pin_cong_list(thread_num);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < net_num; ++i) {
+      NetRudy net_rudy = evalNetRudy(_cong_grid, _cong_net_list[i], rudy_type, direction);
+      evalNetPinRudy(_cong_grid, _cong_net_list[i], net_rudy, pin_cong_list[omp_get_thread_num()]);
+    }
+    for (auto& pin_cong : pin_cong_list) {
+      for (auto& [index, congestion] : pin_cong) {
+        bin_list[index]->increNetCong(congestion);
+      }
+    }
+    return;
+  }
+
+  std::vector<NetRudy> net_rudy_list(net_num);
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < net_num; ++i) {
+    // per net contribution, computed once for all the bins covered by the net
+    net_rudy_list[i] = evalNetRudy(_cong_grid, _cong_net_list[i], rudy_type, direction);
+  }
+  std::vector<double> net_cong;
+  evalNetCongMap(_cong_grid, net_rudy_list, net_cong);
+
+  int bin_num = bin_list.size();
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < bin_num; ++i) {
+    bin_list[i]->set_net_cong(net_cong[i]);
+  }
+}
+
+void CongestionEval::evalNetCongMap(CongGrid* grid, const std::vector<NetRudy>& net_rudy_list, std::vector<double>& net_cong)
+{
+  // the nets are added to one difference array of each weight, then the prefix sums give the congestion of the bins
+  int bin_cnt_x = grid->get_bin_cnt_x();
+  RudyMap scaled_map(bin_cnt_x, grid->get_bin_cnt_y(), grid->get_bin_size_x(), grid->get_bin_size_y());
+  RudyMap map(bin_cnt_x, grid->get_bin_cnt_y(), grid->get_bin_size_x(), grid->get_bin_size_y());
+  scaled_map.add(net_rudy_list, &NetRudy::scaled_weight);
+  map.add(net_rudy_list, &NetRudy::weight);
+  scaled_map.accumulate();
+  map.accumulate();
+
+  const auto& bin_list = grid->get_bin_list();
+  int bin_num = bin_list.size();
+  net_cong.resize(bin_num);
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < bin_num; ++i) {
+    int index_x = i % bin_cnt_x;
+    int index_y = i / bin_cnt_x;
+    net_cong[i] = bin_list[i]->get_average_wire_width() * scaled_map.get(index_x, index_y) + map.get(index_x, index_y);
+  }
+}
+
+NetRudy CongestionEval::evalNetRudy(CongGrid* grid, CongNet* net, RUDY_TYPE rudy_type, DIRECTION direction)
+{
+  NetRudy net_rudy;
+  if (net->get_pin_list().size() == 1) {
+    return net_rudy;
+  }
+  int64_t net_lx = net->get_lx();
+  int64_t net_ly = net->get_ly();
+  int64_t net_ux = net->get_ux();
+  int64_t net_uy = net->get_uy();
+  net_rudy.x_span = makeRudySpan(net_lx, net_ux, grid->get_lx(), grid->get_bin_size_x(), grid->get_bin_cnt_x());
+  net_rudy.y_span = makeRudySpan(net_ly, net_uy, grid->get_ly(), grid->get_bin_size_y(), grid->get_bin_cnt_y());
+  if (net_rudy.x_span.lower > net_rudy.x_span.upper || net_rudy.y_span.lower > net_rudy.y_span.upper) {
+    return net_rudy;
+  }
+  int64_t net_width = net_ux - net_lx;
+  int64_t net_height = net_uy - net_ly;
+
+  if (rudy_type == RUDY_TYPE::kPinRUDY) {
+    if (net_height != 0) {
+      net_rudy.pin_weight += 1 / static_cast<double>(net_height);
+    }
+    if (net_width != 0) {
+      net_rudy.pin_weight += 1 / static_cast<double>(net_width);
+    }
+    return net_rudy;
+  }
+  if (rudy_type != RUDY_TYPE::kRUDY && rudy_type != RUDY_TYPE::kLUTRUDY) {
+    return net_rudy;
+  }
+
+  double weight = rudy_type == RUDY_TYPE::kLUTRUDY ? getLUTFactor(net) : 1.0;
+  if (net_height == 0 || net_width == 0) {
+    net_rudy.weight = weight;
+    return net_rudy;
+  }
+  // scaled by the average wire width of the bin
+  if (direction == DIRECTION::kH) {
+    net_rudy.scaled_weight = weight / net_height;
+  } else if (direction == DIRECTION::kV) {
+    net_rudy.scaled_weight = weight / net_width;
+  } else {
+    net_rudy.scaled_weight = weight / net_height + weight / net_width;
+  }
+  return net_rudy;
+}
+
+void CongestionEval::evalNetPinRudy(CongGrid* grid, CongNet* net, const NetRudy& net_rudy, std::vector<std::pair<int, double>>& pin_cong)
+{
+  if (net_rudy.pin_weight == 0.0) {
+    return;
+  }
+  const auto& bin_list = grid->get_bin_list();
+  int bin_size_x = grid->get_bin_size_x();
+  int bin_size_y = grid->get_bin_size_y();
+  for (auto& pin : net->get_pin_list()) {
+    int index_x = (pin->get_x() - grid->get_lx()) / bin_size_x;
+    int index_y = (pin->get_y() - grid->get_ly()) / bin_size_y;
+    if (index_x < net_rudy.x_span.lower || index_x > net_rudy.x_span.upper || index_y < net_rudy.y_span.lower
+        || index_y > net_rudy.y_span.upper) {
+      continue;
+    }
+    // pins on the bin boundary are not counted
+    CongBin* bin = bin_list[index_y * grid->get_bin_cnt_x() + index_x];
+    if (pin->get_x() > bin->get_lx() && pin->get_x() < bin->get_ux() && pin->get_y() > bin->get_ly() && pin->get_y() < bin->get_uy()) {
+      int64_t overlap = getRudyOverlapArea(net_rudy, index_x, index_y, bin_size_x, bin_size_y);
+      pin_cong.emplace_back(index_y * grid->get_bin_cnt_x() + index_x, overlap * net_rudy.pin_weight);
+    }
+  }
+}
+
+void CongestionEval::evalNetCongByBin(RUDY_TYPE rudy_type, DIRECTION direction)
 {
   for (auto& bin : _cong_grid->get_bin_list()) {
     bin->set_net_cong(0.0);
@@ -513,32 +654,7 @@ void CongestionEval::evalNetCong(RUDY_TYPE rudy_type, DIRECTION direction)
       } else if (rudy_type == RUDY_TYPE::kPinRUDY) {
         congestion += overlap_area * getPinRudy(bin, net, direction);
       } else if (rudy_type == RUDY_TYPE::kLUTRUDY) {
-        int32_t pin_num = net->get_pin_list().size();
-        int64_t net_width = net->get_width();
-        int64_t net_height = net->get_height();
-        int32_t aspect_ratio = 0;
-        if (net_width >= net_height && net_height != 0) {
-          aspect_ratio = std::round(net_width / net_height);
-        } else if (net_width < net_height && net_width != 0) {
-          aspect_ratio = std::round(net_height / net_width);
-        } else {
-          aspect_ratio = 1;
-        }
-        float l_ness = 0.0;
-        if (pin_num <= 3) {
-          l_ness = 1.0;
-        } else if (pin_num <= 15) {
-          std::vector<std::pair<int32_t, int32_t>> point_set;
-          for (int i = 0; i < pin_num; ++i) {
-            const int32_t pin_x = net->get_pin_list()[i]->get_x();
-            const int32_t pin_y = net->get_pin_list()[i]->get_y();
-            point_set.emplace_back(std::make_pair(pin_x, pin_y));
-          }
-          l_ness = calcLness(point_set, net->get_lx(), net->get_ux(), net->get_ly(), net->get_uy());
-        } else {
-          l_ness = 0.5;
-        }
-        congestion += overlap_area * getLUT(pin_num, aspect_ratio, l_ness) * getRudy(bin, net, direction);
+        congestion += overlap_area * getLUTFactor(net) * getRudy(bin, net, direction);
       }
     }
     bin->set_net_cong(congestion);
@@ -910,6 +1026,36 @@ int64_t CongestionEval::calcUpperRightRP(std::vector<std::pair<int32_t, int32_t>
   return R;
 }
 
+double CongestionEval::getLUTFactor(CongNet* net)
+{
+  int32_t pin_num = net->get_pin_list().size();
+  int64_t net_width = net->get_width();
+  int64_t net_height = net->get_height();
+  int32_t aspect_ratio = 0;
+  if (net_width >= net_height && net_height != 0) {
+    aspect_ratio = std::round(net_width / net_height);
+  } else if (net_width < net_height && net_width != 0) {
+    aspect_ratio = std::round(net_height / net_width);
+  } else {
+    aspect_ratio = 1;
+  }
+  float l_ness = 0.0;
+  if (pin_num <= 3) {
+    l_ness = 1.0;
+  } else if (pin_num <= 15) {
+    std::vector<std::pair<int32_t, int32_t>> point_set;
+    for (int i = 0; i < pin_num; ++i) {
+      const int32_t pin_x = net->get_pin_list()[i]->get_x();
+      const int32_t pin_y = net->get_pin_list()[i]->get_y();
+      point_set.emplace_back(std::make_pair(pin_x, pin_y));
+    }
+    l_ness = calcLness(point_set, net->get_lx(), net->get_ux(), net->get_ly(), net->get_uy());
+  } else {
+    l_ness = 0.5;
+  }
+  return getLUT(pin_num, aspect_ratio, l_ness);
+}
+
 double CongestionEval::getLUT(const int32_t& pin_num, const int32_t& aspect_ratio, const float& l_ness)
 {
   switch (aspect_ratio) {
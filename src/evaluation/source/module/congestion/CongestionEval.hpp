@@ -23,6 +23,7 @@
 #include "CongInst.hpp"
 #include "CongNet.hpp"
 #include "CongTile.hpp"
+#include "RudyMap.hpp"
 #include "idm.h"
 
 namespace eval {
@@ -64,7 +65,17 @@ class CongestionEval
   vector<pair<string, pair<int32_t, int32_t>>> evalInstSize(INSTANCE_STATUS inst_status);
   vector<pair<string, pair<int32_t, int32_t>>> evalNetSize();
 
+  // per net contributions are accumulated with difference arrays, bin net lists are not used
   void evalNetCong(RUDY_TYPE rudy_type, DIRECTION direction = DIRECTION::kNone);
+  // reference implementation on the bin net lists of mapNetCoord2Grid
+  void evalNetCongByBin(RUDY_TYPE rudy_type, DIRECTION direction = DIRECTION::kNone);
+  // contribution of one net, shared by evalNetCong and CongestionSession
+  static NetRudy evalNetRudy(CongGrid* grid, CongNet* net, RUDY_TYPE rudy_type, DIRECTION direction = DIRECTION::kNone);
+  // congestion of the bins from the contributions of the nets, RUDY and LUTRUDY only
+  static void evalNetCongMap(CongGrid* grid, const std::vector<NetRudy>& net_rudy_list, std::vector<double>& net_cong);
+  // (bin index, congestion) of the bins with pins of the net, PinRUDY only
+  static void evalNetPinRudy(CongGrid* grid, CongNet* net, const NetRudy& net_rudy, std::vector<std::pair<int, double>>& pin_cong);
+  static double getLUTFactor(CongNet* net);
   void plotTileValue(const string& plot_path, const string& output_file_name);
 
   float evalAreaUtils(INSTANCE_STATUS inst_status);
@@ -152,12 +163,12 @@ class CongestionEval
   double getPinSteinerRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map);
   double getSteinerRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map);
   double getTrueRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map);
-  float calcLness(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmin, int32_t xmax, int32_t ymin, int32_t ymax);
-  int64_t calcLowerLeftRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmin, int32_t ymin);
-  int64_t calcLowerRightRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmax, int32_t ymin);
-  int64_t calcUpperLeftRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmin, int32_t ymax);
-  int64_t calcUpperRightRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmax, int32_t ymax);
-  double getLUT(const int32_t& pin_num, const int32_t& aspect_ratio, const float& l_ness);
+  static float calcLness(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmin, int32_t xmax, int32_t ymin, int32_t ymax);
+  static int64_t calcLowerLeftRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmin, int32_t ymin);
+  static int64_t calcLowerRightRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmax, int32_t ymin);
+  static int64_t calcUpperLeftRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmin, int32_t ymax);
+  static int64_t calcUpperRightRP(std::vector<std::pair<int32_t, int32_t>>& point_set, int32_t xmax, int32_t ymax);
+  static double getLUT(const int32_t& pin_num, const int32_t& aspect_ratio, const float& l_ness);
 
   float getUsageCapacityRatio(Tile* tile);
   CongPin* wrapCongPin(idb::IdbPin* idb_pin);
@@ -0,0 +1,358 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include "CongestionSession.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include "CongestionEval.hpp"
+#include "EvalLog.hpp"
+
+namespace eval {
+
+CongestionSession::CongestionSession(CongGrid* grid, const std::vector<CongInst*>& inst_list, const std::vector<CongNet*>& net_list,
+                                     RUDY_TYPE rudy_type, DIRECTION direction)
+    : _grid(grid), _inst_list(inst_list), _net_list(net_list), _rudy_type(rudy_type), _direction(direction)
+{
+  std::unordered_map<CongPin*, int32_t> pin_to_net_id;
+  for (size_t i = 0; i < _net_list.size(); ++i) {
+    for (auto* pin : _net_list[i]->get_pin_list()) {
+      pin_to_net_id[pin] = i;
+    }
+  }
+  _inst_net_ids.resize(_inst_list.size());
+  for (size_t i = 0; i < _inst_list.size(); ++i) {
+    _name_to_inst_id.emplace(_inst_list[i]->get_name(), i);
+    auto& net_ids = _inst_net_ids[i];
+    for (auto* pin : _inst_list[i]->get_pin_list()) {
+      auto iter = pin_to_net_id.find(pin);
+      if (iter != pin_to_net_id.end()) {
+        net_ids.push_back(iter->second);
+      }
+    }
+    std::sort(net_ids.begin(), net_ids.end());
+    net_ids.erase(std::unique(net_ids.begin(), net_ids.end()), net_ids.end());
+  }
+
+  size_t bin_num = _grid->get_bin_list().size();
+  _bin_stamps.resize(bin_num, 0);
+  _net_stamps.resize(_net_list.size(), 0);
+  reset();
+}
+
+int32_t CongestionSession::findInstId(const std::string& inst_name) const
+{
+  auto iter = _name_to_inst_id.find(inst_name);
+  return iter == _name_to_inst_id.end() ? -1 : iter->second;
+}
+
+std::vector<int32_t> CongestionSession::moveInst(const int32_t& inst_id, const int64_t& lx, const int64_t& ly)
+{
+  return moveInsts({{inst_id, lx, ly}});
+}
+
+std::vector<int32_t> CongestionSession::moveInsts(const std::vector<InstMove>& move_list)
+{
+  ++_stamp;
+  _changed_bins.clear();
+
+  // nets of all the moved instances are taken out once
+  std::vector<int32_t> net_ids;
+  for (auto& move : move_list) {
+    if (move.inst_id < 0 || move.inst_id >= static_cast<int32_t>(_inst_list.size())) {
+      LOG_ERROR << "instance id " << move.inst_id << " is out of range";
+      continue;
+    }
+    for (auto net_id : _inst_net_ids[move.inst_id]) {
+      if (_net_stamps[net_id] != _stamp) {
+        _net_stamps[net_id] = _stamp;
+        net_ids.push_back(net_id);
+      }
+    }
+  }
+  std::vector<char> net_mapped(net_ids.size(), 0);
+  for (size_t i = 0; i < net_ids.size(); ++i) {
+    addNet(net_ids[i], -1);
+    net_mapped[i] = unmapNet(_net_list[net_ids[i]]);
+  }
+
+  for (auto& move : move_list) {
+    if (move.inst_id < 0 || move.inst_id >= static_cast<int32_t>(_inst_list.size())) {
+      continue;
+    }
+    auto* inst = _inst_list[move.inst_id];
+    bool inst_mapped = unmapInst(inst);
+    addInst(inst, -1);
+    int64_t dx = move.lx - inst->get_lx();
+    int64_t dy = move.ly - inst->get_ly();
+    inst->set_shape(move.lx, move.ly, inst->get_ux() + dx, inst->get_uy() + dy);
+    for (auto* pin : inst->get_pin_list()) {
+      pin->set_x(pin->get_x() + dx);
+      pin->set_y(pin->get_y() + dy);
+    }
+    addInst(inst, 1);
+    if (inst_mapped) {
+      mapInst(inst);
+    }
+    ++_move_num;
+  }
+
+  for (size_t i = 0; i < net_ids.size(); ++i) {
+    addNet(net_ids[i], 1);
+    if (net_mapped[i]) {
+      mapNet(_net_list[net_ids[i]]);
+    }
+  }
+
+  std::sort(_changed_bins.begin(), _changed_bins.end());
+  return _changed_bins;
+}
+
+void CongestionSession::reset()
+{
+  size_t bin_num = _grid->get_bin_list().size();
+  _inst_area.assign(bin_num, 0.0);
+  _pin_num.assign(bin_num, 0);
+  _net_cong.assign(bin_num, 0.0);
+
+  for (auto* inst : _inst_list) {
+    addInst(inst, 1);
+  }
+
+  int net_num = _net_list.size();
+  _net_rudy_list.resize(net_num);
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < net_num; ++i) {
+    _net_rudy_list[i] = CongestionEval::evalNetRudy(_grid, _net_list[i], _rudy_type, _direction);
+  }
+  if (_rudy_type == RUDY_TYPE::kPinRUDY) {
+    std::vector<std::pair<int, double>> pin_cong;
+    for (int i = 0; i < net_num; ++i) {
+      CongestionEval::evalNetPinRudy(_grid, _net_list[i], _net_rudy_list[i], pin_cong);
+    }
+    for (auto& [index, congestion] : pin_cong) {
+      _net_cong[index] += congestion;
+    }
+  } else {
+    CongestionEval::evalNetCongMap(_grid, _net_rudy_list, _net_cong);
+  }
+}
+
+void CongestionSession::updateBins()
+{
+  const auto& bin_list = _grid->get_bin_list();
+  for (size_t i = 0; i < bin_list.size(); ++i) {
+    bin_list[i]->set_inst_density(get_inst_dens(i));
+    bin_list[i]->set_pin_num(_pin_num[i]);
+    bin_list[i]->set_net_cong(_net_cong[i]);
+  }
+}
+
+std::vector<float> CongestionSession::get_inst_dens() const
+{
+  std::vector<float> inst_density;
+  inst_density.reserve(_inst_area.size());
+  for (size_t i = 0; i < _inst_area.size(); ++i) {
+    inst_density.emplace_back(get_inst_dens(i));
+  }
+  return inst_density;
+}
+
+std::vector<float> CongestionSession::get_pin_dens() const
+{
+  return std::vector<float>(_pin_num.begin(), _pin_num.end());
+}
+
+std::vector<float> CongestionSession::get_net_cong() const
+{
+  return std::vector<float>(_net_cong.begin(), _net_cong.end());
+}
+
+double CongestionSession::get_inst_dens(const int32_t& bin_index) const
+{
+  return _inst_area[bin_index] / _grid->get_bin_list()[bin_index]->get_area();
+}
+
+// same bins as mapInst2Bin, same overlap as evalInstDens and evalPinNum
+void CongestionSession::addInst(CongInst* inst, const int& sign)
+{
+  if (!inst->isNormalInst()) {
+    return;
+  }
+  int bin_cnt_x = _grid->get_bin_cnt_x();
+  const auto& bin_list = _grid->get_bin_list();
+  std::pair<int, int> pair_x;
+  std::pair<int, int> pair_y;
+  findBinRange(inst, pair_x, pair_y);
+  for (int j = pair_y.first; j <= pair_y.second; ++j) {
+    for (int i = pair_x.first; i <= pair_x.second; ++i) {
+      int32_t bin_index = j * bin_cnt_x + i;
+      CongBin* bin = bin_list[bin_index];
+      int64_t rect_lx = std::max(static_cast<int64_t>(bin->get_lx()), inst->get_lx());
+      int64_t rect_ly = std::max(static_cast<int64_t>(bin->get_ly()), inst->get_ly());
+      int64_t rect_ux = std::min(static_cast<int64_t>(bin->get_ux()), inst->get_ux());
+      int64_t rect_uy = std::min(static_cast<int64_t>(bin->get_uy()), inst->get_uy());
+      if (rect_lx < rect_ux && rect_ly < rect_uy) {
+        _inst_area[bin_index] += sign * static_cast<double>((rect_ux - rect_lx) * (rect_uy - rect_ly));
+        markBin(bin_index);
+      }
+    }
+  }
+  for (auto* pin : inst->get_pin_list()) {
+    int index_x = 0;
+    int index_y = 0;
+    if (findPinBin(pin, index_x, index_y) && index_x >= pair_x.first && index_x <= pair_x.second && index_y >= pair_y.first
+        && index_y <= pair_y.second) {
+      _pin_num[index_y * bin_cnt_x + index_x] += sign;
+      markBin(index_y * bin_cnt_x + index_x);
+    }
+  }
+}
+
+// the stored contribution is taken out, the new contribution is evaluated and stored
+void CongestionSession::addNet(const int32_t& net_id, const int& sign)
+{
+  auto* net = _net_list[net_id];
+  auto& net_rudy = _net_rudy_list[net_id];
+  if (sign > 0) {
+    net_rudy = CongestionEval::evalNetRudy(_grid, net, _rudy_type, _direction);
+  }
+  int bin_cnt_x = _grid->get_bin_cnt_x();
+  int bin_size_x = _grid->get_bin_size_x();
+  int bin_size_y = _grid->get_bin_size_y();
+  if (_rudy_type == RUDY_TYPE::kPinRUDY) {
+    std::vector<std::pair<int, double>> pin_cong;
+    CongestionEval::evalNetPinRudy(_grid, net, net_rudy, pin_cong);
+    for (auto& [index, congestion] : pin_cong) {
+      _net_cong[index] += sign * congestion;
+      markBin(index);
+    }
+    return;
+  }
+  if (net_rudy.scaled_weight == 0.0 && net_rudy.weight == 0.0) {
+    return;
+  }
+  const auto& bin_list = _grid->get_bin_list();
+  for (int j = net_rudy.y_span.lower; j <= net_rudy.y_span.upper; ++j) {
+    for (int i = net_rudy.x_span.lower; i <= net_rudy.x_span.upper; ++i) {
+      int32_t bin_index = j * bin_cnt_x + i;
+      int64_t overlap = getRudyOverlapArea(net_rudy, i, j, bin_size_x, bin_size_y);
+      if (overlap == 0) {
+        continue;
+      }
+      double weight = bin_list[bin_index]->get_average_wire_width() * net_rudy.scaled_weight + net_rudy.weight;
+      _net_cong[bin_index] += sign * overlap * weight;
+      markBin(bin_index);
+    }
+  }
+}
+
+// the instance is removed from the bins of mapInst2Bin, false if it is not mapped
+bool CongestionSession::unmapInst(CongInst* inst)
+{
+  if (!inst->isNormalInst()) {
+    return false;
+  }
+  std::pair<int, int> pair_x;
+  std::pair<int, int> pair_y;
+  findBinRange(inst, pair_x, pair_y);
+  bool mapped = false;
+  for (int j = pair_y.first; j <= pair_y.second; ++j) {
+    for (int i = pair_x.first; i <= pair_x.second; ++i) {
+      mapped |= _grid->get_bin_list()[j * _grid->get_bin_cnt_x() + i]->remove_inst(inst);
+    }
+  }
+  return mapped;
+}
+
+void CongestionSession::mapInst(CongInst* inst)
+{
+  std::pair<int, int> pair_x;
+  std::pair<int, int> pair_y;
+  findBinRange(inst, pair_x, pair_y);
+  for (int j = pair_y.first; j <= pair_y.second; ++j) {
+    for (int i = pair_x.first; i <= pair_x.second; ++i) {
+      _grid->get_bin_list()[j * _grid->get_bin_cnt_x() + i]->add_inst(inst);
+    }
+  }
+}
+
+// the net is removed from the bins of mapNetCoord2Grid, false if it is not mapped
+bool CongestionSession::unmapNet(CongNet* net)
+{
+  if (net->get_pin_list().size() == 1) {
+    return false;
+  }
+  std::pair<int, int> pair_x;
+  std::pair<int, int> pair_y;
+  findBinRange(net, pair_x, pair_y);
+  bool mapped = false;
+  for (int j = pair_y.first; j <= pair_y.second; ++j) {
+    for (int i = pair_x.first; i <= pair_x.second; ++i) {
+      mapped |= _grid->get_bin_list()[j * _grid->get_bin_cnt_x() + i]->remove_net(net);
+    }
+  }
+  return mapped;
+}
+
+void CongestionSession::mapNet(CongNet* net)
+{
+  std::pair<int, int> pair_x;
+  std::pair<int, int> pair_y;
+  findBinRange(net, pair_x, pair_y);
+  for (int j = pair_y.first; j <= pair_y.second; ++j) {
+    for (int i = pair_x.first; i <= pair_x.second; ++i) {
+      _grid->get_bin_list()[j * _grid->get_bin_cnt_x() + i]->add_net(net);
+    }
+  }
+}
+
+// same bins as mapInst2Bin and mapNetCoord2Grid, clipped by the grid
+template <typename T>
+void CongestionSession::findBinRange(T* obj, std::pair<int, int>& pair_x, std::pair<int, int>& pair_y) const
+{
+  pair_x = _grid->getMinMaxX(obj);
+  pair_y = _grid->getMinMaxY(obj);
+  pair_x = {std::max(pair_x.first, 0), std::min(pair_x.second, _grid->get_bin_cnt_x() - 1)};
+  pair_y = {std::max(pair_y.first, 0), std::min(pair_y.second, _grid->get_bin_cnt_y() - 1)};
+}
+
+void CongestionSession::markBin(const int32_t& bin_index)
+{
+  if (_bin_stamps[bin_index] != _stamp) {
+    _bin_stamps[bin_index] = _stamp;
+    _changed_bins.push_back(bin_index);
+  }
+}
+
+bool CongestionSession::findPinBin(CongPin* pin, int& index_x, int& index_y) const
+{
+  if (pin->get_x() <= _grid->get_lx() || pin->get_y() <= _grid->get_ly()) {
+    return false;
+  }
+  index_x = (pin->get_x() - _grid->get_lx()) / _grid->get_bin_size_x();
+  index_y = (pin->get_y() - _grid->get_ly()) / _grid->get_bin_size_y();
+  if (index_x >= _grid->get_bin_cnt_x() || index_y >= _grid->get_bin_cnt_y()) {
+    return false;
+  }
+  // pins on the bin boundary are not counted
+  CongBin* bin = _grid->get_bin_list()[index_y * _grid->get_bin_cnt_x() + index_x];
+  return pin->get_x() > bin->get_lx() && pin->get_x() < bin->get_ux() && pin->get_y() > bin->get_ly() && pin->get_y() < bin->get_uy();
+}
+
+}  // namespace eval
@@ -0,0 +1,112 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#ifndef SRC_EVALUATOR_SOURCE_CONGESTION_CONGESTIONSESSION_HPP_
+#define SRC_EVALUATOR_SOURCE_CONGESTION_CONGESTIONSESSION_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "CongBin.hpp"
+#include "CongInst.hpp"
+#include "CongNet.hpp"
+#include "RudyMap.hpp"
+
+namespace eval {
+
+/**
+ * @brief Congestion maps kept up to date under instance moves, for placers calling in the loop.
+ *
+ * The maps are the same as evalInstDens(), evalPinDens() and evalNetCong(rudy_type) on all the
+ * normal instances. A move takes the contribution of the instance and of its nets out of the
+ * maps, moves the instance and its pins, and adds the new contribution back, so the cost is the
+ * number of bins covered by the instance and its nets instead of the whole grid.
+ * The grid, instances and nets are not owned, the pins of the instances are moved in place. The
+ * instance and net lists of the bins, if mapped by mapInst2Bin and mapNetCoord2Grid, follow the moves.
+ */
+class CongestionSession
+{
+ public:
+  struct InstMove
+  {
+    int32_t inst_id;  // index in the instance list
+    int64_t lx;       // new lower left corner
+    int64_t ly;
+  };
+
+  CongestionSession(CongGrid* grid, const std::vector<CongInst*>& inst_list, const std::vector<CongNet*>& net_list, RUDY_TYPE rudy_type,
+                    DIRECTION direction = DIRECTION::kNone);
+  ~CongestionSession() = default;
+  CongestionSession(const CongestionSession& other) = delete;
+  CongestionSession& operator=(const CongestionSession& other) = delete;
+
+  int32_t findInstId(const std::string& inst_name) const;
+
+  // returns the sorted indexes of the bins whose density, pin number or congestion are changed
+  std::vector<int32_t> moveInst(const int32_t& inst_id, const int64_t& lx, const int64_t& ly);
+  std::vector<int32_t> moveInsts(const std::vector<InstMove>& move_list);
+  // evaluates all the maps again, drops the rounding error of incremental updates
+  void reset();
+  // writes the maps to the bins of the grid
+  void updateBins();
+
+  std::vector<float> get_inst_dens() const;
+  std::vector<float> get_pin_dens() const;
+  std::vector<float> get_net_cong() const;
+  double get_inst_dens(const int32_t& bin_index) const;
+  int32_t get_pin_num(const int32_t& bin_index) const { return _pin_num[bin_index]; }
+  double get_net_cong(const int32_t& bin_index) const { return _net_cong[bin_index]; }
+  int64_t get_move_num() const { return _move_num; }
+
+ private:
+  CongGrid* _grid;
+  std::vector<CongInst*> _inst_list;
+  std::vector<CongNet*> _net_list;
+  RUDY_TYPE _rudy_type;
+  DIRECTION _direction;
+  std::map<std::string, int32_t> _name_to_inst_id;
+  std::vector<std::vector<int32_t>> _inst_net_ids;  // nets of the pins of each instance
+  std::vector<NetRudy> _net_rudy_list;              // contribution of each net in _net_cong
+
+  // maps of the bins
+  std::vector<double> _inst_area;
+  std::vector<int32_t> _pin_num;
+  std::vector<double> _net_cong;
+
+  // bins and nets visited by the current moves
+  int64_t _stamp = 0;
+  std::vector<int64_t> _bin_stamps;
+  std::vector<int64_t> _net_stamps;
+  std::vector<int32_t> _changed_bins;
+  int64_t _move_num = 0;
+
+  void addInst(CongInst* inst, const int& sign);
+  void addNet(const int32_t& net_id, const int& sign);
+  // the bin lists of the instances and nets
+  bool unmapInst(CongInst* inst);
+  void mapInst(CongInst* inst);
+  bool unmapNet(CongNet* net);
+  void mapNet(CongNet* net);
+  template <typename T>
+  void findBinRange(T* obj, std::pair<int, int>& pair_x, std::pair<int, int>& pair_y) const;
+  void markBin(const int32_t& bin_index);
+  bool findPinBin(CongPin* pin, int& index_x, int& index_y) const;
+};
+
+}  // namespace eval
+
+#endif  // SRC_EVALUATOR_SOURCE_CONGESTION_CONGESTIONSESSION_HPP_
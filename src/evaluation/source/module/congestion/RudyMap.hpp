@@ -0,0 +1,216 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#ifndef SRC_EVALUATOR_SOURCE_CONGESTION_RUDYMAP_HPP_
+#define SRC_EVALUATOR_SOURCE_CONGESTION_RUDYMAP_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <omp.h>
+
+namespace eval {
+
+// bins [lower, upper] covered by a net along one axis, only the first and the last bins are partially covered
+struct RudySpan
+{
+  int lower = 0;
+  int upper = -1;
+  int64_t first = 0;  // overlap length with the first bin
+  int64_t last = 0;   // overlap length with the last bin
+};
+
+struct NetRudy
+{
+  RudySpan x_span;
+  RudySpan y_span;
+  double weight = 0.0;         // congestion per overlap area
+  double scaled_weight = 0.0;  // congestion per overlap area and wire width
+  double pin_weight = 0.0;     // congestion per overlap area and pin in the bin, PinRUDY only
+};
+
+// same bins as CongGrid::getMinMaxX/getMinMaxY, clipped by the grid
+inline RudySpan makeRudySpan(const int64_t& lo, const int64_t& hi, const int& grid_lo, const int& bin_size, const int& bin_cnt)
+{
+  RudySpan span;
+  span.lower = std::max<int>(0, (lo - grid_lo) / bin_size);
+  span.upper = std::min<int>(bin_cnt - 1, (hi - grid_lo) / bin_size);
+  if (span.lower > span.upper) {
+    return span;
+  }
+  auto overlap = [&](int index) {
+    int64_t bin_lo = grid_lo + static_cast<int64_t>(index) * bin_size;
+    return std::min(bin_lo + bin_size, hi) - std::max(bin_lo, lo);
+  };
+  span.first = overlap(span.lower);
+  span.last = overlap(span.upper);
+  return span;
+}
+
+// getOverlapArea(bin, net) is the product of the overlap lengths, a zero length counts as 1 (overlap of a line),
+// minus 1 if both lengths are zero (overlap of a point)
+inline int64_t getOverlapLength(const RudySpan& span, const int& index, const int& bin_size)
+{
+  int64_t length = index == span.lower ? span.first : (index == span.upper ? span.last : bin_size);
+  return length > 0 ? length : (length == 0 ? 1 : 0);
+}
+
+inline bool isZeroOverlap(const RudySpan& span, const int& index)
+{
+  return (index == span.lower && span.first == 0) || (index == span.upper && span.last == 0);
+}
+
+inline int64_t getRudyOverlapArea(const NetRudy& net_rudy, const int& index_x, const int& index_y, const int& bin_size_x,
+                                  const int& bin_size_y)
+{
+  return getOverlapLength(net_rudy.x_span, index_x, bin_size_x) * getOverlapLength(net_rudy.y_span, index_y, bin_size_y)
+         - (isZeroOverlap(net_rudy.x_span, index_x) && isZeroOverlap(net_rudy.y_span, index_y));
+}
+
+// congestion map accumulated with a 2D difference array, each net adds O(1) rectangles of constant value
+class RudyMap
+{
+ public:
+  RudyMap(const int& bin_cnt_x, const int& bin_cnt_y, const int& bin_size_x, const int& bin_size_y)
+      : _bin_cnt_x(bin_cnt_x),
+        _bin_cnt_y(bin_cnt_y),
+        _bin_size_x(bin_size_x),
+        _bin_size_y(bin_size_y),
+        _diff(static_cast<size_t>(bin_cnt_x + 1) * (bin_cnt_y + 1), 0.0)
+  {
+  }
+
+  // adds the rectangles of the nets, the rows of the difference array are split into one band per thread and each
+  // thread only writes the rows of its band, so the threads share one array and the order of the sums is fixed
+  void add(const std::vector<NetRudy>& net_rudy_list, double NetRudy::*weight)
+  {
+    int row_num = _bin_cnt_y + 1;
+#pragma omp parallel
+    {
+      int thread_num = omp_get_num_threads();
+      int thread_id = omp_get_thread_num();
+      int row_begin = static_cast<int64_t>(row_num) * thread_id / thread_num;
+      int row_end = static_cast<int64_t>(row_num) * (thread_id + 1) / thread_num;
+      for (auto& net_rudy : net_rudy_list) {
+        // the rectangles of a net write the rows [lower, upper + 1]
+        if (net_rudy.*weight == 0.0 || net_rudy.y_span.upper + 1 < row_begin || net_rudy.y_span.lower >= row_end) {
+          continue;
+        }
+        add(net_rudy.x_span, net_rudy.y_span, net_rudy.*weight, row_begin, row_end);
+      }
+    }
+  }
+
+  // prefix sums of the difference array
+  void accumulate()
+  {
+    int stride = _bin_cnt_x + 1;
+#pragma omp parallel for schedule(static)
+    for (int y = 0; y < _bin_cnt_y; ++y) {
+      double* row = _diff.data() + static_cast<size_t>(y) * stride;
+      for (int x = 1; x < _bin_cnt_x; ++x) {
+        row[x] += row[x - 1];
+      }
+    }
+    constexpr int kBlockSize = 256;
+#pragma omp parallel for schedule(static)
+    for (int begin = 0; begin < _bin_cnt_x; begin += kBlockSize) {
+      int end = std::min(_bin_cnt_x, begin + kBlockSize);
+      for (int y = 1; y < _bin_cnt_y; ++y) {
+        double* row = _diff.data() + static_cast<size_t>(y) * stride;
+        const double* prev_row = row - stride;
+        for (int x = begin; x < end; ++x) {
+          row[x] += prev_row[x];
+        }
+      }
+    }
+  }
+
+  double get(const int& index_x, const int& index_y) const { return _diff[static_cast<size_t>(index_y) * (_bin_cnt_x + 1) + index_x]; }
+
+ private:
+  struct Segment
+  {
+    int begin;
+    int end;
+    int64_t length;  // overlap length of each bin in [begin, end]
+  };
+
+  static int makeSegments(const RudySpan& span, const int& bin_size, Segment* segments)
+  {
+    int num = 0;
+    segments[num++] = {span.lower, span.lower, getOverlapLength(span, span.lower, bin_size)};
+    if (span.upper - span.lower > 1) {
+      segments[num++] = {span.lower + 1, span.upper - 1, bin_size};
+    }
+    if (span.upper > span.lower) {
+      segments[num++] = {span.upper, span.upper, getOverlapLength(span, span.upper, bin_size)};
+    }
+    return num;
+  }
+
+  // only the rows in [row_begin, row_end) are written
+  void add(const RudySpan& x_span, const RudySpan& y_span, const double& weight, const int& row_begin, const int& row_end)
+  {
+    Segment x_segments[3];
+    Segment y_segments[3];
+    int x_num = makeSegments(x_span, _bin_size_x, x_segments);
+    int y_num = makeSegments(y_span, _bin_size_y, y_segments);
+    for (int i = 0; i < x_num; ++i) {
+      for (int j = 0; j < y_num; ++j) {
+        addRect(x_segments[i], y_segments[j], weight * x_segments[i].length * y_segments[j].length, row_begin, row_end);
+      }
+    }
+    // point overlaps
+    for (int x : {x_span.lower, x_span.upper}) {
+      for (int y : {y_span.lower, y_span.upper}) {
+        if (isZeroOverlap(x_span, x) && isZeroOverlap(y_span, y)) {
+          addRect({x, x, 0}, {y, y, 0}, -weight, row_begin, row_end);
+        }
+        if (y_span.lower == y_span.upper) {
+          break;
+        }
+      }
+      if (x_span.lower == x_span.upper) {
+        break;
+      }
+    }
+  }
+
+  void addRect(const Segment& x_segment, const Segment& y_segment, const double& value, const int& row_begin, const int& row_end)
+  {
+    int stride = _bin_cnt_x + 1;
+    if (y_segment.begin >= row_begin && y_segment.begin < row_end) {
+      _diff[static_cast<size_t>(y_segment.begin) * stride + x_segment.begin] += value;
+      _diff[static_cast<size_t>(y_segment.begin) * stride + x_segment.end + 1] -= value;
+    }
+    if (y_segment.end + 1 >= row_begin && y_segment.end + 1 < row_end) {
+      _diff[static_cast<size_t>(y_segment.end + 1) * stride + x_segment.begin] -= value;
+      _diff[static_cast<size_t>(y_segment.end + 1) * stride + x_segment.end + 1] += value;
+    }
+  }
+
+  int _bin_cnt_x;
+  int _bin_cnt_y;
+  int _bin_size_x;
+  int _bin_size_y;
+  std::vector<double> _diff;
+};
+
+}  // namespace eval
+
+#endif  // SRC_EVALUATOR_SOURCE_CONGESTION_RUDYMAP_HPP_
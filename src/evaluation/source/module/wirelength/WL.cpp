@@ -16,15 +16,34 @@
 // ***************************************************************************************
 #include "WL.hpp"
 
+#include <omp.h>
+
 #include "EvalLog.hpp"
+#include "flute.h"
 
 namespace eval {
 
+// flute extends its lookup table to degree FLUTE_D on the first large net, and Flute::readLUT of any evaluator
+// resets it, so run it before each parallel evaluation of the nets.
+static void initFluteLUT()
+{
+  int x[FLUTE_D];
+  int y[FLUTE_D];
+  for (int i = 0; i < FLUTE_D; ++i) {
+    x[i] = i;
+    y[i] = (i * 7) % FLUTE_D;
+  }
+  Flute::Tree tree = Flute::flute(FLUTE_D, x, y, 8);
+  free(tree.branch);
+}
+
 int64_t WLMWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t WLM = 0;
-  for (WLNet* net : length_net_list) {
-    WLM += net->wireLoadModel();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : WLM)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    WLM += length_net_list[i]->wireLoadModel();
   }
   return WLM;
 }
@@ -32,8 +51,10 @@ int64_t WLMWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t HPWLWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t HPWL = 0;
-  for (WLNet* net : length_net_list) {
-    HPWL += net->HPWL();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : HPWL)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    HPWL += length_net_list[i]->HPWL();
   }
   return HPWL;
 }
@@ -41,8 +62,10 @@ int64_t HPWLWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t HTreeWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t HTree = 0;
-  for (WLNet* net : length_net_list) {
-    HTree += net->HTree();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : HTree)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    HTree += length_net_list[i]->HTree();
   }
   return HTree;
 }
@@ -50,8 +73,10 @@ int64_t HTreeWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t VTreeWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t VTree = 0;
-  for (WLNet* net : length_net_list) {
-    VTree += net->VTree();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : VTree)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    VTree += length_net_list[i]->VTree();
   }
   return VTree;
 }
@@ -59,8 +84,10 @@ int64_t VTreeWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t CliqueWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t clique = 0;
-  for (WLNet* net : length_net_list) {
-    clique += net->Clique();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : clique)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    clique += length_net_list[i]->Clique();
   }
   return clique;
 }
@@ -68,8 +95,10 @@ int64_t CliqueWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t StarWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t star = 0;
-  for (WLNet* net : length_net_list) {
-    star += net->Star();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : star)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    star += length_net_list[i]->Star();
   }
   return star;
 }
@@ -77,17 +106,23 @@ int64_t StarWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t B2BWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t B2B = 0;
-  for (WLNet* net : length_net_list) {
-    B2B += net->B2B();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : B2B)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    B2B += length_net_list[i]->B2B();
   }
   return B2B;
 }
 
 int64_t FluteWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
+  initFluteLUT();
+
   int64_t Flute = 0;
-  for (WLNet* net : length_net_list) {
-    Flute += net->FluteWL();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(dynamic, 64) reduction(+ : Flute)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    Flute += length_net_list[i]->FluteWL();
   }
   return Flute;
 }
@@ -95,8 +130,10 @@ int64_t FluteWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t PlaneRouteWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t planeRouteWL = 0;
-  for (WLNet* net : length_net_list) {
-    planeRouteWL += net->planeRouteWL();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : planeRouteWL)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    planeRouteWL += length_net_list[i]->planeRouteWL();
   }
   return planeRouteWL;
 }
@@ -104,8 +141,10 @@ int64_t PlaneRouteWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t SpaceRouteWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t spaceRouteWL = 0;
-  for (WLNet* net : length_net_list) {
-    spaceRouteWL += net->spaceRouteWL();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : spaceRouteWL)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    spaceRouteWL += length_net_list[i]->spaceRouteWL();
   }
   return spaceRouteWL;
 }
@@ -113,8 +152,10 @@ int64_t SpaceRouteWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 int64_t DRWL::getTotalWL(const std::vector<WLNet*>& length_net_list)
 {
   int64_t DRWL = 0;
-  for (WLNet* net : length_net_list) {
-    DRWL += net->detailRouteWL();
+  int64_t num_nets = length_net_list.size();
+#pragma omp parallel for schedule(static) reduction(+ : DRWL)
+  for (int64_t i = 0; i < num_nets; ++i) {
+    DRWL += length_net_list[i]->detailRouteWL();
   }
   return DRWL;
 }
@@ -379,4 +379,19 @@ WLNet* WirelengthEval::find_net(const std::string& net_name) const
   }
 }
 
+void WirelengthEval::notifyPinMove(const std::string& net_name)
+{
+  WLNet* net = find_net(net_name);
+  if (net) {
+    net->invalidateSteiner();
+  }
+}
+
+void WirelengthEval::invalidateSteinerCache()
+{
+  for (WLNet* net : _net_list) {
+    net->invalidateSteiner();
+  }
+}
+
 }  // namespace eval
@@ -55,6 +55,10 @@ class WirelengthEval
 
   WLNet* find_net(const std::string& net_name) const;
 
+  // the pins of a net are moved outside, drop the cached steiner wirelength of the net.
+  void notifyPinMove(const std::string& net_name);
+  void invalidateSteinerCache();
+
  private:
   std::vector<WLNet*> _net_list;
   std::map<std::string, WLNet*> _name2net_map;
@@ -0,0 +1,98 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "CongestionEval.hpp"
+#include "CongestionSession.hpp"
+#include "CongestionTestHelper.hpp"
+#include "EvalLog.hpp"
+
+using namespace eval;
+
+namespace {
+// runtime of the net congestion on the bin net lists and on the difference arrays, 200k random nets
+void benchNetCong()
+{
+  for (int bin_cnt : {512, 2048}) {
+    std::mt19937 gen(0);
+    CongestionEval congestion_eval;
+    auto* grid = makeGrid(bin_cnt, 1000);
+    congestion_eval.set_cong_grid(grid);
+    congestion_eval.set_cong_net_list(makeRandomNets(grid, 200000, 6, gen));
+    auto start = std::chrono::steady_clock::now();
+    congestion_eval.mapNetCoord2Grid();
+    LOG_INFO << bin_cnt << "x" << bin_cnt << " grid, map nets to bins: "
+             << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s";
+
+    for (auto rudy_type : {RUDY_TYPE::kRUDY, RUDY_TYPE::kPinRUDY, RUDY_TYPE::kLUTRUDY}) {
+      start = std::chrono::steady_clock::now();
+      congestion_eval.evalNetCongByBin(rudy_type);
+      auto ref_map = getNetCongMap(grid);
+      auto mid = std::chrono::steady_clock::now();
+      congestion_eval.evalNetCong(rudy_type);
+      auto end = std::chrono::steady_clock::now();
+      LOG_INFO << bin_cnt << "x" << bin_cnt << " grid, rudy type " << static_cast<int>(rudy_type)
+               << ", by bin: " << std::chrono::duration<double>(mid - start).count()
+               << "s, difference array: " << std::chrono::duration<double>(end - mid).count()
+               << "s, max relative difference: " << maxMapDiff(getNetCongMap(grid), ref_map);
+    }
+    deleteNets(congestion_eval.get_cong_net_list());
+    deleteBins(grid);
+  }
+}
+
+// full evaluation and moves per second of the congestion session, 200k instances and 100k moves
+void benchCongSession()
+{
+  std::mt19937 gen(0);
+  auto* grid = makeGrid(512, 1000);
+  std::vector<CongInst*> inst_list;
+  std::vector<CongNet*> net_list;
+  makeRandomDesign(grid, 200000, gen, inst_list, net_list);
+
+  auto start = std::chrono::steady_clock::now();
+  CongestionSession session(grid, inst_list, net_list, RUDY_TYPE::kRUDY);
+  auto mid = std::chrono::steady_clock::now();
+  const int move_num = 100000;
+  auto move_list = makeRandomMoves(grid, inst_list, move_num, gen);
+  for (auto& move : move_list) {
+    session.moveInst(move.inst_id, move.lx, move.ly);
+  }
+  auto end = std::chrono::steady_clock::now();
+  double move_time = std::chrono::duration<double>(end - mid).count();
+
+  CongestionSession ref_session(grid, inst_list, net_list, RUDY_TYPE::kRUDY);
+  LOG_INFO << "congestion session on " << inst_list.size() << " instances, " << net_list.size() << " nets, full evaluation: "
+           << std::chrono::duration<double>(mid - start).count() << "s, " << move_num / move_time
+           << " moves/s, max relative difference: " << maxMapDiff(getNetCongMap(session, grid), getNetCongMap(ref_session, grid));
+
+  deleteDesign(inst_list, net_list);
+  deleteBins(grid);
+  delete grid;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  eval::Log::init(argv);
+  benchNetCong();
+  benchCongSession();
+  eval::Log::end();
+  return 0;
+}
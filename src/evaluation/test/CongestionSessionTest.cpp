@@ -0,0 +1,95 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "CongestionEval.hpp"
+#include "CongestionSession.hpp"
+#include "CongestionTestHelper.hpp"
+#include "EvalLog.hpp"
+#include "gtest/gtest.h"
+
+namespace eval {
+
+class CongestionSessionTest : public testing::Test
+{
+  void SetUp()
+  {
+    char config[] = "json_test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() final { Log::end(); }
+};
+
+TEST_F(CongestionSessionTest, congestionSession)
+{
+  std::mt19937 gen(0);
+  auto* grid = makeGrid(40, 100);
+  std::vector<CongInst*> inst_list;
+  std::vector<CongNet*> net_list;
+  makeRandomDesign(grid, 3000, gen, inst_list, net_list);
+
+  // same maps as the evaluator
+  CongestionEval congestion_eval;
+  congestion_eval.set_cong_grid(grid);
+  congestion_eval.set_cong_inst_list(inst_list);
+  congestion_eval.set_cong_net_list(net_list);
+  congestion_eval.mapInst2Bin();
+  congestion_eval.mapNetCoord2Grid();
+  CongestionSession lut_session(grid, inst_list, net_list, RUDY_TYPE::kLUTRUDY);
+  expectSameMap(lut_session.get_inst_dens(), congestion_eval.getInstDens());
+  expectSameMap(lut_session.get_pin_dens(), congestion_eval.evalPinDens());
+
+  for (auto rudy_type : {RUDY_TYPE::kRUDY, RUDY_TYPE::kPinRUDY, RUDY_TYPE::kLUTRUDY}) {
+    CongestionSession session(grid, inst_list, net_list, rudy_type);
+    for (int move_num : {1, 1, 10, 100, 1000}) {
+      auto inst_dens = session.get_inst_dens();
+      auto pin_dens = session.get_pin_dens();
+      auto net_cong = session.get_net_cong();
+      auto changed_bins = session.moveInsts(makeRandomMoves(grid, inst_list, move_num, gen));
+
+      // maps of a new session on the moved instances
+      CongestionSession ref_session(grid, inst_list, net_list, rudy_type);
+      expectSameMap(session.get_inst_dens(), ref_session.get_inst_dens());
+      expectSameMap(session.get_pin_dens(), ref_session.get_pin_dens());
+      expectSameMap(session.get_net_cong(), ref_session.get_net_cong());
+      auto ref_net_cong = ref_session.get_net_cong();
+      float max_cong = *std::max_element(ref_net_cong.begin(), ref_net_cong.end());
+      for (size_t i = 0; i < inst_dens.size(); ++i) {
+        if (std::abs(inst_dens[i] - ref_session.get_inst_dens()[i]) > 1e-6 || pin_dens[i] != ref_session.get_pin_dens()[i]
+            || std::abs(net_cong[i] - ref_net_cong[i]) > max_cong * 1e-6) {
+          EXPECT_TRUE(std::binary_search(changed_bins.begin(), changed_bins.end(), i)) << "bin " << i;
+        }
+      }
+
+      // the evaluator on the moved instances, and on the bin lists followed the moves
+      congestion_eval.evalNetCong(rudy_type);
+      expectSameMap(getNetCongMap(session, grid), getNetCongMap(grid));
+      congestion_eval.evalNetCongByBin(rudy_type);
+      expectSameMap(getNetCongMap(session, grid), getNetCongMap(grid));
+      expectSameMap(session.get_inst_dens(), congestion_eval.getInstDens());
+      expectSameMap(session.get_pin_dens(), congestion_eval.evalPinDens());
+    }
+  }
+  deleteDesign(inst_list, net_list);
+  deleteBins(grid);
+}
+
+}  // namespace eval
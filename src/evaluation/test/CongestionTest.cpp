@@ -14,9 +14,12 @@
 //
 // See the Mulan PSL v2 for more details.
 // ***************************************************************************************
+#include <random>
 #include <string>
 
 #include "Config.hpp"
+#include "CongestionEval.hpp"
+#include "CongestionTestHelper.hpp"
 #include "EvalLog.hpp"
 #include "gtest/gtest.h"
 #include "manager.hpp"
@@ -61,4 +64,25 @@ TEST_F(CongestionTest, sample)
   LOG_INFO << "Eval time elapsed " << time_delta << "s";
 }
 
+TEST_F(CongestionTest, netCongDifferenceArray)
+{
+  std::mt19937 gen(0);
+  CongestionEval congestion_eval;
+  auto* grid = makeGrid(37, 100);
+  congestion_eval.set_cong_grid(grid);
+  congestion_eval.set_cong_net_list(makeRandomNets(grid, 2000, 8, gen));
+  congestion_eval.mapNetCoord2Grid();
+
+  for (auto rudy_type : {RUDY_TYPE::kRUDY, RUDY_TYPE::kPinRUDY, RUDY_TYPE::kLUTRUDY}) {
+    for (auto direction : {DIRECTION::kNone, DIRECTION::kH, DIRECTION::kV}) {
+      congestion_eval.evalNetCongByBin(rudy_type, direction);
+      auto ref_map = getNetCongMap(grid);
+      congestion_eval.evalNetCong(rudy_type, direction);
+      expectSameMap(getNetCongMap(grid), ref_map);
+    }
+  }
+  deleteNets(congestion_eval.get_cong_net_list());
+  deleteBins(grid);
+}
+
 }  // namespace eval
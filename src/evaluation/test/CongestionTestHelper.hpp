@@ -0,0 +1,242 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#ifndef SRC_EVALUATOR_TEST_CONGESTIONTESTHELPER_HPP_
+#define SRC_EVALUATOR_TEST_CONGESTIONTESTHELPER_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CongBin.hpp"
+#include "CongInst.hpp"
+#include "CongNet.hpp"
+#include "CongestionSession.hpp"
+#include "gtest/gtest.h"
+
+namespace eval {
+
+// synthetic grids and nets shared by the congestion tests and benchmarks
+inline CongGrid* makeGrid(const int& bin_cnt, const int& bin_size)
+{
+  auto* grid = new CongGrid(1000, 500, bin_cnt, bin_cnt, bin_size, bin_size);
+  grid->initBins();
+  for (auto* bin : grid->get_bin_list()) {
+    bin->set_average_wire_width(100 + (bin->get_x() + bin->get_y()) % 3);
+  }
+  return grid;
+}
+
+// the grid does not own its bins
+inline void deleteBins(CongGrid* grid)
+{
+  for (auto* bin : grid->get_bin_list()) {
+    delete bin;
+  }
+}
+
+// random nets on the grid: lines, points, single pin nets, pins on the bin boundary and out of the grid
+inline std::vector<CongNet*> makeRandomNets(CongGrid* grid, const int& net_num, const int& max_span, std::mt19937& gen)
+{
+  std::uniform_int_distribution<int> pin_num_dis(1, 20);
+  std::uniform_int_distribution<int> span_dis(0, max_span);
+  std::uniform_int_distribution<int> type_dis(0, 9);
+  int64_t ux = grid->get_ux() + grid->get_bin_size_x() * 2;
+  int64_t uy = grid->get_uy() + grid->get_bin_size_y() * 2;
+  std::uniform_int_distribution<int64_t> x_dis(0, ux);
+  std::uniform_int_distribution<int64_t> y_dis(0, uy);
+
+  std::vector<CongNet*> net_list;
+  net_list.reserve(net_num);
+  for (int i = 0; i < net_num; ++i) {
+    auto* net = new CongNet();
+    net->set_name("net_" + std::to_string(i));
+    int64_t lx = x_dis(gen);
+    int64_t ly = y_dis(gen);
+    int type = type_dis(gen);
+    // long nets
+    int64_t width = (type == 0 ? 10 : 1) * span_dis(gen) * grid->get_bin_size_x() / 2;
+    int64_t height = (type == 0 ? 10 : 1) * span_dis(gen) * grid->get_bin_size_y() / 2;
+    if (type == 1) {
+      width = 0;
+    } else if (type == 2) {
+      height = 0;
+    } else if (type == 3) {
+      // snap to the bin boundary
+      lx = lx / grid->get_bin_size_x() * grid->get_bin_size_x() + grid->get_lx();
+      ly = ly / grid->get_bin_size_y() * grid->get_bin_size_y() + grid->get_ly();
+    }
+    std::uniform_int_distribution<int64_t> dx_dis(0, width);
+    std::uniform_int_distribution<int64_t> dy_dis(0, height);
+    int pin_num = type == 4 ? 1 : pin_num_dis(gen);
+    net->add_pin(lx, ly, "p0");
+    if (pin_num > 1) {
+      net->add_pin(lx + width, ly + height, "p1");
+    }
+    for (int j = 2; j < pin_num; ++j) {
+      net->add_pin(lx + dx_dis(gen), ly + dy_dis(gen), "p" + std::to_string(j));
+    }
+    net_list.push_back(net);
+  }
+  return net_list;
+}
+
+// the nets of makeRandomNets own their pins
+inline void deleteNets(const std::vector<CongNet*>& net_list)
+{
+  for (auto* net : net_list) {
+    for (auto* pin : net->get_pin_list()) {
+      delete pin;
+    }
+    delete net;
+  }
+}
+
+// random instances with pins, nets connect the pins close to each other
+inline void makeRandomDesign(CongGrid* grid, const int& inst_num, std::mt19937& gen, std::vector<CongInst*>& inst_list,
+                             std::vector<CongNet*>& net_list)
+{
+  int bin_size = grid->get_bin_size_x();
+  std::uniform_int_distribution<int64_t> x_dis(grid->get_lx(), grid->get_ux() - 2 * bin_size);
+  std::uniform_int_distribution<int64_t> y_dis(grid->get_ly(), grid->get_uy() - 2 * bin_size);
+  std::uniform_int_distribution<int64_t> size_dis(bin_size / 4, bin_size * 2);
+  std::uniform_int_distribution<int> pin_num_dis(2, 4);
+  std::uniform_int_distribution<int> net_size_dis(2, 6);
+
+  std::vector<CongPin*> pin_list;
+  for (int i = 0; i < inst_num; ++i) {
+    auto* inst = new CongInst();
+    inst->set_name("inst_" + std::to_string(i));
+    int64_t lx = x_dis(gen);
+    int64_t ly = y_dis(gen);
+    int64_t width = size_dis(gen);
+    int64_t height = size_dis(gen);
+    inst->set_shape(lx, ly, lx + width, ly + height);
+    inst->set_loc_type(i % 50 == 0 ? INSTANCE_LOC_TYPE::kOutside : INSTANCE_LOC_TYPE::kNormal);
+    inst->set_status(INSTANCE_STATUS::kPlaced);
+    std::uniform_int_distribution<int64_t> dx_dis(0, width);
+    std::uniform_int_distribution<int64_t> dy_dis(0, height);
+    int pin_num = pin_num_dis(gen);
+    for (int j = 0; j < pin_num; ++j) {
+      auto* pin = new CongPin();
+      pin->set_name("p" + std::to_string(j));
+      pin->set_x(lx + dx_dis(gen));
+      pin->set_y(ly + dy_dis(gen));
+      inst->add_pin(pin);
+      pin_list.push_back(pin);
+    }
+    inst_list.push_back(inst);
+  }
+  std::sort(pin_list.begin(), pin_list.end(), [&](CongPin* a, CongPin* b) {
+    return std::make_pair(a->get_y() / (bin_size * 4), a->get_x()) < std::make_pair(b->get_y() / (bin_size * 4), b->get_x());
+  });
+  for (size_t i = 0; i < pin_list.size();) {
+    auto* net = new CongNet();
+    net->set_name("net_" + std::to_string(net_list.size()));
+    size_t end = std::min(pin_list.size(), i + net_size_dis(gen));
+    for (; i < end; ++i) {
+      net->add_pin(pin_list[i]);
+    }
+    net_list.push_back(net);
+  }
+}
+
+// the instances of makeRandomDesign own the pins
+inline void deleteDesign(const std::vector<CongInst*>& inst_list, const std::vector<CongNet*>& net_list)
+{
+  for (auto* inst : inst_list) {
+    for (auto* pin : inst->get_pin_list()) {
+      delete pin;
+    }
+    delete inst;
+  }
+  for (auto* net : net_list) {
+    delete net;
+  }
+}
+
+inline std::vector<CongestionSession::InstMove> makeRandomMoves(CongGrid* grid, const std::vector<CongInst*>& inst_list,
+                                                                const int& move_num, std::mt19937& gen)
+{
+  int bin_size = grid->get_bin_size_x();
+  std::uniform_int_distribution<int32_t> inst_dis(0, inst_list.size() - 1);
+  std::uniform_int_distribution<int64_t> move_dis(-bin_size * 2, bin_size * 2);
+  std::vector<CongestionSession::InstMove> move_list;
+  for (int i = 0; i < move_num; ++i) {
+    int32_t inst_id = inst_dis(gen);
+    auto* inst = inst_list[inst_id];
+    int64_t lx = std::clamp<int64_t>(inst->get_lx() + move_dis(gen), grid->get_lx(), grid->get_ux() - inst->get_width());
+    int64_t ly = std::clamp<int64_t>(inst->get_ly() + move_dis(gen), grid->get_ly(), grid->get_uy() - inst->get_height());
+    move_list.push_back({inst_id, lx, ly});
+  }
+  return move_list;
+}
+
+inline std::vector<double> getNetCongMap(CongGrid* grid)
+{
+  std::vector<double> cong_map;
+  for (auto* bin : grid->get_bin_list()) {
+    cong_map.push_back(bin->get_net_cong());
+  }
+  return cong_map;
+}
+
+inline std::vector<double> getNetCongMap(const CongestionSession& session, CongGrid* grid)
+{
+  std::vector<double> cong_map;
+  for (size_t i = 0; i < grid->get_bin_list().size(); ++i) {
+    cong_map.push_back(session.get_net_cong(i));
+  }
+  return cong_map;
+}
+
+// max difference of the maps relative to the max value of the reference map
+inline double maxMapDiff(const std::vector<double>& cong_map, const std::vector<double>& ref_map)
+{
+  double max_value = 1.0;
+  for (auto value : ref_map) {
+    max_value = std::max(max_value, std::abs(value));
+  }
+  double max_diff = 0.0;
+  for (size_t i = 0; i < std::min(cong_map.size(), ref_map.size()); ++i) {
+    max_diff = std::max(max_diff, std::abs(cong_map[i] - ref_map[i]));
+  }
+  return max_diff / max_value;
+}
+
+inline void expectSameMap(const std::vector<double>& cong_map, const std::vector<double>& ref_map)
+{
+  ASSERT_EQ(cong_map.size(), ref_map.size());
+  double max_value = 1.0;
+  for (auto value : ref_map) {
+    max_value = std::max(max_value, std::abs(value));
+  }
+  for (size_t i = 0; i < ref_map.size(); ++i) {
+    EXPECT_NEAR(cong_map[i], ref_map[i], max_value * 1e-9) << "bin " << i;
+  }
+}
+
+template <typename T>
+void expectSameMap(const std::vector<T>& cong_map, const std::vector<T>& ref_map)
+{
+  expectSameMap(std::vector<double>(cong_map.begin(), cong_map.end()), std::vector<double>(ref_map.begin(), ref_map.end()));
+}
+
+}  // namespace eval
+
+#endif  // SRC_EVALUATOR_TEST_CONGESTIONTESTHELPER_HPP_
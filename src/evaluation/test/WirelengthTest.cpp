@@ -14,10 +14,15 @@
 //
 // See the Mulan PSL v2 for more details.
 // ***************************************************************************************
+#include <chrono>
+#include <functional>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "Config.hpp"
 #include "EvalLog.hpp"
+#include "WirelengthEval.hpp"
 #include "gtest/gtest.h"
 #include "manager.hpp"
 #include "usage/usage.hh"
@@ -35,6 +40,140 @@ class WirelengthTest : public testing::Test
   void TearDown() final { Log::end(); }
 };
 
+std::vector<WLNet*> makeRandomNets(int net_num, int max_degree, std::mt19937& gen)
+{
+  std::uniform_int_distribution<int64_t> coord_dist(0, 1000000);
+  std::uniform_int_distribution<int> degree_dist(2, max_degree);
+  std::vector<WLNet*> net_list;
+  for (int i = 0; i < net_num; ++i) {
+    WLNet* net = new WLNet();
+    net->set_name("net_" + std::to_string(i));
+    net->add_driver_pin(coord_dist(gen), coord_dist(gen), "drvr");
+    int degree = degree_dist(gen);
+    for (int j = 1; j < degree; ++j) {
+      net->add_sink_pin(coord_dist(gen), coord_dist(gen), "load_" + std::to_string(j));
+    }
+    net_list.push_back(net);
+  }
+  return net_list;
+}
+
+void deleteNets(std::vector<WLNet*>& net_list)
+{
+  for (WLNet* net : net_list) {
+    for (WLPin* pin : net->get_pin_list()) {
+      delete pin;
+    }
+    delete net;
+  }
+  net_list.clear();
+}
+
+const std::vector<std::pair<std::string, std::function<int64_t(WLNet*)>>>& getNetWLFuncs()
+{
+  static const std::vector<std::pair<std::string, std::function<int64_t(WLNet*)>>> net_wl_funcs
+      = {{"kWLM", [](WLNet* net) { return net->wireLoadModel(); }},
+         {"kHPWL", [](WLNet* net) { return net->HPWL(); }},
+         {"kHTree", [](WLNet* net) { return net->HTree(); }},
+         {"kVTree", [](WLNet* net) { return net->VTree(); }},
+         {"kClique", [](WLNet* net) { return net->Clique(); }},
+         {"kStar", [](WLNet* net) { return net->Star(); }},
+         {"kB2B", [](WLNet* net) { return net->B2B(); }},
+         {"kFlute", [](WLNet* net) { return net->FluteWL(); }},
+         {"kPlaneRoute", [](WLNet* net) { return net->planeRouteWL(); }},
+         {"kSpaceRoute", [](WLNet* net) { return net->spaceRouteWL(); }},
+         {"kDR", [](WLNet* net) { return net->detailRouteWL(); }}};
+  return net_wl_funcs;
+}
+
+TEST_F(WirelengthTest, totalWLReduction)
+{
+  std::mt19937 gen(0);
+  WirelengthEval wirelength_eval;
+  wirelength_eval.set_net_list(makeRandomNets(20000, 40, gen));
+
+  for (auto& [wl_type, net_wl_func] : getNetWLFuncs()) {
+    int64_t ref_wl = 0;
+    for (WLNet* net : wirelength_eval.get_net_list()) {
+      ref_wl += net_wl_func(net);
+    }
+    EXPECT_EQ(wirelength_eval.evalTotalWL(wl_type), ref_wl) << wl_type;
+  }
+  deleteNets(wirelength_eval.get_net_list());
+}
+
+TEST_F(WirelengthTest, steinerCache)
+{
+  std::mt19937 gen(1);
+  WirelengthEval wirelength_eval;
+  auto net_list = makeRandomNets(1000, 40, gen);
+  wirelength_eval.set_net_list(net_list);
+  int64_t flute_wl = wirelength_eval.evalTotalWL("kFlute");
+  for (WLNet* net : net_list) {
+    EXPECT_TRUE(net->isSteinerValid());
+  }
+  EXPECT_EQ(wirelength_eval.evalTotalWL("kFlute"), flute_wl);
+
+  // move the pins and compare with the nets built at the new location.
+  std::uniform_int_distribution<int64_t> coord_dist(0, 1000000);
+  for (WLNet* net : net_list) {
+    auto pin_list = net->get_pin_list();
+    WLPin* pin = pin_list[coord_dist(gen) % pin_list.size()];
+    net->movePin(pin, Point<int64_t>(coord_dist(gen), coord_dist(gen)));
+    EXPECT_FALSE(net->isSteinerValid());
+
+    WLNet ref_net;
+    ref_net.add_driver_pin(net->get_driver_pin()->get_x(), net->get_driver_pin()->get_y(), "drvr");
+    for (WLPin* sink : net->get_sink_pin_list()) {
+      ref_net.add_sink_pin(sink->get_x(), sink->get_y(), sink->get_name());
+    }
+    EXPECT_EQ(net->FluteWL(), ref_net.FluteWL());
+    for (WLPin* ref_pin : ref_net.get_pin_list()) {
+      delete ref_pin;
+    }
+  }
+
+  // the pin coord setters drop the cache of the net too.
+  wirelength_eval.evalTotalWL("kFlute");
+  for (WLNet* net : net_list) {
+    WLPin* pin = net->get_driver_pin();
+    pin->set_x(coord_dist(gen));
+    EXPECT_FALSE(net->isSteinerValid());
+    net->FluteWL();
+    pin->set_coord(Point<int64_t>(coord_dist(gen), coord_dist(gen)));
+    EXPECT_FALSE(net->isSteinerValid());
+  }
+  deleteNets(net_list);
+}
+
+TEST_F(WirelengthTest, totalWLBenchmark)
+{
+  std::mt19937 gen(0);
+  WirelengthEval wirelength_eval;
+  wirelength_eval.set_net_list(makeRandomNets(500000, 16, gen));
+
+  for (auto& [wl_type, net_wl_func] : getNetWLFuncs()) {
+    wirelength_eval.invalidateSteinerCache();
+    auto start = std::chrono::steady_clock::now();
+    int64_t ref_wl = 0;
+    for (WLNet* net : wirelength_eval.get_net_list()) {
+      ref_wl += net_wl_func(net);
+    }
+    auto mid = std::chrono::steady_clock::now();
+    wirelength_eval.invalidateSteinerCache();
+    int64_t total_wl = wirelength_eval.evalTotalWL(wl_type);
+    auto end = std::chrono::steady_clock::now();
+    int64_t cached_wl = wirelength_eval.evalTotalWL(wl_type);
+    auto cached_end = std::chrono::steady_clock::now();
+    EXPECT_EQ(total_wl, ref_wl) << wl_type;
+    EXPECT_EQ(cached_wl, ref_wl) << wl_type;
+    LOG_INFO << wl_type << " serial: " << std::chrono::duration<double>(mid - start).count()
+             << "s, parallel: " << std::chrono::duration<double>(end - mid).count()
+             << "s, cached: " << std::chrono::duration<double>(cached_end - end).count() << "s";
+  }
+  deleteNets(wirelength_eval.get_net_list());
+}
+
 TEST_F(WirelengthTest, sample)
 {
   std::string json_file = "/home/yhqiu/irefactor/src/platform/evaluator/source/config/ysyx_eval_t28.json";
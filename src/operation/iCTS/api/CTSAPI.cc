@@ -143,10 +143,11 @@ void CTSAPI::init(const std::string& config_file)
 
   _evaluator = new Evaluator();
   _model_factory = new ModelFactory();
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   auto external_models = _config->get_external_models();
   for (auto [net_name, model_path] : external_models) {
-    auto* model = _model_factory->pyLoad(model_path);
+    // native model file is evaluated in process, others are loaded by python
+    auto* model = _model_factory->load(model_path);
     _libs->insertModel(net_name, model);
   }
 #endif
@@ -248,6 +249,7 @@ double CTSAPI::getSinkCap(icts::CtsInstance* sink) const
 
 double CTSAPI::getSinkCap(const std::string& load_pin_full_name) const
 {
+  std::lock_guard<std::mutex> lock(_sta_mutex);
   return _timing_engine->reportInstPinCapacitance(load_pin_full_name.c_str());
 }
 
@@ -421,10 +423,12 @@ std::vector<double> CTSAPI::queryCellLibValue(const std::string& cell_master, co
 icts::CtsCellLib* CTSAPI::getCellLib(const std::string& cell_master, const std::string& from_port, const std::string& to_port,
                                      const bool& use_work_value)
 {
+  std::lock_guard<std::mutex> lock(_lib_mutex);
   CtsCellLib* lib = _libs->findLib(cell_master);
   if (lib) {
     return lib;
   }
+  std::lock_guard<std::mutex> sta_lock(_sta_mutex);
   auto index_list = queryCellLibIndex(cell_master, "cell_rise", from_port, to_port);
   std::vector<double> rise_delay = queryCellLibValue(cell_master, "cell_rise", from_port, to_port);
   std::vector<double> fall_delay = queryCellLibValue(cell_master, "cell_fall", from_port, to_port);
@@ -482,12 +486,20 @@ icts::CtsCellLib* CTSAPI::getCellLib(const std::string& cell_master, const std::
   std::vector<std::vector<double>> x_slew = {x_cap_out};
   lib->set_slew_coef(_model_factory->cppLinearModel(x_slew, y_slew));
 
+  // exported lib models are evaluated in process (native runtime), the python fitting is used otherwise
+  auto& lib_models = _config->get_lib_models();
+  if (lib_models.contains(cell_master)) {
+    auto& [delay_model_path, slew_model_path] = lib_models.at(cell_master);
+    lib->set_delay_lib_model(_model_factory->load(delay_model_path));
+    lib->set_slew_lib_model(_model_factory->load(slew_model_path));
+  } else {
 #ifdef PY_MODEL
-  auto* delay_lib_model = _model_factory->pyFit(x_delay, y_delay, icts::FitType::kCatBoost);
-  lib->set_delay_lib_model(delay_lib_model);
-  auto* slew_lib_model = _model_factory->pyFit(x_slew, y_slew, icts::FitType::kCatBoost);
-  lib->set_slew_lib_model(slew_lib_model);
+    auto* delay_lib_model = _model_factory->pyFit(x_delay, y_delay, icts::FitType::kCatBoost);
+    lib->set_delay_lib_model(delay_lib_model);
+    auto* slew_lib_model = _model_factory->pyFit(x_slew, y_slew, icts::FitType::kCatBoost);
+    lib->set_slew_lib_model(slew_lib_model);
 #endif
+  }
   _libs->insertLib(cell_master, lib);
   return lib;
 }
@@ -619,6 +631,11 @@ int CTSAPI::genId()
   return _design->nextId();
 }
 
+int CTSAPI::genRandomInt(const int& lower, const int& upper)
+{
+  return lower + static_cast<int>(_design->nextRandom() % (upper - lower + 1));
+}
+
 void CTSAPI::genFluteTree(const std::string& net_name, icts::Pin* driver, const std::vector<icts::Pin*>& loads)
 {
   std::vector<icts::Pin*> pins{driver};
@@ -637,8 +654,11 @@ void CTSAPI::genFluteTree(const std::string& net_name, icts::Pin* driver, const
   net.init(0, net_name, salt_pins);
 
   salt::Tree tree;
-  salt::FluteBuilder flute_builder;
-  flute_builder.Run(net, tree);
+  {
+    std::lock_guard<std::mutex> lock(_salt_mutex);
+    salt::FluteBuilder flute_builder;
+    flute_builder.Run(net, tree);
+  }
   tree.UpdateId();
   // connect driver node to all loads based on salt's tree(node), if node not exist, create new node
   auto source = tree.source;
@@ -680,8 +700,11 @@ void CTSAPI::genShallowLightTree(const std::string& net_name, icts::Pin* driver,
   net.init(0, net_name, salt_pins);
 
   salt::Tree tree;
-  salt::SaltBuilder salt_builder;
-  salt_builder.Run(net, tree, 0);
+  {
+    std::lock_guard<std::mutex> lock(_salt_mutex);
+    salt::SaltBuilder salt_builder;
+    salt_builder.Run(net, tree, 0);
+  }
 
   // connect driver node to all loads based on salt's tree(node), if node not exist, create new node
   auto source = tree.source;
@@ -749,8 +772,11 @@ icts::Inst* CTSAPI::genBeatSaltTree(const std::string& net_name, const std::vect
   });
   salt::Tree bound_skew_tree(salt_node_map[driver_pin], &salt_net);
   // BEAT Salt
-  icts::BeatSaltBuilder builder;
-  builder.run(salt_net, bound_skew_tree, 0);
+  {
+    std::lock_guard<std::mutex> lock(_salt_mutex);
+    icts::BeatSaltBuilder builder;
+    builder.run(salt_net, bound_skew_tree, 0);
+  }
 
   // connect driver node to all loads based on salt's tree(node), if node not exist, create new node
   icts::TreeBuilder::recoverNet(driver_pin->get_net());
@@ -864,12 +890,26 @@ bool CTSAPI::isTop(const std::string& net_name) const
 
 void CTSAPI::buildRCTree(const std::vector<icts::EvalNet>& eval_nets)
 {
+  ieda::Stats stats;
+  // the rc trees are made serially (name lookup), their rc info is updated in parallel
+  std::vector<ista::Net*> sta_nets;
+  sta_nets.reserve(eval_nets.size());
   for (auto& eval_net : eval_nets) {
-    buildRCTree(eval_net);
+    sta_nets.push_back(makeRCTree(eval_net));
   }
+  std::ranges::sort(sta_nets);
+  sta_nets.erase(std::unique(sta_nets.begin(), sta_nets.end()), sta_nets.end());
+  _timing_engine->updateRCTreeInfo(sta_nets);
+  LOG_INFO << "Build RC tree of " << sta_nets.size() << " nets, runtime " << stats.elapsedRunTime() << "s";
 }
 
 void CTSAPI::buildRCTree(const icts::EvalNet& eval_net)
+{
+  auto* sta_net = makeRCTree(eval_net);
+  _timing_engine->updateRCTreeInfo(sta_net);
+}
+
+ista::Net* CTSAPI::makeRCTree(const icts::EvalNet& eval_net)
 {
   auto net_name = eval_net.get_name();
   LOG_INFO << "Evaluate: " << net_name;
@@ -898,7 +938,7 @@ void CTSAPI::buildRCTree(const icts::EvalNet& eval_net)
     _timing_engine->incrCap(back_node, cap / 2, true);
   });
 
-  _timing_engine->updateRCTreeInfo(sta_net);
+  return sta_net;
 }
 
 void CTSAPI::resetRCTree(const std::string& net_name)
@@ -936,9 +976,6 @@ void CTSAPI::toPyArray(const icts::Point& point, const std::string& label)
   CTSAPIInst.saveToLog(label, "=[[", point.x(), ",", point.y(), "]]");
 }
 
-// python API
-#ifdef PY_MODEL
-
 #ifdef USE_EXTERNAL_MODEL
 icts::ModelBase* CTSAPI::findExternalModel(const std::string& net_name)
 {
@@ -946,6 +983,9 @@ icts::ModelBase* CTSAPI::findExternalModel(const std::string& net_name)
 }
 #endif
 
+// python API
+#ifdef PY_MODEL
+
 /**
  * @brief Python interface for plot
  *
@@ -23,6 +23,8 @@
 #include <any>
 #include <fstream>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -64,6 +66,7 @@ class CTSAPI
   void evaluate();
   icts::CtsConfig* get_config() { return _config; }
   icts::CtsDesign* get_design() { return _design; }
+  void set_design(icts::CtsDesign* design) { _design = design; }
   icts::CtsDBWrapper* get_db_wrapper() { return _db_wrapper; }
 
   // iSTA
@@ -109,6 +112,7 @@ class CTSAPI
   void insertBuffer(const std::string& name);
   void resetId();
   int genId();
+  int genRandomInt(const int& lower, const int& upper);
   void genFluteTree(const std::string& net_name, icts::Pin* driver, const std::vector<icts::Pin*>& loads);
   void genShallowLightTree(const std::string& net_name, icts::Pin* driver, const std::vector<icts::Pin*>& loads);
   icts::Inst* genBeatSaltTree(const std::string& net_name, const std::vector<icts::Pin*>& loads, const std::optional<double>& skew_bound,
@@ -141,6 +145,7 @@ class CTSAPI
   template <typename... Args>
   void saveToLog(const Args&... args)
   {
+    std::lock_guard<std::mutex> lock(_log_mutex);
     (*_log_ofs) << toString(args...) << std::endl;
   }
 
@@ -148,13 +153,13 @@ class CTSAPI
   void writeVerilog() const;
   void toPyArray(const icts::Point& point, const std::string& label);
 
-// python API
-#ifdef PY_MODEL
-
 #ifdef USE_EXTERNAL_MODEL
   icts::ModelBase* findExternalModel(const std::string& net_name);
 #endif
 
+// python API
+#ifdef PY_MODEL
+
   icts::ModelBase* fitPyModel(const std::vector<std::vector<double>>& X, const std::vector<double>& y, const icts::FitType& fit_type);
 
 #endif
@@ -170,6 +175,7 @@ class CTSAPI
   std::vector<std::string> splitString(std::string str, const char split);
   // private STA
   void readSTAFile();
+  ista::Net* makeRCTree(const icts::EvalNet& eval_net);
   ista::RctNode* makeRCTreeNode(const icts::EvalNet& eval_net, const std::string& name);
   ista::RctNode* makeLogicRCTreeNode(icts::CtsPin* pin);
   ista::DesignObject* findStaPin(icts::CtsPin* pin) const;
@@ -192,6 +198,11 @@ class CTSAPI
   icts::Evaluator* _evaluator = nullptr;
   icts::ModelFactory* _model_factory = nullptr;
   ista::TimingEngine* _timing_engine = nullptr;
+  // shared by concurrent routing tasks
+  std::mutex _lib_mutex;   // lazy lib cache
+  std::mutex _salt_mutex;  // salt/flute builders hold global state (e.g. flute LUT)
+  std::mutex _log_mutex;   // log file
+  mutable std::mutex _sta_mutex;  // sta queries, the timing engine is not thread safe
 };
 
 }  // namespace icts
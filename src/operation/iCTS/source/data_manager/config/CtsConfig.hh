@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -67,6 +68,7 @@ class CtsConfig
   const string& get_delay_type() const { return _delay_type; }
   const string& get_cluster_type() const { return _cluster_type; }
   int get_cluster_size() const { return _cluster_size; }
+  int get_thread_num() const { return _thread_num; }
   const string& get_sta_workspace() const { return _sta_workspace; }
   const string& get_output_def_path() const { return _output_def_path; }
   const string& get_log_file() const { return _log_file; }
@@ -79,6 +81,7 @@ class CtsConfig
   bool is_use_netlist() { return _use_netlist == "ON" ? true : false; }
   const vector<std::pair<string, string>> get_clock_netlist() const { return _net_list; }
   const vector<std::pair<string, string>> get_external_models() const { return _external_models; }
+  const std::map<string, std::pair<string, string>>& get_lib_models() const { return _lib_models; }
 
   void set_skew_bound(double skew_bound) { _skew_bound = skew_bound; }
   void set_max_buf_tran(double max_buf_tran) { _max_buf_tran = max_buf_tran; }
@@ -92,6 +95,7 @@ class CtsConfig
   void set_delay_type(const string& delay_type) { _delay_type = delay_type; }
   void set_cluster_type(const string& cluster_type) { _cluster_type = cluster_type; }
   void set_cluster_size(int size) { _cluster_size = size; }
+  void set_thread_num(int thread_num) { _thread_num = thread_num; }
   void set_sta_workspace(const string& sta_workspace) { _sta_workspace = sta_workspace; }
   void set_output_def_path(const string& output_def_path) { _output_def_path = output_def_path; }
   void set_log_file(const string& file) { _log_file = file; }
@@ -103,6 +107,7 @@ class CtsConfig
   void set_use_netlist(const string& use_netlist) { _use_netlist = use_netlist; }
   void set_netlist(const vector<std::pair<string, string>>& net_list) { _net_list = net_list; }
   void set_external_models(const vector<std::pair<string, string>>& external_models) { _external_models = external_models; }
+  void set_lib_models(const std::map<string, std::pair<string, string>>& lib_models) { _lib_models = lib_models; }
 
  private:
   // algorithm
@@ -117,6 +122,7 @@ class CtsConfig
   int _scale_size = 50;
   string _cluster_type = "kmeans";
   int _cluster_size = 32;
+  int _thread_num = 1;  // number of clock nets routed concurrently
   int _h_layer = 1;
   int _v_layer = 1;
   // file
@@ -129,5 +135,6 @@ class CtsConfig
   string _use_netlist = "OFF";
   vector<std::pair<string, string>> _net_list;
   vector<std::pair<string, string>> _external_models;
+  std::map<string, std::pair<string, string>> _lib_models;  // cell master -> (delay model path, slew model path)
 };
 }  // namespace icts
\ No newline at end of file
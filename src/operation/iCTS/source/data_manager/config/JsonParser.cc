@@ -123,6 +123,9 @@ void JsonParser::parse(const string& json_file, CtsConfig* config) const
     if (COMUtil::getData(json, {"cluster_size"}) != nullptr) {
       config->set_cluster_size(COMUtil::getData(json, {"cluster_size"}));
     }
+    if (COMUtil::getData(json, {"thread_num"}) != nullptr) {
+      config->set_thread_num(COMUtil::getData(json, {"thread_num"}));
+    }
     if (COMUtil::getData(json, {"buffer_type"}) != nullptr) {
       config->set_buffer_types(COMUtil::getData(json, {"buffer_type"}));
     }
@@ -163,6 +166,20 @@ void JsonParser::parse(const string& json_file, CtsConfig* config) const
 
       config->set_external_models(external_models);
     }
+
+    nlohmann::json json_lib_models = COMUtil::getData(json, {"lib_model"});
+    {
+      auto cell_master_list = COMUtil::getSerializeObjectData(json_lib_models, "cell_master", data_type_string);
+      auto delay_model_path_list = COMUtil::getSerializeObjectData(json_lib_models, "delay_model_path", data_type_string);
+      auto slew_model_path_list = COMUtil::getSerializeObjectData(json_lib_models, "slew_model_path", data_type_string);
+
+      std::map<string, std::pair<string, string>> lib_models;
+      for (size_t i = 0; i < cell_master_list.size(); ++i) {
+        lib_models[cell_master_list[i]] = std::make_pair(resolvePath(delay_model_path_list[i]), resolvePath(slew_model_path_list[i]));
+      }
+
+      config->set_lib_models(lib_models);
+    }
   }
 
   ifs.close();
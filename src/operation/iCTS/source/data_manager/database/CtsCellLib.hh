@@ -61,10 +61,8 @@ class CtsCellLib
   void set_delay_coef(const std::vector<double>& coef) { _delay_coef = coef; }
   void set_slew_coef(const std::vector<double>& coef) { _slew_coef = coef; }
   void set_init_cap(const double& init_cap) { _init_cap = init_cap; }
-#ifdef PY_MODEL
   void set_delay_lib_model(ModelBase* delay_lib_model) { _delay_lib_model = delay_lib_model; }
   void set_slew_lib_model(ModelBase* slew_lib_model) { _slew_lib_model = slew_lib_model; }
-#endif
 
   // calc
   double calcSlew(const double& cap_out) const
@@ -103,9 +101,9 @@ class CtsCellLib
   }
   double calcDelay(const double& slew_in, const double& cap_out) const
   {
-#ifdef PY_MODEL
-    return _delay_lib_model->predict({slew_in, cap_out});
-#endif
+    if (_delay_lib_model) {
+      return _delay_lib_model->predict({slew_in, cap_out});
+    }
     return calcInsertDelay(slew_in, cap_out);
   }
   double calcLinearSlew(const double& cap_out) const { return _slew_coef[0] + _slew_coef[1] * cap_out; }
@@ -150,10 +148,8 @@ class CtsCellLib
   std::vector<double> _delay_coef;
   std::vector<double> _slew_coef;
   double _init_cap = 0.0;
-#ifdef PY_MODEL
   ModelBase* _delay_lib_model = nullptr;
   ModelBase* _slew_lib_model = nullptr;
-#endif
 };
 
 class CtsLibs
@@ -170,7 +166,7 @@ class CtsLibs
     }
     return _lib_maps[cell_master];
   }
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   void insertModel(const std::string& net_name, ModelBase* model) { _model_maps[net_name] = model; }
 
   ModelBase* findModel(const std::string& net_name)
@@ -183,7 +179,7 @@ class CtsLibs
 #endif
  private:
   std::map<std::string, CtsCellLib*> _lib_maps;
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   std::map<std::string, ModelBase*> _model_maps;
 #endif
 };
@@ -21,6 +21,9 @@
 #include "CtsDesign.hh"
 
 namespace icts {
+thread_local int* CtsDesign::_task_id = nullptr;
+thread_local std::mt19937* CtsDesign::_task_random = nullptr;
+
 CtsDesign::~CtsDesign()
 {
   for (auto* net : _nets) {
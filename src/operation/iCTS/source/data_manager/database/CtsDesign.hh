@@ -20,6 +20,7 @@
  */
 #pragma once
 
+#include <random>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -37,8 +38,13 @@ class CtsDesign
   CtsDesign(const CtsDesign&) = default;
   ~CtsDesign();
 
-  void resetId() { _id = 0; }
-  int nextId() { return _id++; }
+  void resetId(const int& id = 0) { idRef() = id; }
+  int nextId() { return idRef()++; }
+  // bind the id space of current thread to a routing task, nullptr to use the design's id
+  static void bindTaskId(int* task_id) { _task_id = task_id; }
+  unsigned nextRandom() { return randomRef()(); }
+  // bind the random engine of current thread to a routing task, nullptr to use the design's engine
+  static void bindTaskRandom(std::mt19937* task_random) { _task_random = task_random; }
   bool isClockTopNet(const std::string& net_name) const
   {
     for (auto [clock, clock_net_name] : _clock_net_names) {
@@ -94,7 +100,13 @@ class CtsDesign
   Net* findSolverNet(const std::string& net_name) const;
 
  private:
+  int& idRef() { return _task_id ? *_task_id : _id; }
+  std::mt19937& randomRef() { return _task_random ? *_task_random : _random; }
+
+  static thread_local int* _task_id;
+  static thread_local std::mt19937* _task_random;
   int _id = 0;
+  std::mt19937 _random;
   std::vector<std::pair<std::string, std::string>> _clock_net_names;
 
   std::vector<CtsClock*> _clocks;
@@ -159,6 +159,24 @@ std::unique_ptr<CtsReportTable> CtsReportTable::createReportTable(const std::str
       (*report_tbl)[0][5] = "Violation";
       (*report_tbl) << TABLE_ENDLINE;
       break;
+    case CtsReportType::kLEVEL_RUNTIME:
+      (*report_tbl) << TABLE_HEAD;
+      (*report_tbl)[0][0] = "Level";
+      (*report_tbl)[0][1] = "Inst Num";
+      (*report_tbl)[0][2] = "Clustering Time(s)";
+      (*report_tbl)[0][3] = "Level Time(s)";
+      (*report_tbl) << TABLE_ENDLINE;
+      break;
+    case CtsReportType::kNET_RUNTIME:
+      (*report_tbl) << TABLE_HEAD;
+      (*report_tbl)[0][0] = "Clock";
+      (*report_tbl)[0][1] = "Net";
+      (*report_tbl)[0][2] = "Sink Num";
+      (*report_tbl)[0][3] = "Buf Num";
+      (*report_tbl)[0][4] = "Solver Net Num";
+      (*report_tbl)[0][5] = "Runtime(s)";
+      (*report_tbl) << TABLE_ENDLINE;
+      break;
     default:
       break;
   }
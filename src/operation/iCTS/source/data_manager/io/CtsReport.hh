@@ -55,6 +55,8 @@ enum CtsReportType
   kLEVEL_DELAY = 11,
   kLEVEL_INSERT_DELAY = 12,
   kLEVEL_SKEW = 13,
+  kLEVEL_RUNTIME = 14,
+  kNET_RUNTIME = 15,
 };
 
 class CtsReportTable : public ieda::ReportTable
@@ -22,8 +22,12 @@
 
 #include <Eigen/Dense>
 #include <cmath>
+#include <fstream>
 #include <unsupported/Eigen/Polynomials>
 
+#include "log/Log.hh"
+#include "native/NativeModel.hh"
+
 #ifdef PY_MODEL
 #include "PyModel.h"
 #endif
@@ -68,6 +72,67 @@ std::vector<double> ModelFactory::cppLinearModel(const std::vector<std::vector<d
 
   return result;
 }
+std::vector<double> ModelBase::predictBatch(const std::vector<std::vector<double>>& batch) const
+{
+  std::vector<double> result;
+  result.reserve(batch.size());
+  for (const auto& x : batch) {
+    result.push_back(predict(x));
+  }
+  return result;
+}
+
+ModelBase* ModelFactory::cppFit(const std::vector<std::vector<double>>& x, const std::vector<double>& y, const FitType& fit_type) const
+{
+  if (fit_type != FitType::kLinear) {
+    LOG_ERROR << "only linear model can be fitted natively, export boosted model by native/export_model.py";
+    return nullptr;
+  }
+  auto coef = cppLinearModel(x, y);
+  return new LinearModel(coef.front(), std::vector<double>(coef.begin() + 1, coef.end()));
+}
+
+ModelBase* ModelFactory::cppLoad(const std::string& model_path) const
+{
+  std::ifstream ifs(model_path);
+  if (!ifs.is_open()) {
+    LOG_ERROR << "can't open model file: " << model_path;
+    return nullptr;
+  }
+  std::string magic;
+  std::string model_type;
+  ifs >> magic >> model_type;
+  if (magic != kNativeModelMagic) {
+    LOG_ERROR << "not a native model file: " << model_path;
+    return nullptr;
+  }
+  ModelBase* model = nullptr;
+  if (model_type == "linear") {
+    model = LinearModel::read(ifs);
+  } else if (model_type == "tree_ensemble") {
+    model = TreeEnsembleModel::read(ifs);
+  } else {
+    LOG_ERROR << "unknown native model type \"" << model_type << "\"";
+  }
+  LOG_ERROR_IF(!model) << "failed to load native model: " << model_path;
+  return model;
+}
+
+ModelBase* ModelFactory::load(const std::string& model_path) const
+{
+  std::ifstream ifs(model_path);
+  std::string magic;
+  ifs >> magic;
+  if (magic == kNativeModelMagic) {
+    return cppLoad(model_path);
+  }
+#ifdef PY_MODEL
+  return pyLoad(model_path);
+#else
+  LOG_ERROR << "not a native model file (python model requires PY_MODEL): " << model_path;
+  return nullptr;
+#endif
+}
 #ifdef PY_MODEL
 /**
  * @brief Python interface for timing model
@@ -76,7 +141,7 @@ std::vector<double> ModelFactory::cppLinearModel(const std::vector<std::vector<d
  * @param y (n)
  */
 
-double ModelBase::predict(const std::vector<double>& x) const
+double PythonModel::predict(const std::vector<double>& x) const
 {
   return pyPredict(x, _model);
 }
@@ -98,13 +163,13 @@ ModelBase* ModelFactory::pyFit(const std::vector<std::vector<double>>& x, const
       model = pyLinearModel(x, y);
       break;
   }
-  return new ModelBase(model);
+  return new PythonModel(model);
 }
 
 ModelBase* ModelFactory::pyLoad(const std::string& model_path) const
 {
   auto* model = pyLoadModel(model_path);
-  return new ModelBase(model);
+  return new PythonModel(model);
 }
 #endif
 }  // namespace icts
\ No newline at end of file
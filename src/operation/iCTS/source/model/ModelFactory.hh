@@ -31,13 +31,30 @@ namespace icts {
 
 enum class FitType { kLinear, kCatBoost, kXgBoost };
 
-class ModelBase : public PyToolBase {
+/**
+ * @brief Timing model interface
+ *       native models (see native/NativeModel.hh) are evaluated in process,
+ *       python models go through the embedded interpreter (PY_MODEL)
+ *
+ */
+class ModelBase {
  public:
+  ModelBase() = default;
+  virtual ~ModelBase() = default;
+
+  virtual double predict(const std::vector<double>& x) const = 0;
+  /**
+   * @brief predict a batch of feature vectors
+   *
+   * @param batch (num of samples x num of features)
+   */
+  virtual std::vector<double> predictBatch(const std::vector<std::vector<double>>& batch) const;
+};
+
 #ifdef PY_MODEL
-  ModelBase(PyObject* model) {
-    PyToolBase();
-    _model = model;
-  }
+class PythonModel : public ModelBase, public PyToolBase {
+ public:
+  PythonModel(PyObject* model) : PyToolBase(), _model(model) {}
 
   /**
    * @brief Python interface for timing model
@@ -45,16 +62,12 @@ class ModelBase : public PyToolBase {
    * @param X (m x n)
    * @param y (n)
    */
-  double predict(const std::vector<double>& X) const;
-
-#endif
+  double predict(const std::vector<double>& X) const override;
 
  private:
-#ifdef PY_MODEL
-
   PyObject* _model = NULL;
-#endif
 };
+#endif
 
 class ModelFactory : public PyToolBase {
  public:
@@ -63,6 +76,23 @@ class ModelFactory : public PyToolBase {
 
   std::vector<double> cppLinearModel(const std::vector<std::vector<double>>& x,
                                      const std::vector<double>& y) const;
+  /**
+   * @brief Native timing model, no python required
+   *       only kLinear can be fitted natively, boosted models are exported from python and loaded by cppLoad
+   *
+   * @param X (m x n)
+   * @param y (n)
+   */
+  ModelBase* cppFit(const std::vector<std::vector<double>>& X,
+                    const std::vector<double>& y, const FitType& fit_type) const;
+
+  ModelBase* cppLoad(const std::string& model_path) const;
+  /**
+   * @brief load native model if the file is exported for native runtime, otherwise load python model (PY_MODEL)
+   *
+   * @param model_path
+   */
+  ModelBase* load(const std::string& model_path) const;
 #ifdef PY_MODEL
   /**
    * @brief Python interface for timing model
@@ -0,0 +1,249 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file NativeModel.cc
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ */
+#include "NativeModel.hh"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <limits>
+
+#include "log/Log.hh"
+
+namespace icts {
+namespace {
+bool expectKey(std::istream& is, const std::string& key)
+{
+  std::string token;
+  if (!(is >> token) || token != key) {
+    LOG_ERROR << "native model: expect \"" << key << "\" but got \"" << token << "\"";
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool readValue(std::istream& is, const std::string& key, T& value)
+{
+  if (!(is >> value)) {
+    LOG_ERROR << "native model: invalid value of \"" << key << "\"";
+    return false;
+  }
+  return true;
+}
+
+void checkFeatures(const std::vector<double>& x, const size_t& num_features)
+{
+  LOG_FATAL_IF(x.size() < num_features) << "native model: expect " << num_features << " features but got " << x.size();
+}
+}  // namespace
+
+LinearModel* LinearModel::read(std::istream& is)
+{
+  size_t num_features = 0;
+  double intercept = 0;
+  if (!expectKey(is, "num_features") || !readValue(is, "num_features", num_features) || !expectKey(is, "intercept")
+      || !readValue(is, "intercept", intercept) || !expectKey(is, "coef")) {
+    return nullptr;
+  }
+  std::vector<double> coef(num_features);
+  for (auto& w : coef) {
+    if (!readValue(is, "coef", w)) {
+      return nullptr;
+    }
+  }
+  return new LinearModel(intercept, coef);
+}
+
+double LinearModel::predict(const std::vector<double>& x) const
+{
+  checkFeatures(x, _coef.size());
+  double y = _intercept;
+  for (size_t i = 0; i < _coef.size(); ++i) {
+    y += _coef[i] * x[i];
+  }
+  return y;
+}
+
+std::vector<double> LinearModel::predictBatch(const std::vector<std::vector<double>>& batch) const
+{
+  using RowMatrix = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  auto num = batch.size();
+  auto num_features = _coef.size();
+  RowMatrix xs(num, num_features);
+  for (size_t i = 0; i < num; ++i) {
+    checkFeatures(batch[i], num_features);
+    xs.row(i) = Eigen::Map<const Eigen::RowVectorXd>(batch[i].data(), num_features);
+  }
+  Eigen::VectorXd ys = xs * Eigen::Map<const Eigen::VectorXd>(_coef.data(), num_features);
+  ys.array() += _intercept;
+  return std::vector<double>(ys.data(), ys.data() + num);
+}
+
+TreeEnsembleModel* TreeEnsembleModel::read(std::istream& is)
+{
+  size_t num_features = 0;
+  double base_score = 0;
+  size_t num_trees = 0;
+  if (!expectKey(is, "num_features") || !readValue(is, "num_features", num_features) || !expectKey(is, "base_score")
+      || !readValue(is, "base_score", base_score) || !expectKey(is, "num_trees") || !readValue(is, "num_trees", num_trees)) {
+    return nullptr;
+  }
+
+  auto* model = new TreeEnsembleModel(num_features, base_score);
+  auto read_tree = [&]() {
+    size_t num_nodes = 0;
+    if (!expectKey(is, "tree") || !readValue(is, "tree", num_nodes)) {
+      return false;
+    }
+    std::vector<TreeNode> nodes(num_nodes);
+    for (auto& node : nodes) {
+      if (!readValue(is, "feature", node.feature) || !readValue(is, "threshold", node.threshold) || !readValue(is, "left", node.left)
+          || !readValue(is, "right", node.right) || !readValue(is, "value", node.value)) {
+        return false;
+      }
+    }
+    return model->addTree(nodes);
+  };
+  for (size_t t = 0; t < num_trees; ++t) {
+    if (!read_tree()) {
+      delete model;
+      return nullptr;
+    }
+  }
+  return model;
+}
+
+bool TreeEnsembleModel::addTree(const std::vector<TreeNode>& nodes)
+{
+  if (nodes.empty()) {
+    LOG_ERROR << "native model: empty tree";
+    return false;
+  }
+  int num_nodes = nodes.size();
+  for (int i = 0; i < num_nodes; ++i) {
+    const auto& node = nodes[i];
+    if (node.feature >= 0
+        && (static_cast<size_t>(node.feature) >= _num_features || node.left < 0 || node.left >= num_nodes || node.right < 0
+            || node.right >= num_nodes)) {
+      LOG_ERROR << "native model: invalid node " << i << " of tree " << _tree_roots.size();
+      return false;
+    }
+  }
+  auto depth = calcDepth(nodes, 0);
+  if (depth < 0) {
+    LOG_ERROR << "native model: tree " << _tree_roots.size() << " is not a tree";
+    return false;
+  }
+
+  int offset = _nodes.size();
+  for (int i = 0; i < num_nodes; ++i) {
+    const auto& node = nodes[i];
+    if (node.feature < 0) {
+      // leaf points to itself, any sample stays here
+      _nodes.push_back({std::numeric_limits<double>::infinity(), 0, {offset + i, offset + i}});
+      _values.push_back(node.value);
+      continue;
+    }
+    _nodes.push_back({node.threshold, node.feature, {offset + node.left, offset + node.right}});
+    _values.push_back(0);
+  }
+  _tree_depths.push_back(depth);
+  _tree_roots.push_back(offset);
+  return true;
+}
+
+/**
+ * @brief max depth of the tree, -1 if there is a cycle
+ *
+ */
+int TreeEnsembleModel::calcDepth(const std::vector<TreeNode>& nodes, const int& root) const
+{
+  int num_nodes = nodes.size();
+  int max_depth = 0;
+  std::vector<std::pair<int, int>> stack = {{root, 0}};
+  while (!stack.empty()) {
+    auto [id, depth] = stack.back();
+    stack.pop_back();
+    if (depth >= num_nodes) {
+      return -1;
+    }
+    if (nodes[id].feature < 0) {
+      max_depth = std::max(max_depth, depth);
+      continue;
+    }
+    stack.emplace_back(nodes[id].left, depth + 1);
+    stack.emplace_back(nodes[id].right, depth + 1);
+  }
+  return max_depth;
+}
+
+double TreeEnsembleModel::predict(const std::vector<double>& x) const
+{
+  checkFeatures(x, _num_features);
+  double y = _base_score;
+  for (size_t t = 0; t < _tree_roots.size(); ++t) {
+    auto node = _tree_roots[t];
+    for (int d = 0; d < _tree_depths[t]; ++d) {
+      const auto& flat_node = _nodes[node];
+      node = flat_node.children[!(x[flat_node.feature] < flat_node.threshold)];
+    }
+    y += _values[node];
+  }
+  return y;
+}
+
+std::vector<double> TreeEnsembleModel::predictBatch(const std::vector<std::vector<double>>& batch) const
+{
+  constexpr int kBlockSize = 256;
+  int num = batch.size();
+  // leaves read feature 0, keep one column for the model without feature
+  auto stride = std::max(_num_features, size_t{1});
+  std::vector<double> xs(num * stride, 0.0);
+  for (int i = 0; i < num; ++i) {
+    checkFeatures(batch[i], _num_features);
+    std::copy_n(batch[i].begin(), _num_features, xs.begin() + i * stride);
+  }
+  std::vector<double> ys(num, _base_score);
+  int num_blocks = (num + kBlockSize - 1) / kBlockSize;
+#pragma omp parallel for schedule(static) if (num_blocks > 1)
+  for (int b = 0; b < num_blocks; ++b) {
+    int begin = b * kBlockSize;
+    int size = std::min(num - begin, kBlockSize);
+    const double* x = xs.data() + begin * stride;
+    int nodes[kBlockSize];
+    // trees are added in order, the sum is the same as single prediction
+    for (size_t t = 0; t < _tree_roots.size(); ++t) {
+      std::fill_n(nodes, size, _tree_roots[t]);
+      for (int d = 0; d < _tree_depths[t]; ++d) {
+#pragma omp simd
+        for (int i = 0; i < size; ++i) {
+          const auto& flat_node = _nodes[nodes[i]];
+          nodes[i] = flat_node.children[!(x[i * stride + flat_node.feature] < flat_node.threshold)];
+        }
+      }
+      for (int i = 0; i < size; ++i) {
+        ys[begin + i] += _values[nodes[i]];
+      }
+    }
+  }
+  return ys;
+}
+
+}  // namespace icts
@@ -0,0 +1,122 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file NativeModel.hh
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ */
+#pragma once
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "ModelFactory.hh"
+
+namespace icts {
+/**
+ * @brief Native model file (text), exported by native/export_model.py
+ *
+ *       icts_model linear
+ *       num_features <n>
+ *       intercept <b>
+ *       coef <w_0> ... <w_n-1>
+ *
+ *       icts_model tree_ensemble
+ *       num_features <n>
+ *       base_score <b>
+ *       num_trees <t>
+ *       tree <num_nodes>
+ *       <feature> <threshold> <left> <right> <value>   (one line per node, node 0 is root, leaf: feature -1)
+ *
+ *       a sample goes to left child if x[feature] < threshold, otherwise right child
+ *
+ */
+constexpr char kNativeModelMagic[] = "icts_model";
+
+class LinearModel : public ModelBase
+{
+ public:
+  LinearModel(const double& intercept, const std::vector<double>& coef) : _intercept(intercept), _coef(coef) {}
+  ~LinearModel() override = default;
+
+  // nullptr if the model is invalid
+  static LinearModel* read(std::istream& is);
+
+  double predict(const std::vector<double>& x) const override;
+  std::vector<double> predictBatch(const std::vector<std::vector<double>>& batch) const override;
+
+  size_t get_num_features() const { return _coef.size(); }
+
+ private:
+  double _intercept = 0;
+  std::vector<double> _coef;
+};
+/**
+ * @brief Tree ensemble (XGBoost trees, CatBoost oblivious trees), sum of leaf values plus base score
+ *
+ *       all trees are stored in flat arrays, leaf nodes point to themselves with threshold +inf,
+ *       so a sample reaches its leaf after exactly tree depth steps without branches,
+ *       batch prediction walks each tree for a block of samples in lock step (vectorizable)
+ *
+ */
+class TreeEnsembleModel : public ModelBase
+{
+ public:
+  struct TreeNode
+  {
+    int feature;  // -1 for leaf
+    double threshold;
+    int left;
+    int right;
+    double value;
+  };
+
+  TreeEnsembleModel(const size_t& num_features, const double& base_score) : _num_features(num_features), _base_score(base_score) {}
+  ~TreeEnsembleModel() override = default;
+
+  // nullptr if the model is invalid
+  static TreeEnsembleModel* read(std::istream& is);
+
+  // node index is local to the tree, root is the first node, false if the tree is invalid
+  bool addTree(const std::vector<TreeNode>& nodes);
+
+  double predict(const std::vector<double>& x) const override;
+  std::vector<double> predictBatch(const std::vector<std::vector<double>>& batch) const override;
+
+  size_t get_num_features() const { return _num_features; }
+  size_t get_num_trees() const { return _tree_roots.size(); }
+
+ private:
+  int calcDepth(const std::vector<TreeNode>& nodes, const int& root) const;
+
+  size_t _num_features = 0;
+  double _base_score = 0;
+  // flat nodes of all trees, the fields used in one step are packed together
+  struct FlatNode
+  {
+    double threshold;
+    int feature;
+    int children[2];  // left, right
+  };
+  std::vector<FlatNode> _nodes;
+  std::vector<double> _values;
+  // trees
+  std::vector<int> _tree_roots;
+  std::vector<int> _tree_depths;
+};
+
+}  // namespace icts
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""
+Export python timing model (LinearRegression, XGBRegressor, CatBoostRegressor)
+to the text format of the native model runtime (NativeModel.hh)
+
+usage: python3 export_model.py <model.joblib.dat> <model.icm>
+"""
+import json
+import os
+import sys
+import tempfile
+
+import joblib
+import numpy as np
+
+
+def _fmt(value):
+    # repr of python float keeps full precision
+    return repr(float(value))
+
+
+def export_linear(model, ofs):
+    coef = np.asarray(model.coef_, dtype=float).reshape(-1)
+    intercept = float(np.asarray(model.intercept_, dtype=float).reshape(-1)[0])
+    ofs.write("icts_model linear\n")
+    ofs.write("num_features {}\n".format(coef.size))
+    ofs.write("intercept {}\n".format(_fmt(intercept)))
+    ofs.write("coef {}\n".format(" ".join(_fmt(w) for w in coef)))
+
+
+def _write_trees(ofs, num_features, base_score, trees):
+    ofs.write("icts_model tree_ensemble\n")
+    ofs.write("num_features {}\n".format(num_features))
+    ofs.write("base_score {}\n".format(_fmt(base_score)))
+    ofs.write("num_trees {}\n".format(len(trees)))
+    for nodes in trees:
+        ofs.write("tree {}\n".format(len(nodes)))
+        for feature, threshold, left, right, value in nodes:
+            ofs.write("{} {} {} {} {}\n".format(feature, _fmt(threshold), left, right, _fmt(value)))
+
+
+def export_xgboost(model, ofs):
+    booster = model.get_booster()
+    config = json.loads(booster.save_config())
+    base_score = float(config["learner"]["learner_model_param"]["base_score"])
+    num_features = booster.num_features()
+    trees = []
+    for dump in booster.get_dump(dump_format="json"):
+        root = json.loads(dump)
+        # renumber nodes in bfs order, root first
+        nodes = []
+        queue = [root]
+        index = {root["nodeid"]: 0}
+        while queue:
+            node = queue.pop(0)
+            if "leaf" in node:
+                nodes.append((-1, 0.0, -1, -1, node["leaf"]))
+                continue
+            children = {child["nodeid"]: child for child in node["children"]}
+            for child_id in (node["yes"], node["no"]):
+                index[child_id] = len(index)
+                queue.append(children[child_id])
+            feature = node["split"]
+            feature = int(feature[1:]) if isinstance(feature, str) and feature.startswith("f") else int(feature)
+            # xgboost: x < split_condition goes to "yes"
+            nodes.append((feature, node["split_condition"], index[node["yes"]], index[node["no"]], 0.0))
+        trees.append(nodes)
+    _write_trees(ofs, num_features, base_score, trees)
+
+
+def export_catboost(model, ofs):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        path = os.path.join(tmp_dir, "model.json")
+        model.save_model(path, format="json")
+        with open(path) as ifs:
+            data = json.load(ifs)
+    float_features = data["features_info"]["float_features"]
+    num_features = max(feature["flat_feature_index"] for feature in float_features) + 1
+    feature_index = {feature["feature_index"]: feature["flat_feature_index"] for feature in float_features}
+    scale, bias = 1.0, 0.0
+    if "scale_and_bias" in data:
+        scale, bias = data["scale_and_bias"]
+        bias = float(np.asarray(bias, dtype=float).reshape(-1)[0])
+    trees = []
+    for tree in data["oblivious_trees"]:
+        splits = tree.get("splits", [])
+        leaf_values = tree["leaf_values"]
+        depth = len(splits)
+        # expand oblivious tree, level k tests splits[depth - 1 - k], bit i of leaf index is (x > border of splits[i])
+        nodes = []
+
+        def build(level, leaf_index):
+            node_id = len(nodes)
+            nodes.append(None)
+            if level == depth:
+                nodes[node_id] = (-1, 0.0, -1, -1, scale * leaf_values[leaf_index])
+                return node_id
+            split = splits[depth - 1 - level]
+            bit = 1 << (depth - 1 - level)
+            left = build(level + 1, leaf_index)
+            right = build(level + 1, leaf_index | bit)
+            # catboost: x > border goes right, so x < nextafter(border) goes left
+            threshold = np.nextafter(split["border"], np.inf)
+            nodes[node_id] = (feature_index[split["float_feature_index"]], threshold, left, right, 0.0)
+            return node_id
+
+        build(0, 0)
+        trees.append(nodes)
+    _write_trees(ofs, num_features, bias, trees)
+
+
+def export_model(model, path):
+    name = type(model).__name__
+    with open(path, "w") as ofs:
+        if name == "LinearRegression":
+            export_linear(model, ofs)
+        elif name == "XGBRegressor":
+            export_xgboost(model, ofs)
+        elif name == "CatBoostRegressor":
+            export_catboost(model, ofs)
+        else:
+            raise ValueError("unsupported model type: {}".format(name))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print(__doc__)
+        sys.exit(1)
+    export_model(joblib.load(sys.argv[1]), sys.argv[2])
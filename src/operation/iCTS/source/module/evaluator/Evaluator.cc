@@ -103,9 +103,7 @@ void Evaluator::recursiveSetLevel(CtsNet* net) const
 void Evaluator::evaluate()
 {
   CTSAPIInst.refresh();
-  for (auto eval_net : _eval_nets) {
-    CTSAPIInst.buildRCTree(eval_net);
-  }
+  CTSAPIInst.buildRCTree(_eval_nets);
   CTSAPIInst.reportTiming();
 }
 
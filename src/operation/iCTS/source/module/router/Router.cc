@@ -22,8 +22,10 @@
 
 #include "CTSAPI.hh"
 #include "CtsDBWrapper.hh"
+#include "CtsReport.hh"
 #include "GOCA.hh"
 #include "TimingPropagator.hh"
+#include "usage/usage.hh"
 namespace icts {
 void Router::init()
 {
@@ -50,27 +52,41 @@ void Router::init()
     }
   }
 }
+/**
+ * @brief route all clock nets
+ *       each net is a task with its own id space and solver set, which makes the nets independent,
+ *       so tasks can run concurrently (config "thread_num"), the results are merged in net order
+ *
+ */
 void Router::build()
 {
+  std::vector<RoutingTask> tasks;
   for (auto* clock : _clocks) {
-    auto* design = CTSAPIInst.get_design();
     auto& clock_nets = clock->get_clock_nets();
     CTSAPIInst.saveToLog("\n\n");
     for (auto* clk_net : clock_nets) {
       CTSAPIInst.saveToLog("clock net: ", clk_net->get_net_name());
       LOG_INFO << "clock net: " << clk_net->get_net_name();
-      design->resetId();
       auto sink_pins = getSinkPins(clk_net);
       auto buf_pins = getBufferPins(clk_net);
       CTSAPIInst.saveToLog("sink pins: ", sink_pins.size());
       LOG_INFO << "sink pins: " << sink_pins.size();
       CTSAPIInst.saveToLog("buf pins: ", buf_pins.size());
       LOG_INFO << "buf pins: " << buf_pins.size();
-      gocaRouting(clk_net);
-      clk_net->setClockRouted();
+      RoutingTask task;
+      task.clock = clock;
+      task.clk_net = clk_net;
+      task.sink_num = sink_pins.size();
+      task.buf_num = buf_pins.size();
+      task.random.seed(tasks.size());
+      tasks.push_back(task);
     }
   }
+  runTasks(tasks);
+  mergeTasks(tasks);
+  runtimeReport(tasks);
 }
+
 void Router::update()
 {
   LOG_INFO << "Synthesis data to cts design...";
@@ -96,7 +112,67 @@ void Router::printLog()
   LOG_INFO << "Enter router!";
 }
 
-void Router::gocaRouting(CtsNet* clk_net)
+void Router::runTasks(std::vector<RoutingTask>& tasks)
+{
+  auto thread_num = std::max(CTSAPIInst.get_config()->get_thread_num(), 1);
+#ifdef PY_MODEL
+  if (thread_num > 1) {
+    // python models are not thread safe
+    LOG_WARNING << "PY_MODEL is enabled, clock nets are routed serially";
+    thread_num = 1;
+  }
+#endif
+  thread_num = std::min(thread_num, static_cast<int>(tasks.size()));
+  LOG_INFO << "route " << tasks.size() << " clock nets with " << std::max(thread_num, 1) << " threads";
+  auto run_task = [&](RoutingTask& task) {
+    CtsDesign::bindTaskId(&task.id);
+    CtsDesign::bindTaskRandom(&task.random);
+    ieda::Stats stats;
+    gocaRouting(task.clk_net, task.solver_set);
+    task.runtime = stats.elapsedRunTime();
+    CtsDesign::bindTaskId(nullptr);
+    CtsDesign::bindTaskRandom(nullptr);
+  };
+  if (thread_num <= 1) {
+    std::ranges::for_each(tasks, run_task);
+    return;
+  }
+  int task_num = tasks.size();
+#pragma omp parallel for schedule(dynamic, 1) num_threads(thread_num)
+  for (int i = 0; i < task_num; ++i) {
+    run_task(tasks[i]);
+  }
+}
+
+void Router::mergeTasks(std::vector<RoutingTask>& tasks)
+{
+  std::ranges::for_each(tasks, [&](RoutingTask& task) {
+    std::ranges::for_each(task.solver_set.get_nets(), [&](Net* net) {
+      _solver_set.add_net(net);
+      std::ranges::for_each(net->get_pins(), [&](Pin* pin) { _solver_set.add_pin(pin); });
+    });
+    task.clk_net->setClockRouted();
+  });
+  if (!tasks.empty()) {
+    // keep going on the id space of the last net, the same as routing serially
+    CTSAPIInst.get_design()->resetId(tasks.back().id);
+  }
+}
+
+void Router::runtimeReport(const std::vector<RoutingTask>& tasks)
+{
+  auto rpt = CtsReportTable::createReportTable("Net Runtime Log", CtsReportType::kNET_RUNTIME);
+  double total_runtime = 0;
+  std::ranges::for_each(tasks, [&](const RoutingTask& task) {
+    (*rpt) << task.clock->get_clock_name() << task.clk_net->get_net_name() << task.sink_num << task.buf_num
+           << task.solver_set.get_nets().size() << task.runtime << TABLE_ENDLINE;
+    total_runtime += task.runtime;
+  });
+  (*rpt) << "Total" << TABLE_SKIP << TABLE_SKIP << TABLE_SKIP << TABLE_SKIP << total_runtime << TABLE_ENDLINE;
+  CTSAPIInst.saveToLog("\n", std::string(rpt->c_str()));
+}
+
+void Router::gocaRouting(CtsNet* clk_net, SolverSet& solver_set)
 {
   auto pins = clk_net->get_load_pins();
   if (pins.empty()) {
@@ -112,8 +188,8 @@ void Router::gocaRouting(CtsNet* clk_net)
     return;
   }
   std::ranges::for_each(clk_nets, [&](Net* net) {
-    _solver_set.add_net(net);
-    std::ranges::for_each(net->get_pins(), [&](Pin* pin) { _solver_set.add_pin(pin); });
+    solver_set.add_net(net);
+    std::ranges::for_each(net->get_pins(), [&](Pin* pin) { solver_set.add_pin(pin); });
   });
 }
 
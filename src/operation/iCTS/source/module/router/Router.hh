@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <random>
 #include <unordered_map>
 #include <vector>
 
@@ -55,7 +56,7 @@ class SolverSet
     }
   }
   // get
-  std::vector<Net*> get_nets() { return _nets; }
+  std::vector<Net*> get_nets() const { return _nets; }
   Net* get_last_net() const { return _nets.back(); }
 
   // find
@@ -91,8 +92,23 @@ class Router
   void update();
 
  private:
+  struct RoutingTask
+  {
+    CtsClock* clock = nullptr;
+    CtsNet* clk_net = nullptr;
+    size_t sink_num = 0;
+    size_t buf_num = 0;
+    int id = 0;           // id space of the task
+    std::mt19937 random;  // random engine of the task, seeded by the task index
+    SolverSet solver_set;
+    double runtime = 0;
+  };
+
   void printLog();
-  void gocaRouting(CtsNet* clk_net);
+  void runTasks(std::vector<RoutingTask>& tasks);
+  void mergeTasks(std::vector<RoutingTask>& tasks);
+  void runtimeReport(const std::vector<RoutingTask>& tasks);
+  void gocaRouting(CtsNet* clk_net, SolverSet& solver_set);
   std::vector<CtsPin*> getSinkPins(CtsNet* clk_net);
   std::vector<CtsPin*> getBufferPins(CtsNet* clk_net);
 
@@ -31,6 +31,7 @@
 #include "TreeBuilder.hh"
 #include "log/Log.hh"
 #include "time/Time.hh"
+#include "usage/usage.hh"
 namespace icts {
 void GOCA::run()
 {
@@ -84,10 +85,14 @@ void GOCA::resolveSinks()
   // clustering
   const int max_num = 15000;
   while (insts.size() > 1) {
+    ieda::Stats level_stats;
+    _level_cluster_time.push_back(0);
     auto assign = _level > (int) assigns.size() ? assigns.back() : assigns[_level - 1];
     if (insts.size() > max_num) {
       LOG_INFO << "insts divide into " << std::ceil(insts.size() / max_num) << " clusters";
+      ieda::Stats divide_stats;
       auto clusters = BalanceClustering::kMeans(insts, std::ceil(insts.size() / max_num), 0, 100, 5);
+      _level_cluster_time.back() += divide_stats.elapsedRunTime();
       insts.clear();
       std::ranges::for_each(clusters, [&](const std::vector<Inst*>& cluster) {
         auto assign_insts = assignApply(cluster, assign);
@@ -103,6 +108,7 @@ void GOCA::resolveSinks()
       // update load pin cap
       TimingPropagator::updateCapLoad<Node>(load_pin);
     });
+    _level_runtime.push_back(level_stats.elapsedRunTime());
     ++_level;
   }
   auto* root = insts.front();
@@ -187,9 +193,11 @@ std::vector<Inst*> GOCA::assignApply(const std::vector<Inst*>& insts, const Assi
     BalanceClustering::latencyOpt(insts, skew_bound, 0.7);
   }
 
+  ieda::Stats cluster_stats;
   auto clusters = BalanceClustering::iterClustering(target_insts, max_fanout, 5, 5, cluster_ratio);
   // auto enhanced_clusters = clusters;
   auto enhanced_clusters = BalanceClustering::slackClustering(clusters, max_net_len, max_fanout);
+  _level_cluster_time.back() += cluster_stats.elapsedRunTime();
 
   // enhanced_clusters = BalanceClustering::clusteringEnhancement(enhanced_clusters, max_fanout, max_cap, max_net_len);
 
@@ -551,5 +559,15 @@ void GOCA::levelReport() const
         auto* driver_pin = inst->get_driver_pin();
         return !TimingPropagator::skewFeasible(driver_pin);
       });
+  // runtime rpt
+  auto dir = CTSAPIInst.get_config()->get_sta_workspace() + "/level_log";
+  auto rpt = CtsReportTable::createReportTable("Level Runtime Log", CtsReportType::kLEVEL_RUNTIME);
+  for (size_t level = 1; level < _level_insts.size(); ++level) {
+    (*rpt) << level << _level_insts[level].size() << _level_cluster_time[level - 1] << _level_runtime[level - 1] << TABLE_ENDLINE;
+  }
+  std::ofstream outfile(dir + "/" + _net_name + "_runtime.rpt");
+  outfile << "Generate the report at " << Time::getNowWallTime() << std::endl;
+  outfile << rpt->c_str();
+  outfile.close();
 }
 }  // namespace icts
\ No newline at end of file
@@ -79,5 +79,8 @@ class GOCA
   Pin* _driver = nullptr;
   std::vector<Net*> _nets;
   int _level = 1;
+  // runtime (s) of each level
+  std::vector<double> _level_cluster_time;
+  std::vector<double> _level_runtime;
 };
 }  // namespace icts
\ No newline at end of file
@@ -30,6 +30,7 @@
 #include "TimingPropagator.hh"
 #include "TreeBuilder.hh"
 #include "anneal_opt/AnnealOpt.hh"
+#include "k_means/KMeans.hh"
 #include "log/Log.hh"
 #include "min_cost_flow/MinCostFlow.hh"
 namespace icts {
@@ -41,90 +42,30 @@ namespace icts {
  * @param seed
  * @param max_iter
  * @param no_change_stop
+ * @param max_fanout capacity of each cluster, 0 means no limit
+ * @param max_cap capacity of each cluster, 0 means no limit
  * @return std::vector<std::vector<Inst*>>
  */
 std::vector<std::vector<Inst*>> BalanceClustering::kMeans(const std::vector<Inst*>& insts, const size_t& k, const int& seed,
-                                                          const size_t& max_iter, const size_t& no_change_stop)
+                                                          const size_t& max_iter, const size_t& no_change_stop, const size_t& max_fanout,
+                                                          const double& max_cap)
 {
-  std::vector<std::vector<Inst*>> best_clusters(k);
-
-  std::vector<Point> centers;
-  size_t num_instances = insts.size();
-  std::vector<int> assignments(num_instances);
-
-  // Randomly choose first center from instances
-  // std::random_device rd;
-  // std::mt19937 gen(rd());
-  std::mt19937 gen(static_cast<std::mt19937::result_type>(seed));
-  std::uniform_int_distribution<> dis(0, num_instances - 1);
-  auto loc = insts[dis(gen)]->get_location();
-  centers.emplace_back(Point(loc.x(), loc.y()));
-  // Choose k-1 remaining centers using kmeans++ algorithm
-  while (centers.size() < k) {
-    std::vector<double> distances(num_instances, std::numeric_limits<double>::max());
-    for (size_t i = 0; i < num_instances; i++) {
-      double min_distance = std::numeric_limits<double>::max();
-      for (size_t j = 0; j < centers.size(); j++) {
-        double distance = TimingPropagator::calcDist(insts[i]->get_location(), centers[j]);
-        min_distance = std::min(min_distance, distance);
-      }
-      distances[i] = min_distance * min_distance;  // square distance
-    }
-    std::discrete_distribution<> distribution(distances.begin(), distances.end());
-    int selected_index = distribution(gen);
-    auto select_loc = insts[selected_index]->get_location();
-    centers.emplace_back(Point(select_loc.x(), select_loc.y()));
-  }
+  std::vector<Point> locs;
+  std::vector<double> caps;
+  locs.reserve(insts.size());
+  caps.reserve(insts.size());
+  std::ranges::for_each(insts, [&](Inst* inst) {
+    locs.push_back(inst->get_location());
+    caps.push_back(inst->getCapLoad());
+  });
+  KMeans solver(locs, caps);
+  solver.set_max_fanout(max_fanout);
+  solver.set_max_cap(max_cap);
+  auto assignments = solver.run(k, seed, max_iter, no_change_stop);
 
-  size_t num_iterations = 0;
-  double prev_cap_variance = std::numeric_limits<double>::max();
-  size_t no_change = 0;
-  while (num_iterations++ < max_iter && no_change++ < no_change_stop) {
-    // Assignment step
-    for (size_t i = 0; i < num_instances; i++) {
-      double min_distance = std::numeric_limits<double>::max();
-      int min_center_index = -1;
-      for (size_t j = 0; j < centers.size(); j++) {
-        double distance = TimingPropagator::calcDist(insts[i]->get_location(), centers[j]);
-        if (distance < min_distance) {
-          min_distance = distance;
-          min_center_index = j;
-        }
-      }
-      assignments[i] = min_center_index;
-    }
-    // Update step
-    std::vector<Point> new_centers(k, Point(0, 0));
-    std::vector<int> center_counts(k, 0);
-    for (size_t i = 0; i < num_instances; i++) {
-      int center_index = assignments[i];
-      new_centers[center_index] += insts[i]->get_location();
-      center_counts[center_index]++;
-    }
-    for (size_t i = 0; i < k; i++) {
-      if (center_counts[i] > 0) {
-        new_centers[i] /= center_counts[i];
-      }
-    }
-    centers = new_centers;
-    // Check cap variance
-    std::vector<double> cluster_cap(k, 0);
-    for (size_t i = 0; i < num_instances; i++) {
-      int center_index = assignments[i];
-      cluster_cap[center_index] += insts[i]->getCapLoad();
-    }
-    double cap_variance = calcVariance(cluster_cap);
-    // Check for convergence
-    if (cap_variance < prev_cap_variance) {
-      best_clusters.clear();
-      best_clusters.resize(k);
-      prev_cap_variance = cap_variance;
-      for (size_t i = 0; i < num_instances; i++) {
-        int center_index = assignments[i];
-        best_clusters[center_index].push_back(insts[i]);
-      }
-      no_change = 0;
-    }
+  std::vector<std::vector<Inst*>> best_clusters(k);
+  for (size_t i = 0; i < insts.size(); ++i) {
+    best_clusters[assignments[i]].push_back(insts[i]);
   }
   // remove empty clusters
   best_clusters.erase(
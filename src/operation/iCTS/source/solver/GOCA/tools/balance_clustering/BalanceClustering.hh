@@ -40,7 +40,7 @@ struct ViolationScore
 /**
  * @brief BalanceClustering class
  *       clustering sinks by max distance and max fanout
- *       using k-means algorithm construct a initial clustering
+ *       using k-means algorithm construct a initial clustering, the capacity constraint of k-means is opt-in
  *       then iteratively adjust the clustering by min cost flow to balance the capacitance variance
  *
  */
@@ -50,7 +50,8 @@ class BalanceClustering
   BalanceClustering() = delete;
   ~BalanceClustering() = default;
   static std::vector<std::vector<Inst*>> kMeans(const std::vector<Inst*>& sinks, const size_t& k, const int& seed = 0,
-                                                const size_t& max_iter = 100, const size_t& no_change_stop = 5);
+                                                const size_t& max_iter = 100, const size_t& no_change_stop = 5, const size_t& max_fanout = 0,
+                                                const double& max_cap = 0);
 
   static std::vector<std::vector<Inst*>> iterClustering(const std::vector<Inst*>& sinks, const size_t& max_fanout,
                                                         const size_t& iters = 100, const size_t& no_change_stop = 5,
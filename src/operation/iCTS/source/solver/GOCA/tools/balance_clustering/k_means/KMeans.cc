@@ -0,0 +1,296 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file KMeans.cc
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ */
+#include "KMeans.hh"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "TimingPropagator.hh"
+
+namespace icts {
+/**
+ * @brief run k-means, keep the assignment with min cap variance
+ *
+ * @param k
+ * @param seed
+ * @param max_iter
+ * @param no_change_stop
+ * @return std::vector<int>
+ */
+std::vector<int> KMeans::run(const size_t& k, const int& seed, const size_t& max_iter, const size_t& no_change_stop)
+{
+  size_t num_instances = _locs.size();
+  std::vector<int> best_assignments(num_instances, 0);
+  if (num_instances == 0 || k == 0) {
+    return best_assignments;
+  }
+  // grid geometry, all centers are inside the bounding box of instances
+  auto [x_min_it, x_max_it] = std::ranges::minmax_element(_locs, [](const Point& p1, const Point& p2) { return p1.x() < p2.x(); });
+  auto [y_min_it, y_max_it] = std::ranges::minmax_element(_locs, [](const Point& p1, const Point& p2) { return p1.y() < p2.y(); });
+  auto width = std::max(x_max_it->x() - x_min_it->x(), 1);
+  auto height = std::max(y_max_it->y() - y_min_it->y(), 1);
+  auto cell_len = std::max(std::sqrt(1.0 * width * height / k), 1.0 * std::max(width, height) / k);
+  _cell_len = std::max(static_cast<int>(std::ceil(cell_len)), 1);
+  _grid_x = x_min_it->x();
+  _grid_y = y_min_it->y();
+  _num_x = std::max(width / _cell_len + 1, 1);
+  _num_y = std::max(height / _cell_len + 1, 1);
+
+  std::mt19937 gen(static_cast<std::mt19937::result_type>(seed));
+  auto centers = initCenters(k, gen);
+
+  std::vector<int> assignments(num_instances);
+  size_t num_iterations = 0;
+  double prev_cap_variance = std::numeric_limits<double>::max();
+  size_t no_change = 0;
+  while (num_iterations++ < max_iter && no_change++ < no_change_stop) {
+    // Assignment step
+    buildCenterGrid(centers);
+    if (isConstrained()) {
+      capacityAssign(centers, assignments);
+    } else {
+      assign(centers, assignments);
+    }
+    // Update step
+    centers = updateCenters(assignments, k);
+    // Check for convergence
+    auto cap_variance = calcCapVariance(assignments, k);
+    if (cap_variance < prev_cap_variance) {
+      prev_cap_variance = cap_variance;
+      best_assignments = assignments;
+      no_change = 0;
+    }
+  }
+  return best_assignments;
+}
+/**
+ * @brief k-means++ seeding, the min distance to chosen centers is updated incrementally
+ *
+ * @param k
+ * @param gen
+ * @return std::vector<Point>
+ */
+std::vector<Point> KMeans::initCenters(const size_t& k, std::mt19937& gen) const
+{
+  int num_instances = _locs.size();
+  std::vector<Point> centers;
+  centers.reserve(k);
+  // Randomly choose first center from instances
+  std::uniform_int_distribution<> dis(0, num_instances - 1);
+  centers.emplace_back(_locs[dis(gen)]);
+
+  std::vector<int> min_dists(num_instances, std::numeric_limits<int>::max());
+  std::vector<double> distances(num_instances);
+  // Choose k-1 remaining centers using kmeans++ algorithm
+  while (centers.size() < k) {
+    const auto& center = centers.back();
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < num_instances; ++i) {
+      min_dists[i] = std::min(min_dists[i], TimingPropagator::calcDist(_locs[i], center));
+      distances[i] = 1.0 * min_dists[i] * min_dists[i];  // square distance
+    }
+    std::discrete_distribution<> distribution(distances.begin(), distances.end());
+    int selected_index = distribution(gen);
+    centers.emplace_back(_locs[selected_index]);
+  }
+  return centers;
+}
+/**
+ * @brief assign each instance to the nearest center
+ *
+ * @param centers
+ * @param assignments
+ */
+void KMeans::assign(const std::vector<Point>& centers, std::vector<int>& assignments)
+{
+  int num_instances = _locs.size();
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < num_instances; ++i) {
+    assignments[i] = nearestCenter(_locs[i], centers);
+  }
+}
+/**
+ * @brief capacity-constrained assignment
+ *       instances close to their nearest center are assigned first,
+ *       the others go to the nearest center which still has capacity
+ *
+ * @param centers
+ * @param assignments
+ */
+void KMeans::capacityAssign(const std::vector<Point>& centers, std::vector<int>& assignments)
+{
+  int num_instances = _locs.size();
+  std::vector<int> nearest(num_instances);
+  std::vector<int> nearest_dist(num_instances);
+#pragma omp parallel for schedule(static)
+  for (int i = 0; i < num_instances; ++i) {
+    nearest[i] = nearestCenter(_locs[i], centers);
+    nearest_dist[i] = TimingPropagator::calcDist(_locs[i], centers[nearest[i]]);
+  }
+  std::vector<int> order(num_instances);
+  std::iota(order.begin(), order.end(), 0);
+  std::ranges::stable_sort(order, [&nearest_dist](const int& i, const int& j) { return nearest_dist[i] < nearest_dist[j]; });
+
+  std::vector<size_t> fanouts(centers.size(), 0);
+  std::vector<double> caps(centers.size(), 0);
+  for (auto i : order) {
+    auto weight = _weights[i];
+    auto fit = [&](const int& center_id) {
+      return (_max_fanout == 0 || fanouts[center_id] < _max_fanout) && (_max_cap <= 0 || caps[center_id] + weight <= _max_cap);
+    };
+    auto center_id = nearest[i];
+    if (!fit(center_id)) {
+      center_id = nearestCenter(_locs[i], centers, fit);
+      // no center has enough capacity, overflow the nearest one
+      center_id = center_id < 0 ? nearest[i] : center_id;
+    }
+    assignments[i] = center_id;
+    ++fanouts[center_id];
+    caps[center_id] += weight;
+  }
+}
+/**
+ * @brief update centers by centroid of each cluster, use per-thread partial sums
+ *
+ * @param assignments
+ * @param k
+ * @return std::vector<Point>
+ */
+std::vector<Point> KMeans::updateCenters(const std::vector<int>& assignments, const size_t& k) const
+{
+  int num_instances = _locs.size();
+  std::vector<int64_t> sum_x(k, 0);
+  std::vector<int64_t> sum_y(k, 0);
+  std::vector<int> center_counts(k, 0);
+#pragma omp parallel
+  {
+    std::vector<int64_t> local_x(k, 0);
+    std::vector<int64_t> local_y(k, 0);
+    std::vector<int> local_counts(k, 0);
+#pragma omp for schedule(static) nowait
+    for (int i = 0; i < num_instances; ++i) {
+      auto center_index = assignments[i];
+      local_x[center_index] += _locs[i].x();
+      local_y[center_index] += _locs[i].y();
+      ++local_counts[center_index];
+    }
+#pragma omp critical
+    {
+      for (size_t j = 0; j < k; ++j) {
+        sum_x[j] += local_x[j];
+        sum_y[j] += local_y[j];
+        center_counts[j] += local_counts[j];
+      }
+    }
+  }
+  // the center of empty cluster is reset to origin, it will be removed from result
+  std::vector<Point> new_centers(k, Point(0, 0));
+  for (size_t j = 0; j < k; ++j) {
+    if (center_counts[j] > 0) {
+      new_centers[j] = Point(static_cast<int>(sum_x[j] / center_counts[j]), static_cast<int>(sum_y[j] / center_counts[j]));
+    }
+  }
+  return new_centers;
+}
+/**
+ * @brief cap variance of clusters (summed in instance order, keep the result independent of thread num)
+ *
+ * @param assignments
+ * @param k
+ * @return double
+ */
+double KMeans::calcCapVariance(const std::vector<int>& assignments, const size_t& k) const
+{
+  std::vector<double> cluster_cap(k, 0);
+  for (size_t i = 0; i < assignments.size(); ++i) {
+    cluster_cap[assignments[i]] += _weights[i];
+  }
+  double sum = std::accumulate(cluster_cap.begin(), cluster_cap.end(), 0.0);
+  double mean = sum / k;
+  double variance
+      = std::accumulate(cluster_cap.begin(), cluster_cap.end(), 0.0, [&mean](double total, const double& val) { return total + std::pow(val - mean, 2); });
+  return variance / k;
+}
+
+void KMeans::buildCenterGrid(const std::vector<Point>& centers)
+{
+  _cells.assign(static_cast<size_t>(_num_x) * _num_y, {});
+  for (size_t j = 0; j < centers.size(); ++j) {
+    auto x = std::clamp((centers[j].x() - _grid_x) / _cell_len, 0, _num_x - 1);
+    auto y = std::clamp((centers[j].y() - _grid_y) / _cell_len, 0, _num_y - 1);
+    _cells[x * _num_y + y].push_back(j);
+  }
+}
+/**
+ * @brief nearest (feasible) center by ring search on center grid, ties are broken by smaller center index
+ *
+ * @param loc
+ * @param centers
+ * @param feasible
+ * @return int -1 if no feasible center
+ */
+int KMeans::nearestCenter(const Point& loc, const std::vector<Point>& centers, const std::function<bool(const int&)>& feasible) const
+{
+  int best = -1;
+  int best_dist = std::numeric_limits<int>::max();
+  auto visit_cell = [&](const int& x, const int& y) {
+    for (auto center_id : _cells[x * _num_y + y]) {
+      auto dist = TimingPropagator::calcDist(loc, centers[center_id]);
+      if (dist > best_dist || (dist == best_dist && center_id > best)) {
+        continue;
+      }
+      if (feasible && !feasible(center_id)) {
+        continue;
+      }
+      best = center_id;
+      best_dist = dist;
+    }
+  };
+  auto loc_x = std::clamp((loc.x() - _grid_x) / _cell_len, 0, _num_x - 1);
+  auto loc_y = std::clamp((loc.y() - _grid_y) / _cell_len, 0, _num_y - 1);
+  auto max_r = std::max({loc_x, _num_x - 1 - loc_x, loc_y, _num_y - 1 - loc_y});
+  for (int r = 0; r <= max_r; ++r) {
+    // centers in ring r are at least (r - 1) cells away
+    if (best >= 0 && 1LL * (r - 1) * _cell_len > best_dist) {
+      break;
+    }
+    for (int x = std::max(loc_x - r, 0); x <= std::min(loc_x + r, _num_x - 1); ++x) {
+      if (x == loc_x - r || x == loc_x + r) {
+        for (int y = std::max(loc_y - r, 0); y <= std::min(loc_y + r, _num_y - 1); ++y) {
+          visit_cell(x, y);
+        }
+        continue;
+      }
+      if (loc_y - r >= 0) {
+        visit_cell(x, loc_y - r);
+      }
+      if (loc_y + r < _num_y) {
+        visit_cell(x, loc_y + r);
+      }
+    }
+  }
+  return best;
+}
+}  // namespace icts
@@ -0,0 +1,74 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file KMeans.hh
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ */
+#pragma once
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "CtsPoint.hh"
+
+namespace icts {
+/**
+ * @brief KMeans engine for balance clustering
+ *       input: locations and weights (cap) of insts
+ *       constraint: max_fanout, max_cap of each cluster (optional, 0 means no limit)
+ *       output: cluster index of each inst, the one with min cap variance over iterations
+ *
+ *       nearest center is queried by a uniform grid of centers,
+ *       seeding/assignment/centroid update are parallelized by OpenMP
+ *
+ */
+class KMeans
+{
+ public:
+  KMeans(const std::vector<Point>& locs, const std::vector<double>& weights) : _locs(locs), _weights(weights) {}
+  ~KMeans() = default;
+  // set
+  void set_max_fanout(const size_t& max_fanout) { _max_fanout = max_fanout; }
+  void set_max_cap(const double& max_cap) { _max_cap = max_cap; }
+  // run
+  std::vector<int> run(const size_t& k, const int& seed = 0, const size_t& max_iter = 100, const size_t& no_change_stop = 5);
+
+ private:
+  bool isConstrained() const { return _max_fanout > 0 || _max_cap > 0; }
+  std::vector<Point> initCenters(const size_t& k, std::mt19937& gen) const;
+  void assign(const std::vector<Point>& centers, std::vector<int>& assignments);
+  void capacityAssign(const std::vector<Point>& centers, std::vector<int>& assignments);
+  std::vector<Point> updateCenters(const std::vector<int>& assignments, const size_t& k) const;
+  double calcCapVariance(const std::vector<int>& assignments, const size_t& k) const;
+  // center grid
+  void buildCenterGrid(const std::vector<Point>& centers);
+  int nearestCenter(const Point& loc, const std::vector<Point>& centers, const std::function<bool(const int&)>& feasible = nullptr) const;
+
+  std::vector<Point> _locs;
+  std::vector<double> _weights;
+  size_t _max_fanout = 0;
+  double _max_cap = 0;
+
+  int _grid_x = 0;
+  int _grid_y = 0;
+  int _cell_len = 1;
+  int _num_x = 1;
+  int _num_y = 1;
+  std::vector<std::vector<int>> _cells;
+};
+}  // namespace icts
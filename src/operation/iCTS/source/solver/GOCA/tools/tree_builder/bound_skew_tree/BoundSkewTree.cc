@@ -146,21 +146,6 @@ void BoundSkewTree::convert()
   _net = Timing::genNet(_root_buf->get_name(), _root_buf->get_driver_pin(), _load_pins);
   Timing::update(_net);
 }
-Match BoundSkewTree::getBestMatch(CostFunc cost_func) const
-{
-  auto min_cost = std::numeric_limits<double>::max();
-  Match best_match;
-  for (size_t i = 0; i < _unmerged_nodes.size(); ++i) {
-    for (size_t j = i + 1; j < _unmerged_nodes.size(); ++j) {
-      auto cost = cost_func(_unmerged_nodes[i], _unmerged_nodes[j]);
-      if (cost < min_cost) {
-        min_cost = cost;
-        best_match = {_unmerged_nodes[i], _unmerged_nodes[j], cost};
-      }
-    }
-  }
-  return best_match;
-}
 double BoundSkewTree::mergeCost(Area* left, Area* right) const
 {
   auto min_dist = std::numeric_limits<double>::max();
@@ -513,36 +498,32 @@ void BoundSkewTree::bottomUp()
 }
 void BoundSkewTree::bottomUpAllPairBased()
 {
-  // none input topo
-  while (_unmerged_nodes.size() > 1) {
-    // switch cost_func by topo_type
-    CostFunc cost_func;
-    switch (_topo_type) {
-      case TopoType::kGreedyDist:
-        cost_func = [&](Area* left, Area* right) { return distanceCost(left, right); };
-        break;
-      case TopoType::kGreedyMerge:
-        cost_func = [&](Area* left, Area* right) { return mergeCost(left, right); };
-        break;
-      default:
-        LOG_FATAL << "topo type is not supported";
-        break;
-    }
-    auto best_match = getBestMatch(cost_func);
-    auto* left = best_match.left;
-    auto* right = best_match.right;
+  // none input topo, switch cost_func by topo_type
+  CostFunc cost_func;
+  // distance cost is bounded by the distance of merging regions' bounding box, so the spatial index can be used
+  bool spatial_bound = false;
+  switch (_topo_type) {
+    case TopoType::kGreedyDist:
+      cost_func = [&](Area* left, Area* right) { return distanceCost(left, right); };
+      spatial_bound = true;
+      break;
+    case TopoType::kGreedyMerge:
+      cost_func = [&](Area* left, Area* right) { return mergeCost(left, right); };
+      break;
+    default:
+      LOG_FATAL << "topo type is not supported";
+      break;
+  }
+  auto merger = GreedyMerger(cost_func, spatial_bound);
+  _root = merger.run(_unmerged_nodes, [&](Area* left, Area* right) {
     auto* parent = new Area();
     // random select RCpattern
-    auto pattern = static_cast<RCPattern>(1 + std::rand() % 2);
+    auto pattern = static_cast<RCPattern>(CTSAPIInst.genRandomInt(1, 2));
     parent->set_pattern(pattern);
     merge(parent, left, right);
-    // erase left and right
-    _unmerged_nodes.erase(
-        std::remove_if(_unmerged_nodes.begin(), _unmerged_nodes.end(), [&](Area* node) { return node == left || node == right; }),
-        _unmerged_nodes.end());
-    _unmerged_nodes.push_back(parent);
-  }
-  _root = _unmerged_nodes.front();
+    return parent;
+  });
+  _unmerged_nodes = {_root};
 }
 void BoundSkewTree::bottomUpTopoBased()
 {
@@ -569,7 +550,7 @@ void BoundSkewTree::recursiveBottomUp(Area* cur)
   if (left && right) {
     recursiveBottomUp(left);
     recursiveBottomUp(right);
-    auto pattern = static_cast<RCPattern>(1 + std::rand() % 2);
+    auto pattern = static_cast<RCPattern>(CTSAPIInst.genRandomInt(1, 2));
     cur->set_pattern(pattern);
     merge(cur, left, right);
   }
@@ -26,6 +26,7 @@
 #include "BalanceClustering.hh"
 #include "Components.hh"
 #include "GeomCalc.hh"
+#include "GreedyMerger.hh"
 #include "Inst.hh"
 #include "Net.hh"
 #include "Pin.hh"
@@ -78,8 +79,7 @@ class BoundSkewTree
    * @brief match
    *
    */
-  using CostFunc = std::function<double(Area*, Area*)>;
-  Match getBestMatch(CostFunc cost_func) const;
+  using CostFunc = GreedyMerger::CostFunc;
   double mergeCost(Area* left, Area* right) const;
   double distanceCost(Area* left, Area* right) const;
   /**
@@ -128,7 +128,7 @@ class Area
   {
     _pattern = node->get_pattern();
     if (_pattern == RCPattern::kSingle) {
-      _pattern = static_cast<RCPattern>(1 + std::rand() % 2);
+      _pattern = static_cast<RCPattern>(CTSAPIInst.genRandomInt(1, 2));
     }
     auto loc = node->get_location();
     auto x = 1.0 * loc.x() / Timing::getDbUnit();
@@ -0,0 +1,268 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file GreedyMerger.cc
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ */
+#include "GreedyMerger.hh"
+
+#include <cmath>
+#include <limits>
+
+#include "log/Log.hh"
+namespace icts {
+namespace bst {
+/**
+ * @brief merge areas until only one left, return the root
+ *
+ * @param areas unmerged areas, in the order of the all-pair scan
+ * @param merge_func build parent (with merging region) of two areas, the earlier one is passed as the first argument
+ * @return Area*
+ */
+Area* GreedyMerger::run(const std::vector<Area*>& areas, const MergeFunc& merge_func)
+{
+  LOG_FATAL_IF(areas.empty()) << "areas is empty";
+  _areas.clear();
+  _alive.clear();
+  _alive_ids.clear();
+  _alive_pos.clear();
+  _visit_stamp.clear();
+  _cells.clear();
+  _cell_ranges.clear();
+  _heap = {};
+  _cur_stamp = 0;
+  _cost_calls = 0;
+  _nn_queries = 0;
+
+  auto num = areas.size();
+  _areas.reserve(2 * num);
+  _alive.reserve(2 * num);
+  _alive_pos.reserve(2 * num);
+  _visit_stamp.reserve(2 * num);
+  if (_spatial_bound) {
+    initGrid(areas);
+  }
+  std::ranges::for_each(areas, [&](Area* area) { addArea(area); });
+  for (size_t id = 0; id < num; ++id) {
+    pushNearest(id);
+  }
+  while (_alive_ids.size() > 1) {
+    LOG_FATAL_IF(_heap.empty()) << "candidate heap is empty with " << _alive_ids.size() << " unmerged areas";
+    auto candidate = _heap.top();
+    _heap.pop();
+    if (!_alive[candidate.owner]) {
+      continue;
+    }
+    auto partner = candidate.owner == candidate.lo ? candidate.hi : candidate.lo;
+    if (!_alive[partner]) {
+      // lazy invalidation, the nearest neighbor has been merged
+      pushNearest(candidate.owner);
+      continue;
+    }
+    auto* parent = merge_func(_areas[candidate.lo], _areas[candidate.hi]);
+    removeArea(candidate.lo);
+    removeArea(candidate.hi);
+    addArea(parent);
+    pushNearest(_areas.size() - 1);
+  }
+  return _areas[_alive_ids.front()];
+}
+
+void GreedyMerger::addArea(Area* area)
+{
+  auto id = _areas.size();
+  _areas.push_back(area);
+  _alive.push_back(true);
+  _alive_pos.push_back(_alive_ids.size());
+  _alive_ids.push_back(id);
+  _visit_stamp.push_back(0);
+  if (!_spatial_bound) {
+    return;
+  }
+  auto range = cellRange(calcBoundBox(area));
+  _cell_ranges.push_back(range);
+  for (int x = range[0]; x <= range[2]; ++x) {
+    for (int y = range[1]; y <= range[3]; ++y) {
+      _cells[x * _num_y + y].push_back(id);
+    }
+  }
+}
+
+void GreedyMerger::removeArea(const size_t& id)
+{
+  _alive[id] = false;
+  auto pos = _alive_pos[id];
+  auto last = _alive_ids.back();
+  _alive_ids[pos] = last;
+  _alive_pos[last] = pos;
+  _alive_ids.pop_back();
+  if (!_spatial_bound) {
+    return;
+  }
+  auto range = _cell_ranges[id];
+  for (int x = range[0]; x <= range[2]; ++x) {
+    for (int y = range[1]; y <= range[3]; ++y) {
+      auto& cell = _cells[x * _num_y + y];
+      cell.erase(std::remove(cell.begin(), cell.end(), id), cell.end());
+    }
+  }
+}
+
+double GreedyMerger::pairCost(const size_t& id1, const size_t& id2)
+{
+  ++_cost_calls;
+  // keep the argument order of all-pair scan, since the cost may be asymmetric (e.g. merge cost)
+  return id1 < id2 ? _cost_func(_areas[id1], _areas[id2]) : _cost_func(_areas[id2], _areas[id1]);
+}
+
+bool GreedyMerger::better(const double& cost, const size_t& partner, const double& best_cost, const size_t& best_partner) const
+{
+  // for a fixed owner, the pair with smaller partner id always comes first in the all-pair scan
+  return cost < best_cost || (cost == best_cost && partner < best_partner);
+}
+
+void GreedyMerger::pushNearest(const size_t& id)
+{
+  ++_nn_queries;
+  auto best_cost = std::numeric_limits<double>::max();
+  auto nearest = _spatial_bound ? nearestByGrid(id, best_cost) : nearestByScan(id, best_cost);
+  if (!nearest.has_value()) {
+    return;
+  }
+  auto partner = nearest.value();
+  _heap.push({best_cost, std::min(id, partner), std::max(id, partner), id});
+}
+
+std::optional<size_t> GreedyMerger::nearestByScan(const size_t& id, double& best_cost)
+{
+  std::optional<size_t> nearest;
+  std::ranges::for_each(_alive_ids, [&](const size_t& other) {
+    if (other == id) {
+      return;
+    }
+    auto cost = pairCost(id, other);
+    if (!nearest.has_value() || better(cost, other, best_cost, nearest.value())) {
+      best_cost = cost;
+      nearest = other;
+    }
+  });
+  return nearest;
+}
+
+std::optional<size_t> GreedyMerger::nearestByGrid(const size_t& id, double& best_cost)
+{
+  std::optional<size_t> nearest;
+  ++_cur_stamp;
+  _visit_stamp[id] = _cur_stamp;
+  auto visit_cell = [&](const int& x, const int& y) {
+    for (auto other : _cells[x * _num_y + y]) {
+      if (_visit_stamp[other] == _cur_stamp) {
+        continue;
+      }
+      _visit_stamp[other] = _cur_stamp;
+      auto cost = pairCost(id, other);
+      if (!nearest.has_value() || better(cost, other, best_cost, nearest.value())) {
+        best_cost = cost;
+        nearest = other;
+      }
+    }
+  };
+  auto range = _cell_ranges[id];
+  for (int r = 0;; ++r) {
+    // areas in ring r are at least (r - 1) cells away in x or y
+    auto lower_bound = r > 0 ? (r - 1) * _cell_len : 0.0;
+    if (nearest.has_value() && lower_bound - kEpsilon > best_cost) {
+      break;
+    }
+    auto x_lo = range[0] - r;
+    auto y_lo = range[1] - r;
+    auto x_hi = range[2] + r;
+    auto y_hi = range[3] + r;
+    for (int x = std::max(x_lo, 0); x <= std::min(x_hi, _num_x - 1); ++x) {
+      if (r == 0 || x == x_lo || x == x_hi) {
+        for (int y = std::max(y_lo, 0); y <= std::min(y_hi, _num_y - 1); ++y) {
+          visit_cell(x, y);
+        }
+        continue;
+      }
+      if (y_lo >= 0) {
+        visit_cell(x, y_lo);
+      }
+      if (y_hi < _num_y) {
+        visit_cell(x, y_hi);
+      }
+    }
+    if (x_lo <= 0 && y_lo <= 0 && x_hi >= _num_x - 1 && y_hi >= _num_y - 1) {
+      break;
+    }
+  }
+  return nearest;
+}
+
+void GreedyMerger::initGrid(const std::vector<Area*>& areas)
+{
+  auto x_min = std::numeric_limits<double>::max();
+  auto y_min = std::numeric_limits<double>::max();
+  auto x_max = std::numeric_limits<double>::lowest();
+  auto y_max = std::numeric_limits<double>::lowest();
+  std::ranges::for_each(areas, [&](Area* area) {
+    auto box = calcBoundBox(area);
+    x_min = std::min(x_min, box.x_min);
+    y_min = std::min(y_min, box.y_min);
+    x_max = std::max(x_max, box.x_max);
+    y_max = std::max(y_max, box.y_max);
+  });
+  auto width = std::max(x_max - x_min, kEpsilon);
+  auto height = std::max(y_max - y_min, kEpsilon);
+  // square cells, about one area per cell
+  auto cell_len = std::max(std::sqrt(width * height / areas.size()), std::max(width, height) / areas.size());
+  _num_x = std::clamp(static_cast<int>(std::ceil(width / cell_len)), 1, static_cast<int>(areas.size()));
+  _num_y = std::clamp(static_cast<int>(std::ceil(height / cell_len)), 1, static_cast<int>(areas.size()));
+  _grid_x = x_min;
+  _grid_y = y_min;
+  _cell_len = cell_len;
+  _cells.assign(static_cast<size_t>(_num_x) * _num_y, {});
+  _cell_ranges.reserve(2 * areas.size());
+}
+
+GreedyMerger::BoundBox GreedyMerger::calcBoundBox(Area* area) const
+{
+  auto convex_hull = area->get_convex_hull();
+  if (convex_hull.empty()) {
+    convex_hull.push_back(area->get_location());
+  }
+  BoundBox box{std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(),
+               std::numeric_limits<double>::lowest()};
+  std::ranges::for_each(convex_hull, [&box](const Pt& pt) {
+    box.x_min = std::min(box.x_min, pt.x);
+    box.y_min = std::min(box.y_min, pt.y);
+    box.x_max = std::max(box.x_max, pt.x);
+    box.y_max = std::max(box.y_max, pt.y);
+  });
+  return box;
+}
+
+std::array<int, 4> GreedyMerger::cellRange(const BoundBox& box) const
+{
+  // the region out of grid is clamped to the boundary cells, which keeps the ring lower bound valid
+  auto to_x = [&](const double& x) { return std::clamp(static_cast<int>(std::floor((x - _grid_x) / _cell_len)), 0, _num_x - 1); };
+  auto to_y = [&](const double& y) { return std::clamp(static_cast<int>(std::floor((y - _grid_y) / _cell_len)), 0, _num_y - 1); };
+  return {to_x(box.x_min), to_y(box.y_min), to_x(box.x_max), to_y(box.y_max)};
+}
+
+}  // namespace bst
+}  // namespace icts
@@ -0,0 +1,118 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file GreedyMerger.hh
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ */
+#pragma once
+#include <array>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <vector>
+
+#include "Components.hh"
+
+namespace icts {
+namespace bst {
+/**
+ * @brief Greedy bottom-up merging engine based on nearest-neighbor graph
+ *
+ * Every unmerged area keeps one candidate (its nearest neighbor) in a min-heap, the globally cheapest pair is merged
+ * first. Entries are invalidated lazily: when a popped entry points to an area which has already been merged, only the
+ * owner's nearest neighbor is recomputed. Ties are broken by creation order, so the result is the same topology as the
+ * all-pair scan (first pair with the minimum cost in order of unmerged nodes).
+ *
+ * When the cost is not less than the manhattan distance between the bounding boxes of two merging regions (e.g.
+ * greedy-dist), nearest neighbor queries are answered by a uniform grid, otherwise all unmerged areas are scanned.
+ */
+class GreedyMerger
+{
+ public:
+  using CostFunc = std::function<double(Area*, Area*)>;
+  using MergeFunc = std::function<Area*(Area*, Area*)>;
+
+  GreedyMerger(const CostFunc& cost_func, const bool& spatial_bound) : _cost_func(cost_func), _spatial_bound(spatial_bound) {}
+  ~GreedyMerger() = default;
+
+  Area* run(const std::vector<Area*>& areas, const MergeFunc& merge_func);
+
+  size_t get_cost_calls() const { return _cost_calls; }
+  size_t get_nn_queries() const { return _nn_queries; }
+
+ private:
+  struct Candidate
+  {
+    double cost;
+    size_t lo;
+    size_t hi;
+    size_t owner;
+    bool operator>(const Candidate& other) const
+    {
+      if (cost != other.cost) {
+        return cost > other.cost;
+      }
+      if (lo != other.lo) {
+        return lo > other.lo;
+      }
+      return hi > other.hi;
+    }
+  };
+  struct BoundBox
+  {
+    double x_min;
+    double y_min;
+    double x_max;
+    double y_max;
+  };
+
+  void addArea(Area* area);
+  void removeArea(const size_t& id);
+  double pairCost(const size_t& id1, const size_t& id2);
+  bool better(const double& cost, const size_t& partner, const double& best_cost, const size_t& best_partner) const;
+  void pushNearest(const size_t& id);
+  std::optional<size_t> nearestByScan(const size_t& id, double& best_cost);
+  std::optional<size_t> nearestByGrid(const size_t& id, double& best_cost);
+  // grid
+  void initGrid(const std::vector<Area*>& areas);
+  BoundBox calcBoundBox(Area* area) const;
+  std::array<int, 4> cellRange(const BoundBox& box) const;
+
+  CostFunc _cost_func;
+  bool _spatial_bound = false;
+
+  std::vector<Area*> _areas;
+  std::vector<bool> _alive;
+  std::vector<size_t> _alive_ids;
+  std::vector<size_t> _alive_pos;
+  std::vector<size_t> _visit_stamp;
+  size_t _cur_stamp = 0;
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> _heap;
+
+  double _grid_x = 0;
+  double _grid_y = 0;
+  double _cell_len = 1;
+  int _num_x = 1;
+  int _num_y = 1;
+  std::vector<std::vector<size_t>> _cells;
+  std::vector<std::array<int, 4>> _cell_ranges;
+
+  size_t _cost_calls = 0;
+  size_t _nn_queries = 0;
+};
+}  // namespace bst
+}  // namespace icts
@@ -0,0 +1,53 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file GreedyMergerBenchmark.cc
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ * @brief Runtime of the greedy merger over 1k to 100k synthetic sinks, the all-pair scan is run for small sizes
+ */
+#include <chrono>
+
+#include "GreedyMergerHelper.hh"
+#include "log/Log.hh"
+
+using ieda::Log;
+using icts::bst::GreedyMerger;
+using icts::bst::GreedyMergerHelper;
+
+int main(int argc, char** argv)
+{
+  Log::init(argv);
+  for (size_t sink_num : {1000, 2000, 5000, 10000, 20000, 50000, 100000}) {
+    GreedyMergerHelper helper;
+    auto sinks = helper.genSinks(sink_num, 0);
+    auto merger = GreedyMerger(GreedyMergerHelper::cost, true);
+    auto start = std::chrono::high_resolution_clock::now();
+    auto* root = helper.greedyMerge(sinks, true, &merger);
+    auto end = std::chrono::high_resolution_clock::now();
+    LOG_INFO << "GreedyMerger sinks: " << sink_num << " runtime: " << std::chrono::duration<double>(end - start).count()
+             << "s cost calls: " << merger.get_cost_calls() << " nn queries: " << merger.get_nn_queries();
+    if (sink_num <= 2000) {
+      start = std::chrono::high_resolution_clock::now();
+      auto* ref_root = helper.allPairMerge(sinks);
+      end = std::chrono::high_resolution_clock::now();
+      LOG_INFO << "All pair merge sinks: " << sink_num << " runtime: " << std::chrono::duration<double>(end - start).count() << "s"
+               << " same topology: " << (GreedyMergerHelper::topoStr(root) == GreedyMergerHelper::topoStr(ref_root));
+    }
+  }
+  Log::end();
+  return 0;
+}
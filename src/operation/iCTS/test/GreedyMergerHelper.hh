@@ -0,0 +1,140 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file GreedyMergerHelper.hh
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ * @brief Synthetic in-memory sinks of the greedy merger test and benchmark
+ */
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CTSAPI.hh"
+#include "CtsDesign.hh"
+#include "bound_skew_tree/GeomCalc.hh"
+#include "bound_skew_tree/GreedyMerger.hh"
+
+namespace icts {
+namespace bst {
+/**
+ * @brief Owner of the design used for area ids and of all the areas created by a merge
+ *
+ * The areas only need the id of the design, so no config file is read.
+ */
+class GreedyMergerHelper
+{
+ public:
+  GreedyMergerHelper() : _prev_design(CTSAPIInst.get_design()), _design(std::make_unique<CtsDesign>())
+  {
+    CTSAPIInst.set_design(_design.get());
+  }
+  ~GreedyMergerHelper()
+  {
+    _areas.clear();
+    CTSAPIInst.set_design(_prev_design);
+  }
+
+  std::vector<Area*> genSinks(const size_t& sink_num, const unsigned& seed)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dis(0, 1000000);
+    std::vector<Area*> sinks;
+    for (size_t i = 0; i < sink_num; ++i) {
+      auto x = dis(gen) / 100.0;
+      auto y = dis(gen) / 100.0;
+      sinks.push_back(_areas.emplace_back(std::make_unique<Area>("sink_" + std::to_string(i), x, y, 0)).get());
+    }
+    return sinks;
+  }
+
+  static double cost(Area* left, Area* right)
+  {
+    auto min_dist = std::numeric_limits<double>::max();
+    for (auto left_pt : left->get_convex_hull()) {
+      for (auto right_pt : right->get_convex_hull()) {
+        min_dist = std::min(min_dist, GeomCalc::distance(left_pt, right_pt));
+      }
+    }
+    return min_dist;
+  }
+
+  // merging region is simplified to the segment between children's locations
+  Area* merge(Area* left, Area* right)
+  {
+    auto* parent = _areas.emplace_back(std::make_unique<Area>()).get();
+    parent->set_left(left);
+    parent->set_right(right);
+    left->set_parent(parent);
+    right->set_parent(parent);
+    auto left_loc = left->get_location();
+    auto right_loc = right->get_location();
+    parent->set_location((left_loc + right_loc) / 2);
+    parent->set_convex_hull({(left_loc * 2 + right_loc) / 3, (left_loc + right_loc * 2) / 3});
+    return parent;
+  }
+
+  Area* greedyMerge(const std::vector<Area*>& sinks, const bool& spatial_bound, GreedyMerger* merger = nullptr)
+  {
+    GreedyMerger local_merger(cost, spatial_bound);
+    auto* the_merger = merger ? merger : &local_merger;
+    return the_merger->run(sinks, [this](Area* left, Area* right) { return merge(left, right); });
+  }
+
+  // reference of the greedy merger, first pair with the minimum cost in order of unmerged areas
+  Area* allPairMerge(std::vector<Area*> unmerged)
+  {
+    while (unmerged.size() > 1) {
+      auto min_cost = std::numeric_limits<double>::max();
+      Area* left = nullptr;
+      Area* right = nullptr;
+      for (size_t i = 0; i < unmerged.size(); ++i) {
+        for (size_t j = i + 1; j < unmerged.size(); ++j) {
+          auto pair_cost = cost(unmerged[i], unmerged[j]);
+          if (pair_cost < min_cost) {
+            min_cost = pair_cost;
+            left = unmerged[i];
+            right = unmerged[j];
+          }
+        }
+      }
+      auto* parent = merge(left, right);
+      std::erase_if(unmerged, [&](Area* area) { return area == left || area == right; });
+      unmerged.push_back(parent);
+    }
+    return unmerged.front();
+  }
+
+  static std::string topoStr(Area* area)
+  {
+    if (area->get_left() == nullptr) {
+      return area->get_name();
+    }
+    return "(" + topoStr(area->get_left()) + "," + topoStr(area->get_right()) + ")";
+  }
+
+ private:
+  CtsDesign* _prev_design;
+  std::unique_ptr<CtsDesign> _design;
+  std::vector<std::unique_ptr<Area>> _areas;
+};
+}  // namespace bst
+}  // namespace icts
@@ -0,0 +1,179 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file ModelTest.cc
+ * @author Dawn Li (dawnli619215645@gmail.com)
+ */
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "log/Log.hh"
+#include "model/ModelFactory.hh"
+#include "model/native/NativeModel.hh"
+
+using ieda::Log;
+
+namespace {
+
+class ModelTest : public testing::Test
+{
+  void SetUp()
+  {
+    char config[] = "test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() { Log::end(); }
+};
+
+// two features, tree 0: x0 < 0.5 ? (x1 < 1 ? 1 : 2) : 3, tree 1: leaf 0.25
+const char* kTreeEnsemble = R"(icts_model tree_ensemble
+num_features 2
+base_score 0.5
+num_trees 2
+tree 5
+0 0.5 1 2 0
+1 1.0 3 4 0
+-1 0 -1 -1 3
+-1 0 -1 -1 1
+-1 0 -1 -1 2
+tree 1
+-1 0 -1 -1 0.25
+)";
+
+TEST_F(ModelTest, NativeLinearModel)
+{
+  auto* model_factory = new icts::ModelFactory();
+  // y = 1 + 2 * x1 + 3 * x2
+  std::vector<double> x1 = {1, 2, 3, 4, 5, 6};
+  std::vector<double> x2 = {2, 1, 0, 3, 5, 4};
+  std::vector<double> y;
+  for (size_t i = 0; i < x1.size(); ++i) {
+    y.push_back(1 + 2 * x1[i] + 3 * x2[i]);
+  }
+  auto* model = model_factory->cppFit({x1, x2}, y, icts::FitType::kLinear);
+  EXPECT_NEAR(model->predict({1, 1}), 6, 1e-6);
+  auto batch = model->predictBatch({{0, 0}, {1, 1}, {2, 3}});
+  ASSERT_EQ(batch.size(), 3);
+  EXPECT_NEAR(batch[0], 1, 1e-6);
+  EXPECT_NEAR(batch[1], 6, 1e-6);
+  EXPECT_NEAR(batch[2], 14, 1e-6);
+  EXPECT_EQ(model_factory->cppFit({x1, x2}, y, icts::FitType::kCatBoost), nullptr);
+  delete model;
+  delete model_factory;
+}
+
+TEST_F(ModelTest, NativeTreeEnsemble)
+{
+  std::istringstream iss(kTreeEnsemble);
+  std::string magic;
+  std::string model_type;
+  iss >> magic >> model_type;
+  auto* model = icts::TreeEnsembleModel::read(iss);
+  EXPECT_EQ(model->get_num_trees(), 2);
+  EXPECT_DOUBLE_EQ(model->predict({0, 0}), 0.5 + 1 + 0.25);
+  EXPECT_DOUBLE_EQ(model->predict({0, 1}), 0.5 + 2 + 0.25);
+  EXPECT_DOUBLE_EQ(model->predict({0.5, 0}), 0.5 + 3 + 0.25);
+
+  // batch prediction is the same as single prediction
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<> dis(-1, 2);
+  std::vector<std::vector<double>> samples(1000);
+  for (auto& sample : samples) {
+    sample = {dis(gen), dis(gen)};
+  }
+  auto batch = model->predictBatch(samples);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    EXPECT_DOUBLE_EQ(batch[i], model->predict(samples[i]));
+  }
+  EXPECT_DEATH(model->predict({0}), "features");
+  delete model;
+}
+
+TEST_F(ModelTest, NativeLoad)
+{
+  auto* model_factory = new icts::ModelFactory();
+  auto path = std::string(testing::TempDir()) + "native_model.icm";
+  {
+    std::ofstream ofs(path);
+    ofs << kTreeEnsemble;
+  }
+  auto* model = model_factory->load(path);
+  EXPECT_DOUBLE_EQ(model->predict({0, 0}), 1.75);
+  delete model;
+  {
+    std::ofstream ofs(path);
+    ofs << "icts_model linear\nnum_features 2\nintercept 1\ncoef 2 3\n";
+  }
+  model = model_factory->cppLoad(path);
+  EXPECT_DOUBLE_EQ(model->predict({1, 1}), 6);
+  delete model;
+  {
+    std::ofstream ofs(path);
+    ofs << "icts_model tree_ensemble\nnum_features 1\nbase_score 0\nnum_trees 1\ntree 2\n0 0.5 1 1 0\n";
+  }
+  EXPECT_EQ(model_factory->cppLoad(path), nullptr);
+  std::remove(path.c_str());
+  delete model_factory;
+}
+
+TEST_F(ModelTest, NativeTreeEnsembleBenchmark)
+{
+  // random complete trees of depth 6, like a boosted delay model
+  const int num_trees = 200;
+  const int depth = 6;
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<> dis(0, 1);
+  icts::TreeEnsembleModel model(2, 0.1);
+  for (int t = 0; t < num_trees; ++t) {
+    std::vector<icts::TreeEnsembleModel::TreeNode> nodes;
+    int num_inner = (1 << depth) - 1;
+    for (int i = 0; i < num_inner; ++i) {
+      nodes.push_back({static_cast<int>(gen() % 2), dis(gen), 2 * i + 1, 2 * i + 2, 0});
+    }
+    for (int i = 0; i < (1 << depth); ++i) {
+      nodes.push_back({-1, 0, -1, -1, dis(gen) * 0.01});
+    }
+    ASSERT_TRUE(model.addTree(nodes));
+  }
+  std::vector<std::vector<double>> samples(100000);
+  for (auto& sample : samples) {
+    sample = {dis(gen), dis(gen)};
+  }
+  auto start = std::chrono::steady_clock::now();
+  std::vector<double> singles;
+  singles.reserve(samples.size());
+  for (const auto& sample : samples) {
+    singles.push_back(model.predict(sample));
+  }
+  auto mid = std::chrono::steady_clock::now();
+  auto batch = model.predictBatch(samples);
+  auto end = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < samples.size(); ++i) {
+    EXPECT_DOUBLE_EQ(batch[i], singles[i]);
+  }
+  LOG_INFO << "native tree ensemble (" << num_trees << " trees, depth " << depth << ") on " << samples.size()
+           << " samples, single: " << std::chrono::duration<double>(mid - start).count()
+           << "s, batch: " << std::chrono::duration<double>(end - mid).count() << "s";
+}
+
+}  // namespace
@@ -23,6 +23,7 @@
 #include "../../database/interaction/ids.hpp"
 #include "../../platform/data_manager/idm.h"
 #include "CTSAPI.hh"
+#include "GreedyMergerHelper.hh"
 #include "Inst.hh"
 #include "TimingPropagator.hh"
 #include "TreeBuilder.hh"
@@ -241,6 +242,17 @@ TEST_F(SolverTest, Compare)
   fluteTest(load_pins, guide_loc);
 }
 
+TEST_F(SolverTest, GreedyMergerTopo)
+{
+  using icts::bst::GreedyMergerHelper;
+  GreedyMergerHelper helper;
+  auto sinks = helper.genSinks(200, 0);
+  auto ref_topo = GreedyMergerHelper::topoStr(helper.allPairMerge(sinks));
+  // greedy-dist queries the grid, greedy-merge scans the unmerged areas
+  EXPECT_EQ(GreedyMergerHelper::topoStr(helper.greedyMerge(sinks, true)), ref_topo);
+  EXPECT_EQ(GreedyMergerHelper::topoStr(helper.greedyMerge(sinks, false)), ref_topo);
+}
+
 TEST_F(SolverTest, GeomTest)
 {
   using icts::bst::GeomCalc;
@@ -16,6 +16,8 @@
 // ***************************************************************************************
 #include "tapcell.h"
 
+#include <algorithm>
+
 #include "IdbCellMaster.h"
 #include "IdbDesign.h"
 #include "IdbEnum.h"
@@ -75,24 +77,47 @@ bool TapCellPlacer::tapCells(double distance, std::string tapcell_name, std::str
 }
 
 /**
- * build tap cell & endcap region in rows
+ * build tap cell & endcap region in rows, rows are processed in parallel
  */
 int TapCellPlacer::buildTapcellRegion()
 {
   auto idb_layout = dmInst->get_idb_layout();
   auto idb_rows = idb_layout->get_rows();
+  auto idb_design = dmInst->get_idb_design();
+  auto idb_blockage_list = idb_design->get_blockage_list();
 
-  auto row_list = idb_rows->get_row_list();
+  /// placement blockage rects sorted by low y, a row only scans the rects whose low y is in [row low y - max height, row high y]
+  std::vector<idb::IdbRect*> blockage_rect_list;
+  int32_t max_blockage_height = 0;
+  for (auto blockage : idb_blockage_list->get_blockage_list()) {
+    if (blockage->is_palcement_blockage()) {
+      for (auto rect : blockage->get_rect_list()) {
+        blockage_rect_list.emplace_back(rect);
+        max_blockage_height = std::max(max_blockage_height, rect->get_high_y() - rect->get_low_y());
+      }
+    }
+  }
+  std::sort(blockage_rect_list.begin(), blockage_rect_list.end(),
+            [](idb::IdbRect* rect_1, idb::IdbRect* rect_2) { return rect_1->get_low_y() < rect_2->get_low_y(); });
+
+  auto& row_list = idb_rows->get_row_list();
+  std::vector<std::vector<TapcellRegion>> row_region_list(row_list.size());
+#pragma omp parallel for schedule(dynamic, 64)
   for (size_t i = 0; i < row_list.size(); i++) {
-    buildRegionInRow(row_list[i], i);
+    buildRegionInRow(row_list[i], i, blockage_rect_list, max_blockage_height, row_region_list[i]);
+  }
+
+  for (auto& region_list : row_region_list) {
+    _cell_region_list.insert(_cell_region_list.end(), region_list.begin(), region_list.end());
   }
 
   return _cell_region_list.size();
 }
 /**
- * build tapcell & endcap region in row by ignore blockage area
+ * build tapcell & endcap region in row by subtracting the blockage intervals from the row
  */
-void TapCellPlacer::buildRegionInRow(idb::IdbRow* idb_row, int32_t index)
+void TapCellPlacer::buildRegionInRow(idb::IdbRow* idb_row, int32_t index, const std::vector<idb::IdbRect*>& blockage_rect_list,
+                                     int32_t max_blockage_height, std::vector<TapcellRegion>& region_list)
 {
   /// row coordinate
   auto row_rect = idb_row->get_bounding_box();
@@ -101,169 +126,178 @@ void TapCellPlacer::buildRegionInRow(idb::IdbRow* idb_row, int32_t index)
   int32_t idb_row_end_x = row_rect->get_high_x();
   int32_t idb_row_end_y = row_rect->get_high_y();
 
-  auto idb_design = dmInst->get_idb_design();
-  auto idb_blockage_list = idb_design->get_blockage_list();
-
-  std::vector<idb::IdbRect*> rect_list;  /// intersected blockage rect list
-  for (auto blockage : idb_blockage_list->get_blockage_list()) {
-    if (blockage->is_palcement_blockage()) {
-      /// add blocakge shape to region
-      for (auto rect : blockage->get_rect_list()) {
-        /// row and rect intersected
-        if (idb_row_end_y < rect->get_low_y() || idb_row_start_y > rect->get_high_y() || idb_row_start_x > rect->get_low_x()
-            || idb_row_end_x < rect->get_high_x()) {
-          continue;
-        }
-
-        rect_list.emplace_back(rect);
-      }
+  /// intersected blockage interval list
+  std::vector<std::pair<int32_t, int32_t>> interval_list;
+  auto iter = std::lower_bound(blockage_rect_list.begin(), blockage_rect_list.end(), idb_row_start_y - max_blockage_height,
+                               [](idb::IdbRect* rect, int32_t y) { return rect->get_low_y() < y; });
+  for (; iter != blockage_rect_list.end() && (*iter)->get_low_y() <= idb_row_end_y; ++iter) {
+    auto rect = *iter;
+    /// row and rect intersected
+    if (idb_row_start_y > rect->get_high_y() || idb_row_start_x > rect->get_low_x() || idb_row_end_x < rect->get_high_x()) {
+      continue;
     }
+    interval_list.emplace_back(rect->get_low_x(), rect->get_high_x());
   }
+  std::sort(interval_list.begin(), interval_list.end());
 
-  /// no blockage, save row data
-  if (rect_list.size() <= 0) {
+  auto addRegion = [&](int32_t start, int32_t end) {
     TapcellRegion region;
-    region.start = idb_row_start_x;
-    region.end = idb_row_end_x;
+    region.start = start;
+    region.end = end;
     region.y = idb_row->get_original_coordinate()->get_y();
     region.orient = idb_row->get_orient();
     region.index = index;
 
-    _cell_region_list.emplace_back(region);
-
-    return;
-  } else {
-    /// sort blockage rect by coordinate x
-    std::sort(rect_list.begin(), rect_list.end(),
-              [](idb::IdbRect* rect_1, idb::IdbRect* rect_2) { return rect_1->get_low_x() < rect_2->get_low_x(); });
-
-    /// build region
-    for (size_t i = 0; i < rect_list.size(); i++) {
-      /// process begin
-      if (i == 0) {
-        if (idb_row_start_x < rect_list[i]->get_low_x()) {
-          TapcellRegion region;
-          region.start = idb_row_start_x;
-          region.end = rect_list[i]->get_low_x();
-          region.y = idb_row->get_original_coordinate()->get_y();
-          region.orient = idb_row->get_orient();
-          region.index = index;
-
-          _cell_region_list.emplace_back(region);
-        }
-      }
+    region_list.emplace_back(region);
+  };
 
-      /// process end
-      if ((i == rect_list.size() - 1)) {
-        if (idb_row_end_x > rect_list[i]->get_high_x()) {
-          TapcellRegion region;
-          region.start = rect_list[i]->get_high_x();
-          region.end = idb_row_end_x;
-          region.y = idb_row->get_original_coordinate()->get_y();
-          region.orient = idb_row->get_orient();
-          region.index = index;
-
-          _cell_region_list.emplace_back(region);
-        }
-      }
-      /// process middle region
-      if (i > 0 && i < (rect_list.size() - 1)) {
-        TapcellRegion region;
-        region.start = rect_list[i - 1]->get_high_x();
-        region.end = rect_list[i]->get_low_x();
-        region.y = idb_row->get_original_coordinate()->get_y();
-        region.orient = idb_row->get_orient();
-        region.index = index;
-
-        _cell_region_list.emplace_back(region);
-      }
+  /// scan the sorted intervals, the gaps between merged intervals are regions
+  int32_t region_start = idb_row_start_x;
+  for (auto& [low_x, high_x] : interval_list) {
+    if (region_start < low_x) {
+      addRegion(region_start, low_x);
     }
+    region_start = std::max(region_start, high_x);
+  }
+  if (region_start < idb_row_end_x) {
+    addRegion(region_start, idb_row_end_x);
   }
 }
 
 /**
- * insert tapcell & endcap in region
+ * insert tapcell & endcap in region,
+ * the cells of regions are computed in parallel, and the instances are created in bulk in the order of regions
  */
 int TapCellPlacer::insertCell(int32_t inst_space, std::string tapcell_name, std::string endcap_name)
 {
   auto idb_layout = dmInst->get_idb_layout();
   auto idb_core = idb_layout->get_core();
+  auto idb_inst_list = dmInst->get_idb_design()->get_instance_list();
 
   auto tapcell_master = idb_layout->get_cell_master_list()->find_cell_master(tapcell_name);
   auto endcap_master = idb_layout->get_cell_master_list()->find_cell_master(endcap_name);
 
-  int endcap_index = 0;
-  int tapcell_index = 0;
-  for (auto region : _cell_region_list) {
-    /// get width for endcap by orient
-    int32_t endcap_width = getCellMasterWidthByOrient(endcap_master, region.orient);
+  /// get core low bottom x
+  int32_t core_start_x = idb_core->get_bounding_box()->get_low_x();
 
-    /// insert endcap at the begin
-    if ((region.end - region.start) >= endcap_width) {
-      dmInst->createInstance("ENDCAP_" + std::to_string(endcap_index++), endcap_name, region.start, region.y, region.orient,
-                             idb::IdbInstanceType::kDist, idb::IdbPlacementStatus::kFixed);
-    }
-    /// insert endcap at the end
-    if ((region.end - region.start) >= (2 * endcap_width)) {
-      dmInst->createInstance("ENDCAP_" + std::to_string(endcap_index++), endcap_name, region.end - endcap_width, region.y, region.orient,
-                             idb::IdbInstanceType::kDist, idb::IdbPlacementStatus::kFixed);
+  size_t region_num = _cell_region_list.size();
+  std::vector<std::vector<TapcellInsertion>> insertion_lists(region_num);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (size_t i = 0; i < region_num; i++) {
+    buildInsertionInRegion(_cell_region_list[i], inst_space, core_start_x, tapcell_master, endcap_master, insertion_lists[i]);
+  }
+
+  /// first instance, endcap and tapcell index of each region
+  std::vector<int> inst_offset(region_num + 1, 0);
+  std::vector<int> endcap_offset(region_num + 1, 0);
+  std::vector<int> tapcell_offset(region_num + 1, 0);
+  for (size_t i = 0; i < region_num; i++) {
+    int endcap_num = std::count_if(insertion_lists[i].begin(), insertion_lists[i].end(),
+                                   [](const TapcellInsertion& insertion) { return insertion.is_endcap; });
+    inst_offset[i + 1] = inst_offset[i] + insertion_lists[i].size();
+    endcap_offset[i + 1] = endcap_offset[i] + endcap_num;
+    tapcell_offset[i + 1] = tapcell_offset[i] + insertion_lists[i].size() - endcap_num;
+  }
+
+  std::vector<idb::IdbInstance*> inst_list(inst_offset[region_num], nullptr);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (size_t i = 0; i < region_num; i++) {
+    auto& region = _cell_region_list[i];
+    int endcap_index = endcap_offset[i];
+    int tapcell_index = tapcell_offset[i];
+    for (size_t j = 0; j < insertion_lists[i].size(); j++) {
+      auto& insertion = insertion_lists[i][j];
+      idb::IdbInstance* inst = new idb::IdbInstance();
+      if (insertion.is_endcap) {
+        inst->set_name("ENDCAP_" + std::to_string(endcap_index++));
+        inst->set_cell_master(endcap_master);
+      } else {
+        inst->set_name("PHY_" + std::to_string(tapcell_index++));
+        inst->set_cell_master(tapcell_master);
+      }
+      inst->set_type(idb::IdbInstanceType::kDist);
+      /// do not update other cell data, and set update false.
+      inst->set_orient(region.orient, false);
+      inst->set_coodinate(insertion.x, region.y);
+      inst->set_status(idb::IdbPlacementStatus::kFixed);
+
+      inst_list[inst_offset[i] + j] = inst;
     }
+  }
 
-    /// insert tapcell in the middle region
-    {
-      /// get core low bottom x
-      int32_t core_start_x = idb_core->get_bounding_box()->get_low_x();
-
-      /// get start & end of this region plus endcap width
-      int32_t region_start = region.start + endcap_width;
-      int32_t region_end = region.end - endcap_width;
-
-      /// get width for tapcell and endcap by orient
-      int32_t tapcell_width = getCellMasterWidthByOrient(tapcell_master, region.orient);
-      int32_t coord_x = region_start;
-      while ((coord_x + tapcell_width) <= region_end) {
-        /// process first tapcell
-        if (coord_x == region_start) {
-          /// insert tapcell
-          if (region.index % 2 == 0) {
-            dmInst->createInstance("PHY_" + std::to_string(tapcell_index++), tapcell_name, region_start, region.y, region.orient,
-                                   idb::IdbInstanceType::kDist, idb::IdbPlacementStatus::kFixed);
-            /// 以core x为基准，inst_space为间距，奇偶行交错对齐tapcell
-            /// 校准偶数行起始点x
-            coord_x = core_start_x + ((coord_x - core_start_x) / inst_space + 2) * inst_space;
-          } else {
-            /// 校准奇数行起始点x
-            coord_x = core_start_x + ((coord_x - core_start_x) / inst_space + 1) * inst_space;
-          }
-
-          continue;
-        }
+  idb_inst_list->init(idb_inst_list->get_instance_list().size() + inst_list.size());
+  for (auto inst : inst_list) {
+    idb_inst_list->add_instance(inst);
+  }
 
-        /// process middle cell
-        dmInst->createInstance("PHY_" + std::to_string(tapcell_index++), tapcell_name, coord_x, region.y, region.orient,
-                               idb::IdbInstanceType::kDist, idb::IdbPlacementStatus::kFixed);
-
-        /// process last tapcell
-        if ((coord_x + 2 * inst_space) >= region_end) {
-          /// add tapcell to the end of the row adjacentd to the endcap
-          /// at less 2 tapcell width is needed in order to insert tapcell
-          if ((region_end - coord_x) > (tapcell_width * 2)) {
-            /// insert tapcell at the end,
-            /// and coordinate x = region_end - tapcell_width
-            if (region.index % 2 == 0) {
-              dmInst->createInstance("PHY_" + std::to_string(tapcell_index++), tapcell_name, region_end - tapcell_width, region.y,
-                                     region.orient, idb::IdbInstanceType::kDist, idb::IdbPlacementStatus::kFixed);
-            }
-          }
-        }
+  return inst_list.size();
+}
+
+/**
+ * cells of a region, endcaps at both ends and tapcells in the middle,
+ * tapcells of even and odd rows are staggered by inst_space from core x
+ */
+void TapCellPlacer::buildInsertionInRegion(const TapcellRegion& region, int32_t inst_space, int32_t core_start_x,
+                                           idb::IdbCellMaster* tapcell_master, idb::IdbCellMaster* endcap_master,
+                                           std::vector<TapcellInsertion>& insertion_list)
+{
+  /// get width for endcap by orient
+  int32_t endcap_width = getCellMasterWidthByOrient(endcap_master, region.orient);
+
+  /// insert endcap at the begin
+  if ((region.end - region.start) >= endcap_width) {
+    insertion_list.push_back({true, region.start});
+  }
+  /// insert endcap at the end
+  if ((region.end - region.start) >= (2 * endcap_width)) {
+    insertion_list.push_back({true, region.end - endcap_width});
+  }
+
+  /// insert tapcell in the middle region
+  /// get start & end of this region plus endcap width
+  int32_t region_start = region.start + endcap_width;
+  int32_t region_end = region.end - endcap_width;
+
+  /// get width for tapcell by orient
+  int32_t tapcell_width = getCellMasterWidthByOrient(tapcell_master, region.orient);
+  int32_t coord_x = region_start;
+  while ((coord_x + tapcell_width) <= region_end) {
+    /// process first tapcell
+    if (coord_x == region_start) {
+      /// insert tapcell
+      if (region.index % 2 == 0) {
+        insertion_list.push_back({false, region_start});
+        /// 以core x为基准，inst_space为间距，奇偶行交错对齐tapcell
+        /// 校准偶数行起始点x
+        coord_x = core_start_x + ((coord_x - core_start_x) / inst_space + 2) * inst_space;
+      } else {
+        /// 校准奇数行起始点x
+        coord_x = core_start_x + ((coord_x - core_start_x) / inst_space + 1) * inst_space;
+      }
+
+      continue;
+    }
 
-        coord_x += (inst_space * 2);
+    /// process middle cell
+    insertion_list.push_back({false, coord_x});
+
+    /// process last tapcell
+    if ((coord_x + 2 * inst_space) >= region_end) {
+      /// add tapcell to the end of the row adjacentd to the endcap
+      /// at less 2 tapcell width is needed in order to insert tapcell
+      if ((region_end - coord_x) > (tapcell_width * 2)) {
+        /// insert tapcell at the end,
+        /// and coordinate x = region_end - tapcell_width
+        if (region.index % 2 == 0) {
+          insertion_list.push_back({false, region_end - tapcell_width});
+        }
       }
     }
-  }
 
-  return endcap_index + tapcell_index;
+    coord_x += (inst_space * 2);
+  }
 }
+
 /**
  * get width of cell master by orient for a row
  */
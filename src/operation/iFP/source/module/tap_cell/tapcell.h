@@ -27,6 +27,7 @@ using std::vector;
 namespace idb {
 enum class IdbOrient : uint8_t;
 class IdbCellMaster;
+class IdbRect;
 class IdbRow;
 }  // namespace idb
 namespace ifp {
@@ -39,6 +40,13 @@ struct TapcellRegion
   idb::IdbOrient orient;
 };
 
+/// cell to insert in a region, in insertion order
+struct TapcellInsertion
+{
+  bool is_endcap;
+  int32_t x;
+};
+
 class TapCellPlacer
 {
  public:
@@ -52,9 +60,12 @@ class TapCellPlacer
 
   bool checkDistance(int32_t distance);
   int buildTapcellRegion();
-  void buildRegionInRow(idb::IdbRow* idb_row, int32_t index);
+  void buildRegionInRow(idb::IdbRow* idb_row, int32_t index, const std::vector<idb::IdbRect*>& blockage_rect_list,
+                        int32_t max_blockage_height, std::vector<TapcellRegion>& region_list);
 
   int insertCell(int32_t inst_space, std::string tapcell_name, std::string endcap_name);
+  void buildInsertionInRegion(const TapcellRegion& region, int32_t inst_space, int32_t core_start_x, idb::IdbCellMaster* tapcell_master,
+                              idb::IdbCellMaster* endcap_master, std::vector<TapcellInsertion>& insertion_list);
   int32_t getCellMasterWidthByOrient(idb::IdbCellMaster* cell_master, idb::IdbOrient orinet);
 };
 
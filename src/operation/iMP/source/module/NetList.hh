@@ -10,6 +10,7 @@
  */
 #ifndef IMP_NETLIST_H
 #define IMP_NETLIST_H
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 namespace imp {
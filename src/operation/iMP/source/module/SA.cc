@@ -1,7 +1,9 @@
 #include "SA.hh"
 
+#include <algorithm>
 #include <cstring>
-#include <map>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 #include "Evaluator.hh"
@@ -41,80 +43,174 @@ SequencePair<T>::~SequencePair()
   delete[] pos_seq;
   delete[] neg_seq;
 }
-bool pack_sp(int size, int* pos, int* neg, int* w, int* h, int* lx, int* ly, int& W, int& H)
+double evaluate(SequencePair<NetList> sp)
 {
-  std::map<int, int> BST;
+  const NetList& netlist = sp.Tp;
+  int W, H;
+  // pack_sp(netlist.num_v, sp.pos_seq, sp.neg_seq, netlist.w, netlist.h, netlist.x, netlist.y, W, H);
 
-  auto find = [&](int index) {
-    int loc;
-    auto iter = BST.lower_bound(index);
-    if (iter != BST.begin()) {
-      iter--;
-      loc = (*iter).second;
-    } else
-      loc = 0;
-    return loc;
-  };
+  return 0.0;
+}
 
-  auto remove = [&](int index, int length) {
-    auto endIter = BST.end();
-    auto iter = BST.find(index);
-    auto nextIter = iter;
-    ++nextIter;
-    if (nextIter != BST.end()) {
-      ++iter;
-      while (true) {
-        ++nextIter;
-        if ((*iter).second < length)
-          BST.erase(iter);
-        if (nextIter == endIter)
-          break;
-        iter = nextIter;
-      }
-    }
-  };
+SequencePairSolution::SequencePairSolution(const NetList& netlist)
+    : _netlist(&netlist),
+      _num_vertexs(netlist.get_x_size().size()),
+      _pos(_num_vertexs),
+      _neg(_num_vertexs),
+      _dx(netlist.get_x_size().begin(), netlist.get_x_size().end()),
+      _dy(netlist.get_y_size().begin(), netlist.get_y_size().end()),
+      _lx(_num_vertexs),
+      _ly(_num_vertexs),
+      _pack_lx(_num_vertexs),
+      _pack_ly(_num_vertexs),
+      _width(0),
+      _height(0),
+      _net_hpwl(netlist.get_net_span().size() - 1),
+      _cost(0.),
+      _delta_cost(0.),
+      _move(kSwapPos),
+      _i(0),
+      _j(0),
+      _old_width(0),
+      _old_height(0),
+      _net_stamp(_net_hpwl.size(), 0),
+      _stamp(0)
+{
+  std::iota(_pos.begin(), _pos.end(), 0);
+  std::iota(_neg.begin(), _neg.end(), 0);
+  _packer.pack(_pos, _neg, _dx.data(), _dy.data(), _lx.data(), _ly.data(), _width, _height);
+  for (size_t i = 0; i < _net_hpwl.size(); ++i) {
+    _net_hpwl[i] = netHPWL(i);
+  }
+  _cost = evaluate();
+}
 
-  std::vector<int> match(size);
+bool SequencePairSolution::operate(std::mt19937& gen)
+{
+  if (_num_vertexs < 2) {
+    return false;
+  }
+  std::uniform_int_distribution<int> move_rand(kSwapPos, kSwapBoth);
+  std::uniform_int_distribution<int> vertex_rand(0, _num_vertexs - 1);
+  _move = static_cast<MoveType>(move_rand(gen));
+  _i = vertex_rand(gen);
+  do {
+    _j = vertex_rand(gen);
+  } while (_j == _i);
+  swapSeq(_move, _i, _j);
 
-  auto pack = [&](int size, int* pos, int* neg, int* loc, int* weight) {
-    BST.clear();
-    BST[0] = 0;
-    for (int i{0}; i < size; i++) {
-      match[neg[i]] = i;
-    }
+  _old_width = _width;
+  _old_height = _height;
+  _moved_vertexs.clear();
+  _changed_nets.clear();
+  if (++_stamp == 0) {
+    std::fill(_net_stamp.begin(), _net_stamp.end(), 0);
+    _stamp = 1;
+  }
+
+  _packer.pack(_pos, _neg, _dx.data(), _dy.data(), _pack_lx.data(), _pack_ly.data(), _width, _height);
 
-    float t{0.f};
-    for (int i{0}; i < size; ++i) {
-      int p = match[pos[i]];
-      loc[pos[i]] = find(p);
-      t = loc[pos[i]] + weight[pos[i]];
-      BST[p] = t;
-      remove(p, t);
+  const auto& vertex_span = _netlist->get_vertex_span();
+  const auto& pin2net = _netlist->get_pin2net();
+  for (int v = 0; v < _num_vertexs; ++v) {
+    if (_pack_lx[v] == _lx[v] && _pack_ly[v] == _ly[v]) {
+      continue;
     }
-    return find(size);
-  };
+    _moved_vertexs.emplace_back(v, _lx[v], _ly[v]);
+    _lx[v] = _pack_lx[v];
+    _ly[v] = _pack_ly[v];
+    for (size_t k = vertex_span[v]; k < vertex_span[v + 1]; ++k) {
+      size_t net = pin2net[k];
+      if (_net_stamp[net] != _stamp) {
+        _net_stamp[net] = _stamp;
+        _changed_nets.emplace_back(net, _net_hpwl[net]);
+      }
+    }
+  }
 
-  W = pack(size, pos, neg, lx, w);
+  int64_t delta = 0;
+  for (auto& [net, old_hpwl] : _changed_nets) {
+    _net_hpwl[net] = netHPWL(net);
+    delta += _net_hpwl[net] - old_hpwl;
+  }
+  _delta_cost = delta;
+  return true;
+}
 
-  int rpos_sp[size];
+void SequencePairSolution::update()
+{
+  _cost += _delta_cost;
+  _delta_cost = 0.;
+  _moved_vertexs.clear();
+  _changed_nets.clear();
+}
 
-  int iter = 0;
-  int riter = size;
-  while (iter < size) {
-    rpos_sp[--riter] = pos[iter++];
+void SequencePairSolution::rollback()
+{
+  swapSeq(_move, _i, _j);
+  for (auto& [v, lx, ly] : _moved_vertexs) {
+    _lx[v] = lx;
+    _ly[v] = ly;
+  }
+  for (auto& [net, old_hpwl] : _changed_nets) {
+    _net_hpwl[net] = old_hpwl;
   }
-  H = pack(size, rpos_sp, neg, ly, h);
+  _width = _old_width;
+  _height = _old_height;
+  _delta_cost = 0.;
+  _moved_vertexs.clear();
+  _changed_nets.clear();
+}
 
-  return true;
+double SequencePairSolution::evaluate() const
+{
+  int64_t total = 0;
+  for (size_t i = 0; i < _net_hpwl.size(); ++i) {
+    total += netHPWL(i);
+  }
+  return total;
 }
 
-double evaluate(SequencePair<NetList> sp)
+void SequencePairSolution::swapSeq(MoveType move, int i, int j)
 {
-  const NetList& netlist = sp.Tp;
-  int W, H;
-  // pack_sp(netlist.num_v, sp.pos_seq, sp.neg_seq, netlist.w, netlist.h, netlist.x, netlist.y, W, H);
+  if (move == kSwapPos || move == kSwapBoth) {
+    std::swap(_pos[i], _pos[j]);
+  }
+  if (move == kSwapNeg || move == kSwapBoth) {
+    // swap the same two vertexs in negative sequence
+    if (move == kSwapBoth) {
+      auto iter_i = std::find(_neg.begin(), _neg.end(), _pos[j]);
+      auto iter_j = std::find(_neg.begin(), _neg.end(), _pos[i]);
+      std::iter_swap(iter_i, iter_j);
+    } else {
+      std::swap(_neg[i], _neg[j]);
+    }
+  }
+}
 
-  return 0.0;
+int64_t SequencePairSolution::netHPWL(size_t net) const
+{
+  const auto& net_span = _netlist->get_net_span();
+  const auto& pin2vertex = _netlist->get_pin2vertex();
+  const auto& x_off = _netlist->get_pin_x_off();
+  const auto& y_off = _netlist->get_pin_y_off();
+  int64_t min_x = std::numeric_limits<int64_t>::max();
+  int64_t max_x = std::numeric_limits<int64_t>::min();
+  int64_t min_y = std::numeric_limits<int64_t>::max();
+  int64_t max_y = std::numeric_limits<int64_t>::min();
+  for (size_t j = net_span[net]; j < net_span[net + 1]; ++j) {
+    size_t v = pin2vertex[j];
+    int64_t x = static_cast<int64_t>(_lx[v]) + _dx[v] / 2 + x_off[j];
+    int64_t y = static_cast<int64_t>(_ly[v]) + _dy[v] / 2 + y_off[j];
+    min_x = std::min(min_x, x);
+    max_x = std::max(max_x, x);
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+  }
+  if (min_x > max_x) {
+    return 0;
+  }
+  return (max_x - min_x) + (max_y - min_y);
 }
 
 }  // namespace imp
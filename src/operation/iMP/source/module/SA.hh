@@ -10,8 +10,13 @@
  */
 #ifndef IMP_SA_H
 #define IMP_SA_H
+#include <random>
+#include <tuple>
+#include <vector>
+
 #include "Annealer.hh"
 #include "NetList.hh"
+#include "SequencePairPacker.hh"
 namespace imp {
 
 template <typename T>
@@ -27,10 +32,73 @@ struct SequencePair
   const T& Tp;
 };
 
-template <typename T>
-bool pack_sp(int size, int* pos, int* neg, int* w, int* h, int* lx, int* ly, int& W, int& H);
 double evaluate(SequencePair<NetList> sp);
 
+/**
+ * @brief Sequence pair of all vertexs of a netlist, the cost is the total hpwl, pin location is vertex center plus pin offset.
+ *
+ * A move swaps two vertexs in the positive sequence, the negative sequence or both. After packing, only the vertexs whose
+ * location changed and the nets on them are updated, the old locations and net hpwls are kept in the undo log of the move
+ * for rollback. Used by PTSolve.
+ */
+class SequencePairSolution
+{
+ public:
+  explicit SequencePairSolution(const NetList& netlist);
+
+  bool operate(std::mt19937& gen);
+  double deltaCost() const { return _delta_cost; }
+  void update();
+  void rollback();
+  // total hpwl from scratch
+  double evaluate() const;
+
+  double get_cost() const { return _cost; }
+  int get_width() const { return _width; }
+  int get_height() const { return _height; }
+  const std::vector<int>& get_lx() const { return _lx; }
+  const std::vector<int>& get_ly() const { return _ly; }
+
+ private:
+  enum MoveType
+  {
+    kSwapPos,
+    kSwapNeg,
+    kSwapBoth
+  };
+
+  void swapSeq(MoveType move, int i, int j);
+  int64_t netHPWL(size_t net) const;
+
+  const NetList* _netlist;
+  int _num_vertexs;
+  std::vector<int> _pos;
+  std::vector<int> _neg;
+  std::vector<int> _dx;
+  std::vector<int> _dy;
+  std::vector<int> _lx;
+  std::vector<int> _ly;
+  std::vector<int> _pack_lx;
+  std::vector<int> _pack_ly;
+  ieda_solver::SequencePairPacker _packer;
+  int _width;
+  int _height;
+  std::vector<int64_t> _net_hpwl;
+  double _cost;
+  double _delta_cost;
+
+  // undo log of the last move
+  MoveType _move;
+  int _i;
+  int _j;
+  int _old_width;
+  int _old_height;
+  std::vector<std::tuple<int, int, int>> _moved_vertexs;  // vertex, old lx, old ly
+  std::vector<std::pair<size_t, int64_t>> _changed_nets;  // net, old hpwl
+  std::vector<uint32_t> _net_stamp;                       // nets already in _changed_nets have the current stamp
+  uint32_t _stamp;
+};
+
 }  // namespace imp
 
 #endif
\ No newline at end of file
@@ -10,10 +10,13 @@
  */
 #ifndef IMP_ANNEALER_H
 #define IMP_ANNEALER_H
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <functional>
 #include <iostream>
 #include <random>
+#include <vector>
 namespace imp {
 struct SAOption
 {
@@ -24,7 +27,7 @@ struct SAOption
   double start_temperature = 1000;
 };
 
-void test()
+inline void test()
 {
   std::cout << "test";
 }
@@ -47,7 +50,7 @@ class SimulateAnneal
   ~SimulateAnneal() = delete;
 };
 template <typename T>
-bool SASolve(T& solution, std::function<double(const T&)> evaluate, std::function<bool(const T&)> action, int max_iters, int num_actions,
+bool SASolve(T& solution, std::function<double(const T&)> evaluate, std::function<bool(T&)> action, int max_iters, int num_actions,
              double cool_rate, double temperature)
 {
   double curr_cost = evaluate(solution);
@@ -75,6 +78,101 @@ bool SASolve(T& solution, std::function<double(const T&)> evaluate, std::functio
   }
   return true;
 }
+
+struct PTOption
+{
+  int max_iters = 500;              // epochs, replicas try to swap temperatures after each epoch
+  int num_actions = 60;             // moves of each replica in one epoch
+  double cool_rate = 0.92;          // all temperatures are cooled after each epoch
+  double start_temperature = 1000;  // temperature of the hottest replica
+  double temperature_ratio = 0.5;   // temperature of replica k is start_temperature * temperature_ratio^k
+  int num_threads = 1;
+  unsigned seed = 0;  // 0 for random seed
+};
+
+/**
+ * @brief Parallel tempering, replicas anneal at different temperatures on separate threads, the neighbouring temperatures
+ * are exchanged with probability min(1, exp((E_i - E_j) * (1 / T_i - 1 / T_j))) after each epoch.
+ *
+ * A replica only keeps the undo log of its last move instead of a copy of the solution, T should provide:
+ *   bool operate(std::mt19937&);  // make a random move, false if nothing moved
+ *   double deltaCost() const;     // cost change of the last move
+ *   void update();                // accept the last move
+ *   void rollback();              // undo the last move
+ *   double get_cost() const;      // current cost
+ *
+ * @return the best solution of all replicas, checked at the end of each epoch
+ */
+template <typename T>
+T PTSolve(std::vector<T>& replicas, const PTOption& opt)
+{
+  const int num_replicas = replicas.size();
+  std::random_device r;
+  const unsigned seed = opt.seed == 0 ? r() : opt.seed;
+  std::vector<std::mt19937> gens;
+  for (int i = 0; i < num_replicas; ++i) {
+    gens.emplace_back(seed + i);
+  }
+  std::mt19937 swap_gen(seed + num_replicas);
+  std::uniform_real_distribution<double> real_rand(0., 1.);
+
+  // slot k is the k-th temperature from hot to cold, slot2replica[k] is the replica annealing at it
+  std::vector<double> temperature(num_replicas);
+  std::vector<int> slot2replica(num_replicas);
+  for (int k = 0; k < num_replicas; ++k) {
+    temperature[k] = opt.start_temperature * std::pow(opt.temperature_ratio, k);
+    slot2replica[k] = k;
+  }
+
+  int best_replica = 0;
+  for (int i = 1; i < num_replicas; ++i) {
+    if (replicas[i].get_cost() < replicas[best_replica].get_cost()) {
+      best_replica = i;
+    }
+  }
+  T best = replicas[best_replica];
+
+  for (int iter = 0; iter < opt.max_iters; ++iter) {
+#pragma omp parallel for num_threads(opt.num_threads) schedule(static, 1)
+    for (int k = 0; k < num_replicas; ++k) {
+      T& solution = replicas[slot2replica[k]];
+      std::mt19937& gen = gens[slot2replica[k]];
+      std::uniform_real_distribution<double> rand(0., 1.);
+      for (int times = 0; times < opt.num_actions; ++times) {
+        if (!solution.operate(gen)) {
+          continue;
+        }
+        double delta_cost = solution.deltaCost();
+        if (delta_cost < 0 || std::exp(-delta_cost / temperature[k]) > rand(gen)) {
+          solution.update();
+        } else {
+          solution.rollback();
+        }
+      }
+    }
+
+    for (int i = 0; i < num_replicas; ++i) {
+      if (replicas[i].get_cost() < best.get_cost()) {
+        best = replicas[i];
+      }
+    }
+
+    // even and odd neighbouring pairs take turns to exchange
+    for (int k = iter % 2; k + 1 < num_replicas; k += 2) {
+      double e_hot = replicas[slot2replica[k]].get_cost();
+      double e_cold = replicas[slot2replica[k + 1]].get_cost();
+      double exponent = (e_cold - e_hot) * (1. / temperature[k + 1] - 1. / temperature[k]);
+      if (exponent >= 0 || std::exp(exponent) > real_rand(swap_gen)) {
+        std::swap(slot2replica[k], slot2replica[k + 1]);
+      }
+    }
+
+    for (auto& t : temperature) {
+      t *= opt.cool_rate;
+    }
+  }
+  return best;
+}
 }  // namespace imp
 
 #endif
\ No newline at end of file
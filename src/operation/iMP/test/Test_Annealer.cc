@@ -0,0 +1,115 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Annealer.hh"
+#include "SA.hh"
+
+// random macros and nets, usage: test_annealer [num_vertexs] [num_nets] [num_threads]
+imp::NetList makeRandomNetList(size_t num_vertexs, size_t num_nets, unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int32_t> size_rand(10, 100);
+  std::uniform_int_distribution<size_t> degree_rand(2, 6);
+  std::uniform_int_distribution<size_t> vertex_rand(0, num_vertexs - 1);
+  std::vector<imp::NetList::VertexType> type(num_vertexs, imp::NetList::kMacro);
+  std::vector<int32_t> lx(num_vertexs, 0);
+  std::vector<int32_t> ly(num_vertexs, 0);
+  std::vector<int32_t> dx(num_vertexs);
+  std::vector<int32_t> dy(num_vertexs);
+  for (size_t i = 0; i < num_vertexs; ++i) {
+    dx[i] = size_rand(gen);
+    dy[i] = size_rand(gen);
+  }
+  std::vector<int32_t> pin_x_off;
+  std::vector<int32_t> pin_y_off;
+  std::vector<size_t> net_span{0};
+  std::vector<size_t> pin2vertex;
+  for (size_t i = 0; i < num_nets; ++i) {
+    size_t degree = degree_rand(gen);
+    for (size_t j = 0; j < degree; ++j) {
+      size_t v = vertex_rand(gen);
+      pin2vertex.push_back(v);
+      pin_x_off.push_back(std::uniform_int_distribution<int32_t>(-dx[v] / 2, dx[v] / 2)(gen));
+      pin_y_off.push_back(std::uniform_int_distribution<int32_t>(-dy[v] / 2, dy[v] / 2)(gen));
+    }
+    net_span.push_back(pin2vertex.size());
+  }
+  return imp::NetList(num_vertexs, num_vertexs, 0, num_nets, std::move(type), std::move(lx), std::move(ly), std::move(dx), std::move(dy),
+                      std::move(pin_x_off), std::move(pin_y_off), std::move(net_span), std::move(pin2vertex));
+}
+
+// start temperature with init_pro acceptance of the average uphill move
+double initTemperature(imp::SequencePairSolution solution, double init_pro)
+{
+  std::mt19937 gen(1);
+  double sum = 0.;
+  int num_uphill = 0;
+  for (int i = 0; i < 200; ++i) {
+    if (solution.operate(gen) && solution.deltaCost() > 0) {
+      sum += solution.deltaCost();
+      ++num_uphill;
+    }
+    solution.rollback();
+  }
+  return num_uphill == 0 ? 1. : -(sum / num_uphill) / std::log(init_pro);
+}
+
+int main(int argc, char* argv[])
+{
+  size_t num_vertexs = argc > 1 ? std::stoul(argv[1]) : 200;
+  size_t num_nets = argc > 2 ? std::stoul(argv[2]) : 400;
+  int num_threads = argc > 3 ? std::stoi(argv[3]) : 4;
+  imp::NetList netlist = makeRandomNetList(num_vertexs, num_nets, 1);
+  imp::SequencePairSolution init_solution(netlist);
+  imp::SAOption sa_opt;
+  double temperature = initTemperature(init_solution, sa_opt.init_pro);
+  std::cout << "vertexs: " << num_vertexs << " nets: " << num_nets << " init hpwl: " << init_solution.get_cost() << std::endl;
+
+  // full copy and full evaluation on every move
+  auto start = std::chrono::steady_clock::now();
+  imp::SequencePairSolution sa_solution = init_solution;
+  std::mt19937 gen(1);
+  auto evaluate = [](const imp::SequencePairSolution& s) { return s.evaluate(); };
+  auto action = [&gen](imp::SequencePairSolution& s) {
+    bool moved = s.operate(gen);
+    s.update();
+    return moved;
+  };
+  imp::SASolve<imp::SequencePairSolution>(sa_solution, evaluate, action, sa_opt.max_iters, sa_opt.num_operates, sa_opt.cool_rate,
+                                          temperature);
+  double sa_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "SASolve hpwl: " << sa_solution.evaluate() << " time: " << sa_time << "s" << std::endl;
+
+  // undo log and incremental cost, one replica
+  imp::PTOption pt_opt;
+  pt_opt.max_iters = sa_opt.max_iters;
+  pt_opt.num_actions = sa_opt.num_operates;
+  pt_opt.cool_rate = sa_opt.cool_rate;
+  pt_opt.start_temperature = temperature;
+  pt_opt.seed = 1;
+  start = std::chrono::steady_clock::now();
+  std::vector<imp::SequencePairSolution> replicas(1, init_solution);
+  imp::SequencePairSolution single = imp::PTSolve(replicas, pt_opt);
+  double single_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "PTSolve(1 replica) hpwl: " << single.get_cost() << " time: " << single_time << "s"
+            << " speedup: " << sa_time / single_time << std::endl;
+
+  // parallel tempering
+  pt_opt.num_threads = num_threads;
+  start = std::chrono::steady_clock::now();
+  replicas.assign(num_threads, init_solution);
+  imp::SequencePairSolution best = imp::PTSolve(replicas, pt_opt);
+  double pt_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "PTSolve(" << num_threads << " replicas) hpwl: " << best.get_cost() << " time: " << pt_time << "s" << std::endl;
+
+  if (single.get_cost() != single.evaluate() || best.get_cost() != best.evaluate()) {
+    std::cout << "incremental hpwl mismatch: " << single.get_cost() << " " << single.evaluate() << " " << best.get_cost() << " "
+              << best.evaluate() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -17,6 +17,10 @@
 #include "FixFanout.h"
 #include "builder.h"
 
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
 #include "IdbEnum.h"
 #include "api/TimingEngine.hh"
 #include "api/TimingIDBAdapter.hh"
@@ -32,8 +36,16 @@ FixFanout::FixFanout(ino::DbInterface *db_interface) : _db_interface(db_interfac
 void FixFanout::fixFanout() {
   _idb_layout = _idb->get_lef_service()->get_layout();
   _idb_design = _idb->get_def_service()->get_design();
-  auto net_list = _idb_design->get_net_list()->get_net_list();
 
+  auto *buffer_cell =
+      _timing_engine->findLibertyCell(_db_interface->get_insert_buffer().c_str());
+  LOG_ERROR_IF(!buffer_cell) << "insert buffer uninitialized.";
+  if (!buffer_cell) {
+    return;
+  }
+
+  std::vector<FanoutTree> trees;
+  auto *idb_adpat = dynamic_cast<ista::TimingIDBAdapter *>(_timing_engine->get_db_adapter());
   auto      *design_nl = _timing_engine->get_netlist();
   ista::Net *sta_net;
   FOREACH_NET(design_nl, sta_net) {
@@ -44,116 +56,182 @@ void FixFanout::fixFanout() {
     if (fanout > _max_fanout) {
       _fanout_vio_num++;
 
-      auto idb_adpat =
-          dynamic_cast<ista::TimingIDBAdapter *>(_timing_engine->get_db_adapter());
-      IdbNet *db_net = idb_adpat->staToDb(sta_net);
-      fixFanout(db_net);
+      FanoutTree tree;
+      tree.net = idb_adpat->staToDb(sta_net);
+      trees.push_back(std::move(tree));
     }
   }
 
-  LOG_INFO << "[Result: ] Find " << _fanout_vio_num << " Net with fanout violation.\n";
-  LOG_INFO << "[Result: ] Insert " << _insert_instance_index << " Buffers.\n";
+  // the trees of different nets are independent, the netlist is edited after all trees are built
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < trees.size(); ++i) {
+    buildTree(trees[i]);
+  }
+  for (auto &tree : trees) {
+    insertTree(tree, buffer_cell);
+  }
+
+  int    max_depth = 0;
+  double total_runtime = 0.0;
+  for (auto &tree : trees) {
+    max_depth = std::max(max_depth, tree.depth);
+    total_runtime += tree.runtime;
+  }
 
-  _db_interface->report()->get_ofstream() << "[Result: ] Find " << _fanout_vio_num
-                                          << " Net with fanout violation.\n"
-                                             "[Result: ] Insert "
-                                          << _insert_instance_index - 1 << " Buffers.\n";
-  _db_interface->report()->get_ofstream().close();
+  LOG_INFO << "[Result: ] Find " << _fanout_vio_num << " Net with fanout violation.\n";
+  LOG_INFO << "[Result: ] Insert " << _insert_instance_index - 1 << " Buffers.\n";
+  LOG_INFO << "[Result: ] Max buffer tree depth " << max_depth << ", runtime "
+           << total_runtime << " ms.\n";
+
+  auto &ofs = _db_interface->report()->get_ofstream();
+  ofs << "[Result: ] Find " << _fanout_vio_num
+      << " Net with fanout violation.\n"
+         "[Result: ] Insert "
+      << _insert_instance_index - 1 << " Buffers.\n";
+  for (auto &tree : trees) {
+    ofs << "  net " << tree.net->get_net_name() << " fanout " << tree.fanout
+        << " depth " << tree.depth << " runtime " << tree.runtime << " ms\n";
+  }
+  ofs.close();
   _db_interface->report()->reportTime(false);
 }
 
-void FixFanout::fixFanout(IdbNet *net) {
-  int fanout = net->get_load_pins().size();
-  while (fanout > _max_fanout) {
-    auto load_pins = net->get_load_pins();
-    /* code */
-    IdbNet *in_net, *out_net;
-    in_net = net;
-    string net_name = ("fanout_net_" + std::to_string(_make_net_index));
-    _make_net_index++;
-    out_net = makeNet(net_name.c_str());
-    out_net->set_connect_type(idb::IdbConnectType::kSignal);
-
-    string buf_name = ("fanout_buf_" + std::to_string(_insert_instance_index));
-    _insert_instance_index++;
+void FixFanout::buildTree(FanoutTree &tree) {
+  auto start = std::chrono::steady_clock::now();
 
-    auto         insert_buffer = _db_interface->get_insert_buffer();
-    IdbInstance *insert_buf = makeInstance(insert_buffer, buf_name.c_str());
-    LOG_ERROR_IF(!insert_buf) << "insert buffer uninitialized.";
-
-    // get buf input_pin and output_pin
-    IdbPin  *buf_input_pin = nullptr;
-    IdbPin  *buf_output_pin = nullptr;
-    IdbPins *buf_pins = insert_buf->get_pin_list();
-    for (auto pin : buf_pins->get_pin_list()) {
-      if (pin->get_term()->get_type() == idb::IdbConnectType::kPower ||
-          pin->get_term()->get_type() == idb::IdbConnectType::kGround) {
-        continue;
-      }
-      if (pin->get_term()->get_direction() == idb::IdbConnectDirection::kInput) {
-        buf_input_pin = pin;
-      } else if (pin->get_term()->get_direction() == idb::IdbConnectDirection::kOutput) {
-        buf_output_pin = pin;
-      }
-    }
-    LOG_ERROR_IF(!buf_input_pin) << "'buf_input_pin' uninitialized.";
-    LOG_ERROR_IF(!buf_output_pin) << "'buf_output_pin' uninitialized.";
-    connect(insert_buf, buf_input_pin, in_net);
-    connect(insert_buf, buf_output_pin, out_net);
-    for (int i = 0; i < _max_fanout; i++) {
-      IdbPin *idb_pin = load_pins[i];
-      // 1
-      disconnectPin(idb_pin);
-      // 2
-      connect(idb_pin->get_instance(), idb_pin, out_net);
+  auto load_pins = tree.net->get_load_pins();
+  tree.fanout = load_pins.size();
+  for (IdbPin *pin : load_pins) {
+    if (pin->is_io_pin()) {
+      tree.num_io_loads++;
+      continue;
     }
-    fanout = net->get_load_pins().size();
+    auto *coord = pin->get_average_coordinate();
+    tree.nodes.push_back({coord->get_x(), coord->get_y(), pin, {}});
   }
-}
+  planTree(tree, _max_fanout);
 
-IdbNet *FixFanout::makeNet(const char *name) {
-  string str_name = name;
-  // IdbNetList *dbnet_list = _idb_design->get_net_list();
-  IdbNet *dnet = _idb_design->get_net_list()->add_net(str_name);
-  return dnet;
+  tree.runtime +=
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+          .count();
 }
 
-IdbInstance *FixFanout::makeInstance(string master_name, string inst_name) {
-  IdbCellMasterList *master_list = _idb_layout->get_cell_master_list();
-  IdbCellMaster     *master = master_list->find_cell_master(master_name);
-  if (!master) {
-    return nullptr;
+void FixFanout::planTree(FanoutTree &tree, int max_fanout) {
+  max_fanout = std::max(max_fanout, 2);
+
+  std::vector<int> items(tree.nodes.size());
+  std::iota(items.begin(), items.end(), 0);
+  int root_fanout = std::max(max_fanout - tree.num_io_loads, 1);
+  while ((int)items.size() > root_fanout) {
+    int              num_groups = (items.size() + max_fanout - 1) / max_fanout;
+    std::vector<int> next_items;
+    partition(tree, items, 0, items.size(), num_groups, next_items);
+    items.swap(next_items);
+    tree.depth++;
   }
-  IdbInstance *idb_inst = new IdbInstance();
-  idb_inst->set_name(inst_name);
-  idb_inst->set_cell_master(master);
-
-  _idb_design->get_instance_list()->add_instance(idb_inst);
-  return idb_inst;
+  tree.roots = std::move(items);
 }
 
-void FixFanout::disconnectPin(IdbPin *dpin) {
-  if (dpin) {
-    auto *dnet = dpin->get_net();
-    dnet->remove_pin(dpin);
+void FixFanout::partition(FanoutTree &tree, std::vector<int> &items, int begin, int end,
+                          int num_groups, std::vector<int> &next_items) {
+  auto &nodes = tree.nodes;
+  if (num_groups == 1) {
+    TreeNode buffer{0, 0, nullptr, {}};
+    int64_t  sum_x = 0;
+    int64_t  sum_y = 0;
+    for (int i = begin; i < end; ++i) {
+      sum_x += nodes[items[i]].x;
+      sum_y += nodes[items[i]].y;
+      buffer.children.push_back(items[i]);
+    }
+    buffer.x = sum_x / (end - begin);
+    buffer.y = sum_y / (end - begin);
+    next_items.push_back(nodes.size());
+    nodes.push_back(std::move(buffer));
+    return;
+  }
+
+  int32_t min_x = INT32_MAX, min_y = INT32_MAX, max_x = INT32_MIN, max_y = INT32_MIN;
+  for (int i = begin; i < end; ++i) {
+    min_x = std::min(min_x, nodes[items[i]].x);
+    min_y = std::min(min_y, nodes[items[i]].y);
+    max_x = std::max(max_x, nodes[items[i]].x);
+    max_y = std::max(max_y, nodes[items[i]].y);
   }
+  bool by_x = (int64_t)max_x - min_x >= (int64_t)max_y - min_y;
+
+  // groups of the two halves hold the nodes in proportion, so no group exceeds _max_fanout
+  int left_groups = num_groups / 2;
+  int mid = begin + (int64_t)(end - begin) * left_groups / num_groups;
+  std::nth_element(items.begin() + begin, items.begin() + mid, items.begin() + end,
+                   [&](int a, int b) {
+                     return by_x ? nodes[a].x < nodes[b].x : nodes[a].y < nodes[b].y;
+                   });
+  partition(tree, items, begin, mid, left_groups, next_items);
+  partition(tree, items, mid, end, num_groups - left_groups, next_items);
 }
 
-void FixFanout::connect(IdbInstance *dinst, IdbPin *dpin, IdbNet *dnet) {
-  auto  &dpin_list = dinst->get_pin_list()->get_pin_list();
-  string port_name = dpin->get_pin_name();
-  for (auto dpin : dpin_list) {
-    if (dpin->get_pin_name() == port_name) {
-      if (dpin->is_io_pin()) {
-        dnet->set_io_pin(dpin);
-        dpin->set_net(dnet);
-      } else {
-        dnet->add_instance_pin(dpin);
-        dpin->set_net(dnet);
-      }
-      break;
+void FixFanout::insertTree(FanoutTree &tree, ista::LibertyCell *buffer_cell) {
+  auto  start = std::chrono::steady_clock::now();
+  auto &nodes = tree.nodes;
+  auto *idb_adapter = dynamic_cast<ista::TimingIDBAdapter *>(_timing_engine->get_db_adapter());
+
+  ista::LibertyPort *buffer_input_port, *buffer_output_port;
+  buffer_cell->bufferPorts(buffer_input_port, buffer_output_port);
+
+  ista::Net *sta_net = idb_adapter->dbToSta(tree.net);
+  auto moveToNet = [idb_adapter](ista::Pin *pin, ista::Net *net) {
+    if (pin->get_net() == net) {
+      return;
+    }
+    ista::Instance *inst = pin->get_own_instance();
+    idb_adapter->disconnectPin(pin);
+    auto debug = idb_adapter->connect(inst, pin->get_name(), net);
+    LOG_ERROR_IF(!debug);
+  };
+
+  // the buffers are made bottom up, the input of a new buffer is on the net until the
+  // buffer of the next level moves it, so the sta graph is updated buffer by buffer.
+  std::vector<ista::Pin *> buf_input_pins(nodes.size(), nullptr);
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (nodes[i].load_pin) {
+      continue;
     }
+    string net_name = ("fanout_net_" + std::to_string(_make_net_index));
+    _make_net_index++;
+    ista::Net *out_net = idb_adapter->makeNet(net_name.c_str(), nullptr);
+    idb_adapter->staToDb(out_net)->set_connect_type(idb::IdbConnectType::kSignal);
+
+    string buf_name = ("fanout_buf_" + std::to_string(_insert_instance_index));
+    _insert_instance_index++;
+    ista::Instance *insert_buf = idb_adapter->makeInstance(buffer_cell, buf_name.c_str());
+    IdbInstance    *idb_buf = idb_adapter->staToDb(insert_buf);
+    IdbCellMaster  *buffer_master = idb_buf->get_cell_master();
+    idb_buf->set_coodinate(nodes[i].x - (int32_t)buffer_master->get_width() / 2,
+                           nodes[i].y - (int32_t)buffer_master->get_height() / 2);
+    idb_buf->set_status_placed();
+
+    auto debug_buf_out =
+        idb_adapter->connect(insert_buf, buffer_output_port->get_port_name(), out_net);
+    auto debug_buf_in =
+        idb_adapter->connect(insert_buf, buffer_input_port->get_port_name(), sta_net);
+    LOG_ERROR_IF(!debug_buf_in);
+    LOG_ERROR_IF(!debug_buf_out);
+    buf_input_pins[i] = debug_buf_in;
+
+    for (int child : nodes[i].children) {
+      ista::Pin *child_pin = nodes[child].load_pin
+                                 ? idb_adapter->dbToStaPin(nodes[child].load_pin)
+                                 : buf_input_pins[child];
+      moveToNet(child_pin, out_net);
+    }
+
+    _timing_engine->insertBuffer(insert_buf->get_name());
   }
+
+  tree.runtime +=
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+          .count();
 }
 
 } // namespace ino
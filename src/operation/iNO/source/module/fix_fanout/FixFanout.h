@@ -16,8 +16,14 @@
 // ***************************************************************************************
 #pragma once
 
+#include <vector>
+
 #include "DbInterface.h"
 
+namespace ista {
+class LibertyCell;
+} // namespace ista
+
 namespace ino {
 using idb::IdbBuilder;
 using idb::IdbCellMaster;
@@ -37,18 +43,40 @@ class FixFanout {
 
   void fixFanout();
 
- private:
-  void checkFanout() {}
+  /**
+   * @brief Buffer tree of a net, built level by level: the nodes of a level are split into
+   * ceil(n / _max_fanout) groups by recursive bisection on the longer side of their bounding
+   * box, each group is driven by a buffer at its centroid, the buffers are the nodes of the
+   * next level, until the net drives no more than _max_fanout nodes.
+   */
+  struct TreeNode {
+    int32_t          x;
+    int32_t          y;
+    IdbPin          *load_pin; // nullptr for buffer
+    std::vector<int> children;
+  };
+  struct FanoutTree {
+    IdbNet               *net;
+    std::vector<TreeNode> nodes; // loads first, then buffers
+    std::vector<int>      roots; // nodes driven by the net
+    int                   fanout = 0;
+    int                   num_io_loads = 0; // io loads are kept on the net
+    int                   depth = 0;        // buffer levels
+    double                runtime = 0.0;    // ms
+  };
 
-  void fixFanout(IdbNet *net);
+  // plan the buffers of the tree whose load nodes are filled, only the node locations are read
+  static void planTree(FanoutTree &tree, int max_fanout);
 
-  IdbNet *makeNet(const char *name);
+ private:
+  void checkFanout() {}
 
-  IdbInstance *makeInstance(string master_name, string inst_name);
+  void buildTree(FanoutTree &tree);
 
-  void disconnectPin(IdbPin *dpin);
+  static void partition(FanoutTree &tree, std::vector<int> &items, int begin, int end,
+                        int num_groups, std::vector<int> &next_items);
 
-  void connect(IdbInstance *dinst, IdbPin *dpin, IdbNet *dnet);
+  void insertTree(FanoutTree &tree, ista::LibertyCell *buffer_cell);
 
   /* data */
   ino::DbInterface *_db_interface;
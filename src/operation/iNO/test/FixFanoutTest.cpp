@@ -0,0 +1,72 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <random>
+#include <vector>
+
+#include "FixFanout.h"
+#include "gtest/gtest.h"
+
+namespace ino {
+
+class FixFanoutTest : public testing::Test {};
+
+TEST_F(FixFanoutTest, planTreePartition) {
+  std::mt19937                           gen(0);
+  std::uniform_int_distribution<int32_t> coord_dist(0, 100000);
+
+  for (int max_fanout : {2, 3, 8, 30}) {
+    for (int num_loads : {1, 2, 31, 100, 1000, 5000}) {
+      for (int num_io_loads : {0, 1}) {
+        FixFanout::FanoutTree tree;
+        tree.num_io_loads = num_io_loads;
+        for (int i = 0; i < num_loads; ++i) {
+          // clustered locations, many loads share a coordinate
+          int32_t x = coord_dist(gen) / (i % 3 == 0 ? 1 : 1000);
+          int32_t y = coord_dist(gen) / (i % 3 == 0 ? 1 : 1000);
+          tree.nodes.push_back({x, y, nullptr, {}});
+        }
+        FixFanout::planTree(tree, max_fanout);
+
+        // every group has at most max_fanout loads, the net drives at most max_fanout nodes
+        std::vector<int> num_drivers(tree.nodes.size(), 0);
+        for (size_t i = num_loads; i < tree.nodes.size(); ++i) {
+          auto &children = tree.nodes[i].children;
+          EXPECT_FALSE(children.empty());
+          EXPECT_LE((int)children.size(), max_fanout);
+          for (int child : children) {
+            ASSERT_LT(child, (int)i);
+            num_drivers[child]++;
+          }
+        }
+        EXPECT_LE((int)tree.roots.size() + num_io_loads, std::max(max_fanout, num_io_loads + 1));
+        for (int root : tree.roots) {
+          num_drivers[root]++;
+        }
+
+        // each node is driven exactly once
+        for (size_t i = 0; i < tree.nodes.size(); ++i) {
+          EXPECT_EQ(num_drivers[i], 1) << "node " << i;
+        }
+        if (num_loads + num_io_loads <= max_fanout) {
+          EXPECT_EQ(tree.depth, 0);
+        }
+      }
+    }
+  }
+}
+
+} // namespace ino
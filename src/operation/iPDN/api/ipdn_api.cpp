@@ -20,6 +20,7 @@
 #include "builder.h"
 #include "idm.h"
 #include "pdn_plan.h"
+#include "pdn_sim.h"
 #include "pdn_via.h"
 
 namespace ipdn {
@@ -144,4 +145,29 @@ bool PdnApi::addSegmentVia(std::string net_name, std::string cut_layer_name, int
   return pdn_via.addSegmentVia(net_name, cut_layer_name, coord_x, coord_y, width, height);
 }
 
+/**
+ * @brief static ir drop analysis of the power and ground nets
+ *
+ * @param instance_power_map total power of each instance, unit is W, e.g. from Power::getInstancePowerMap of iPW
+ * @param supply_voltage unit is V
+ * @param instance_drop_map the drop of each instance on its power and ground nets, unit is V
+ * @param drop_file_path write the instance drops if not empty
+ * @return true if all the nets are solved
+ */
+bool PdnApi::analyzeIRDrop(const std::map<std::string, double>& instance_power_map, double supply_voltage,
+                           std::map<std::string, double>& instance_drop_map, const std::string& drop_file_path)
+{
+  PdnSim pdn_sim;
+  pdn_sim.set_supply_voltage(supply_voltage);
+
+  bool is_success = pdn_sim.analyzeIRDrop(instance_power_map);
+  pdn_sim.reportIRDrop();
+  if (!drop_file_path.empty()) {
+    pdn_sim.writeInstanceDrop(drop_file_path);
+  }
+  instance_drop_map = std::move(pdn_sim.get_instance_drop_map());
+
+  return is_success;
+}
+
 }  // namespace ipdn
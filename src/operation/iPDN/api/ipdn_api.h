@@ -65,6 +65,9 @@ class PdnApi
                      int32_t height);
   bool addSegmentVia(std::string net_name, std::string cut_layer_name, int32_t coord_x, int32_t coord_y, int32_t width, int32_t height);
 
+  bool analyzeIRDrop(const std::map<std::string, double>& instance_power_map, double supply_voltage,
+                     std::map<std::string, double>& instance_drop_map, const std::string& drop_file_path = "");
+
  private:
   static PdnApi* _instance;
 
@@ -16,6 +16,8 @@
 // ***************************************************************************************
 #include "pdn_cut_stripe.h"
 
+#include <algorithm>
+
 #include "IdbEnum.h"
 #include "IdbSpecialNet.h"
 #include "IdbSpecialWire.h"
@@ -764,6 +766,78 @@ bool CutStripe::get_intersect_coordinate(idb::IdbSpecialWireSegment* segment_fir
   }
   return false;
 }
+/**
+ * @brief  find the intersect rects between the stripes of two layers, the bottom stripes are sorted along the axis they are narrow
+ * in, each top stripe only visits the bottom stripes in its range, the rects are ordered by top stripe then bottom stripe
+ * @param  segment_list_top
+ * @param  segment_list_bottom
+ * @param  rect_list
+ */
+void CutStripe::findIntersectRectList(std::vector<idb::IdbSpecialWireSegment*>& segment_list_top,
+                                      std::vector<idb::IdbSpecialWireSegment*>& segment_list_bottom, std::vector<IdbRect>& rect_list)
+{
+  struct StripeRange
+  {
+    int32_t low;
+    int32_t high;
+    size_t index;
+  };
+
+  /// sort by y if the bottom stripes are horizontal
+  int64_t width_sum = 0;
+  int64_t height_sum = 0;
+  for (idb::IdbSpecialWireSegment* segment : segment_list_bottom) {
+    if (segment->is_line()) {
+      width_sum += segment->get_bounding_box()->get_width();
+      height_sum += segment->get_bounding_box()->get_height();
+    }
+  }
+  bool sort_by_y = width_sum >= height_sum;
+  auto get_low = [sort_by_y](IdbRect* rect) { return sort_by_y ? rect->get_low_y() : rect->get_low_x(); };
+  auto get_high = [sort_by_y](IdbRect* rect) { return sort_by_y ? rect->get_high_y() : rect->get_high_x(); };
+
+  std::vector<StripeRange> range_list;
+  range_list.reserve(segment_list_bottom.size());
+  int32_t max_span = 0;
+  for (size_t i = 0; i < segment_list_bottom.size(); ++i) {
+    idb::IdbSpecialWireSegment* segment = segment_list_bottom[i];
+    if (!segment->is_line()) {
+      continue;
+    }
+    IdbRect* rect = segment->get_bounding_box();
+    range_list.push_back({get_low(rect), get_high(rect), i});
+    max_span = std::max(max_span, get_high(rect) - get_low(rect));
+  }
+  std::sort(range_list.begin(), range_list.end(), [](const StripeRange& a, const StripeRange& b) { return a.low < b.low; });
+
+  std::vector<size_t> candidate_list;
+  for (idb::IdbSpecialWireSegment* segment_top : segment_list_top) {
+    if (!segment_top->is_line()) {
+      continue;
+    }
+    int32_t top_low = get_low(segment_top->get_bounding_box());
+    int32_t top_high = get_high(segment_top->get_bounding_box());
+
+    /// the bottom stripes overlap the range have low in [top_low - max_span, top_high]
+    auto iter = std::lower_bound(range_list.begin(), range_list.end(), static_cast<int64_t>(top_low) - max_span,
+                                 [](const StripeRange& range, int64_t value) { return range.low < value; });
+    candidate_list.clear();
+    for (; iter != range_list.end() && iter->low <= top_high; ++iter) {
+      if (iter->high >= top_low) {
+        candidate_list.push_back(iter->index);
+      }
+    }
+    std::sort(candidate_list.begin(), candidate_list.end());
+
+    for (size_t index : candidate_list) {
+      IdbRect coordinate;
+      if (get_intersect_coordinate(segment_top, segment_list_bottom[index], coordinate)) {
+        rect_list.push_back(coordinate);
+      }
+    }
+  }
+}
+
 bool get_intersect_coordinate(idb::IdbSpecialWireSegment* segment_first, idb::IdbSpecialWireSegment* segment_second,
                               idb::IdbCoordinate<int32_t>& intersect_coordinate)
 {
@@ -195,6 +195,8 @@ class CutStripe
                                 idb::IdbRect& intersect_coordinate);
   bool get_intersect_coordinate(idb::IdbSpecialWireSegment* segment_first, idb::IdbSpecialWireSegment* segment_second,
                                 idb::IdbCoordinate<int32_t>& intersect_coordinate);
+  void findIntersectRectList(std::vector<idb::IdbSpecialWireSegment*>& segment_list_top,
+                             std::vector<idb::IdbSpecialWireSegment*>& segment_list_bottom, std::vector<idb::IdbRect>& rect_list);
   bool containLine(idb::IdbSpecialWireSegment* segment_first, idb::IdbCoordinate<int32_t>* start, idb::IdbCoordinate<int32_t>* end);
 
  private:
@@ -16,6 +16,8 @@
 // ***************************************************************************************
 #include "pdn_plan.h"
 
+#include <chrono>
+
 #include "idm.h"
 #include "pdn_via.h"
 
@@ -530,23 +532,54 @@ void PdnPlan::connectLayer(std::string layer_name_first, std::string layer_name_
     return;
   }
 
-  /// connect each net
-  for (IdbSpecialNet* net : idb_pdn_list->get_net_list()) {
-    /// get the routing width and height to find via
-    /// attention : use the given layer top and layer bottom width
-    // int32_t width_top = net->get_layer_width(layer_top->get_name());
-    // int32_t width_bottom = net->get_layer_width(layer_bottom->get_name());
-    // int width = layer_top->is_vertical() ? width_top : width_bottom;
-    // int height = layer_bottom->is_horizontal() ? width_bottom : width_top;
+  auto start = std::chrono::steady_clock::now();
+
+  /// find the cut layers between the 2 layers
+  std::vector<idb::IdbLayerCut*> cut_layer_list;
+  for (int32_t layer_order = layer_bottom->get_order(); layer_order <= (layer_top->get_order() - 2); layer_order += 2) {
+    idb::IdbLayerCut* layer_cut_find = dynamic_cast<idb::IdbLayerCut*>(idb_layer_list->find_layer_by_order(layer_order + 1));
+    if (layer_cut_find == nullptr) {
+      std::cout << "Error : layer input illegal." << std::endl;
+      return;
+    }
+    cut_layer_list.push_back(layer_cut_find);
+  }
 
-    /// find via list that fit the 2 layers for each net
-    std::vector<IdbVia*> via_find_list;
+  /// find the stripes of each wire on the 2 layers
+  std::vector<IdbSpecialNet*> net_list = idb_pdn_list->get_net_list();
+  std::vector<std::vector<WireStripeList>> net_wire_stripe_list(net_list.size());
+  for (size_t i = 0; i < net_list.size(); ++i) {
+    connectTwoLayerForNet(net_list[i], layer_top, layer_bottom, net_wire_stripe_list[i]);
+  }
 
-    connectTwoLayerForNet(net, via_find_list, layer_top, layer_bottom);
-    std::cout << "Success : ConnectTwoLayerForNet " << net->get_net_name() << std::endl;
+  /// the intersections of the wires are independent, the vias are added in the net order after that
+  std::vector<WireStripeList*> wire_stripe_ptr_list;
+  for (auto& wire_stripe_list : net_wire_stripe_list) {
+    for (auto& wire_stripe : wire_stripe_list) {
+      wire_stripe_ptr_list.push_back(&wire_stripe);
+    }
+  }
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < wire_stripe_ptr_list.size(); ++i) {
+    WireStripeList* wire_stripe = wire_stripe_ptr_list[i];
+    _cut_stripe->findIntersectRectList(wire_stripe->segment_list_top, wire_stripe->segment_list_bottom, wire_stripe->intersect_list);
+  }
+  double intersect_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  PdnVia pdn_via;
+  int64_t via_number = 0;
+  for (size_t i = 0; i < net_list.size(); ++i) {
+    int64_t net_via_number = 0;
+    for (auto& wire_stripe : net_wire_stripe_list[i]) {
+      net_via_number += connectTwoLayerForWire(wire_stripe, cut_layer_list, pdn_via);
+    }
+    via_number += net_via_number;
+    std::cout << "Success : ConnectTwoLayerForNet " << net_list[i]->get_net_name() << " via number = " << net_via_number << std::endl;
   }
+  double total_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-  std::cout << "Success : connectTwoLayer " << layer_name_first << " & " << layer_name_second << std::endl;
+  std::cout << "Success : connectTwoLayer " << layer_name_first << " & " << layer_name_second << " via number = " << via_number
+            << " intersect time = " << intersect_time << "s total time = " << total_time << "s" << std::endl;
 }
 
 void PdnPlan::updateRouteMap()
@@ -576,15 +609,15 @@ void PdnPlan::updateRouteMap()
 }
 
 /**
- * @brief Connect power lines on different layers of the same specialnet
+ * @brief Find the power lines on different layers of the same specialnet
  *
  * @param net
- * @param via_list
  * @param layer_top
  * @param layer_bottom
+ * @param wire_stripe_list
  */
-void PdnPlan::connectTwoLayerForNet(idb::IdbSpecialNet* net, std::vector<idb::IdbVia*>& via_list, idb::IdbLayerRouting* layer_top,
-                                    idb::IdbLayerRouting* layer_bottom)
+void PdnPlan::connectTwoLayerForNet(idb::IdbSpecialNet* net, idb::IdbLayerRouting* layer_top, idb::IdbLayerRouting* layer_bottom,
+                                    std::vector<WireStripeList>& wire_stripe_list)
 {
   /// find wire list which this net has
   idb::IdbSpecialWireList* wire_list = net->get_wire_list();
@@ -594,93 +627,56 @@ void PdnPlan::connectTwoLayerForNet(idb::IdbSpecialNet* net, std::vector<idb::Id
   }
   /// find all wire segment belong to layer_top and layer_bottom
   for (idb::IdbSpecialWire* wire : wire_list->get_wire_list()) {
-    std::vector<idb::IdbSpecialWireSegment*> segment_list_top;
-    std::vector<idb::IdbSpecialWireSegment*> segment_list_bottom;
+    WireStripeList wire_stripe;
+    wire_stripe.wire = wire;
     for (idb::IdbSpecialWireSegment* segment : wire->get_segment_list()) {
       if (segment->is_tripe() || segment->is_follow_pin()) {
         if (segment->get_layer()->compareLayer(layer_top)) {
-          segment_list_top.emplace_back(segment);
+          wire_stripe.segment_list_top.emplace_back(segment);
         }
 
         if (segment->get_layer()->compareLayer(layer_bottom)) {
-          segment_list_bottom.emplace_back(segment);
+          wire_stripe.segment_list_bottom.emplace_back(segment);
         }
       }
     }
 
-    std::cout << net->get_net_name() << " Finish construct segment list" << std::endl;
-
-    connectTwoLayerForWire(wire, via_list, segment_list_top, segment_list_bottom);
+    if (wire_stripe.segment_list_top.size() > 0 && wire_stripe.segment_list_bottom.size() > 0) {
+      wire_stripe_list.emplace_back(std::move(wire_stripe));
+    }
   }
 }
 
 /**
- * @brief Connect power line segments of the same wire on different layers
+ * @brief Connect power line segments of the same wire on different layers by the vias on the intersect rects
  *
- * @param wire
- * @param via_list
- * @param segment_list_top
- * @param segment_list_bottom
+ * @param wire_stripe
+ * @param cut_layer_list
+ * @param pdn_via
+ * @return the number of vias added
  */
-void PdnPlan::connectTwoLayerForWire(idb::IdbSpecialWire* wire, std::vector<idb::IdbVia*>& via_list,
-                                     std::vector<idb::IdbSpecialWireSegment*>& segment_list_top,
-                                     std::vector<idb::IdbSpecialWireSegment*>& segment_list_bottom)
+int32_t PdnPlan::connectTwoLayerForWire(WireStripeList& wire_stripe, std::vector<idb::IdbLayerCut*>& cut_layer_list, PdnVia& pdn_via)
 {
-  if (segment_list_top.size() <= 0 || segment_list_bottom.size() <= 0) {
-    return;
-  }
-
-  auto idb_layout = dmInst->get_idb_layout();
-  auto idb_layer_list = idb_layout->get_layers();
-  PdnVia pdn_via;
-  int number = 0;
-
-  idb::IdbLayerRouting* layer_bottom_routing
-      = dynamic_cast<idb::IdbLayerRouting*>(idb_layer_list->find_layer(segment_list_bottom[0]->get_layer()->get_name()));
-  idb::IdbLayerRouting* layer_top_routing
-      = dynamic_cast<idb::IdbLayerRouting*>(idb_layer_list->find_layer(segment_list_top[0]->get_layer()->get_name()));
-  for (idb::IdbSpecialWireSegment* segment_top : segment_list_top) {
-    for (idb::IdbSpecialWireSegment* segment_bottom : segment_list_bottom) {
-      /// calculate intersection between layer stripe
-      idb::IdbRect coordinate;
-      // if (segment_top->get_intersect_coordinate(segment_bottom, coordinate))
-      // {
-      if (_cut_stripe->get_intersect_coordinate(segment_top, segment_bottom, coordinate)) {
-        // for (IdbVia *via : via_list) {
-        // IdbLayer *             layer_top =
-        // via->get_top_layer_shape().get_layer();
-        for (int32_t layer_order = layer_bottom_routing->get_order(); layer_order <= (layer_top_routing->get_order() - 2);) {
-          // int32_t layer_order_bottom = layer_bottom_routing->get_order();
-          idb::IdbLayerCut* layer_cut_find = dynamic_cast<idb::IdbLayerCut*>(idb_layer_list->find_layer_by_order(layer_order + 1));
-          if (layer_cut_find == nullptr) {
-            std::cout << "Error : layer input illegal." << std::endl;
-            return;
-          }
-          //   IdbVia *via_find = via_listt->find_via_generate(
-          //       layer_cut_find, coordinate.get_width(),
-          //       coordinate.get_height());
-          idb::IdbVia* via_find = pdn_via.findVia(layer_cut_find, coordinate.get_width(), coordinate.get_height());
-          if (via_find == nullptr) {
-            std::cout << "Error : can not find VIA matchs." << std::endl;
-            continue;
-          }
-          idb::IdbLayer* layer_top = via_find->get_top_layer_shape().get_layer();
-          idb::IdbCoordinate<int32_t> middle = coordinate.get_middle_point();
-          idb::IdbSpecialWireSegment* segment_via
-              = pdn_via.createSpecialWireVia(layer_top, 0, idb::IdbWireShapeType::kStripe, &middle, via_find);
-          wire->add_segment(segment_via);
-          number++;
-
-          if (number % 10000 == 0) {
-            std::cout << "-";
-          }
-          layer_order += 2;
-          // }
-        }
+  int32_t number = 0;
+  for (idb::IdbRect& coordinate : wire_stripe.intersect_list) {
+    for (idb::IdbLayerCut* layer_cut_find : cut_layer_list) {
+      idb::IdbVia* via_find = pdn_via.findVia(layer_cut_find, coordinate.get_width(), coordinate.get_height());
+      if (via_find == nullptr) {
+        std::cout << "Error : can not find VIA matchs." << std::endl;
+        continue;
       }
+      idb::IdbLayer* layer_top = via_find->get_top_layer_shape().get_layer();
+      idb::IdbCoordinate<int32_t> middle = coordinate.get_middle_point();
+      idb::IdbSpecialWireSegment* segment_via
+          = pdn_via.createSpecialWireVia(layer_top, 0, idb::IdbWireShapeType::kStripe, &middle, via_find);
+      wire_stripe.wire->add_segment(segment_via);
+      number++;
     }
   }
-  std::cout << std::endl << "Finish add_segment number = " << number << std::endl;
+  /// release the intersect rects once the vias are added
+  std::vector<idb::IdbRect>().swap(wire_stripe.intersect_list);
+
+  return number;
 }
 
 /**
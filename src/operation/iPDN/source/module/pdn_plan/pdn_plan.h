@@ -46,6 +46,8 @@ class IdbCoordinate;
 
 namespace ipdn {
 
+class PdnVia;
+
 class PdnPlan
 {
  public:
@@ -100,12 +102,19 @@ class PdnPlan
   std::map<std::string, std::vector<idb::IdbRect>> mergeOverlapRect(idb::IdbPin* pin);
   std::vector<idb::IdbRect> mergeOverlapRect(std::vector<idb::IdbRect*> rect_list);
 
-  void connectTwoLayerForNet(idb::IdbSpecialNet* net, std::vector<idb::IdbVia*>& via_list, idb::IdbLayerRouting* layer_top,
-                             idb::IdbLayerRouting* layer_bottom);
+  /// the stripes of a wire on the two layers to be connected, and the intersect rects between them
+  struct WireStripeList
+  {
+    idb::IdbSpecialWire* wire;
+    std::vector<idb::IdbSpecialWireSegment*> segment_list_top;
+    std::vector<idb::IdbSpecialWireSegment*> segment_list_bottom;
+    std::vector<idb::IdbRect> intersect_list;
+  };
+
+  void connectTwoLayerForNet(idb::IdbSpecialNet* net, idb::IdbLayerRouting* layer_top, idb::IdbLayerRouting* layer_bottom,
+                             std::vector<WireStripeList>& wire_stripe_list);
 
-  void connectTwoLayerForWire(idb::IdbSpecialWire* wire, std::vector<idb::IdbVia*>& via_list,
-                              std::vector<idb::IdbSpecialWireSegment*>& segment_list_top,
-                              std::vector<idb::IdbSpecialWireSegment*>& segment_list_bottom);
+  int32_t connectTwoLayerForWire(WireStripeList& wire_stripe, std::vector<idb::IdbLayerCut*>& cut_layer_list, PdnVia& pdn_via);
 };
 
 }  // namespace ipdn
\ No newline at end of file
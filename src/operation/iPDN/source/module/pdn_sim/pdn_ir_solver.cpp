@@ -0,0 +1,167 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include "pdn_ir_solver.h"
+
+#include <omp.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace ipdn {
+
+PdnIRSolver::PdnIRSolver(int32_t num_nodes) : _num_nodes(num_nodes)
+{
+  _current_list.resize(num_nodes, 0.0);
+  _diagonal_list.resize(num_nodes, 0.0);
+}
+
+void PdnIRSolver::addConductance(int32_t node_first, int32_t node_second, double conductance)
+{
+  if (node_first == node_second || conductance <= 0.0) {
+    return;
+  }
+  if (node_first != kFixedNode) {
+    _diagonal_list[node_first] += conductance;
+  }
+  if (node_second != kFixedNode) {
+    _diagonal_list[node_second] += conductance;
+  }
+  if (node_first != kFixedNode && node_second != kFixedNode) {
+    _resistor_list.push_back({node_first, node_second, conductance});
+  }
+}
+
+/**
+ * @brief build the CSR of the off diagonal entries, each resistor is stored in both rows, the parallel resistors are kept as they are.
+ */
+void PdnIRSolver::buildMatrix()
+{
+  _row_offset_list.assign(_num_nodes + 1, 0);
+  for (const Resistor& resistor : _resistor_list) {
+    ++_row_offset_list[resistor.node_first + 1];
+    ++_row_offset_list[resistor.node_second + 1];
+  }
+  for (int32_t i = 0; i < _num_nodes; ++i) {
+    _row_offset_list[i + 1] += _row_offset_list[i];
+  }
+
+  _column_list.resize(_row_offset_list[_num_nodes]);
+  _value_list.resize(_row_offset_list[_num_nodes]);
+  std::vector<int64_t> fill_list(_row_offset_list.begin(), _row_offset_list.end() - 1);
+  for (const Resistor& resistor : _resistor_list) {
+    int64_t first_index = fill_list[resistor.node_first]++;
+    _column_list[first_index] = resistor.node_second;
+    _value_list[first_index] = -resistor.conductance;
+    int64_t second_index = fill_list[resistor.node_second]++;
+    _column_list[second_index] = resistor.node_first;
+    _value_list[second_index] = -resistor.conductance;
+  }
+  std::vector<Resistor>().swap(_resistor_list);
+}
+
+void PdnIRSolver::multiply(const std::vector<double>& x, std::vector<double>& y)
+{
+#pragma omp parallel for schedule(static)
+  for (int32_t i = 0; i < _num_nodes; ++i) {
+    double sum = _diagonal_list[i] * x[i];
+    for (int64_t j = _row_offset_list[i]; j < _row_offset_list[i + 1]; ++j) {
+      sum += _value_list[j] * x[_column_list[j]];
+    }
+    y[i] = sum;
+  }
+}
+
+/**
+ * @brief solve the drop of each node
+ *
+ * @param drop_list the drop of each node, unit is the current unit times the resistance unit
+ * @param tolerance the relative residual to stop
+ * @param max_iteration
+ * @return true if the residual reaches the tolerance
+ */
+bool PdnIRSolver::solve(std::vector<double>& drop_list, double tolerance, int32_t max_iteration)
+{
+  auto start = std::chrono::steady_clock::now();
+  buildMatrix();
+
+  int32_t n = _num_nodes;
+  drop_list.assign(n, 0.0);
+  std::vector<double> residual_list(_current_list);
+  std::vector<double> precond_list(n);
+  std::vector<double> direction_list(n);
+  std::vector<double> product_list(n);
+
+  double rhs_norm = 0.0;
+  double rz = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : rhs_norm, rz)
+  for (int32_t i = 0; i < n; ++i) {
+    precond_list[i] = residual_list[i] / _diagonal_list[i];
+    direction_list[i] = precond_list[i];
+    rhs_norm += residual_list[i] * residual_list[i];
+    rz += residual_list[i] * precond_list[i];
+  }
+  rhs_norm = std::sqrt(rhs_norm);
+
+  _solve_stats = SolveStats();
+  bool is_converged = rhs_norm == 0.0;
+  int32_t iteration = 0;
+  while (!is_converged && iteration < max_iteration) {
+    ++iteration;
+    multiply(direction_list, product_list);
+
+    double p_ap = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : p_ap)
+    for (int32_t i = 0; i < n; ++i) {
+      p_ap += direction_list[i] * product_list[i];
+    }
+    double alpha = rz / p_ap;
+
+    double residual_norm = 0.0;
+    double rz_new = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : residual_norm, rz_new)
+    for (int32_t i = 0; i < n; ++i) {
+      drop_list[i] += alpha * direction_list[i];
+      residual_list[i] -= alpha * product_list[i];
+      precond_list[i] = residual_list[i] / _diagonal_list[i];
+      residual_norm += residual_list[i] * residual_list[i];
+      rz_new += residual_list[i] * precond_list[i];
+    }
+    _solve_stats.residual = std::sqrt(residual_norm) / rhs_norm;
+    if (_solve_stats.residual <= tolerance) {
+      is_converged = true;
+      break;
+    }
+
+    double beta = rz_new / rz;
+    rz = rz_new;
+#pragma omp parallel for schedule(static)
+    for (int32_t i = 0; i < n; ++i) {
+      direction_list[i] = precond_list[i] + beta * direction_list[i];
+    }
+  }
+
+  _solve_stats.iterations = iteration;
+  _solve_stats.runtime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (!is_converged) {
+    std::cout << "[iPDN warning]: IR solver does not converge, iterations = " << iteration << " residual = " << _solve_stats.residual
+              << std::endl;
+  }
+  return is_converged;
+}
+
+}  // namespace ipdn
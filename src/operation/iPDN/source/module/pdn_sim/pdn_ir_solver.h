@@ -0,0 +1,77 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ipdn {
+/**
+ * @brief Solve the static drop of a resistive mesh, G * drop = I, by the conjugate gradient with jacobi preconditioner.
+ *
+ * The nodes connected to a fixed node (the pad) have drop 0 on the fixed node side, so G is symmetric positive definite as long as
+ * every node reaches a pad. The matrix is kept in CSR with the diagonal stored alone, the memory is linear to the resistor number.
+ */
+class PdnIRSolver
+{
+ public:
+  static constexpr int32_t kFixedNode = -1;
+
+  struct SolveStats
+  {
+    int32_t iterations = 0;
+    double residual = 0.0;  /// relative residual |b - Ax| / |b|
+    double runtime = 0.0;   /// s
+  };
+
+  explicit PdnIRSolver(int32_t num_nodes);
+  ~PdnIRSolver() = default;
+
+  /// node_second is kFixedNode for the resistor to a pad
+  void addConductance(int32_t node_first, int32_t node_second, double conductance);
+  void addCurrent(int32_t node, double current) { _current_list[node] += current; }
+
+  bool solve(std::vector<double>& drop_list, double tolerance = 1e-8, int32_t max_iteration = 20000);
+
+  int32_t get_num_nodes() const { return _num_nodes; }
+  const SolveStats& get_solve_stats() const { return _solve_stats; }
+
+ private:
+  struct Resistor
+  {
+    int32_t node_first;
+    int32_t node_second;
+    double conductance;
+  };
+
+  void buildMatrix();
+  void multiply(const std::vector<double>& x, std::vector<double>& y);
+
+  int32_t _num_nodes;
+  std::vector<Resistor> _resistor_list;
+  std::vector<double> _current_list;
+
+  /// off diagonal of G in CSR, the values are the negative conductance
+  std::vector<int64_t> _row_offset_list;
+  std::vector<int32_t> _column_list;
+  std::vector<double> _value_list;
+  std::vector<double> _diagonal_list;
+
+  SolveStats _solve_stats;
+};
+
+}  // namespace ipdn
@@ -0,0 +1,559 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include "pdn_sim.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+
+#include "idm.h"
+#include "pdn_ir_solver.h"
+#include "usage/usage.hh"
+
+namespace ipdn {
+
+namespace {
+
+int32_t findRoot(std::vector<int32_t>& parent_list, int32_t node)
+{
+  while (parent_list[node] != node) {
+    parent_list[node] = parent_list[parent_list[node]];
+    node = parent_list[node];
+  }
+  return node;
+}
+
+void unionNode(std::vector<int32_t>& parent_list, int32_t node_first, int32_t node_second)
+{
+  int32_t root_first = findRoot(parent_list, node_first);
+  int32_t root_second = findRoot(parent_list, node_second);
+  if (root_first != root_second) {
+    parent_list[std::max(root_first, root_second)] = std::min(root_first, root_second);
+  }
+}
+
+}  // namespace
+
+void PdnSim::clear()
+{
+  std::vector<MeshSegment>().swap(_segment_list);
+  _layer_index_map.clear();
+}
+
+double PdnSim::calcSheetResistance(idb::IdbLayerRouting* layer)
+{
+  double sheet_resistance = layer->get_resistance();
+  return sheet_resistance > 0.0 ? sheet_resistance : _default_sheet_resistance;
+}
+
+/**
+ * @brief analyze the ir drop of all the power and ground nets
+ *
+ * @param instance_power_map
+ * @return true if all the nets are solved
+ */
+bool PdnSim::analyzeIRDrop(const std::map<std::string, double>& instance_power_map)
+{
+  _instance_drop_map.clear();
+  _stats_list.clear();
+
+  auto idb_design = dmInst->get_idb_design();
+  bool is_success = true;
+  for (idb::IdbSpecialNet* net : idb_design->get_special_net_list()->get_net_list()) {
+    if (!net->is_vdd() && !net->is_vss()) {
+      continue;
+    }
+    is_success &= analyzeIRDrop(net, instance_power_map);
+  }
+  return is_success;
+}
+
+/**
+ * @brief extract the stripes and follow pins of the net, the end points are the first nodes of each stripe
+ *
+ * @param net
+ */
+void PdnSim::extractSegment(idb::IdbSpecialNet* net)
+{
+  for (idb::IdbSpecialWire* wire : net->get_wire_list()->get_wire_list()) {
+    for (idb::IdbSpecialWireSegment* segment : wire->get_segment_list()) {
+      if (segment->is_via() || !segment->is_line()) {
+        continue;
+      }
+      auto* layer = dynamic_cast<idb::IdbLayerRouting*>(segment->get_layer());
+      if (layer == nullptr) {
+        continue;
+      }
+      idb::IdbCoordinate<int32_t>* start = segment->get_point_start();
+      idb::IdbCoordinate<int32_t>* end = segment->get_point_second();
+      bool is_horizontal = start->get_y() == end->get_y();
+      bool is_vertical = start->get_x() == end->get_x();
+      if (is_horizontal == is_vertical) {
+        /// zero length or not orthogonal
+        continue;
+      }
+
+      MeshSegment mesh_segment;
+      mesh_segment.layer_order = layer->get_order();
+      mesh_segment.is_horizontal = is_horizontal;
+      mesh_segment.track = is_horizontal ? start->get_y() : start->get_x();
+      mesh_segment.low = is_horizontal ? std::min(start->get_x(), end->get_x()) : std::min(start->get_y(), end->get_y());
+      mesh_segment.high = is_horizontal ? std::max(start->get_x(), end->get_x()) : std::max(start->get_y(), end->get_y());
+      mesh_segment.width = segment->get_route_width() > 0 ? segment->get_route_width() : layer->get_width();
+      mesh_segment.sheet_resistance = calcSheetResistance(layer);
+      mesh_segment.pos_list = {mesh_segment.low, mesh_segment.high};
+
+      int32_t segment_id = _segment_list.size();
+      LayerIndex& layer_index = _layer_index_map[mesh_segment.layer_order];
+      if (is_horizontal) {
+        layer_index.horizontal_map.emplace(mesh_segment.track, segment_id);
+      } else {
+        layer_index.vertical_map.emplace(mesh_segment.track, segment_id);
+      }
+      layer_index.max_half_width = std::max(layer_index.max_half_width, (mesh_segment.width + 1) / 2);
+      _segment_list.push_back(std::move(mesh_segment));
+    }
+  }
+}
+
+/**
+ * @brief find the segments of the layer covering the point
+ *
+ * @param layer_order
+ * @param x
+ * @param y
+ * @return the node refs on the center line of the segments
+ */
+std::vector<PdnSim::NodeRef> PdnSim::findContainSegmentList(int32_t layer_order, int32_t x, int32_t y)
+{
+  std::vector<NodeRef> node_ref_list;
+  auto layer_iter = _layer_index_map.find(layer_order);
+  if (layer_iter == _layer_index_map.end()) {
+    return node_ref_list;
+  }
+  LayerIndex& layer_index = layer_iter->second;
+
+  auto find_in_map = [&](std::multimap<int32_t, int32_t>& track_map, int32_t track_coord, int32_t pos) {
+    auto iter = track_map.lower_bound(track_coord - layer_index.max_half_width);
+    for (; iter != track_map.end() && iter->first <= track_coord + layer_index.max_half_width; ++iter) {
+      MeshSegment& segment = _segment_list[iter->second];
+      if (std::abs(track_coord - segment.track) <= (segment.width + 1) / 2 && segment.low <= pos && pos <= segment.high) {
+        node_ref_list.push_back({iter->second, pos});
+      }
+    }
+  };
+  find_in_map(layer_index.horizontal_map, y, x);
+  find_in_map(layer_index.vertical_map, x, y);
+
+  return node_ref_list;
+}
+
+/**
+ * @brief find the segment of the layer nearest to the point, the distance is manhattan
+ *
+ * @param layer_order
+ * @param x
+ * @param y
+ * @param node_ref the nearest point on the center line
+ * @return true if the layer has segment
+ */
+bool PdnSim::findNearestSegment(int32_t layer_order, int32_t x, int32_t y, NodeRef& node_ref)
+{
+  auto layer_iter = _layer_index_map.find(layer_order);
+  if (layer_iter == _layer_index_map.end()) {
+    return false;
+  }
+  LayerIndex& layer_index = layer_iter->second;
+
+  int64_t min_distance = std::numeric_limits<int64_t>::max();
+  auto check_segment = [&](int32_t segment_id, int32_t track_coord, int32_t pos) {
+    MeshSegment& segment = _segment_list[segment_id];
+    int32_t clamp_pos = std::clamp(pos, segment.low, segment.high);
+    int64_t distance = std::abs(static_cast<int64_t>(track_coord) - segment.track) + std::abs(static_cast<int64_t>(pos) - clamp_pos);
+    if (distance < min_distance) {
+      min_distance = distance;
+      node_ref = {segment_id, clamp_pos};
+    }
+  };
+  /// walk the tracks away from the point until the track distance is larger than the nearest one
+  auto find_in_map = [&](std::multimap<int32_t, int32_t>& track_map, int32_t track_coord, int32_t pos) {
+    auto lower = track_map.lower_bound(track_coord);
+    for (auto iter = lower; iter != track_map.end() && iter->first - static_cast<int64_t>(track_coord) < min_distance; ++iter) {
+      check_segment(iter->second, track_coord, pos);
+    }
+    for (auto iter = lower; iter != track_map.begin();) {
+      --iter;
+      if (static_cast<int64_t>(track_coord) - iter->first >= min_distance) {
+        break;
+      }
+      check_segment(iter->second, track_coord, pos);
+    }
+  };
+  find_in_map(layer_index.horizontal_map, y, x);
+  find_in_map(layer_index.vertical_map, x, y);
+
+  return min_distance != std::numeric_limits<int64_t>::max();
+}
+
+int64_t PdnSim::findNode(const NodeRef& node_ref)
+{
+  MeshSegment& segment = _segment_list[node_ref.segment_id];
+  auto iter = std::lower_bound(segment.pos_list.begin(), segment.pos_list.end(), node_ref.pos);
+  return segment.node_offset + (iter - segment.pos_list.begin());
+}
+
+/**
+ * @brief analyze the ir drop of one net, the drop of the instances is added to the instance drop map
+ *
+ * @param net
+ * @param instance_power_map
+ * @return true if the mesh is solved
+ */
+bool PdnSim::analyzeIRDrop(idb::IdbSpecialNet* net, const std::map<std::string, double>& instance_power_map)
+{
+  ieda::Stats ir_status;
+  auto start = std::chrono::steady_clock::now();
+
+  IRStats ir_stats;
+  ir_stats.net_name = net->get_net_name();
+
+  clear();
+  extractSegment(net);
+  if (_segment_list.empty()) {
+    std::cout << "[iPDN warning]: no stripe in net " << net->get_net_name() << std::endl;
+    return false;
+  }
+
+  /// the segments ending on other segments of the same layer
+  std::vector<std::pair<NodeRef, NodeRef>> short_list;
+  for (int32_t segment_id = 0; segment_id < static_cast<int32_t>(_segment_list.size()); ++segment_id) {
+    for (int32_t end_pos : {_segment_list[segment_id].low, _segment_list[segment_id].high}) {
+      MeshSegment& segment = _segment_list[segment_id];
+      int32_t x = segment.is_horizontal ? end_pos : segment.track;
+      int32_t y = segment.is_horizontal ? segment.track : end_pos;
+      for (NodeRef& node_ref : findContainSegmentList(segment.layer_order, x, y)) {
+        if (node_ref.segment_id != segment_id) {
+          addNode(node_ref);
+          short_list.push_back({{segment_id, end_pos}, node_ref});
+        }
+      }
+    }
+  }
+
+  /// vias
+  struct ViaConnection
+  {
+    NodeRef bottom;
+    NodeRef top;
+    double conductance;
+  };
+  std::vector<ViaConnection> via_list;
+  for (idb::IdbSpecialWire* wire : net->get_wire_list()->get_wire_list()) {
+    for (idb::IdbSpecialWireSegment* segment : wire->get_segment_list()) {
+      if (!segment->is_via() || segment->get_via() == nullptr) {
+        continue;
+      }
+      idb::IdbVia* via = segment->get_via();
+      idb::IdbCoordinate<int32_t>* coord = via->get_coordinate();
+      idb::IdbLayer* layer_bottom = via->get_bottom_layer_shape().get_layer();
+      idb::IdbLayer* layer_top = via->get_top_layer_shape().get_layer();
+      ir_stats.num_vias++;
+      if (coord == nullptr || layer_bottom == nullptr || layer_top == nullptr) {
+        ir_stats.num_dangling_vias++;
+        continue;
+      }
+      auto bottom_list = findContainSegmentList(layer_bottom->get_order(), coord->get_x(), coord->get_y());
+      auto top_list = findContainSegmentList(layer_top->get_order(), coord->get_x(), coord->get_y());
+      if (bottom_list.empty() || top_list.empty()) {
+        ir_stats.num_dangling_vias++;
+        continue;
+      }
+      int32_t num_cuts = std::max(1u, via->get_cut_layer_shape().get_rect_list_num());
+      addNode(bottom_list[0]);
+      addNode(top_list[0]);
+      via_list.push_back({bottom_list[0], top_list[0], num_cuts / _via_resistance});
+    }
+  }
+
+  /// pads on the io pins, or on the end points of the top layer stripes if the net has no io pin
+  std::vector<NodeRef> pad_list;
+  if (net->get_io_pin_list() != nullptr) {
+    for (idb::IdbPin* pin : net->get_io_pin_list()->get_pin_list()) {
+      for (idb::IdbLayerShape* layer_shape : pin->get_port_box_list()) {
+        idb::IdbLayer* layer = layer_shape->get_layer();
+        if (layer == nullptr || !layer->is_routing()) {
+          continue;
+        }
+        for (idb::IdbRect* rect : layer_shape->get_rect_list()) {
+          NodeRef node_ref;
+          if (!findNearestSegment(layer->get_order(), rect->get_middle_point_x(), rect->get_middle_point_y(), node_ref)) {
+            continue;
+          }
+          MeshSegment& segment = _segment_list[node_ref.segment_id];
+          int32_t x = segment.is_horizontal ? node_ref.pos : segment.track;
+          int32_t y = segment.is_horizontal ? segment.track : node_ref.pos;
+          int32_t half_width = (segment.width + 1) / 2;
+          if (rect->get_low_x() - half_width <= x && x <= rect->get_high_x() + half_width && rect->get_low_y() - half_width <= y
+              && y <= rect->get_high_y() + half_width) {
+            addNode(node_ref);
+            pad_list.push_back(node_ref);
+          }
+        }
+      }
+    }
+  }
+  if (pad_list.empty()) {
+    int32_t top_layer_order = _layer_index_map.rbegin()->first;
+    std::cout << "[iPDN info]: no io pin on the stripes of " << net->get_net_name() << ", use the stripe ends of the top layer as pads"
+              << std::endl;
+    for (int32_t segment_id = 0; segment_id < static_cast<int32_t>(_segment_list.size()); ++segment_id) {
+      if (_segment_list[segment_id].layer_order == top_layer_order) {
+        pad_list.push_back({segment_id, _segment_list[segment_id].low});
+        pad_list.push_back({segment_id, _segment_list[segment_id].high});
+      }
+    }
+  }
+
+  /// instance taps on the lowest layer
+  struct Tap
+  {
+    NodeRef node_ref;
+    double current;
+    idb::IdbInstance* instance;
+  };
+  std::vector<Tap> tap_list;
+  int32_t bottom_layer_order = _layer_index_map.begin()->first;
+  auto add_instance_taps = [&](idb::IdbInstance* instance, std::vector<idb::IdbPin*>& pin_list) {
+    if (pin_list.empty()) {
+      return;
+    }
+    auto power_iter = instance_power_map.find(instance->get_name());
+    double power = power_iter != instance_power_map.end() ? power_iter->second : 0.0;
+    double current = power / _supply_voltage / pin_list.size();
+    for (idb::IdbPin* pin : pin_list) {
+      NodeRef node_ref;
+      idb::IdbCoordinate<int32_t>* coord = pin->get_average_coordinate();
+      if (coord != nullptr && findNearestSegment(bottom_layer_order, coord->get_x(), coord->get_y(), node_ref)) {
+        addNode(node_ref);
+        tap_list.push_back({node_ref, current, instance});
+      }
+    }
+  };
+  if (net->get_instance_pin_list() != nullptr && net->get_instance_pin_list()->get_pin_num() > 0) {
+    std::map<idb::IdbInstance*, std::vector<idb::IdbPin*>> instance_pin_map;
+    for (idb::IdbPin* pin : net->get_instance_pin_list()->get_pin_list()) {
+      if (pin->get_instance() != nullptr) {
+        instance_pin_map[pin->get_instance()].push_back(pin);
+      }
+    }
+    for (auto& [instance, pin_list] : instance_pin_map) {
+      add_instance_taps(instance, pin_list);
+    }
+  } else {
+    /// the pins are connected by name in global connect
+    std::set<std::string> pin_name_set(net->get_pin_string_list().begin(), net->get_pin_string_list().end());
+    for (idb::IdbInstance* instance : dmInst->get_idb_design()->get_instance_list()->get_instance_list()) {
+      std::vector<idb::IdbPin*> pin_list;
+      for (idb::IdbPin* pin : instance->get_pin_list()->get_pin_list()) {
+        if (pin->get_special_net() == net || pin_name_set.count(pin->get_pin_name()) > 0) {
+          pin_list.push_back(pin);
+        }
+      }
+      add_instance_taps(instance, pin_list);
+    }
+  }
+
+  /// number the nodes of each segment along the segment
+  int64_t num_nodes = 0;
+  for (MeshSegment& segment : _segment_list) {
+    std::sort(segment.pos_list.begin(), segment.pos_list.end());
+    segment.pos_list.erase(std::unique(segment.pos_list.begin(), segment.pos_list.end()), segment.pos_list.end());
+    segment.node_offset = num_nodes;
+    num_nodes += segment.pos_list.size();
+  }
+  if (num_nodes > std::numeric_limits<int32_t>::max()) {
+    std::cout << "[iPDN error]: too many nodes in net " << net->get_net_name() << std::endl;
+    return false;
+  }
+
+  /// merge the shorted nodes to mesh nodes
+  std::vector<int32_t> parent_list(num_nodes);
+  std::iota(parent_list.begin(), parent_list.end(), 0);
+  for (auto& [node_ref_first, node_ref_second] : short_list) {
+    unionNode(parent_list, findNode(node_ref_first), findNode(node_ref_second));
+  }
+  std::vector<int32_t> mesh_node_list(num_nodes);
+  int32_t num_mesh_nodes = 0;
+  for (int64_t node = 0; node < num_nodes; ++node) {
+    int32_t root = findRoot(parent_list, node);
+    mesh_node_list[node] = root == node ? num_mesh_nodes++ : mesh_node_list[root];
+  }
+  auto to_mesh_node = [&](const NodeRef& node_ref) { return mesh_node_list[findNode(node_ref)]; };
+
+  /// resistors of the stripes and vias
+  struct Resistor
+  {
+    int32_t node_first;
+    int32_t node_second;
+    double conductance;
+  };
+  std::vector<Resistor> resistor_list;
+  for (MeshSegment& segment : _segment_list) {
+    for (size_t i = 1; i < segment.pos_list.size(); ++i) {
+      double length = segment.pos_list[i] - segment.pos_list[i - 1];
+      double conductance = segment.width / (segment.sheet_resistance * length);
+      resistor_list.push_back({mesh_node_list[segment.node_offset + i - 1], mesh_node_list[segment.node_offset + i], conductance});
+    }
+  }
+  for (ViaConnection& via_connection : via_list) {
+    resistor_list.push_back({to_mesh_node(via_connection.bottom), to_mesh_node(via_connection.top), via_connection.conductance});
+  }
+
+  /// the nodes not connected to any pad are floating, they are not solved
+  std::vector<bool> is_pad_list(num_mesh_nodes, false);
+  for (NodeRef& node_ref : pad_list) {
+    is_pad_list[to_mesh_node(node_ref)] = true;
+  }
+  std::vector<int32_t> component_list(num_mesh_nodes);
+  std::iota(component_list.begin(), component_list.end(), 0);
+  for (Resistor& resistor : resistor_list) {
+    unionNode(component_list, resistor.node_first, resistor.node_second);
+  }
+  std::vector<bool> is_grounded_list(num_mesh_nodes, false);
+  for (int32_t node = 0; node < num_mesh_nodes; ++node) {
+    if (is_pad_list[node]) {
+      is_grounded_list[findRoot(component_list, node)] = true;
+    }
+  }
+  std::vector<int32_t> unknown_list(num_mesh_nodes, PdnIRSolver::kFixedNode);
+  int32_t num_unknowns = 0;
+  for (int32_t node = 0; node < num_mesh_nodes; ++node) {
+    if (!is_pad_list[node] && is_grounded_list[findRoot(component_list, node)]) {
+      unknown_list[node] = num_unknowns++;
+    }
+  }
+
+  PdnIRSolver ir_solver(num_unknowns);
+  for (Resistor& resistor : resistor_list) {
+    if (!is_grounded_list[findRoot(component_list, resistor.node_first)]) {
+      continue;
+    }
+    ir_solver.addConductance(unknown_list[resistor.node_first], unknown_list[resistor.node_second], resistor.conductance);
+  }
+  for (Tap& tap : tap_list) {
+    int32_t unknown = unknown_list[to_mesh_node(tap.node_ref)];
+    if (unknown != PdnIRSolver::kFixedNode) {
+      ir_solver.addCurrent(unknown, tap.current);
+    }
+  }
+  ir_stats.num_nodes = num_mesh_nodes;
+  ir_stats.num_resistors = resistor_list.size();
+  ir_stats.num_pads = std::count(is_pad_list.begin(), is_pad_list.end(), true);
+  ir_stats.num_taps = tap_list.size();
+  std::vector<Resistor>().swap(resistor_list);
+  ir_stats.extract_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::vector<double> drop_list;
+  bool is_converged = ir_solver.solve(drop_list);
+  ir_stats.iterations = ir_solver.get_solve_stats().iterations;
+  ir_stats.residual = ir_solver.get_solve_stats().residual;
+  ir_stats.solve_time = ir_solver.get_solve_stats().runtime;
+
+  /// the drop of an instance on this net is the max drop of its pins
+  std::unordered_map<idb::IdbInstance*, double> instance_drop_map;
+  double drop_sum = 0.0;
+  int64_t num_drops = 0;
+  for (Tap& tap : tap_list) {
+    int32_t mesh_node = to_mesh_node(tap.node_ref);
+    if (!is_grounded_list[findRoot(component_list, mesh_node)]) {
+      ir_stats.num_floating_taps++;
+      continue;
+    }
+    double drop = is_pad_list[mesh_node] ? 0.0 : drop_list[unknown_list[mesh_node]];
+    auto [iter, is_new] = instance_drop_map.emplace(tap.instance, drop);
+    if (!is_new) {
+      iter->second = std::max(iter->second, drop);
+    }
+    ir_stats.max_drop = std::max(ir_stats.max_drop, drop);
+    drop_sum += drop;
+    num_drops++;
+  }
+  ir_stats.avg_drop = num_drops > 0 ? drop_sum / num_drops : 0.0;
+  for (auto& [instance, drop] : instance_drop_map) {
+    _instance_drop_map[instance->get_name()] += drop;
+  }
+  ir_stats.memory = ir_status.memoryDelta();
+  _stats_list.push_back(ir_stats);
+  clear();
+
+  std::cout << "[iPDN info]: IR drop of " << ir_stats.net_name << " nodes = " << ir_stats.num_nodes
+            << " resistors = " << ir_stats.num_resistors << " pads = " << ir_stats.num_pads << " taps = " << ir_stats.num_taps
+            << " max drop = " << ir_stats.max_drop << "V iterations = " << ir_stats.iterations
+            << " extract time = " << ir_stats.extract_time << "s solve time = " << ir_stats.solve_time << "s memory = " << ir_stats.memory
+            << "MB" << std::endl;
+  return is_converged;
+}
+
+/**
+ * @brief report the statistics of each net and the worst instances
+ *
+ * @param worst_num
+ */
+void PdnSim::reportIRDrop(int32_t worst_num)
+{
+  for (IRStats& ir_stats : _stats_list) {
+    std::cout << "[iPDN info]: net " << ir_stats.net_name << std::endl;
+    std::cout << "  nodes = " << ir_stats.num_nodes << " resistors = " << ir_stats.num_resistors << " vias = " << ir_stats.num_vias
+              << " dangling vias = " << ir_stats.num_dangling_vias << std::endl;
+    std::cout << "  pads = " << ir_stats.num_pads << " taps = " << ir_stats.num_taps << " floating taps = " << ir_stats.num_floating_taps
+              << std::endl;
+    std::cout << "  max drop = " << ir_stats.max_drop << "V avg drop = " << ir_stats.avg_drop << "V" << std::endl;
+    std::cout << "  iterations = " << ir_stats.iterations << " residual = " << ir_stats.residual << std::endl;
+    std::cout << "  extract time = " << ir_stats.extract_time << "s solve time = " << ir_stats.solve_time
+              << "s memory = " << ir_stats.memory << "MB" << std::endl;
+  }
+
+  std::vector<std::pair<std::string, double>> drop_list(_instance_drop_map.begin(), _instance_drop_map.end());
+  int32_t report_num = std::min(static_cast<int32_t>(drop_list.size()), worst_num);
+  std::partial_sort(drop_list.begin(), drop_list.begin() + report_num, drop_list.end(),
+                    [](auto& first, auto& second) { return first.second > second.second; });
+  std::cout << "[iPDN info]: worst " << report_num << " instance drops" << std::endl;
+  for (int32_t i = 0; i < report_num; ++i) {
+    std::cout << "  " << drop_list[i].first << " " << drop_list[i].second << "V" << std::endl;
+  }
+}
+
+bool PdnSim::writeInstanceDrop(const std::string& file_path)
+{
+  std::ofstream drop_file(file_path);
+  if (!drop_file.is_open()) {
+    std::cout << "[iPDN error]: can not open " << file_path << std::endl;
+    return false;
+  }
+  drop_file << "instance drop(V)" << std::endl;
+  for (auto& [instance_name, drop] : _instance_drop_map) {
+    drop_file << instance_name << " " << drop << std::endl;
+  }
+  return true;
+}
+
+}  // namespace ipdn
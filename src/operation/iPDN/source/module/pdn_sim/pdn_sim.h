@@ -0,0 +1,125 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace idb {
+class IdbSpecialNet;
+class IdbLayerRouting;
+}  // namespace idb
+
+namespace ipdn {
+/**
+ * @brief Static IR drop analysis of the special nets.
+ *
+ * The resistive mesh of a net is extracted from its stripes, follow pins and vias: the nodes of a stripe are its end points, the
+ * points connected by vias, the other stripes ending on it, the pads and the instance taps, neighbour nodes are connected by the
+ * sheet resistance of the layer, vias by the cut resistance divided by the cut number. The io pins of the net are the pads, the
+ * instance current is the instance power divided by the supply voltage, injected to the nearest stripe of the lowest layer.
+ * The drop of the instance is the sum of the drops on its power and ground nets.
+ */
+class PdnSim
+{
+ public:
+  struct IRStats
+  {
+    std::string net_name;
+    int64_t num_nodes = 0;
+    int64_t num_resistors = 0;
+    int64_t num_vias = 0;
+    int64_t num_dangling_vias = 0;
+    int64_t num_pads = 0;
+    int64_t num_taps = 0;
+    int64_t num_floating_taps = 0;  /// taps on the nodes not connected to any pad
+    int32_t iterations = 0;
+    double residual = 0.0;
+    double max_drop = 0.0;  /// V
+    double avg_drop = 0.0;  /// V, average of the taps
+    double extract_time = 0.0;  /// s
+    double solve_time = 0.0;    /// s
+    double memory = 0.0;        /// MB
+  };
+
+  PdnSim() = default;
+  ~PdnSim() = default;
+
+  void set_supply_voltage(double supply_voltage) { _supply_voltage = supply_voltage; }
+  void set_via_resistance(double via_resistance) { _via_resistance = via_resistance; }
+  void set_default_sheet_resistance(double sheet_resistance) { _default_sheet_resistance = sheet_resistance; }
+
+  /// instance power is the total power of each instance by name, unit is W
+  bool analyzeIRDrop(const std::map<std::string, double>& instance_power_map);
+  bool analyzeIRDrop(idb::IdbSpecialNet* net, const std::map<std::string, double>& instance_power_map);
+
+  std::map<std::string, double>& get_instance_drop_map() { return _instance_drop_map; }
+  std::vector<IRStats>& get_stats_list() { return _stats_list; }
+
+  void reportIRDrop(int32_t worst_num = 10);
+  bool writeInstanceDrop(const std::string& file_path);
+
+ private:
+  /// a stripe or follow pin of the net, pos is along the stripe and track is the center line
+  struct MeshSegment
+  {
+    int32_t layer_order;
+    bool is_horizontal;
+    int32_t track;
+    int32_t low;
+    int32_t high;
+    int32_t width;
+    double sheet_resistance;
+    std::vector<int32_t> pos_list;
+    int64_t node_offset = 0;
+  };
+
+  struct NodeRef
+  {
+    int32_t segment_id;
+    int32_t pos;
+  };
+
+  /// the segments of one layer by the track, the segments of the same orient are parallel
+  struct LayerIndex
+  {
+    std::multimap<int32_t, int32_t> horizontal_map;
+    std::multimap<int32_t, int32_t> vertical_map;
+    int32_t max_half_width = 0;
+  };
+
+  void extractSegment(idb::IdbSpecialNet* net);
+  std::vector<NodeRef> findContainSegmentList(int32_t layer_order, int32_t x, int32_t y);
+  bool findNearestSegment(int32_t layer_order, int32_t x, int32_t y, NodeRef& node_ref);
+  void addNode(const NodeRef& node_ref) { _segment_list[node_ref.segment_id].pos_list.push_back(node_ref.pos); }
+  int64_t findNode(const NodeRef& node_ref);
+  double calcSheetResistance(idb::IdbLayerRouting* layer);
+  void clear();
+
+  double _supply_voltage = 1.0;            /// V
+  double _via_resistance = 1.0;            /// ohm per cut
+  double _default_sheet_resistance = 0.1;  /// ohm per square, used when the layer has no resistance
+
+  std::vector<MeshSegment> _segment_list;
+  std::map<int32_t, LayerIndex> _layer_index_map;
+
+  std::map<std::string, double> _instance_drop_map;
+  std::vector<IRStats> _stats_list;
+};
+
+}  // namespace ipdn
@@ -39,6 +39,12 @@ int32_t PdnVia::transUnitDB(double value)
  */
 idb::IdbVia* PdnVia::findVia(idb::IdbLayerCut* layer_cut, int32_t width_design, int32_t height_design)
 {
+  auto cache_key = std::make_tuple(layer_cut, width_design, height_design);
+  auto cache_iter = _via_cache.find(cache_key);
+  if (cache_iter != _via_cache.end()) {
+    return cache_iter->second;
+  }
+
   auto idb_design = dmInst->get_idb_design();
   auto via_list = idb_design->get_via_list();
 
@@ -47,6 +53,9 @@ idb::IdbVia* PdnVia::findVia(idb::IdbLayerCut* layer_cut, int32_t width_design,
   if (via_find == nullptr) {
     via_find = createVia(layer_cut, width_design, height_design, via_name);
   }
+  if (via_find != nullptr) {
+    _via_cache[cache_key] = via_find;
+  }
   return via_find;
 }
 
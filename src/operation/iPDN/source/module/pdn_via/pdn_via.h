@@ -16,7 +16,9 @@
 // ***************************************************************************************
 #pragma once
 
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace idb {
@@ -61,6 +63,9 @@ class PdnVia
                      int32_t height);
 
  private:
+  /// vias found by (cut layer, width, height), valid while the via list of the design is not cleared
+  std::map<std::tuple<idb::IdbLayerCut*, int32_t, int32_t>, idb::IdbVia*> _via_cache;
+
   int32_t transUnitDB(double value);
 };
 
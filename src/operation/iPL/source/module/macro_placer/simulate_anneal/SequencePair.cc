@@ -64,68 +64,22 @@ void SequencePair::perturb()
 
 void SequencePair::pack()
 {
+  _macro_width.resize(_num_macro);
+  _macro_height.resize(_num_macro);
+  _macro_x.resize(_num_macro);
+  _macro_y.resize(_num_macro);
   for (int i = 0; i < _num_macro; ++i) {
-    _macro_list[i]->set_x(0);
-    _macro_list[i]->set_y(0);
+    _macro_width[i] = _macro_list[i]->get_width();
+    _macro_height[i] = _macro_list[i]->get_height();
   }
 
-  // calculate x position
-  std::vector<std::pair<int, int>> match(_num_macro);
-  for (size_t i = 0; i < _pos_seq.size(); ++i) {
-    match[_pos_seq[i]].first = i;
-    match[_neg_seq[i]].second = i;
-  }
-
-  std::vector<uint32_t> length(_num_macro);
-  for (int i = 0; i < _num_macro; ++i) {
-    length[i] = 0;
-  }
-
-  for (size_t i = 0; i < _pos_seq.size(); ++i) {
-    int b = _pos_seq[i];
-    int p = match[b].second;
-    _macro_list[b]->set_x(length[p]);
-    uint t = _macro_list[b]->get_x() + _macro_list[b]->get_width();
-    for (size_t j = p; j < _neg_seq.size(); ++j) {
-      if (t > length[j]) {
-        length[j] = t;
-      } else {
-        break;
-      }
-    }
-  }
-
-  _total_width = length[_num_macro - 1];
-
-  // calculate Y position
-  std::vector<int> pos_seq(_pos_seq.size());
-  for (int i = 0; i < _num_macro; ++i) {
-    pos_seq[i] = _pos_seq[_num_macro - 1 - i];
-  }
-  for (int i = 0; i < _num_macro; ++i) {
-    match[pos_seq[i]].first = i;
-    match[_neg_seq[i]].second = i;
-  }
-
-  for (int i = 0; i < _num_macro; ++i) {
-    length[i] = 0;
-  }
+  _packer.pack(_pos_seq, _neg_seq, _macro_width.data(), _macro_height.data(), _macro_x.data(), _macro_y.data(), _total_width,
+               _total_height);
 
   for (int i = 0; i < _num_macro; ++i) {
-    int b = pos_seq[i];
-    int p = match[b].second;
-    _macro_list[b]->set_y(length[p]);
-    uint32_t t = _macro_list[b]->get_y() + _macro_list[b]->get_height();
-    for (int j = p; j < _num_macro; ++j) {
-      if (t > length[j]) {
-        length[j] = t;
-      } else {
-        break;
-      }
-    }
+    _macro_list[i]->set_x(_macro_x[i]);
+    _macro_list[i]->set_y(_macro_y[i]);
   }
-
-  _total_height = length[_num_macro - 1];
   _total_area = float(_total_width) * float(_total_height);
 }
 
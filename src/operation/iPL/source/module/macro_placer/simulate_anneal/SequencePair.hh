@@ -23,6 +23,7 @@
 #include <unordered_map>
 
 #include "MPSolution.hh"
+#include "SequencePairPacker.hh"
 #include "Setting.hh"
 #include "module/logger/Log.hh"
 
@@ -51,6 +52,12 @@ class SequencePair : public MPSolution
   int _rotate_macro_index;
   Orient _old_orient;
 
+  ieda_solver::SequencePairPacker _packer;
+  std::vector<uint32_t> _macro_width;
+  std::vector<uint32_t> _macro_height;
+  std::vector<uint32_t> _macro_x;
+  std::vector<uint32_t> _macro_y;
+
   void singleSwap(bool flag);  // true for pos_seq and false for neg_seq
   void doubleSwap(int index1, int index2);
   void pl2sp(std::vector<FPInst*> macro_list);
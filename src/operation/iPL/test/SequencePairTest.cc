@@ -0,0 +1,148 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../source/module/macro_placer/simulate_anneal/SequencePair.hh"
+#include "SequencePairPacker.hh"
+#include "gtest/gtest.h"
+
+namespace ipl {
+class SequencePairTest : public testing::Test
+{
+};
+
+// the nested loop packing, O(n^2)
+void referencePack(const std::vector<int>& pos, const std::vector<int>& neg, const std::vector<uint32_t>& width,
+                   const std::vector<uint32_t>& height, std::vector<uint32_t>& x, std::vector<uint32_t>& y, uint32_t& total_width,
+                   uint32_t& total_height)
+{
+  const size_t num = pos.size();
+  std::vector<size_t> match(num);
+  for (size_t i = 0; i < num; ++i) {
+    match[neg[i]] = i;
+  }
+  std::vector<uint32_t> length(num, 0);
+  for (size_t i = 0; i < num; ++i) {
+    int b = pos[i];
+    x[b] = length[match[b]];
+    uint32_t t = x[b] + width[b];
+    for (size_t j = match[b]; j < num && t > length[j]; ++j) {
+      length[j] = t;
+    }
+  }
+  total_width = length[num - 1];
+  std::fill(length.begin(), length.end(), 0);
+  for (size_t i = num; i-- > 0;) {
+    int b = pos[i];
+    y[b] = length[match[b]];
+    uint32_t t = y[b] + height[b];
+    for (size_t j = match[b]; j < num && t > length[j]; ++j) {
+      length[j] = t;
+    }
+  }
+  total_height = length[num - 1];
+}
+
+TEST_F(SequencePairTest, packMatchesReference)
+{
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<uint32_t> size_rand(1, 1000);
+  ieda_solver::SequencePairPacker packer;
+  for (int num : {1, 2, 7, 100, 500}) {
+    std::vector<int> pos(num);
+    std::vector<int> neg(num);
+    std::iota(pos.begin(), pos.end(), 0);
+    std::iota(neg.begin(), neg.end(), 0);
+    std::vector<uint32_t> width(num);
+    std::vector<uint32_t> height(num);
+    for (int i = 0; i < num; ++i) {
+      width[i] = size_rand(gen);
+      height[i] = size_rand(gen);
+    }
+    for (int times = 0; times < 20; ++times) {
+      std::shuffle(pos.begin(), pos.end(), gen);
+      std::shuffle(neg.begin(), neg.end(), gen);
+      std::vector<uint32_t> x(num), y(num), ref_x(num), ref_y(num);
+      uint32_t total_width, total_height, ref_width, ref_height;
+      packer.pack(pos, neg, width.data(), height.data(), x.data(), y.data(), total_width, total_height);
+      referencePack(pos, neg, width, height, ref_x, ref_y, ref_width, ref_height);
+      EXPECT_EQ(x, ref_x);
+      EXPECT_EQ(y, ref_y);
+      EXPECT_EQ(total_width, ref_width);
+      EXPECT_EQ(total_height, ref_height);
+    }
+  }
+}
+
+TEST_F(SequencePairTest, packBenchmark)
+{
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<uint32_t> size_rand(1, 1000);
+  imp::Setting setting;
+  for (int num : {100, 500, 1000, 2000}) {
+    std::vector<imp::FPInst*> macro_list;
+    std::vector<uint32_t> width(num), height(num), x(num), y(num);
+    for (int i = 0; i < num; ++i) {
+      auto* macro = new imp::FPInst();
+      macro->set_width(size_rand(gen));
+      macro->set_height(size_rand(gen));
+      width[i] = macro->get_width();
+      height[i] = macro->get_height();
+      macro_list.push_back(macro);
+    }
+    const int num_moves = 2000;
+
+    // moves of the solution, perturb() packs
+    imp::SequencePair solution(macro_list, &setting);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_moves; ++i) {
+      solution.perturb();
+      if (i % 2 == 0) {
+        solution.update();
+      } else {
+        solution.rollback();
+      }
+    }
+    double pack_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // the same number of nested loop packings of random sequences
+    std::vector<int> pos(num);
+    std::vector<int> neg(num);
+    std::iota(pos.begin(), pos.end(), 0);
+    std::iota(neg.begin(), neg.end(), 0);
+    std::shuffle(pos.begin(), pos.end(), gen);
+    std::shuffle(neg.begin(), neg.end(), gen);
+    uint32_t total_width, total_height;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_moves; ++i) {
+      std::swap(pos[gen() % num], pos[gen() % num]);
+      referencePack(pos, neg, width, height, x, y, total_width, total_height);
+    }
+    double ref_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LOG_INFO << "macros: " << num << " moves/s: " << num_moves / pack_time << " nested loop moves/s: " << num_moves / ref_time;
+
+    for (auto* macro : macro_list) {
+      delete macro;
+    }
+  }
+}
+
+}  // namespace ipl
@@ -25,6 +25,7 @@
 #include "Power.hh"
 
 #include <array>
+#include <set>
 
 #include "ops/annotate_toggle_sp/AnnotateToggleSP.hh"
 #include "ops/build_graph/PwrBuildGraph.hh"
@@ -38,6 +39,7 @@
 #include "ops/levelize_seq_graph/PwrLevelizeSeqGraph.hh"
 #include "ops/plot_power/PwrReport.hh"
 #include "ops/propagate_toggle_sp/PwrPropagateClock.hh"
+#include "ops/propagate_toggle_sp/PwrIncrPropagateToggleSP.hh"
 #include "ops/propagate_toggle_sp/PwrPropagateConst.hh"
 #include "ops/propagate_toggle_sp/PwrPropagateToggleSP.hh"
 #include "ops/read_vcd/VCDParserWrapper.hh"
@@ -109,6 +111,7 @@ unsigned Power::readVCD(
     std::string_view vcd_path, std::string top_instance_name,
     std::optional<std::pair<int64_t, int64_t>> begin_end_time) {
   LOG_INFO << "read vcd start";
+  _vcd_wrapper.set_num_threads(_num_threads);
   _vcd_wrapper.readVCD(vcd_path, begin_end_time);
   _vcd_wrapper.buildAnnotateDB(top_instance_name);
   _vcd_wrapper.calcScopeToggleAndSp();
@@ -229,9 +232,12 @@ unsigned Power::propagateToggleSP() {
  * @return unsigned
  */
 unsigned Power::calcLeakagePower() {
+  ieda::Stats stats;
   PwrCalcLeakagePower calc_leakage_power;
+  calc_leakage_power.set_num_threads(_num_threads);
   calc_leakage_power(&_power_graph);
   _leakage_powers = std::move(calc_leakage_power.takeLeakagePowers());
+  _calc_runtime.leakage_power = stats.elapsedRunTime();
   return 1;
 }
 
@@ -241,9 +247,12 @@ unsigned Power::calcLeakagePower() {
  * @return unsigned
  */
 unsigned Power::calcInternalPower() {
+  ieda::Stats stats;
   PwrCalcInternalPower calc_internal_power;
+  calc_internal_power.set_num_threads(_num_threads);
   calc_internal_power(&_power_graph);
   _internal_powers = std::move(calc_internal_power.takeInternalPowers());
+  _calc_runtime.internal_power = stats.elapsedRunTime();
   return 1;
 }
 
@@ -253,9 +262,39 @@ unsigned Power::calcInternalPower() {
  * @return unsigned
  */
 unsigned Power::calcSwitchPower() {
+  ieda::Stats stats;
   PwrCalcSwitchPower calc_switch_power;
+  calc_switch_power.set_num_threads(_num_threads);
   calc_switch_power(&_power_graph);
   _switch_powers = std::move(calc_switch_power.takeSwitchPowers());
+  _calc_runtime.switch_power = stats.elapsedRunTime();
+  return 1;
+}
+
+/**
+ * @brief calc leakage, internal and switch power and group them, the group
+ * data of the last calculation is cleared, so it could be called repeatedly
+ * after the toggle/sp or the timing is changed.
+ *
+ * @return unsigned
+ */
+unsigned Power::calcPower() {
+  calcLeakagePower();
+  calcInternalPower();
+  calcSwitchPower();
+
+  ieda::Stats stats;
+  _type_to_group_data.clear();
+  _group_datas.clear();
+  _obj_to_power_datas.clear();
+  analyzeGroupPower();
+  _calc_runtime.group_power = stats.elapsedRunTime();
+
+  LOG_INFO << "power calculation runtime leakage "
+           << _calc_runtime.leakage_power << "s internal "
+           << _calc_runtime.internal_power << "s switch "
+           << _calc_runtime.switch_power << "s group "
+           << _calc_runtime.group_power << "s";
   return 1;
 }
 
@@ -298,10 +337,7 @@ unsigned Power::updatePower() {
     LOG_INFO << "power calculation start";
 
     // thirdly analyze power.
-    calcLeakagePower();
-    calcInternalPower();
-    calcSwitchPower();
-    analyzeGroupPower();
+    calcPower();
 
     LOG_INFO << "power calculation end";
     double memory_delta = stats.memoryDelta();
@@ -314,83 +350,309 @@ unsigned Power::updatePower() {
 }
 
 /**
- * @brief analyze power by group.
+ * @brief get the group type of the power data, the switch power belong to the
+ * group of the net driver instance.
  *
- * @return unsigned
+ * @param power_data
+ * @return std::optional<PwrGroupData::PwrGroupType>
  */
-unsigned Power::analyzeGroupPower() {
-  auto add_group_data_from_analysi_data = [this](auto group_type,
-                                                 PwrAnalysisData* power_data) {
-    auto group_data = std::make_unique<PwrGroupData>(
-        group_type, power_data->get_design_obj());
-    double power_data_value = power_data->getPowerDataValue();
-    if (power_data->isLeakageData()) {
-      group_data->set_leakage_power(NW_TO_W(power_data_value));
-    } else if (power_data->isInternalData()) {
-      group_data->set_internal_power(MW_TO_W(power_data_value));
+std::optional<PwrGroupData::PwrGroupType> Power::getPowerDataGroup(
+    PwrAnalysisData* power_data) {
+  Instance* inst = nullptr;
+  if (power_data->isSwitchData()) {
+    auto* net = dynamic_cast<Net*>(power_data->get_design_obj());
+    auto* driver_obj = net->getDriver();
+
+    auto* the_sta_graph = _power_graph.get_sta_graph();
+    auto driver_sta_vertex = the_sta_graph->findVertex(driver_obj);
+
+    PwrVertex* driver_pwr_vertex = nullptr;
+    if (driver_sta_vertex) {
+      driver_pwr_vertex = _power_graph.staToPwrVertex(*driver_sta_vertex);
     } else {
-      group_data->set_switch_power(MW_TO_W(power_data_value));
+      LOG_FATAL << "not found driver sta vertex.";
     }
 
-    addGroupData(std::move(group_data));
+    // TODO  input port
+    if (driver_pwr_vertex->is_input_port()) {
+      return std::nullopt;
+    }
+
+    inst = driver_pwr_vertex->getOwnInstance();
+    if (!inst) {
+      LOG_FATAL << "not found driver instance.";
+    }
+  } else {
+    inst = dynamic_cast<Instance*>(power_data->get_design_obj());
+    LOG_FATAL_IF(!inst) << "power instance is not exist.";
+  }
+
+  auto group_type = getInstPowerGroup(inst);
+  if (!group_type) {
+    LOG_INFO << "can not find group type for" << inst->get_name();
+  }
+  return group_type;
+}
+
+/**
+ * @brief add the group data of the power data, the unit is converted to W.
+ *
+ * @param group_type
+ * @param power_data
+ * @return PwrGroupData*
+ */
+PwrGroupData* Power::addGroupData(PwrGroupData::PwrGroupType group_type,
+                                  PwrAnalysisData* power_data) {
+  auto group_data =
+      std::make_unique<PwrGroupData>(group_type, power_data->get_design_obj());
+  double power_data_value = power_data->getPowerDataValue();
+  if (power_data->isLeakageData()) {
+    group_data->set_leakage_power(NW_TO_W(power_data_value));
+  } else if (power_data->isInternalData()) {
+    group_data->set_internal_power(MW_TO_W(power_data_value));
+  } else {
+    group_data->set_switch_power(MW_TO_W(power_data_value));
+  }
+
+  auto* the_group_data = group_data.get();
+  addGroupData(std::move(group_data));
+  return the_group_data;
+}
+
+/**
+ * @brief analyze power by group.
+ *
+ * @return unsigned
+ */
+unsigned Power::analyzeGroupPower() {
+  auto add_group_data_from_analysi_data = [this](PwrAnalysisData* power_data) {
+    auto group_type = getPowerDataGroup(power_data);
+    auto* group_data =
+        group_type ? addGroupData(*group_type, power_data) : nullptr;
+    _obj_to_power_datas[power_data->get_design_obj()].emplace_back(power_data,
+                                                                   group_data);
   };
 
   PwrLeakageData* leakage_power_data;
   FOREACH_PWR_LEAKAGE_POWER(this, leakage_power_data) {
-    auto* inst = dynamic_cast<Instance*>(leakage_power_data->get_design_obj());
-    LOG_FATAL_IF(!inst) << "leakage power instance is not exist.";
-    auto group_type = getInstPowerGroup(inst);
-    if (group_type) {
-      add_group_data_from_analysi_data(group_type.value(), leakage_power_data);
-    } else {
-      LOG_INFO << "can not find group type for" << inst->get_name();
-    }
+    add_group_data_from_analysi_data(leakage_power_data);
   }
 
   PwrInternalData* internal_power_data;
   FOREACH_PWR_INTERNAL_POWER(this, internal_power_data) {
-    auto* inst = dynamic_cast<Instance*>(internal_power_data->get_design_obj());
-    LOG_FATAL_IF(!inst) << "internal power instance is not exist.";
-    auto group_type = getInstPowerGroup(inst);
-    if (group_type) {
-      add_group_data_from_analysi_data(group_type.value(), internal_power_data);
-    } else {
-      LOG_INFO << "can not find group type for" << inst->get_name();
+    add_group_data_from_analysi_data(internal_power_data);
+  }
+
+  PwrSwitchData* switch_power_data;
+  FOREACH_PWR_SWITCH_POWER(this, switch_power_data) {
+    add_group_data_from_analysi_data(switch_power_data);
+  }
+  return 1;
+}
+
+/**
+ * @brief get the total power of each instance, the switch power of a net is
+ * counted to its driver instance, the unit is W.
+ *
+ * @return std::map<std::string, double>
+ */
+std::map<std::string, double> Power::getInstancePowerMap() {
+  std::map<std::string, double> inst_to_power;
+  auto add_inst_power = [&inst_to_power](Instance* inst, double power) {
+    if (inst) {
+      inst_to_power[inst->get_name()] += power;
     }
+  };
+
+  PwrLeakageData* leakage_power_data;
+  FOREACH_PWR_LEAKAGE_POWER(this, leakage_power_data) {
+    add_inst_power(
+        dynamic_cast<Instance*>(leakage_power_data->get_design_obj()),
+        NW_TO_W(leakage_power_data->getPowerDataValue()));
+  }
+
+  PwrInternalData* internal_power_data;
+  FOREACH_PWR_INTERNAL_POWER(this, internal_power_data) {
+    add_inst_power(
+        dynamic_cast<Instance*>(internal_power_data->get_design_obj()),
+        MW_TO_W(internal_power_data->getPowerDataValue()));
   }
 
   PwrSwitchData* switch_power_data;
   FOREACH_PWR_SWITCH_POWER(this, switch_power_data) {
     auto* net = dynamic_cast<Net*>(switch_power_data->get_design_obj());
     auto* driver_obj = net->getDriver();
+    if (driver_obj && driver_obj->isPin()) {
+      add_inst_power(driver_obj->get_own_instance(),
+                     MW_TO_W(switch_power_data->getPowerDataValue()));
+    }
+  }
 
-    auto* the_sta_graph = _power_graph.get_sta_graph();
-    auto driver_sta_vertex = the_sta_graph->findVertex(driver_obj);
+  return inst_to_power;
+}
 
-    PwrVertex* driver_pwr_vertex = nullptr;
-    if (driver_sta_vertex) {
-      driver_pwr_vertex = _power_graph.staToPwrVertex(*driver_sta_vertex);
-    } else {
-      LOG_FATAL << "not found driver sta vertex.";
-    }
+/**
+ * @brief update the power data of the design obj in place and its group data,
+ * the power change is added to the group power delta.
+ *
+ * @param new_power_data
+ * @return bool false if the design obj has not the kind of power data.
+ */
+bool Power::updatePowerData(PwrAnalysisData* new_power_data) {
+  auto found = _obj_to_power_datas.find(new_power_data->get_design_obj());
+  if (found == _obj_to_power_datas.end()) {
+    return false;
+  }
 
-    // TODO  input port
-    if (driver_pwr_vertex->is_input_port()) {
+  for (auto& [power_data, group_data] : found->second) {
+    if (power_data->isLeakageData() != new_power_data->isLeakageData() ||
+        power_data->isInternalData() != new_power_data->isInternalData() ||
+        power_data->isSwitchData() != new_power_data->isSwitchData()) {
       continue;
     }
 
-    auto* driver_inst = driver_pwr_vertex->getOwnInstance();
-    if (!driver_inst) {
-      LOG_FATAL << "not found driver instance.";
+    power_data->setPowerDataValue(new_power_data->getPowerDataValue());
+    if (group_data) {
+      double power_value = power_data->getPowerDataValue();
+      double& power_delta = _group_power_delta[group_data->get_group_type()];
+      if (power_data->isLeakageData()) {
+        power_delta += NW_TO_W(power_value) - group_data->get_leakage_power();
+        group_data->set_leakage_power(NW_TO_W(power_value));
+      } else if (power_data->isInternalData()) {
+        power_delta += MW_TO_W(power_value) - group_data->get_internal_power();
+        group_data->set_internal_power(MW_TO_W(power_value));
+      } else {
+        power_delta += MW_TO_W(power_value) - group_data->get_switch_power();
+        group_data->set_switch_power(MW_TO_W(power_value));
+      }
     }
+    return true;
+  }
 
-    auto group_type = getInstPowerGroup(driver_inst);
-    if (group_type) {
-      add_group_data_from_analysi_data(group_type.value(), switch_power_data);
-    } else {
-      LOG_INFO << "can not find group type for" << driver_inst->get_name();
+  return false;
+}
+
+/**
+ * @brief add the power data of the new design obj to group, the power is added
+ * to the group power delta.
+ *
+ * @param new_power_data
+ */
+void Power::addPowerData(PwrAnalysisData* new_power_data) {
+  auto group_type = getPowerDataGroup(new_power_data);
+  PwrGroupData* group_data = nullptr;
+  if (group_type) {
+    group_data = addGroupData(*group_type, new_power_data);
+    _group_power_delta[*group_type] += group_data->get_leakage_power() +
+                                       group_data->get_internal_power() +
+                                       group_data->get_switch_power();
+  }
+  _obj_to_power_datas[new_power_data->get_design_obj()].emplace_back(
+      new_power_data, group_data);
+}
+
+/**
+ * @brief incremental update power after the instances are resized or inserted
+ * by the optimization, the sta graph and the timing should be updated before.
+ * The power graph is rebuilt around the instances only, the toggle and sp are
+ * propagated again in the fanout cone of the instances, and the power data of
+ * the affected cells and nets are updated in place. Removed instance is not
+ * supported, the power graph need to be built again.
+ *
+ * @param changed_insts
+ * @return unsigned
+ */
+unsigned Power::incrUpdatePower(const std::vector<Instance*>& changed_insts) {
+  ieda::Stats stats;
+  LOG_INFO << "incremental update power start";
+  LOG_FATAL_IF(_group_datas.empty()) << "power is not calculated before.";
+
+  _group_power_delta.clear();
+
+  // firstly rebuild the power graph around the changed instances.
+  PwrBuildGraph build_graph(_power_graph);
+  auto* the_sta_graph = _power_graph.get_sta_graph();
+
+  build_graph.buildInsts(changed_insts);
+
+  std::vector<PwrVertex*> seed_vertexes;
+  std::set<Instance*> affected_insts;
+  std::set<Net*> affected_nets;
+  for (auto* inst : changed_insts) {
+    affected_insts.insert(inst);
+
+    Pin* pin;
+    FOREACH_INSTANCE_PIN(inst, pin) {
+      auto the_sta_vertex = the_sta_graph->findVertex(pin);
+      seed_vertexes.push_back(_power_graph.staToPwrVertex(*the_sta_vertex));
+
+      // the load of the net is changed, so the driver internal power.
+      if (auto* the_net = pin->get_net(); the_net) {
+        affected_nets.insert(the_net);
+        auto* driver_obj = the_net->getDriver();
+        if (driver_obj && driver_obj->isPin()) {
+          affected_insts.insert(
+              dynamic_cast<Pin*>(driver_obj)->get_own_instance());
+        }
+      }
+    }
+  }
+
+  // secondly propagate toggle and sp in the fanout cone.
+  PwrIncrPropagateToggleSP incr_propagate_toggle_sp(std::move(seed_vertexes));
+  incr_propagate_toggle_sp(&_power_graph);
+  for (auto* cone_vertex : incr_propagate_toggle_sp.get_cone_vertexes()) {
+    if (auto* own_inst = cone_vertex->getOwnInstance(); own_inst) {
+      affected_insts.insert(own_inst);
+    }
+    if (auto* the_net = cone_vertex->getDesignObj()->get_net(); the_net) {
+      affected_nets.insert(the_net);
     }
   }
+
+  // thirdly calc the power of the affected instances and nets.
+  PwrCalcLeakagePower calc_leakage_power;
+  calc_leakage_power.set_the_pwr_graph(&_power_graph);
+  PwrCalcInternalPower calc_internal_power;
+  calc_internal_power.set_the_pwr_graph(&_power_graph);
+  for (auto* inst : affected_insts) {
+    PwrLeakageData leakage_data(
+        inst, calc_leakage_power.calcInstLeakagePower(inst));
+    if (!updatePowerData(&leakage_data)) {
+      addPowerData(&_leakage_powers.emplace_back(leakage_data));
+    }
+
+    PwrInternalData internal_data(
+        inst, calc_internal_power.calcInstInternalPower(inst));
+    if (!updatePowerData(&internal_data)) {
+      addPowerData(&_internal_powers.emplace_back(internal_data));
+    }
+  }
+
+  PwrCalcSwitchPower calc_switch_power;
+  calc_switch_power.set_the_pwr_graph(&_power_graph);
+  for (auto* net : affected_nets) {
+    PwrSwitchData switch_data(
+        net, calc_switch_power.calcNetSwitchPower(&_power_graph, net));
+    if (!updatePowerData(&switch_data)) {
+      addPowerData(&_switch_powers.emplace_back(switch_data));
+    }
+  }
+
+  double total_power_delta = 0.0;
+  for (auto& [group_type, power_delta] : _group_power_delta) {
+    total_power_delta += power_delta;
+  }
+  LOG_INFO << "incremental update power instances " << affected_insts.size()
+           << " nets " << affected_nets.size() << " power delta "
+           << total_power_delta << "W";
+
+  LOG_INFO << "incremental update power end";
+  double memory_delta = stats.memoryDelta();
+  LOG_INFO << "incremental update power memory usage " << memory_delta << "MB";
+  double time_delta = stats.elapsedRunTime();
+  LOG_INFO << "incremental update power time elapsed " << time_delta << "s";
+
   return 1;
 }
 
@@ -24,6 +24,11 @@
 
 #pragma once
 
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+
 #include "core/PwrAnalysisData.hh"
 #include "core/PwrGraph.hh"
 #include "core/PwrGroupData.hh"
@@ -39,6 +44,14 @@ namespace ipower {
  */
 class Power {
  public:
+  /*The runtime of the power calculation stages, unit is s.*/
+  struct PwrCalcRuntime {
+    double leakage_power = 0.0;
+    double internal_power = 0.0;
+    double switch_power = 0.0;
+    double group_power = 0.0;
+  };
+
   explicit Power(StaGraph* sta_graph) : _power_graph(sta_graph) {}
   ~Power() = default;
 
@@ -79,7 +92,10 @@ class Power {
   unsigned calcInternalPower();
   unsigned calcSwitchPower();
   unsigned analyzeGroupPower();
+  std::map<std::string, double> getInstancePowerMap();
+  unsigned calcPower();
   unsigned updatePower();
+  unsigned incrUpdatePower(const std::vector<Instance*>& changed_insts);
   unsigned reportPower(const char* rpt_file_name,
                        PwrAnalysisMode pwr_analysis_mode);
   unsigned runCompleteFlow();
@@ -89,6 +105,9 @@ class Power {
   auto& get_switch_powers() { return _switch_powers; }
 
   auto& get_type_to_group_data() { return _type_to_group_data; }
+  auto& get_calc_runtime() { return _calc_runtime; }
+  auto& get_group_power_delta() { return _group_power_delta; }
+  void set_num_threads(unsigned num_threads) { _num_threads = num_threads; }
 
  private:
   std::optional<PwrGroupData::PwrGroupType> getInstPowerGroup(
@@ -98,23 +117,37 @@ class Power {
         group_data.get());
     _group_datas.emplace_back(std::move(group_data));
   }
+  PwrGroupData* addGroupData(PwrGroupData::PwrGroupType group_type,
+                             PwrAnalysisData* power_data);
+  std::optional<PwrGroupData::PwrGroupType> getPowerDataGroup(
+      PwrAnalysisData* power_data);
+  bool updatePowerData(PwrAnalysisData* new_power_data);
+  void addPowerData(PwrAnalysisData* new_power_data);
 
   PwrGraph _power_graph;          //< The power graph, mapped to sta graph.
   PwrSeqGraph _power_seq_graph;   //!< The power sequential graph, vertex is
                                   //!< sequential inst.
   VcdParserWrapper _vcd_wrapper;  //!< The vcd database.
 
-  std::vector<std::unique_ptr<PwrLeakageData>>
-      _leakage_powers;  //!< The leakage power.
-  std::vector<std::unique_ptr<PwrInternalData>>
-      _internal_powers;  //!< The internal power.
-  std::vector<std::unique_ptr<PwrSwitchData>>
-      _switch_powers;  //!< The switch power.
+  std::deque<PwrLeakageData> _leakage_powers;    //!< The leakage power.
+  std::deque<PwrInternalData> _internal_powers;  //!< The internal power.
+  std::deque<PwrSwitchData> _switch_powers;      //!< The switch power.
 
   std::vector<std::unique_ptr<PwrGroupData>> _group_datas;  //!< The group data.
   std::map<PwrGroupData::PwrGroupType, std::vector<PwrGroupData*>>
       _type_to_group_data;  //!< The mapping of type to group data.
 
+  std::unordered_map<DesignObject*,
+                     std::vector<std::pair<PwrAnalysisData*, PwrGroupData*>>>
+      _obj_to_power_datas;  //!< The power data and group data of the design
+                            //!< obj, for incremental update.
+  std::map<PwrGroupData::PwrGroupType, double>
+      _group_power_delta;  //!< The group power delta of the last incremental
+                           //!< update, unit is W.
+
+  PwrCalcRuntime _calc_runtime;  //!< The runtime of the last calculation.
+  unsigned _num_threads = c_num_threads;  //!< The power calculation threads.
+
   static Power* _power;
   DISALLOW_COPY_AND_ASSIGN(Power);
 };
@@ -132,7 +165,7 @@ class Power {
   if (auto& leakage_powers = (ipower)->get_leakage_powers();                 \
       !leakage_powers.empty())                                               \
     for (auto p = leakage_powers.begin();                                    \
-         p != leakage_powers.end() ? leakage_power = p->get(), true : false; \
+         p != leakage_powers.end() ? leakage_power = &*p, true : false;      \
          ++p)
 
 /**
@@ -148,7 +181,7 @@ class Power {
   if (auto& internal_powers = (ipower)->get_internal_powers();                 \
       !internal_powers.empty())                                                \
     for (auto p = internal_powers.begin();                                     \
-         p != internal_powers.end() ? internal_power = p->get(), true : false; \
+         p != internal_powers.end() ? internal_power = &*p, true : false;      \
          ++p)
 
 /**
@@ -164,7 +197,7 @@ class Power {
   if (auto& switch_powers = (ipower)->get_switch_powers();                 \
       !switch_powers.empty())                                              \
     for (auto p = switch_powers.begin();                                   \
-         p != switch_powers.end() ? switch_power = p->get(), true : false; \
+         p != switch_powers.end() ? switch_power = &*p, true : false;      \
          ++p)
 
 }  // namespace ipower
@@ -42,6 +42,7 @@ class PwrAnalysisData {
   [[nodiscard]] virtual unsigned isSwitchData() const { return 0; }
 
   [[nodiscard]] virtual double getPowerDataValue() const { return 0; }
+  virtual void setPowerDataValue(double power_value) {}
 
   auto* get_design_obj() { return _design_obj; }
 
@@ -65,6 +66,9 @@ class PwrLeakageData : public PwrAnalysisData {
   [[nodiscard]] double getPowerDataValue() const override {
     return _leakage_power;
   }
+  void setPowerDataValue(double power_value) override {
+    _leakage_power = power_value;
+  }
 
  private:
   double _leakage_power;
@@ -86,6 +90,9 @@ class PwrInternalData : public PwrAnalysisData {
   [[nodiscard]] double getPowerDataValue() const override {
     return _internal_power;
   }
+  void setPowerDataValue(double power_value) override {
+    _internal_power = power_value;
+  }
 
  private:
   double _internal_power;
@@ -107,6 +114,9 @@ class PwrSwitchData : public PwrAnalysisData {
   [[nodiscard]] double getPowerDataValue() const override {
     return _switch_power;
   }
+  void setPowerDataValue(double power_value) override {
+    _switch_power = power_value;
+  }
 
  private:
   double _switch_power;
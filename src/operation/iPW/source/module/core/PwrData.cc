@@ -163,6 +163,37 @@ void PwrDataBucket::addData(PwrData* data, int track_stack_deep) {
   }
 }
 
+/**
+ * @brief Remove the data of the data source, the bucket after is moved forward
+ * if the removed data is in the bucket.
+ *
+ * @param data_source
+ */
+void PwrDataBucket::removeData(PwrDataSource data_source) {
+  if (_data_list.empty()) {
+    return;
+  }
+
+  if (_data_list.front()->get_data_source() != data_source) {
+    if (_next) {
+      _next->removeData(data_source);
+      if (_next->empty()) {
+        _next.reset();
+      }
+    }
+    return;
+  }
+
+  _data_list.clear();
+  _count = 0;
+  if (_next) {
+    auto next_bucket = std::move(_next);
+    _data_list = std::move(next_bucket->_data_list);
+    _count = next_bucket->_count;
+    _next = std::move(next_bucket->_next);
+  }
+}
+
 /**
  * @brief Get (Propagation/Default/Annotate) data.
  *
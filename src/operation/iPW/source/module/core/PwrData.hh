@@ -165,6 +165,7 @@ class PwrDataBucket {
     _count++;
   }
   void addData(PwrData* data, int track_stack_deep);
+  void removeData(PwrDataSource data_source);
   PwrData* frontData() {
     return !_data_list.empty() ? _data_list.front().get() : nullptr;
   }
@@ -23,8 +23,13 @@
  */
 #include "PwrFunc.hh"
 
+#include <algorithm>
+#include <future>
+#include <vector>
+
 #include "PwrArc.hh"
 #include "PwrSeqGraph.hh"
+#include "ThreadPool/ThreadPool.h"
 
 namespace ipower {
 
@@ -77,4 +82,49 @@ void PwrFunc::printArcTraceStack(const char* file_name, PwrFunc& dump_func) {
   dump_func.printText(file_name);
 }
 
+/**
+ * @brief Split the objs [0, num_objs) to chunks, calc the chunks in the thread
+ * pool and sum the chunk results in chunk order, so the sum is the same for
+ * every run.
+ *
+ * @param num_objs
+ * @param calc_range calc the objs [begin, end), return the partial sum, it
+ * should only write the data of the objs in the range.
+ * @return double
+ */
+double PwrFunc::parallelSum(
+    std::size_t num_objs,
+    const std::function<double(std::size_t, std::size_t)>& calc_range) {
+  // the chunk is not too small, otherwise the task overhead dominates.
+  constexpr std::size_t c_min_chunk_size = 256;
+  std::size_t num_threads = std::max(1U, get_num_threads());
+  std::size_t chunk_size =
+      std::max(c_min_chunk_size, (num_objs + num_threads * 4 - 1) /
+                                     (num_threads * 4));
+  std::size_t num_chunks = (num_objs + chunk_size - 1) / chunk_size;
+
+  if (num_chunks <= 1) {
+    return num_objs ? calc_range(0, num_objs) : 0.0;
+  }
+
+  std::vector<std::future<double>> chunk_results;
+  chunk_results.reserve(num_chunks);
+  {
+    ThreadPool thread_pool(std::min(num_threads, num_chunks));
+    for (std::size_t begin = 0; begin < num_objs; begin += chunk_size) {
+      std::size_t end = std::min(begin + chunk_size, num_objs);
+      chunk_results.emplace_back(
+          thread_pool.enqueue([&calc_range, begin, end]() {
+            return calc_range(begin, end);
+          }));
+    }
+  }
+
+  double sum = 0.0;
+  for (auto& chunk_result : chunk_results) {
+    sum += chunk_result.get();
+  }
+  return sum;
+}
+
 }  // namespace ipower
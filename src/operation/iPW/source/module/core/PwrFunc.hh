@@ -23,6 +23,7 @@
  */
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <stack>
 
@@ -122,6 +123,10 @@ class PwrFunc {
   void printVertexTraceStack(const char* file_name, PwrFunc& dump_func);
   void printArcTraceStack(const char* file_name, PwrFunc& dump_func);
 
+  double parallelSum(
+      std::size_t num_objs,
+      const std::function<double(std::size_t, std::size_t)>& calc_range);
+
  private:
   PwrGraph* _the_pwr_graph = nullptr;  //!< The power functor need the power
                                        //!< graph, store here for useful.
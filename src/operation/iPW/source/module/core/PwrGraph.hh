@@ -24,6 +24,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "BTreeSet.hh"
@@ -95,6 +96,10 @@ class PwrGraph {
   }
   auto& get_arcs() { return _arcs; }
   auto numArc() { return _arcs.size(); }
+  void removePowerArcs(const std::set<PwrArc*>& arcs) {
+    std::erase_if(_arcs,
+                  [&arcs](auto& arc) { return arcs.contains(arc.get()); });
+  }
 
   void addPowerCell(std::unique_ptr<PwrCell> cell) {
     _inst_name_to_pwr_cell[cell->get_design_inst()->get_name()] = cell.get();
@@ -106,6 +111,10 @@ class PwrGraph {
         << inst_name << " is not found power cell.";
     return _inst_name_to_pwr_cell[inst_name];
   }
+  PwrCell* findCell(std::string_view inst_name) {
+    auto it = _inst_name_to_pwr_cell.find(inst_name);
+    return it != _inst_name_to_pwr_cell.end() ? it->second : nullptr;
+  }
 
   PwrVertex* getDriverVertex(const std::string& net_name);
 
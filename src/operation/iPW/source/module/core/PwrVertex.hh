@@ -104,6 +104,11 @@ class PwrVertex {
     return _is_toggle_sp_propagated;
   }
   void set_is_toggle_sp_propagated() { _is_toggle_sp_propagated = 1; }
+  void resetPropagatedToggleSP() {
+    _toggle_bucket.removeData(PwrDataSource::kDataPropagation);
+    _sp_bucket.removeData(PwrDataSource::kDataPropagation);
+    _is_toggle_sp_propagated = 0;
+  }
 
   [[nodiscard]] unsigned is_const_vdd() const { return _is_const_vdd; }
   void set_is_const_vdd() { _is_const_vdd = 1; }
@@ -122,6 +127,8 @@ class PwrVertex {
 
   void addSrcArc(PwrArc* src_arc) { _src_arcs.emplace_back(src_arc); }
   void addSnkArc(PwrArc* snk_arc) { _snk_arcs.emplace_back(snk_arc); }
+  void removeSrcArc(PwrArc* src_arc) { std::erase(_src_arcs, src_arc); }
+  void removeSnkArc(PwrArc* snk_arc) { std::erase(_snk_arcs, snk_arc); }
   auto& get_src_arcs() { return _src_arcs; }
   auto& get_snk_arcs() { return _snk_arcs; }
 
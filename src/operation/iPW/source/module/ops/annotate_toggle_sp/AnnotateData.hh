@@ -74,6 +74,7 @@ class AnnotateTime {
 class AnnotateToggle {
  public:
   void incrTC() { ++_TC; }
+  void incrTC(int64_t num) { _TC += num; }
 
   void printAnnotateToggle(std::ostream& out);
   int64_t get_toggle() { return _TC.get_ui(); }
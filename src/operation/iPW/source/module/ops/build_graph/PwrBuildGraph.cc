@@ -23,6 +23,8 @@
  */
 #include "PwrBuildGraph.hh"
 
+#include <set>
+
 #include "liberty/Liberty.hh"
 #include "netlist/Instance.hh"
 #include "string/Str.hh"
@@ -68,6 +70,135 @@ unsigned PwrBuildGraph::annotateInternalPower(PwrInstArc* inst_power_arc,
   return 1;
 }
 
+/**
+ * @brief build the power vertex of the sta vertex if not built.
+ *
+ * @param sta_vertex
+ * @return PwrVertex*
+ */
+PwrVertex* PwrBuildGraph::buildVertex(StaVertex* sta_vertex) {
+  if (auto* pwr_vertex = _power_graph.staToPwrVertex(sta_vertex); pwr_vertex) {
+    return pwr_vertex;
+  }
+
+  auto power_vertex = std::make_unique<PwrVertex>(sta_vertex);
+  auto* the_pwr_vertex = power_vertex.get();
+  _power_graph.addStaAndPwrCrossRef(sta_vertex, the_pwr_vertex);
+  _power_graph.addPowerVertex(std::move(power_vertex));
+  return the_pwr_vertex;
+}
+
+/**
+ * @brief build the power arc of the sta arc, power arc only exist for delay
+ * arc and net arc.
+ *
+ * @param sta_arc
+ */
+void PwrBuildGraph::buildArc(StaArc* sta_arc) {
+  auto* sta_src_vertex = sta_arc->get_src();
+  auto* sta_snk_vertex = sta_arc->get_snk();
+  auto* pwr_src_vertex = _power_graph.staToPwrVertex(sta_src_vertex);
+  auto* pwr_snk_vertex = _power_graph.staToPwrVertex(sta_snk_vertex);
+
+  std::unique_ptr<PwrArc> power_arc;
+  // power arc only exist for delay arc.
+  if (sta_arc->isInstArc()) {
+    if (sta_arc->isDelayArc()) {
+      power_arc = std::make_unique<PwrInstArc>(pwr_src_vertex, pwr_snk_vertex);
+      // annoate the internal power to inst arc.
+      annotateInternalPower(dynamic_cast<PwrInstArc*>(power_arc.get()),
+                            dynamic_cast<StaInstArc*>(sta_arc)->get_inst());
+    }
+  } else {
+    // net arc
+    power_arc = std::make_unique<PwrNetArc>(pwr_src_vertex, pwr_snk_vertex);
+    dynamic_cast<PwrNetArc*>(power_arc.get())
+        ->set_net(dynamic_cast<StaNetArc*>(sta_arc)->get_net());
+  }
+
+  if (power_arc) {
+    pwr_src_vertex->addSrcArc(power_arc.get());
+    pwr_snk_vertex->addSnkArc(power_arc.get());
+    _power_graph.addPowerArc(std::move(power_arc));
+  }
+}
+
+/**
+ * @brief update the power graph around the instances after the instances are
+ * resized or inserted, the sta graph should be updated before. The power
+ * vertexes of the new pins are built, the sink arcs of the instance pins and
+ * the pins on the connected nets are rebuilt from the sta arcs, so the power
+ * arc set of the resized cell is annotated again. The old arcs of all the
+ * instances are removed from the graph at once.
+ *
+ * @param insts
+ * @return unsigned
+ */
+unsigned PwrBuildGraph::buildInsts(const std::vector<Instance*>& insts) {
+  auto* sta_graph = _power_graph.get_sta_graph();
+
+  // the sta vertexes whose sink arcs may be changed.
+  std::set<StaVertex*> changed_sta_vertexes;
+  auto add_changed_vertex = [sta_graph,
+                             &changed_sta_vertexes](DesignObject* obj) {
+    auto the_sta_vertex = sta_graph->findVertex(obj);
+    LOG_FATAL_IF(!the_sta_vertex)
+        << "not found sta vertex " << obj->getFullName();
+    changed_sta_vertexes.insert(*the_sta_vertex);
+    if ((*the_sta_vertex)->is_bidirection()) {
+      changed_sta_vertexes.insert(sta_graph->getAssistant(*the_sta_vertex));
+    }
+  };
+
+  for (auto* inst : insts) {
+    Pin* pin;
+    FOREACH_INSTANCE_PIN(inst, pin) {
+      add_changed_vertex(pin);
+      if (auto* the_net = pin->get_net(); the_net) {
+        if (auto* driver_obj = the_net->getDriver(); driver_obj) {
+          add_changed_vertex(driver_obj);
+        }
+        for (auto* load_obj : the_net->getLoads()) {
+          add_changed_vertex(load_obj);
+        }
+      }
+    }
+  }
+
+  for (auto* sta_vertex : changed_sta_vertexes) {
+    buildVertex(sta_vertex);
+  }
+
+  // remove the old sink arcs, then rebuild them from the sta arcs.
+  std::set<PwrArc*> removed_arcs;
+  for (auto* sta_vertex : changed_sta_vertexes) {
+    auto* pwr_vertex = _power_graph.staToPwrVertex(sta_vertex);
+    auto snk_arcs = pwr_vertex->get_snk_arcs();
+    for (auto* snk_arc : snk_arcs) {
+      snk_arc->get_src()->removeSrcArc(snk_arc);
+      pwr_vertex->removeSnkArc(snk_arc);
+      removed_arcs.insert(snk_arc);
+    }
+  }
+  _power_graph.removePowerArcs(removed_arcs);
+
+  for (auto* sta_vertex : changed_sta_vertexes) {
+    FOREACH_SNK_ARC(sta_vertex, sta_arc) {
+      // the src vertex may be a new pin too.
+      buildVertex(sta_arc->get_src());
+      buildArc(sta_arc);
+    }
+  }
+
+  for (auto* inst : insts) {
+    if (!_power_graph.findCell(inst->get_name())) {
+      _power_graph.addPowerCell(std::make_unique<PwrCell>(inst));
+    }
+  }
+
+  return 1;
+}
+
 /**
  * @brief build power graph based on sta graph, annotate the interal power
  * information.
@@ -102,33 +233,7 @@ unsigned PwrBuildGraph::operator()(StaGraph* sta_graph) {
   // build power arc based on sta arc.
   StaArc* sta_arc;
   FOREACH_ARC(sta_graph, sta_arc) {
-    auto* sta_src_vertex = sta_arc->get_src();
-    auto* sta_snk_vertex = sta_arc->get_snk();
-    auto* pwr_src_vertex = _power_graph.staToPwrVertex(sta_src_vertex);
-    auto* pwr_snk_vertex = _power_graph.staToPwrVertex(sta_snk_vertex);
-
-    std::unique_ptr<PwrArc> power_arc;
-    // power arc only exist for delay arc.
-    if (sta_arc->isInstArc()) {
-      if (sta_arc->isDelayArc()) {
-        power_arc =
-            std::make_unique<PwrInstArc>(pwr_src_vertex, pwr_snk_vertex);
-        // annoate the internal power to inst arc.
-        annotateInternalPower(dynamic_cast<PwrInstArc*>(power_arc.get()),
-                              dynamic_cast<StaInstArc*>(sta_arc)->get_inst());
-      }
-    } else {
-      // net arc
-      power_arc = std::make_unique<PwrNetArc>(pwr_src_vertex, pwr_snk_vertex);
-      dynamic_cast<PwrNetArc*>(power_arc.get())
-          ->set_net(dynamic_cast<StaNetArc*>(sta_arc)->get_net());
-    }
-
-    if (power_arc) {
-      pwr_src_vertex->addSrcArc(power_arc.get());
-      pwr_snk_vertex->addSnkArc(power_arc.get());
-      _power_graph.addPowerArc(std::move(power_arc));
-    }
+    buildArc(sta_arc);
   }
 
   // build power cell.
@@ -40,11 +40,14 @@ class PwrBuildGraph : public StaFunc {
   explicit PwrBuildGraph(PwrGraph& power_graph) : _power_graph(power_graph) {}
   ~PwrBuildGraph() override = default;
   unsigned operator()(StaGraph* the_graph) override;
+  unsigned buildInsts(const std::vector<Instance*>& insts);
 
   auto& takePowerGraph() { return _power_graph; }
 
  private:
   unsigned annotateInternalPower(PwrInstArc* inst_power_arc, Instance* inst);
+  PwrVertex* buildVertex(StaVertex* sta_vertex);
+  void buildArc(StaArc* sta_arc);
 
   PwrGraph& _power_graph;  //!< The power graph to be build.
 };
@@ -49,20 +49,27 @@ double PwrCalcInternalPower::getToggleData(Pin* pin) {
 /**
  * @brief Calc sp data of the when condition.
  *
- * @param when
+ * @param internal_power
  * @param inst
  * @return double
  */
-double PwrCalcInternalPower::calcSPByWhen(const char* when, Instance* inst) {
-  /*Parse conditional statements of the leakage power*/
-  LibertyExprBuilder expr_builder(nullptr, when);
+double PwrCalcInternalPower::calcSPByWhen(
+    LibertyInternalPowerInfo* internal_power, Instance* inst) {
+  PwrCalcSPData calc_sp_data;
+  calc_sp_data.set_the_pwr_graph(get_the_pwr_graph());
+
+  // the when compiled when the liberty is loaded.
+  if (auto* when_expr = internal_power->get_when_expr(); when_expr) {
+    return calc_sp_data.calcSPData(when_expr, inst);
+  }
+
+  /*Parse conditional statements of the internal power*/
+  LibertyExprBuilder expr_builder(nullptr, internal_power->get_when().c_str());
   expr_builder.execute();
-  auto* expr = expr_builder.get_result_expr();
+  std::unique_ptr<LibertyExpr> expr(expr_builder.get_result_expr());
 
   /*Calc sp data.*/
-  PwrCalcSPData calc_sp_data;
-  calc_sp_data.set_the_pwr_graph(get_the_pwr_graph());
-  double sp_value = calc_sp_data.calcSPData(expr, inst);
+  double sp_value = calc_sp_data.calcSPData(expr.get(), inst);
   return sp_value;
 }
 
@@ -130,7 +137,7 @@ double PwrCalcInternalPower::calcCombInputPinPower(Instance* inst,
     auto& when = internal_power->get_when();
     if (!when.empty()) {
       // get the sp data of this condition.
-      double sp_value = calcSPByWhen(when.c_str(), inst);
+      double sp_value = calcSPByWhen(internal_power, inst);
       pin_internal_power += sp_value * the_internal_power;
     } else {
       pin_internal_power += the_internal_power;
@@ -240,29 +247,11 @@ double PwrCalcInternalPower::calcOutputPinPower(Instance* inst,
       auto& when = internal_power_info->get_when();
       if (!when.empty()) {
         // get the sp data of this condition.
-        double sp_value = calcSPByWhen(when.c_str(), inst);
+        double sp_value = calcSPByWhen(internal_power_info, inst);
         pin_internal_power += sp_value * the_arc_power;
       } else {
         pin_internal_power += the_arc_power;
       }
-
-      // for debug
-      if (0) {
-        std::ofstream out_debug("internal_out.txt");
-        out_debug << "inst: " << inst->get_name();
-        out_debug << "\nrise power :" << rise_power_mw;
-        out_debug << "\nrise input slew :" << rise_input_slew_ns;
-        out_debug << "\nrise output load :" << rise_output_load;
-
-        out_debug << "\nfall power :" << fall_power_mw;
-        out_debug << "\nfall input slew :" << fall_input_slew_ns;
-        out_debug << "\nfall output load :" << fall_output_load;
-
-        out_debug << "\nouput pin :" << output_pin->getFullName();
-        out_debug << "\ntoggle :" << output_toggle;
-
-        out_debug.close();
-      }
     }
   }
 
@@ -336,7 +325,7 @@ double PwrCalcInternalPower::calcClockPinPower(Instance* inst, Pin* clock_pin,
     auto& when = internal_power->get_when();
     if (!when.empty()) {
       // get the sp data of this condition.
-      double sp_value = calcSPByWhen(when.c_str(), inst);
+      double sp_value = calcSPByWhen(internal_power, inst);
       pin_internal_power +=
           sp_value * (output_flip_power + output_no_flip_power);
     } else {
@@ -404,7 +393,7 @@ double PwrCalcInternalPower::calcSeqInputPinPower(Instance* inst,
     auto& when = internal_power->get_when();
     if (!when.empty()) {
       // get the sp data of this condition.
-      double sp_value = calcSPByWhen(when.c_str(), inst);
+      double sp_value = calcSPByWhen(internal_power, inst);
       pin_internal_power += sp_value * the_internal_power;
     } else {
       pin_internal_power += the_internal_power;
@@ -517,11 +506,15 @@ double PwrCalcInternalPower::calcSeqInternalPower(Instance* inst) {
  */
 void PwrCalcInternalPower::printInternalPower(std::ostream& out,
                                               PwrGraph* the_graph) {
-  std::ranges::sort(_internal_powers, [](auto& left, auto& right) {
+  std::vector<PwrInternalData*> internal_powers;
+  for (auto& internal_power : _internal_powers) {
+    internal_powers.push_back(&internal_power);
+  }
+  std::ranges::sort(internal_powers, [](auto* left, auto* right) {
     return left->get_internal_power() > right->get_internal_power();
   });
 
-  for (auto& internal_power : _internal_powers) {
+  for (auto* internal_power : internal_powers) {
     auto* design_obj = internal_power->get_design_obj();
     auto* design_inst = dynamic_cast<Instance*>(design_obj);
 
@@ -531,6 +524,27 @@ void PwrCalcInternalPower::printInternalPower(std::ostream& out,
   }
 }
 
+/**
+ * @brief Calc the internal power of the instance.
+ *
+ * @param inst
+ * @return double
+ */
+double PwrCalcInternalPower::calcInstInternalPower(Instance* inst) {
+  auto* inst_cell = inst->get_inst_cell();
+  if (inst_cell->isMacroCell()) {
+    return 0.0;
+  }
+
+  if (inst_cell->isSequentialCell()) {
+    /*Calc seq internal power.*/
+    return calcSeqInternalPower(inst);
+  }
+
+  /*Calc comb internal power.*/
+  return calcCombInternalPower(inst);
+}
+
 /**
  * @brief Calc internal power.
  *
@@ -543,31 +557,29 @@ unsigned PwrCalcInternalPower::operator()(PwrGraph* the_graph) {
 
   set_the_pwr_graph(the_graph);
 
-  double inst_internal_power = 0;
-
-  PwrCell* cell;
-  FOREACH_PWR_CELL(the_graph, cell) {
-    auto* design_inst = cell->get_design_inst();
-    auto* inst_cell = design_inst->get_inst_cell();
-
-    if (inst_cell->isMacroCell()) {
-      // TODO
-    } else if (inst_cell->isSequentialCell()) {
-      /*Calc seq internal power.*/
-      inst_internal_power = calcSeqInternalPower(design_inst);
-    } else {
-      /*Calc comb internal power.*/
-      inst_internal_power = calcCombInternalPower(design_inst);
-    }
-
-    // add power analysis data.
-    addInternalPower(
-        std::make_unique<PwrInternalData>(design_inst, inst_internal_power));
-    VERBOSE_LOG(1) << "cell  " << design_inst->get_name()
-                   << "  internal power: " << inst_internal_power << "mW";
-    _internal_power_result += inst_internal_power;
+  auto& cells = the_graph->get_cells();
+  for (auto& cell : cells) {
+    _internal_powers.emplace_back(cell->get_design_inst(), 0.0);
   }
 
+  // each chunk write its own internal power data, sum the partial result.
+  _internal_power_result = parallelSum(
+      cells.size(), [this, &cells](std::size_t begin, std::size_t end) {
+        double partial_result = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+          auto* design_inst = cells[i]->get_design_inst();
+          double inst_internal_power = calcInstInternalPower(design_inst);
+
+          // add power analysis data.
+          _internal_powers[i].setPowerDataValue(inst_internal_power);
+          VERBOSE_LOG(1) << "cell  " << design_inst->get_name()
+                         << "  internal power: " << inst_internal_power
+                         << "mW";
+          partial_result += inst_internal_power;
+        }
+        return partial_result;
+      });
+
 // debug internal power
 #if 0
   std::ofstream out("internal.txt");
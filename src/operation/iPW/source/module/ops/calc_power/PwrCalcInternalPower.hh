@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <deque>
 #include <fstream>
 #include <iostream>
 
@@ -43,9 +44,11 @@ class PwrCalcInternalPower : public PwrFunc {
   auto& takeInternalPowers() { return _internal_powers; }
   void printInternalPower(std::ostream& out, PwrGraph* the_graph);
 
+  double calcInstInternalPower(Instance* inst);
+
  private:
   double getToggleData(Pin* pin);
-  double calcSPByWhen(const char* when, Instance* inst);
+  double calcSPByWhen(LibertyInternalPowerInfo* internal_power, Instance* inst);
 
   /*Clac power for pin.*/
   // comb pins
@@ -63,11 +66,8 @@ class PwrCalcInternalPower : public PwrFunc {
   double calcCombInternalPower(Instance* inst);
   double calcSeqInternalPower(Instance* inst);
 
-  void addInternalPower(std::unique_ptr<PwrInternalData> power_data) {
-    _internal_powers.emplace_back(std::move(power_data));
-  }
-  std::vector<std::unique_ptr<PwrInternalData>>
-      _internal_powers;               //!< The internal power.
+  std::deque<PwrInternalData>
+      _internal_powers;  //!< The internal power of the pwr cells.
   double _internal_power_result = 0;  //!< the sum data of internal power.
 };
 
@@ -37,19 +37,26 @@ using ieda::Stats;
  */
 double PwrCalcLeakagePower::calcLeakagePower(LibertyLeakagePower* leakage_power,
                                              Instance* inst) {
-  std::string when = leakage_power->get_when();
+  auto& when = leakage_power->get_when();
   double leakage_power_value = leakage_power->get_value();
 
   if (!when.empty()) {
-    /*Parse conditional statements of the leakage power*/
-    LibertyExprBuilder expr_builder(nullptr, when.c_str());
-    expr_builder.execute();
-    auto* expr = expr_builder.get_result_expr();
-
-    /*Calc sp data.*/
     PwrCalcSPData calc_sp_data;
     calc_sp_data.set_the_pwr_graph(get_the_pwr_graph());
-    double sp_value = calc_sp_data.calcSPData(expr, inst);
+
+    double sp_value;
+    if (auto* when_expr = leakage_power->get_when_expr(); when_expr) {
+      // the when compiled when the liberty is loaded.
+      sp_value = calc_sp_data.calcSPData(when_expr, inst);
+    } else {
+      /*Parse conditional statements of the leakage power*/
+      LibertyExprBuilder expr_builder(nullptr, when.c_str());
+      expr_builder.execute();
+      std::unique_ptr<LibertyExpr> expr(expr_builder.get_result_expr());
+
+      /*Calc sp data.*/
+      sp_value = calc_sp_data.calcSPData(expr.get(), inst);
+    }
     leakage_power_value *= sp_value;
   }
 
@@ -62,18 +69,79 @@ double PwrCalcLeakagePower::calcLeakagePower(LibertyLeakagePower* leakage_power,
  * @param out
  */
 void PwrCalcLeakagePower::printLeakagePower(std::ostream& out) {
-  std::ranges::sort(_leakage_powers, [](auto& left, auto& right) {
+  std::vector<PwrLeakageData*> leakage_powers;
+  for (auto& leakage_power : _leakage_powers) {
+    leakage_powers.push_back(&leakage_power);
+  }
+  std::ranges::sort(leakage_powers, [](auto* left, auto* right) {
     return left->get_leakage_power() > right->get_leakage_power();
   });
 
   out << "leakage power :\n";
-  for (auto& elem : _leakage_powers) {
+  for (auto* elem : leakage_powers) {
     out << elem->get_design_obj()->get_name() << " : "
         << elem->get_leakage_power() << " nW"
         << "\n";
   }
 }
 
+/**
+ * @brief Sum the leakage power without when condition of the liberty cell.
+ *
+ * @param inst_cell
+ * @return double
+ */
+double PwrCalcLeakagePower::calcCellLeakagePower(LibertyCell* inst_cell) {
+  double cell_leakage_power = 0.0;
+  LibertyLeakagePower* leakage_power;
+  FOREACH_LEAKAGE_POWER(inst_cell, leakage_power) {
+    if (leakage_power->get_when().empty()) {
+      cell_leakage_power += leakage_power->get_value();
+    }
+  }
+  return cell_leakage_power;
+}
+
+/**
+ * @brief Cache the leakage power without when condition of each liberty cell,
+ * the value is the same for all the instances of the cell.
+ *
+ * @param the_graph
+ */
+void PwrCalcLeakagePower::buildCellLeakageCache(PwrGraph* the_graph) {
+  PwrCell* cell;
+  FOREACH_PWR_CELL(the_graph, cell) {
+    auto* inst_cell = cell->get_design_inst()->get_inst_cell();
+    if (!_cell_to_leakage.contains(inst_cell)) {
+      _cell_to_leakage[inst_cell] = calcCellLeakagePower(inst_cell);
+    }
+  }
+}
+
+/**
+ * @brief Calc the leakage power of the instance, the conditional leakage power
+ * need the sp data of the instance.
+ *
+ * @param inst
+ * @return double
+ */
+double PwrCalcLeakagePower::calcInstLeakagePower(Instance* inst) {
+  auto* inst_cell = inst->get_inst_cell();
+  auto found = _cell_to_leakage.find(inst_cell);
+  double leakage_power_sum_data = (found != _cell_to_leakage.end())
+                                      ? found->second
+                                      : calcCellLeakagePower(inst_cell);
+
+  LibertyLeakagePower* leakage_power;
+  FOREACH_LEAKAGE_POWER(inst_cell, leakage_power) {
+    if (!leakage_power->get_when().empty()) {
+      leakage_power_sum_data += calcLeakagePower(leakage_power, inst);
+    }
+  }
+
+  return leakage_power_sum_data;
+}
+
 /**
  * @brief Calc leakage power of the power vertex.
  *
@@ -85,28 +153,32 @@ unsigned PwrCalcLeakagePower::operator()(PwrGraph* the_graph) {
   LOG_INFO << "calc leakage power start";
 
   set_the_pwr_graph(the_graph);
+  buildCellLeakageCache(the_graph);
 
-  PwrCell* cell;
-  FOREACH_PWR_CELL(the_graph, cell) {
-    auto* design_inst = cell->get_design_inst();
-    auto* inst_cell = design_inst->get_inst_cell();
-
-    LibertyLeakagePower* leakage_power;
-    double leakage_power_sum_data = 0;
-    FOREACH_LEAKAGE_POWER(inst_cell, leakage_power) {
-      double leakage_power_data = calcLeakagePower(leakage_power, design_inst);
-      leakage_power_sum_data += leakage_power_data;
-    }
-
-    // add power analysis data.
-    addLeakagePower(
-        std::make_unique<PwrLeakageData>(design_inst, leakage_power_sum_data));
-    VERBOSE_LOG(2) << "cell  " << design_inst->get_name()
-                   << "  leakage power: " << leakage_power_sum_data << " nW";
-
-    _leakage_power_result += leakage_power_sum_data;
+  auto& cells = the_graph->get_cells();
+  for (auto& cell : cells) {
+    _leakage_powers.emplace_back(cell->get_design_inst(), 0.0);
   }
 
+  // each chunk write its own leakage power data, sum the partial result.
+  _leakage_power_result = parallelSum(
+      cells.size(), [this, &cells](std::size_t begin, std::size_t end) {
+        double partial_result = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+          auto* design_inst = cells[i]->get_design_inst();
+          double leakage_power_sum_data = calcInstLeakagePower(design_inst);
+
+          // add power analysis data.
+          _leakage_powers[i].setPowerDataValue(leakage_power_sum_data);
+          VERBOSE_LOG(2) << "cell  " << design_inst->get_name()
+                         << "  leakage power: " << leakage_power_sum_data
+                         << " nW";
+
+          partial_result += leakage_power_sum_data;
+        }
+        return partial_result;
+      });
+
   // debug leakage power
   // std::ofstream out("leakage.txt");
   // printLeakagePower(out);
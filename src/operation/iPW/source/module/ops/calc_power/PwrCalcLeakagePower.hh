@@ -24,8 +24,10 @@
 
 #pragma once
 
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
 
 #include "PwrCalcSPData.hh"
 #include "core/PwrAnalysisData.hh"
@@ -44,17 +46,20 @@ class PwrCalcLeakagePower : public PwrFunc {
   unsigned operator()(PwrGraph* the_graph) override;
   auto& takeLeakagePowers() { return _leakage_powers; }
 
+  double calcInstLeakagePower(Instance* inst);
+
  private:
   double calcLeakagePower(LibertyLeakagePower* leakage_power, Instance* inst);
-
-  void addLeakagePower(std::unique_ptr<PwrLeakageData> power_data) {
-    _leakage_powers.emplace_back(std::move(power_data));
-  }
+  double calcCellLeakagePower(LibertyCell* inst_cell);
+  void buildCellLeakageCache(PwrGraph* the_graph);
 
   void printLeakagePower(std::ostream& out);
 
-  std::vector<std::unique_ptr<PwrLeakageData>>
-      _leakage_powers;               //!< The leakage power.
+  std::deque<PwrLeakageData>
+      _leakage_powers;  //!< The leakage power of the pwr cells.
+  std::unordered_map<LibertyCell*, double>
+      _cell_to_leakage;  //!< The leakage power sum without when condition of
+                         //!< the liberty cell, shared by the instances.
   double _leakage_power_result = 0;  //!< the sum data of leakage power.
 };
 }  // namespace ipower
\ No newline at end of file
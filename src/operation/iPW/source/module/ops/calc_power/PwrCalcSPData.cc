@@ -47,11 +47,21 @@ double PwrCalcSPData::getSPData(std::string_view port_name, Instance* inst) {
                               << inst->get_inst_cell()->get_cell_name()
                               << " not found pin " << port_name;
 
+  return getSPData(the_find_pin);
+}
+
+/**
+ * @brief Get SP data of the pin.
+ *
+ * @param pin
+ * @return double
+ */
+double PwrCalcSPData::getSPData(Pin* pin) {
   // find power vertex
   PwrVertex* the_pwr_vertex = nullptr;
   auto* the_pwr_graph = get_the_pwr_graph();
   auto* the_sta_graph = the_pwr_graph->get_sta_graph();
-  auto the_sta_vertex = the_sta_graph->findVertex(the_find_pin);
+  auto the_sta_vertex = the_sta_graph->findVertex(pin);
   if (the_sta_vertex) {
     the_pwr_vertex = the_pwr_graph->staToPwrVertex(*the_sta_vertex);
   } else {
@@ -134,4 +144,22 @@ double PwrCalcSPData::calcSPData(LibertyExpr* expr, Instance* inst) {
   return sp_data;
 }
 
+/**
+ * @brief Calc sp data of the compiled when, the ports are resolved to the
+ * instance pins without the port name lookup.
+ *
+ * @param when_expr
+ * @param inst
+ * @return double
+ */
+double PwrCalcSPData::calcSPData(const LibertyWhenExpr* when_expr,
+                                 Instance* inst) {
+  return when_expr->calcSP([this, inst](LibertyPort* port) {
+    if (auto* pin = inst->findPin(port); pin) {
+      return getSPData(pin);
+    }
+    return getSPData(port->get_port_name(), inst);
+  });
+}
+
 }  // namespace ipower
\ No newline at end of file
@@ -35,6 +35,8 @@ namespace ipower {
 class PwrCalcSPData : public PwrFunc {
  public:
   double getSPData(std::string_view port_name, Instance* inst);
+  double getSPData(Pin* pin);
   double calcSPData(LibertyExpr* expr, Instance* inst);
+  double calcSPData(const LibertyWhenExpr* when_expr, Instance* inst);
 };
 }  // namespace ipower
\ No newline at end of file
@@ -36,14 +36,18 @@ using ieda::Stats;
  */
 void PwrCalcSwitchPower::printSwitchPower(std::ostream& out,
                                           PwrGraph* the_graph) {
-  std::ranges::sort(_switch_powers, [](auto& left, auto& right) {
+  std::vector<PwrSwitchData*> switch_powers;
+  for (auto& switch_power : _switch_powers) {
+    switch_powers.push_back(&switch_power);
+  }
+  std::ranges::sort(switch_powers, [](auto* left, auto* right) {
     return left->get_switch_power() > right->get_switch_power();
   });
 
   auto* seq_graph = the_graph->get_pwr_seq_graph();
 
   out << "switch power :\n";
-  for (auto& elem : _switch_powers) {
+  for (auto* elem : switch_powers) {
     auto* design_net = dynamic_cast<Net*>(elem->get_design_obj());
     PwrSeqVertex* seq_vertex;
     auto* driver_obj = design_net->getDriver();
@@ -79,6 +83,46 @@ void PwrCalcSwitchPower::printSwitchPower(std::ostream& out,
   }
 }
 
+/**
+ * @brief Calc the switch power of the net driver.
+ *
+ * @param the_graph
+ * @param net
+ * @return double
+ */
+double PwrCalcSwitchPower::calcNetSwitchPower(PwrGraph* the_graph, Net* net) {
+  auto* driver_obj = net->getDriver();
+
+  auto* the_sta_graph = the_graph->get_sta_graph();
+  auto driver_sta_vertex = the_sta_graph->findVertex(driver_obj);
+
+  PwrVertex* driver_pwr_vertex = nullptr;
+  if (driver_sta_vertex) {
+    driver_pwr_vertex = the_graph->staToPwrVertex(*driver_sta_vertex);
+  } else {
+    LOG_FATAL << "not found driver sta vertex.";
+  }
+
+  // get VDD
+  auto driver_voltage = driver_pwr_vertex->getDriveVoltage();
+  if (!driver_voltage) {
+    LOG_FATAL << "can not get driver voltage.";
+  }
+  double vdd = driver_voltage.value();
+
+  // get Capacitance
+  double cap = (*driver_sta_vertex)->getNetLoad();
+
+  // get Toggle
+  double toggle = driver_pwr_vertex->getToggleData(std::nullopt);
+
+  // calc swich power of the arc.
+  // swich_power = k*toggle*Cap*(VDD^2)
+  double arc_swich_power = c_switch_power_K * toggle * cap * vdd * vdd;
+
+  return arc_swich_power;
+}
+
 /**
  * @brief Calc switch power.
  *
@@ -93,56 +137,33 @@ unsigned PwrCalcSwitchPower::operator()(PwrGraph* the_graph) {
   auto* sta_graph = the_graph->get_sta_graph();
   auto* nl = sta_graph->get_nl();
 
+  // the nets are stored in list, index them for the chunks.
+  std::vector<Net*> nets;
+  nets.reserve(nl->getNetNum());
   Net* net;
-  /*Calc switch power for power net arc.*/
   FOREACH_NET(nl, net) {
-    auto* driver_obj = net->getDriver();
-
-    auto* the_sta_graph = the_graph->get_sta_graph();
-    auto driver_sta_vertex = the_sta_graph->findVertex(driver_obj);
-
-    PwrVertex* driver_pwr_vertex = nullptr;
-    if (driver_sta_vertex) {
-      driver_pwr_vertex = the_graph->staToPwrVertex(*driver_sta_vertex);
-    } else {
-      LOG_FATAL << "not found driver sta vertex.";
-    }
-
-    // get VDD
-    auto driver_voltage = driver_pwr_vertex->getDriveVoltage();
-    if (!driver_voltage) {
-      LOG_FATAL << "can not get driver voltage.";
-    }
-    double vdd = driver_voltage.value();
-
-    // get Capacitance
-    double cap = (*driver_sta_vertex)->getNetLoad();
-
-    // get Toggle
-    double toggle = driver_pwr_vertex->getToggleData(std::nullopt);
-
-    // calc swich power of the arc.
-    // swich_power = k*toggle*Cap*(VDD^2)
-    double arc_swich_power = c_switch_power_K * toggle * cap * vdd * vdd;
-    // add power analysis data.
-    addSwitchPower(std::make_unique<PwrSwitchData>(net, arc_swich_power));
-    VERBOSE_LOG(2) << "net  " << net->get_name()
-                   << "  switch power: " << arc_swich_power << "mW";
-
-    // for debug
-    if (0) {
-      std::ofstream out_debug("switch_out.txt");
-
-      out_debug << "toggle :" << toggle;
-      out_debug << "\ncap :" << cap;
-      out_debug << "\nvdd :" << vdd;
-
-      out_debug.close();
-    }
-
-    _switch_power_result += arc_swich_power;
+    nets.push_back(net);
+    _switch_powers.emplace_back(net, 0.0);
   }
 
+  /*Calc switch power for power net arc.*/
+  _switch_power_result = parallelSum(
+      nets.size(),
+      [this, the_graph, &nets](std::size_t begin, std::size_t end) {
+        double partial_result = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+          auto* the_net = nets[i];
+          double arc_swich_power = calcNetSwitchPower(the_graph, the_net);
+          // add power analysis data.
+          _switch_powers[i].setPowerDataValue(arc_swich_power);
+          VERBOSE_LOG(2) << "net  " << the_net->get_name()
+                         << "  switch power: " << arc_swich_power << "mW";
+
+          partial_result += arc_swich_power;
+        }
+        return partial_result;
+      });
+
 #if 0
   // debug switch power
   std::ofstream out("switch.txt");
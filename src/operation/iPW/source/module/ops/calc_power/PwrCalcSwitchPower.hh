@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <deque>
 #include <fstream>
 #include <iostream>
 
@@ -44,13 +45,10 @@ class PwrCalcSwitchPower : public PwrFunc {
 
   void printSwitchPower(std::ostream& out, PwrGraph* the_graph);
 
- private:
-  void addSwitchPower(std::unique_ptr<PwrSwitchData> power_data) {
-    _switch_powers.emplace_back(std::move(power_data));
-  }
+  double calcNetSwitchPower(PwrGraph* the_graph, Net* net);
 
-  std::vector<std::unique_ptr<PwrSwitchData>>
-      _switch_powers;               //!< The switch power.
+ private:
+  std::deque<PwrSwitchData> _switch_powers;  //!< The switch power of the nets.
   double _switch_power_result = 0;  //!< the sum data of switch power.
 };
 }  // namespace ipower
\ No newline at end of file
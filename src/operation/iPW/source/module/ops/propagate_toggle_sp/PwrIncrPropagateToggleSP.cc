@@ -0,0 +1,152 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file PwrIncrPropagateToggleSP.cc
+ * @brief Incremental propagate toggle and sp after the netlist is changed.
+ * @version 0.1
+ * @date 2025-03-24
+ */
+
+#include "PwrIncrPropagateToggleSP.hh"
+
+#include <queue>
+#include <unordered_set>
+
+namespace ipower {
+using ieda::Stats;
+
+/**
+ * @brief find the seq vertex of the data in vertex or output port vertex.
+ *
+ * @param data_in_vertex
+ * @return PwrSeqVertex*
+ */
+PwrSeqVertex* PwrIncrPropagateToggleSP::findSeqVertex(
+    PwrVertex* data_in_vertex) {
+  if (auto* own_seq_vertex = data_in_vertex->get_own_seq_vertex();
+      own_seq_vertex) {
+    return own_seq_vertex;
+  }
+
+  auto* the_seq_graph = get_the_pwr_seq_graph();
+  if (data_in_vertex->is_output_port()) {
+    return the_seq_graph->getPortSeqVertex(data_in_vertex);
+  }
+  return the_seq_graph->getSeqVertex(data_in_vertex->getOwnInstance());
+}
+
+/**
+ * @brief collect the fanout cone of the seed vertexes by bfs, the cone go
+ * through the seq vertex from the data in to the data out, the clock network
+ * is not changed by the data propagation.
+ *
+ */
+void PwrIncrPropagateToggleSP::collectCone() {
+  std::unordered_set<PwrVertex*> visited_vertexes;
+  std::unordered_set<PwrSeqVertex*> visited_seq_vertexes;
+  std::queue<PwrVertex*> bfs_queue;
+
+  auto visit = [&visited_vertexes, &bfs_queue](PwrVertex* the_vertex) {
+    if (!the_vertex->is_clock_network() &&
+        visited_vertexes.insert(the_vertex).second) {
+      bfs_queue.push(the_vertex);
+    }
+  };
+
+  std::ranges::for_each(_seed_vertexes, visit);
+
+  while (!bfs_queue.empty()) {
+    auto* the_vertex = bfs_queue.front();
+    bfs_queue.pop();
+    _cone_vertexes.push_back(the_vertex);
+
+    if (the_vertex->isSeqClockPin()) {
+      continue;
+    }
+
+    if ((the_vertex->isSeqPin() && the_vertex->isSeqDataIn()) ||
+        the_vertex->is_output_port()) {
+      auto* seq_vertex = findSeqVertex(the_vertex);
+      if (seq_vertex && visited_seq_vertexes.insert(seq_vertex).second) {
+        _cone_seq_vertexes.push_back(seq_vertex);
+        if (!seq_vertex->isOutputPort()) {
+          std::ranges::for_each(seq_vertex->get_seq_out_vertexes(), visit);
+        }
+      }
+      continue;
+    }
+
+    FOREACH_SRC_PWR_ARC(the_vertex, src_arc) { visit(src_arc->get_snk()); }
+  }
+}
+
+/**
+ * @brief Incremental propagate toggle and SP.
+ *
+ * @param the_graph
+ * @return unsigned
+ */
+unsigned PwrIncrPropagateToggleSP::operator()(PwrGraph* the_graph) {
+  Stats stats;
+  set_the_pwr_graph(the_graph);
+  set_the_pwr_seq_graph(the_graph->get_pwr_seq_graph());
+
+  LOG_INFO << "incremental propagate toggle sp start";
+
+  collectCone();
+
+  // the input port and const data is not from propagation.
+  for (auto* cone_vertex : _cone_vertexes) {
+    if (!cone_vertex->is_input_port() && !cone_vertex->is_const()) {
+      cone_vertex->resetPropagatedToggleSP();
+    }
+  }
+
+  // the lower level seq vertex data out is the higher level data in source.
+  std::ranges::stable_sort(_cone_seq_vertexes, [](auto* left, auto* right) {
+    return left->get_level() < right->get_level();
+  });
+
+  unsigned is_ok = 1;
+  for (auto* seq_vertex : _cone_seq_vertexes) {
+    if (seq_vertex->get_level() == 0 || seq_vertex->isConst()) {
+      continue;
+    }
+    is_ok &= propagateFromSeq(seq_vertex);
+  }
+
+  // the vertexes not reach the seq vertex, such as dangling output.
+  for (auto* cone_vertex : _cone_vertexes) {
+    is_ok &= cone_vertex->exec(*this);
+  }
+
+  LOG_INFO << "incremental propagate toggle sp vertexes "
+           << _cone_vertexes.size() << " seq vertexes "
+           << _cone_seq_vertexes.size();
+  LOG_INFO << "incremental propagate toggle sp end";
+
+  double memory_delta = stats.memoryDelta();
+  LOG_INFO << "incremental propagate toggle sp memory usage " << memory_delta
+           << "MB";
+  double time_delta = stats.elapsedRunTime();
+  LOG_INFO << "incremental propagate toggle sp time elapsed " << time_delta
+           << "s";
+
+  return is_ok;
+}
+
+}  // namespace ipower
@@ -0,0 +1,63 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file PwrIncrPropagateToggleSP.hh
+ * @brief Incremental propagate toggle and sp after the netlist is changed.
+ * @version 0.1
+ * @date 2025-03-24
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "PwrPropagateToggleSP.hh"
+
+namespace ipower {
+
+/**
+ * @brief Incremental propagate toggle and sp.
+ *
+ * The seed vertexes are the pins of the changed instances. The fanout cone of
+ * the seeds is collected until the seq data in vertexes, the data out vertexes
+ * of these seq vertexes are the seeds too. The propagation data of the cone is
+ * reset, then the seq vertexes in the cone are propagated in level order as
+ * the full propagation, the vertexes out of the cone keep their data.
+ */
+class PwrIncrPropagateToggleSP : public PwrPropagateToggleSP {
+ public:
+  explicit PwrIncrPropagateToggleSP(std::vector<PwrVertex*>&& seed_vertexes)
+      : _seed_vertexes(std::move(seed_vertexes)) {}
+  ~PwrIncrPropagateToggleSP() override = default;
+
+  using PwrPropagateToggleSP::operator();
+  unsigned operator()(PwrGraph* the_graph) override;
+
+  auto& get_cone_vertexes() { return _cone_vertexes; }
+
+ private:
+  PwrSeqVertex* findSeqVertex(PwrVertex* data_in_vertex);
+  void collectCone();
+
+  std::vector<PwrVertex*> _seed_vertexes;  //!< The vertexes changed.
+  std::vector<PwrVertex*>
+      _cone_vertexes;  //!< The fanout cone to be propagated again.
+  std::vector<PwrSeqVertex*>
+      _cone_seq_vertexes;  //!< The seq vertexes whose data in is in the cone.
+};
+
+}  // namespace ipower
@@ -183,6 +183,52 @@ unsigned PwrPropagateToggleSP::operator()(PwrVertex* the_vertex) {
   return 1;
 }
 
+/**
+ * @brief Propagate toggle and SP from a seq vertex, propagate the data in
+ * vertexes, then save the results to the data out vertex.
+ *
+ * @param seq_vertex
+ * @return unsigned
+ */
+unsigned PwrPropagateToggleSP::propagateFromSeq(PwrSeqVertex* seq_vertex) {
+  /*Start from data in vertex and work forward.*/
+  auto data_in_vertexes = seq_vertex->getDataInVertexes();
+  unsigned is_ok = 1;
+
+  for (auto* data_in_vertex : data_in_vertexes) {
+    VERBOSE_LOG(2) << "propagate toggle sp from data in vertex "
+                   << data_in_vertex->getName() << " start.";
+    is_ok &= data_in_vertex->exec(*this);
+
+    VERBOSE_LOG(2) << "propagate toggle sp from data in vertex "
+                   << data_in_vertex->getName() << " end.";
+  }
+
+  /*Save the results to dataout vertex.*/
+  if (!seq_vertex->isOutputPort()) {
+    // TODO Disregard macro, (data in /data out) have only one vertex.
+    auto& data_out_vertexes = seq_vertex->get_seq_out_vertexes();
+    auto* data_out_vertex = (*data_out_vertexes.begin());
+    auto* data_in_vertex = (*data_in_vertexes.begin());
+
+    // Get the data in vertex's data.
+    auto seq_toggle_sp_data = getToggleSPData(data_in_vertex);
+
+    // Convert the seq data in toggle sp data to data out toggle sp data.
+    auto seq_data_out_toggle_sp = calcSeqDataOutToggleSP(
+        data_in_vertex, data_out_vertex, seq_toggle_sp_data);
+    // get the fastest clock
+    auto* the_pwr_graph = get_the_pwr_graph();
+    auto& the_fastest_clock = the_pwr_graph->get_fastest_clock();
+    data_out_vertex->addData(seq_data_out_toggle_sp._toggle_value,
+                             seq_data_out_toggle_sp._sp_value,
+                             PwrDataSource::kDataPropagation,
+                             &the_fastest_clock);
+  }
+
+  return is_ok;
+}
+
 /**
  * @brief Propagate toggle and SP.
  *
@@ -198,46 +244,6 @@ unsigned PwrPropagateToggleSP::operator()(PwrGraph* the_graph) {
 
   LOG_INFO << "propagate toggle sp start";
   {
-    /*Lambda function of propagate toggle and SP from a seq vertex.*/
-    auto propagate_from_seq = [this](PwrSeqVertex* seq_vertex) {
-      /*Start from data in vertex and work forward.*/
-      auto data_in_vertexes = seq_vertex->getDataInVertexes();
-      unsigned is_ok = 1;
-
-      for (auto* data_in_vertex : data_in_vertexes) {
-        VERBOSE_LOG(2) << "propagate toggle sp from data in vertex "
-                       << data_in_vertex->getName() << " start.";
-        is_ok &= data_in_vertex->exec(*this);
-
-        VERBOSE_LOG(2) << "propagate toggle sp from data in vertex "
-                       << data_in_vertex->getName() << " end.";
-      }
-
-      /*Save the results to dataout vertex.*/
-      if (!seq_vertex->isOutputPort()) {
-        // TODO Disregard macro, (data in /data out) have only one vertex.
-        auto& data_out_vertexes = seq_vertex->get_seq_out_vertexes();
-        auto* data_out_vertex = (*data_out_vertexes.begin());
-        auto* data_in_vertex = (*data_in_vertexes.begin());
-
-        // Get the data in vertex's data.
-        auto seq_toggle_sp_data = getToggleSPData(data_in_vertex);
-
-        // Convert the seq data in toggle sp data to data out toggle sp data.
-        auto seq_data_out_toggle_sp = calcSeqDataOutToggleSP(
-            data_in_vertex, data_out_vertex, seq_toggle_sp_data);
-        // get the fastest clock
-        auto* the_pwr_graph = get_the_pwr_graph();
-        auto& the_fastest_clock = the_pwr_graph->get_fastest_clock();
-        data_out_vertex->addData(seq_data_out_toggle_sp._toggle_value,
-                                 seq_data_out_toggle_sp._sp_value,
-                                 PwrDataSource::kDataPropagation,
-                                 &the_fastest_clock);
-      }
-
-      return is_ok;
-    };
-
 /*Calculate the toggle and SP of the current layer starting from 1th
  * level.*/
 #if MULTI_THREAD
@@ -264,10 +270,14 @@ unsigned PwrPropagateToggleSP::operator()(PwrGraph* the_graph) {
 /*Select whether to use multithreading for propagate toggle and SP from a seq
  * vertex.*/
 #if MULTI_THREAD
-        futures.emplace_back(seq_vertex, the_same_level_thread_pool.enqueue(
-                                             propagate_from_seq, seq_vertex));
+        futures.emplace_back(
+            seq_vertex, the_same_level_thread_pool.enqueue(
+                            [this](PwrSeqVertex* seq_vertex) {
+                              return propagateFromSeq(seq_vertex);
+                            },
+                            seq_vertex));
 #else
-        propagate_from_seq(seq_vertex);
+        propagateFromSeq(seq_vertex);
 #endif
 
         if (isTrace()) {
@@ -47,6 +47,9 @@ class PwrPropagateToggleSP : public PwrFunc {
   unsigned operator()(PwrGraph* the_graph) override;
   unsigned operator()(PwrVertex* the_vertex) override;
 
+ protected:
+  unsigned propagateFromSeq(PwrSeqVertex* seq_vertex);
+
  private:
   PwrToggleSPData getToggleSPData(PwrVertex* the_vertex);
   PwrToggleSPData calcSeqDataOutToggleSP(
@@ -102,7 +102,7 @@ std::vector<AnnotateTime> VcdScalarCounter::countDuration() {
   auto& last_time_signal_value = signal_time_values->back();
   auto last_time = last_time_signal_value.time;
   auto last_bit_value = last_time_signal_value.value.get_value_bit();
-  auto last_time_duration = simulation_end_time - last_time;
+  auto last_time_duration = getDuration(last_time, simulation_end_time);
   auto update_duration_func =
       getUpdateDurationFunc(annotate_signal_duration_time, last_bit_value);
   update_duration_func(last_time_duration);
@@ -131,7 +131,8 @@ void VcdScalarCounter::run() {
   }
 
   auto* record_data =
-      _annotate_db->findSignalRecord(parent_instance_names, _signal->reference);
+      _annotate_db->findSignalRecord(parent_instance_names,
+                                     scalarSignalName(_signal));
   LOG_FATAL_IF(!record_data) << "not found record data";
 
   *record_data = std::move(annotate_record);
@@ -149,10 +150,6 @@ std::vector<AnnotateToggle> VcdBusCounter::countTcAndGlitch() {
   auto* trace_vcd_file = get_trace();
   auto* signal_time_values = trace_vcd_file->get_signal_values(signal_hash);
 
-  // count the toggle, if current signal value is rise transition or fall
-  // transition, count add one.
-  VCDTimedValue* prev_time_signal_value = nullptr;
-
   int lindex = the_signal->lindex;
   int rindex = the_signal->rindex;
   int bus_size = lindex - rindex + 1;
@@ -160,6 +157,9 @@ std::vector<AnnotateToggle> VcdBusCounter::countTcAndGlitch() {
   // loop access to the bus signal
   for (auto i = rindex; i <= lindex; ++i) {
     int vec_i = lindex - i;  // bus signal value is high bit first.
+    // count the toggle, if current signal value is rise transition or fall
+    // transition, count add one, each bit starts from its first value.
+    VCDTimedValue* prev_time_signal_value = nullptr;
     for (auto& signal_time_value : *signal_time_values) {
       if (prev_time_signal_value) {
         if (isTransition(prev_time_signal_value, &signal_time_value, vec_i)) {
@@ -246,7 +246,7 @@ std::vector<AnnotateTime> VcdBusCounter::countDuration() {
     auto last_time = last_time_signal_value.time;
     auto last_bit_value =
         last_time_signal_value.value.get_value_vector()[vec_i];
-    auto last_time_duration = simulation_end_time - last_time;
+    auto last_time_duration = getDuration(last_time, simulation_end_time);
     auto update_duration_func =
         getUpdateDurationFunc(annotate_signal_duration_time, last_bit_value);
     update_duration_func(last_time_duration);
@@ -306,15 +306,29 @@ bool VcdParserWrapper::readVCD(
     // FIXME change to optional begin and endtime
     std::optional<std::pair<int64_t, int64_t>> begin_end_time) {
   // assume begin time and end time scale is the same with vcd file.
-  VCDFileParser parser;
   if (begin_end_time) {
     std::tie(_begin_time, _end_time) = begin_end_time.value();
-    parser.start_time = _begin_time.value();
-    parser.end_time = _end_time.value();
   }
 
   std::string vcd_file_path(vcd_path.data(), vcd_path.size());
 
+  if (_is_stream_read) {
+    // only read the header, the value changes are counted when calc toggle
+    // and sp.
+    _stream_reader = std::make_unique<VcdStreamReader>(vcd_file_path);
+    _stream_reader->set_min_chunk_size(_min_chunk_size);
+    _trace = _stream_reader->readHeader(begin_end_time);
+    return _trace ? true : false;
+  }
+
+  _stream_reader.reset();
+  // the values before the begin time are kept for the value at the begin
+  // time, the counters only count within the begin and end time.
+  VCDFileParser parser;
+  if (begin_end_time) {
+    parser.end_time = _end_time.value();
+  }
+
   auto* trace_file = parser.parse_file(vcd_file_path);
   _trace.reset(trace_file);
 
@@ -365,6 +379,7 @@ unsigned VcdParserWrapper::buildAnnotateDB(
     // User set timescale end time
     if (_begin_time) {
       // User set timescale begin time
+      _annotate_db.set_simulation_start_time(_begin_time.value());
       _annotate_db.set_simulation_duration(_end_time.value() -
                                            _begin_time.value());
     } else {
@@ -403,7 +418,7 @@ unsigned VcdParserWrapper::buildAnnotateDB(
               if (signal->size == 1) {
                 // scalar signal
                 auto annotate_signal =
-                    std::make_unique<AnnotateSignal>(signal->reference);
+                    std::make_unique<AnnotateSignal>(scalarSignalName(signal));
                 the_scope_instance_ptr->addSignal(std::move(annotate_signal));
               } else {
                 // bus signal
@@ -436,6 +451,11 @@ unsigned VcdParserWrapper::buildAnnotateDB(
  * @return unsigned return 1 if success, else 0.
  */
 unsigned VcdParserWrapper::calcScopeToggleAndSp() {
+  if (_stream_reader) {
+    return _stream_reader->countActivity(_top_instance_scope, &_annotate_db,
+                                         _num_threads);
+  }
+
   /*lambda function of count signal tc etc.*/
   auto count_signal = [this](auto* scope_signal) {
     if (scope_signal->size == 1) {
@@ -451,8 +471,7 @@ unsigned VcdParserWrapper::calcScopeToggleAndSp() {
     }
   };
   /*first, traverse the scope signal, build the counter thread.*/
-  std::size_t num_thread = 48;
-  ThreadPool thread_pool(num_thread);
+  ThreadPool thread_pool(_num_threads);
   /*traverse the hier scope*/
   std::function<void(VCDScope*)> traverse_scope =
       [&traverse_scope, &count_signal, &thread_pool, this](auto* parent_scope) {
@@ -24,11 +24,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <optional>
 
 #include "VCDFileParser.hpp"
+#include "VCDStreamReader.hh"
+#include "include/PwrConfig.hh"
 #include "log/Log.hh"
 #include "ops/annotate_toggle_sp/AnnotateData.hh"
 
@@ -91,7 +94,9 @@ class VcdScalarCounter : public VcdCounter {
     // not the same, judge is transition.
     auto prev_time = prev_signal_value->time;
     auto curr_time = curr_signal_value->time;
-    if (prev_time == curr_time) {
+    if ((prev_time == curr_time) ||
+        (curr_time < static_cast<int64_t>(
+                         _annotate_db->get_simulation_sart_time()))) {
       return false;
     }
 
@@ -108,12 +113,19 @@ class VcdScalarCounter : public VcdCounter {
     return (prev_bit_value != VCD_X) && (curr_bit_value != VCD_X) &&
            (prev_bit_value != curr_bit_value);
   }
+  /*the duration from begin time to end time within the simulation time.*/
+  int64_t getDuration(int64_t begin_time, int64_t end_time) {
+    int64_t simulation_start_time = _annotate_db->get_simulation_sart_time();
+    int64_t simulation_end_time = _annotate_db->getSimulationEndTime();
+    return std::max(int64_t(0), std::min(end_time, simulation_end_time) -
+                                    std::max(begin_time, simulation_start_time));
+  }
   auto getDuration(VCDTimedValue* prev_time_signal_value,
                    VCDTimedValue* curr_time_signal_value) {
     auto prev_time = prev_time_signal_value->time;
     auto cur_time = curr_time_signal_value->time;
 
-    return cur_time - prev_time;
+    return getDuration(prev_time, cur_time);
   }
   auto getUpdateDurationFunc(AnnotateTime& annotate_signal_duration_time,
                              VCDBit bit_value) {
@@ -171,9 +183,23 @@ class VcdParserWrapper {
   void printAnnotateDB(std::ostream& out) { _annotate_db.printAnnotateDB(out); }
   auto* get_annotate_db() { return &_annotate_db; }
 
+  void set_is_stream_read(bool is_stream_read) {
+    _is_stream_read = is_stream_read;
+  }
+  void set_num_threads(int num_threads) { _num_threads = num_threads; }
+  void set_min_chunk_size(std::size_t min_chunk_size) {
+    _min_chunk_size = min_chunk_size;
+  }
+
  private:
   std::unique_ptr<VCDFile> _trace;  //!< The parsed vcd file, may be only record
                                     //!< according begin time and end time.
+  std::unique_ptr<VcdStreamReader>
+      _stream_reader;  //!< The stream reader, the _trace is only the header.
+  bool _is_stream_read = true;  //!< Whether count the vcd when streaming.
+  int _num_threads = c_num_threads;  //!< The thread num of counting the signal.
+  std::size_t _min_chunk_size =
+      64 * 1024 * 1024;  //!< The min bytes of the time range read in parallel.
   VCDScope* _top_instance_scope;    //!< The specifid top instance scope of vcd.
   std::optional<int64_t> _begin_time;  //!< simulation begin time.
   std::optional<int64_t> _end_time;    //!< simulation end time.
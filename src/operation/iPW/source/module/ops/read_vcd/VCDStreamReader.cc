@@ -0,0 +1,583 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file VCDStreamReader.cc
+ * @brief The streaming vcd reader.
+ * @version 0.1
+ * @date 2025-03-10
+ */
+#include "VCDStreamReader.hh"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <functional>
+#include <map>
+
+#include "ThreadPool/ThreadPool.h"
+#include "fs.hh"
+
+namespace ipower {
+
+namespace {
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+/*get the next white space separated token, empty if reach the end.*/
+std::string_view nextToken(const char*& curr, const char* end) {
+  while (curr < end && isSpace(*curr)) {
+    ++curr;
+  }
+  const char* token_begin = curr;
+  while (curr < end && !isSpace(*curr)) {
+    ++curr;
+  }
+  return {token_begin, static_cast<std::size_t>(curr - token_begin)};
+}
+
+/*skip the tokens of the command until $end.*/
+void skipToEnd(const char*& curr, const char* end) {
+  for (auto token = nextToken(curr, end); !token.empty() && token != "$end";
+       token = nextToken(curr, end)) {
+  }
+}
+
+int64_t toInteger(std::string_view str) {
+  int64_t value = 0;
+  std::from_chars(str.data(), str.data() + str.size(), value);
+  return value;
+}
+
+VCDBit toVCDBit(char c) {
+  switch (c) {
+    case '0':
+      return VCD_0;
+    case '1':
+      return VCD_1;
+    case 'z':
+    case 'Z':
+      return VCD_Z;
+    default:
+      return VCD_X;
+  }
+}
+
+VCDVarType toVarType(std::string_view var_type) {
+  static const std::map<std::string_view, VCDVarType> var_types = {
+      {"event", VCD_VAR_EVENT},     {"integer", VCD_VAR_INTEGER},
+      {"parameter", VCD_VAR_PARAMETER}, {"real", VCD_VAR_REAL},
+      {"realtime", VCD_VAR_REALTIME}, {"reg", VCD_VAR_REG},
+      {"supply0", VCD_VAR_SUPPLY0}, {"supply1", VCD_VAR_SUPPLY1},
+      {"time", VCD_VAR_TIME},       {"tri", VCD_VAR_TRI},
+      {"triand", VCD_VAR_TRIAND},   {"trior", VCD_VAR_TRIOR},
+      {"trireg", VCD_VAR_TRIREG},   {"tri0", VCD_VAR_TRI0},
+      {"tri1", VCD_VAR_TRI1},       {"wand", VCD_VAR_WAND},
+      {"wire", VCD_VAR_WIRE},       {"wor", VCD_VAR_WOR}};
+  auto found = var_types.find(var_type);
+  return found != var_types.end() ? found->second : VCD_VAR_EVENT;
+}
+
+VCDTimeUnit toTimeUnit(std::string_view time_unit) {
+  static const std::map<std::string_view, VCDTimeUnit> time_units = {
+      {"s", TIME_S},   {"ms", TIME_MS}, {"us", TIME_US},
+      {"ns", TIME_NS}, {"ps", TIME_PS}, {"fs", TIME_FS}};
+  auto found = time_units.find(time_unit);
+  return found != time_units.end() ? found->second : TIME_S;
+}
+
+/*the scope names from the signal scope to the top instance, top is excluded.*/
+std::vector<std::string_view> getParentInstanceNames(
+    VCDSignal* signal, VCDScope* top_instance_scope) {
+  std::vector<std::string_view> parent_instance_names;
+  auto* signal_scope = signal->scope;
+  while (signal_scope && (signal_scope != top_instance_scope)) {
+    parent_instance_names.emplace_back(signal_scope->name);
+    signal_scope = signal_scope->parent;
+  }
+  return parent_instance_names;
+}
+
+}  // namespace
+
+VcdStreamReader::VcdStreamReader(const std::string& vcd_path)
+    : _mfile(std::make_unique<os::fs::MemoryMappedFile>(vcd_path)) {
+  _read_stats.file_size = _mfile->end() - _mfile->begin();
+}
+
+VcdStreamReader::~VcdStreamReader() = default;
+
+/**
+ * @brief read the vcd header, build the scopes and the signals.
+ *
+ * @param begin_end_time the count begin-end time, unit is vcd time scale.
+ * @return std::unique_ptr<VCDFile> the vcd file without value changes,
+ * nullptr if the header is not complete.
+ */
+std::unique_ptr<VCDFile> VcdStreamReader::readHeader(
+    std::optional<std::pair<int64_t, int64_t>> begin_end_time) {
+  auto trace = std::make_unique<VCDFile>();
+  trace->time_units = TIME_S;
+  trace->time_resolution = 1;
+
+  auto* root_scope = new VCDScope;
+  root_scope->name = "";
+  root_scope->type = VCD_SCOPE_ROOT;
+  root_scope->parent = nullptr;
+  trace->root_scope = root_scope;
+  trace->add_scope(root_scope);
+  std::vector<VCDScope*> scopes = {root_scope};
+
+  const char* curr = _mfile->begin();
+  const char* end = _mfile->end();
+  bool is_end_definitions = false;
+  while (!is_end_definitions) {
+    auto token = nextToken(curr, end);
+    if (token.empty()) {
+      break;
+    }
+
+    if (token == "$timescale") {
+      // the number and the unit may be separated, such as 1ps or 1 ps.
+      std::string time_scale;
+      for (auto t = nextToken(curr, end); !t.empty() && t != "$end";
+           t = nextToken(curr, end)) {
+        time_scale += t;
+      }
+      auto unit_pos = time_scale.find_first_not_of("0123456789");
+      trace->time_resolution = std::max<int64_t>(
+          toInteger(std::string_view(time_scale).substr(0, unit_pos)), 1);
+      trace->time_units = toTimeUnit(
+          unit_pos != std::string::npos ? time_scale.substr(unit_pos) : "s");
+    } else if (token == "$scope") {
+      nextToken(curr, end);  // scope type
+      auto scope_name = nextToken(curr, end);
+      skipToEnd(curr, end);
+
+      auto* new_scope = new VCDScope;
+      new_scope->name = std::string(scope_name);
+      new_scope->type = VCD_SCOPE_MODULE;
+      new_scope->parent = scopes.back();
+      trace->add_scope(new_scope);
+      scopes.back()->children.push_back(new_scope);
+      scopes.push_back(new_scope);
+    } else if (token == "$upscope") {
+      skipToEnd(curr, end);
+      if (scopes.size() > 1) {
+        scopes.pop_back();
+      }
+    } else if (token == "$var") {
+      auto* new_signal = new VCDSignal;
+      new_signal->type = toVarType(nextToken(curr, end));
+      new_signal->size = toInteger(nextToken(curr, end));
+      new_signal->hash = std::string(nextToken(curr, end));
+      auto reference = nextToken(curr, end);
+      new_signal->lindex = -1;
+      new_signal->rindex = -1;
+
+      // the bit select, such as [7:0] or [3], may be attached to the reference.
+      std::string bit_select;
+      if (auto bracket_pos = reference.find('[');
+          bracket_pos != std::string_view::npos && bracket_pos != 0) {
+        bit_select = reference.substr(bracket_pos);
+        reference = reference.substr(0, bracket_pos);
+      }
+      new_signal->reference = std::string(reference);
+      for (auto t = nextToken(curr, end); !t.empty() && t != "$end";
+           t = nextToken(curr, end)) {
+        bit_select += t;
+      }
+      if (!bit_select.empty() && bit_select.front() == '[') {
+        std::string_view range(bit_select);
+        range = range.substr(1, range.find(']') - 1);
+        auto colon_pos = range.find(':');
+        new_signal->lindex = toInteger(range.substr(0, colon_pos));
+        if (colon_pos != std::string_view::npos) {
+          int rindex = toInteger(range.substr(colon_pos + 1));
+          new_signal->rindex = (rindex == new_signal->lindex) ? -1 : rindex;
+        }
+      }
+      if (new_signal->size > 1 && new_signal->lindex <= 0) {
+        new_signal->rindex = 0;
+        new_signal->lindex = new_signal->size - 1;
+      }
+
+      new_signal->scope = scopes.back();
+      scopes.back()->signals.push_back(new_signal);
+    } else if (token == "$enddefinitions") {
+      skipToEnd(curr, end);
+      is_end_definitions = true;
+    } else if (token.front() == '$') {
+      skipToEnd(curr, end);
+    }
+  }
+
+  if (!is_end_definitions) {
+    LOG_ERROR << "the vcd header is not complete.";
+    return nullptr;
+  }
+  _value_begin = curr;
+
+  // the last timestamp is the default end time.
+  int64_t last_time = 0;
+  for (const char* p = end; p > _value_begin; --p) {
+    if (*(p - 1) == '#' && (p - 1 == _value_begin || isSpace(*(p - 2)))) {
+      const char* time_curr = p;
+      last_time = toInteger(nextToken(time_curr, end));
+      break;
+    }
+  }
+  trace->add_timestamp(last_time);
+
+  // the same as the vcd parser, the begin-end time is scaled by the time
+  // resolution.
+  _begin_time = 0;
+  _end_time = last_time;
+  if (begin_end_time) {
+    _begin_time = begin_end_time->first / trace->time_resolution;
+    _end_time = begin_end_time->second / trace->time_resolution;
+  }
+
+  return trace;
+}
+
+/**
+ * @brief assign the slots of the wire signals under the scope.
+ *
+ * @param the_scope
+ */
+void VcdStreamReader::buildSignalSlots(VCDScope* the_scope) {
+  for (auto* signal : the_scope->signals) {
+    if (signal->type != VCD_VAR_WIRE) {
+      continue;
+    }
+
+    auto [slot_iter, is_new] = _code_to_slot.try_emplace(
+        std::string_view(signal->hash), static_cast<int>(_slots.size()));
+    if (is_new) {
+      _slots.push_back({_num_bits, static_cast<int>(signal->size), {}});
+      _num_bits += signal->size;
+    }
+
+    auto& slot = _slots[slot_iter->second];
+    if (slot.size != static_cast<int>(signal->size)) {
+      LOG_WARNING << "the signal " << signal->reference
+                  << " size is not the same with the alias, skip it.";
+      continue;
+    }
+    slot.signals.push_back(signal);
+  }
+
+  for (auto* child_scope : the_scope->children) {
+    buildSignalSlots(child_scope);
+  }
+}
+
+/**
+ * @brief split the value change section at the timestamp.
+ *
+ * @param num_threads
+ * @return std::vector<Chunk>
+ */
+std::vector<VcdStreamReader::Chunk> VcdStreamReader::splitChunks(
+    int num_threads) {
+  const char* end = _mfile->end();
+  std::size_t section_size = end - _value_begin;
+  std::size_t num_chunks = std::clamp<std::size_t>(
+      section_size / std::max<std::size_t>(_min_chunk_size, 1), 1,
+      num_threads);
+
+  std::vector<Chunk> chunks;
+  const char* chunk_begin = _value_begin;
+  for (std::size_t i = 1; i < num_chunks; ++i) {
+    std::string_view rest(_value_begin + i * section_size / num_chunks,
+                          end - (_value_begin + i * section_size / num_chunks));
+    auto time_pos = rest.find("\n#");
+    if (time_pos == std::string_view::npos) {
+      break;
+    }
+    const char* chunk_end = rest.data() + time_pos + 1;
+    if (chunk_end <= chunk_begin) {
+      continue;
+    }
+    chunks.push_back({chunk_begin, chunk_end, {}, 0});
+    chunk_begin = chunk_end;
+  }
+  chunks.push_back({chunk_begin, end, {}, 0});
+
+  return chunks;
+}
+
+/**
+ * @brief judge whether is transition, 0-1 or 1-0 at the different time.
+ *
+ */
+bool VcdStreamReader::isTransition(int64_t prev_time, VCDBit prev_value,
+                                   int64_t curr_time, VCDBit curr_value) {
+  return (prev_time != curr_time) && (curr_time >= _begin_time) &&
+         (prev_value != VCD_X) && (curr_value != VCD_X) &&
+         (prev_value != curr_value);
+}
+
+/**
+ * @brief add the duration within the begin and end time to the value.
+ *
+ */
+void VcdStreamReader::addDuration(BitActivity& bit, int64_t begin_time,
+                                  int64_t end_time, VCDBit value) {
+  auto duration =
+      std::min(end_time, _end_time) - std::max(begin_time, _begin_time);
+  if (duration > 0) {
+    bit.durations[value] += duration;
+  }
+}
+
+/**
+ * @brief record the value change of the bit.
+ *
+ */
+void VcdStreamReader::updateBit(BitActivity& bit, int64_t time, VCDBit value) {
+  if (bit.first_time < 0) {
+    // the value before is in the previous range, merge later.
+    bit.first_time = time;
+    bit.first_value = value;
+  } else {
+    addDuration(bit, bit.last_time, time, bit.last_value);
+    if (isTransition(bit.last_time, bit.last_value, time, value)) {
+      ++bit.tc;
+    }
+  }
+  bit.last_time = time;
+  bit.last_value = value;
+}
+
+/**
+ * @brief count the value changes of the time range.
+ *
+ * @param chunk
+ */
+void VcdStreamReader::countChunk(Chunk& chunk) {
+  chunk.bits.assign(_num_bits, BitActivity());
+
+  auto find_slot = [this](std::string_view code) -> SignalSlot* {
+    auto found = _code_to_slot.find(code);
+    return found != _code_to_slot.end() ? &_slots[found->second] : nullptr;
+  };
+
+  int64_t curr_time = 0;
+  const char* curr = chunk.begin;
+  while (curr < chunk.end) {
+    auto token = nextToken(curr, chunk.end);
+    if (token.empty()) {
+      break;
+    }
+
+    char first_char = token.front();
+    if (first_char == '#') {
+      curr_time = toInteger(token.substr(1));
+      if (curr_time > _end_time) {
+        break;
+      }
+    } else if (first_char == '$') {
+      // $dumpvars, $dumpall etc. only wrap the value changes.
+      if (token == "$comment") {
+        skipToEnd(curr, chunk.end);
+      }
+    } else if (first_char == 'b' || first_char == 'B') {
+      auto value_str = token.substr(1);
+      auto* slot = find_slot(nextToken(curr, chunk.end));
+      if (!slot || value_str.empty()) {
+        continue;
+      }
+      ++chunk.num_value_changes;
+
+      // the value is left extended to the signal size, x and z extend itself,
+      // 0 and 1 extend 0.
+      int size = slot->size;
+      int num_value_bits = value_str.size();
+      if (num_value_bits > size) {
+        value_str = value_str.substr(num_value_bits - size);
+        num_value_bits = size;
+      }
+      int extend_size = size - num_value_bits;
+      VCDBit extend_value =
+          value_str.front() == '1' ? VCD_0 : toVCDBit(value_str.front());
+      for (int i = 0; i < size; ++i) {
+        VCDBit bit_value = i < extend_size
+                               ? extend_value
+                               : toVCDBit(value_str[i - extend_size]);
+        updateBit(chunk.bits[slot->offset + i], curr_time, bit_value);
+      }
+    } else if (first_char == 'r' || first_char == 'R') {
+      // real value is not counted.
+      nextToken(curr, chunk.end);
+    } else {
+      auto* slot = find_slot(token.substr(1));
+      if (!slot) {
+        continue;
+      }
+      ++chunk.num_value_changes;
+      updateBit(chunk.bits[slot->offset], curr_time, toVCDBit(first_char));
+    }
+  }
+}
+
+/**
+ * @brief merge the time ranges of the slots and write to the annotate records.
+ *
+ */
+void VcdStreamReader::writeRecords(VCDScope* top_instance_scope,
+                                   AnnotateDB* annotate_db,
+                                   std::vector<Chunk>& chunks,
+                                   std::size_t slot_begin,
+                                   std::size_t slot_end) {
+  for (std::size_t slot_index = slot_begin; slot_index < slot_end;
+       ++slot_index) {
+    auto& slot = _slots[slot_index];
+    for (int i = 0; i < slot.size; ++i) {
+      // merge the ranges in time order, the last value of the previous range
+      // lasts to the first value change of the range.
+      BitActivity merged_bit;
+      for (auto& chunk : chunks) {
+        auto& bit = chunk.bits[slot.offset + i];
+        if (bit.first_time < 0) {
+          continue;
+        }
+        if (merged_bit.first_time < 0) {
+          merged_bit.first_time = bit.first_time;
+        } else {
+          addDuration(merged_bit, merged_bit.last_time, bit.first_time,
+                      merged_bit.last_value);
+          if (isTransition(merged_bit.last_time, merged_bit.last_value,
+                           bit.first_time, bit.first_value)) {
+            ++merged_bit.tc;
+          }
+        }
+        merged_bit.tc += bit.tc;
+        for (std::size_t value = 0; value < bit.durations.size(); ++value) {
+          merged_bit.durations[value] += bit.durations[value];
+        }
+        merged_bit.last_time = bit.last_time;
+        merged_bit.last_value = bit.last_value;
+      }
+
+      // for last time, the signal should steady to end.
+      if (merged_bit.first_time >= 0) {
+        addDuration(merged_bit, merged_bit.last_time, _end_time,
+                    merged_bit.last_value);
+      }
+
+      for (auto* signal : slot.signals) {
+        AnnotateToggle annotate_signal_toggle;
+        annotate_signal_toggle.incrTC(merged_bit.tc);
+        AnnotateTime annotate_signal_duration_time;
+        annotate_signal_duration_time.incrT0(merged_bit.durations[VCD_0]);
+        annotate_signal_duration_time.incrT1(merged_bit.durations[VCD_1]);
+        annotate_signal_duration_time.incrTX(merged_bit.durations[VCD_X]);
+        annotate_signal_duration_time.incrTZ(merged_bit.durations[VCD_Z]);
+
+        // bus signal value is high bit first.
+        std::string signal_name =
+            slot.size == 1 ? scalarSignalName(signal)
+                           : signal->reference + "[" +
+                                 std::to_string(signal->lindex - i) + "]";
+        auto parent_instance_names =
+            getParentInstanceNames(signal, top_instance_scope);
+        auto* record_data =
+            annotate_db->findSignalRecord(parent_instance_names, signal_name);
+        LOG_FATAL_IF(!record_data) << "not found record data";
+
+        *record_data =
+            AnnotateRecord(std::move(annotate_signal_toggle),
+                           std::move(annotate_signal_duration_time));
+      }
+    }
+  }
+}
+
+/**
+ * @brief count the tc and t0/t1/tx/tz of the signals under the top instance
+ * scope, write to the annotate database.
+ *
+ * @param top_instance_scope
+ * @param annotate_db
+ * @param num_threads
+ * @return unsigned return 1 if success, else 0.
+ */
+unsigned VcdStreamReader::countActivity(VCDScope* top_instance_scope,
+                                        AnnotateDB* annotate_db,
+                                        int num_threads) {
+  auto start_time = std::chrono::steady_clock::now();
+  num_threads = std::max(num_threads, 1);
+
+  _code_to_slot.clear();
+  _slots.clear();
+  _num_bits = 0;
+  buildSignalSlots(top_instance_scope);
+
+  auto chunks = splitChunks(num_threads);
+  {
+    ThreadPool thread_pool(std::min<std::size_t>(chunks.size(), num_threads));
+    for (auto& chunk : chunks) {
+      thread_pool.enqueue([this](Chunk* chunk) { countChunk(*chunk); },
+                          &chunk);
+    }
+  }
+
+  {
+    ThreadPool thread_pool(num_threads);
+    std::size_t batch_size =
+        std::max<std::size_t>(_slots.size() / num_threads, 1);
+    for (std::size_t slot_begin = 0; slot_begin < _slots.size();
+         slot_begin += batch_size) {
+      std::size_t slot_end = std::min(slot_begin + batch_size, _slots.size());
+      thread_pool.enqueue(
+          [this, top_instance_scope, annotate_db, &chunks, slot_begin,
+           slot_end]() {
+            writeRecords(top_instance_scope, annotate_db, chunks, slot_begin,
+                         slot_end);
+          });
+    }
+  }
+
+  _read_stats.num_chunks = chunks.size();
+  _read_stats.num_value_changes = 0;
+  for (auto& chunk : chunks) {
+    _read_stats.num_value_changes += chunk.num_value_changes;
+  }
+  _read_stats.runtime = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - start_time)
+                            .count();
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  _read_stats.peak_rss = usage.ru_maxrss / 1024.0;
+
+  double file_size_mb = _read_stats.file_size / (1024.0 * 1024.0);
+  LOG_INFO << "vcd stream read " << file_size_mb << "MB, "
+           << _read_stats.num_value_changes << " value changes of "
+           << _num_bits << " bits in " << _read_stats.num_chunks
+           << " time ranges, time elapsed " << _read_stats.runtime << "s ("
+           << file_size_mb / std::max(_read_stats.runtime, 1e-9)
+           << "MB/s), peak rss " << _read_stats.peak_rss << "MB";
+
+  return 1;
+}
+
+}  // namespace ipower
@@ -0,0 +1,139 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file VCDStreamReader.hh
+ * @brief The streaming vcd reader, count the signal activity without keeping
+ * the value changes in memory.
+ * @version 0.1
+ * @date 2025-03-10
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "VCDFile.hpp"
+#include "ops/annotate_toggle_sp/AnnotateData.hh"
+
+namespace os::fs {
+class MemoryMappedFile;
+}
+
+namespace ipower {
+
+/*The annotate name of the one bit signal, the bit select of the bus bit is
+ * kept, such as a[3].*/
+inline std::string scalarSignalName(const VCDSignal* signal) {
+  return signal->lindex < 0
+             ? signal->reference
+             : signal->reference + "[" + std::to_string(signal->lindex) + "]";
+}
+
+/**
+ * @brief The streaming vcd reader.
+ *
+ * The vcd file is memory mapped, only the header(scopes and signals) is built
+ * to VCDFile. The value changes are counted on the fly for the signals under
+ * the top instance scope, the tc and t0/t1/tx/tz of each bit are accumulated
+ * within the begin and end time. The value change section could be split to
+ * time ranges at the timestamp, each range is counted by one thread and the
+ * ranges are merged in time order, so the memory is the number of bits times
+ * the number of ranges, not the length of the vcd.
+ */
+class VcdStreamReader {
+ public:
+  struct ReadStats {
+    std::size_t file_size = 0;          //!< The vcd file size in bytes.
+    std::size_t num_value_changes = 0;  //!< The counted value changes.
+    std::size_t num_chunks = 0;         //!< The time ranges counted.
+    double runtime = 0.0;               //!< The counting time in s.
+    double peak_rss = 0.0;              //!< The process peak rss in MB.
+  };
+
+  explicit VcdStreamReader(const std::string& vcd_path);
+  ~VcdStreamReader();
+
+  std::unique_ptr<VCDFile> readHeader(
+      std::optional<std::pair<int64_t, int64_t>> begin_end_time);
+  unsigned countActivity(VCDScope* top_instance_scope, AnnotateDB* annotate_db,
+                         int num_threads);
+
+  void set_min_chunk_size(std::size_t min_chunk_size) {
+    _min_chunk_size = min_chunk_size;
+  }
+  auto& get_read_stats() { return _read_stats; }
+
+ private:
+  /*The activity of one bit in one time range.*/
+  struct BitActivity {
+    int64_t first_time = -1;  //!< The first value change time, -1 if none.
+    int64_t last_time = -1;   //!< The last value change time.
+    int64_t tc = 0;           //!< The transition in the range.
+    std::array<int64_t, 4> durations{0, 0, 0, 0};  //!< Indexed by VCDBit.
+    VCDBit first_value = VCD_X;
+    VCDBit last_value = VCD_X;
+  };
+
+  /*The value change section of one time range.*/
+  struct Chunk {
+    const char* begin;
+    const char* end;
+    std::vector<BitActivity> bits;
+    std::size_t num_value_changes = 0;
+  };
+
+  /*The signals of one vcd id code, the bits are high bit first.*/
+  struct SignalSlot {
+    int offset;  //!< The first bit index.
+    int size;    //!< The bit number.
+    std::vector<VCDSignal*> signals;
+  };
+
+  void buildSignalSlots(VCDScope* the_scope);
+  std::vector<Chunk> splitChunks(int num_threads);
+  void countChunk(Chunk& chunk);
+  void updateBit(BitActivity& bit, int64_t time, VCDBit value);
+  void addDuration(BitActivity& bit, int64_t begin_time, int64_t end_time,
+                   VCDBit value);
+  bool isTransition(int64_t prev_time, VCDBit prev_value, int64_t curr_time,
+                    VCDBit curr_value);
+  void writeRecords(VCDScope* top_instance_scope, AnnotateDB* annotate_db,
+                    std::vector<Chunk>& chunks, std::size_t slot_begin,
+                    std::size_t slot_end);
+
+  std::unique_ptr<os::fs::MemoryMappedFile> _mfile;  //!< The mapped vcd file.
+  const char* _value_begin = nullptr;  //!< The value change section begin.
+
+  int64_t _begin_time = 0;  //!< The count begin time, unit is vcd time.
+  int64_t _end_time = 0;    //!< The count end time, unit is vcd time.
+
+  std::unordered_map<std::string_view, int>
+      _code_to_slot;                   //!< The vcd id code to the slot.
+  std::vector<SignalSlot> _slots;      //!< The signals of the top scope.
+  int _num_bits = 0;                   //!< The total bits of the slots.
+  std::size_t _min_chunk_size = 64 * 1024 * 1024;  //!< The min range bytes.
+
+  ReadStats _read_stats;
+};
+
+}  // namespace ipower
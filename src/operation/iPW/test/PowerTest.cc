@@ -94,4 +94,66 @@ TEST_F(PowerTest, example1) {
   ipower.reportPower("report.txt", PwrAnalysisMode::kAveraged);
 }
 
+TEST_F(PowerTest, incrUpdatePower) {
+  auto* timing_engine = TimingEngine::getOrCreateTimingEngine();
+  timing_engine->set_num_threads(48);
+  const char* design_work_space =
+      "/home/longshuaiying/iEDA/src/iSTA/example/sizer/";
+  timing_engine->set_design_work_space(design_work_space);
+
+  std::vector<const char*> lib_files = {"NangateOpenCellLibrary_fast.lib"};
+  timing_engine->readLiberty(lib_files);
+  timing_engine->get_ista()->set_analysis_mode(ista::AnalysisMode::kMaxMin);
+  timing_engine->readDesign("sizer.v");
+  timing_engine->readSdc("sizer.sdc");
+  timing_engine->buildGraph();
+  timing_engine->buildRCTree("sizer.spef", DelayCalcMethod::kElmore);
+  timing_engine->updateTiming();
+
+  auto* the_sta_graph = &(timing_engine->get_ista()->get_graph());
+  auto setup_power = [timing_engine](Power& ipower) {
+    auto* fastest_clock = timing_engine->get_ista()->getFastestClock();
+    PwrClock pwr_fastest_clock(fastest_clock->get_clock_name(),
+                               fastest_clock->getPeriodNs());
+    auto clocks = timing_engine->get_ista()->getClocks();
+    ipower.setupClock(std::move(pwr_fastest_clock), std::move(clocks));
+    ipower.buildGraph();
+    ipower.buildSeqGraph();
+    ipower.updatePower();
+  };
+  auto get_group_powers = [](Power& ipower) {
+    std::map<PwrGroupData::PwrGroupType, double> group_powers;
+    for (auto& [group_type, group_datas] : ipower.get_type_to_group_data()) {
+      for (auto* group_data : group_datas) {
+        group_powers[group_type] += group_data->get_leakage_power() +
+                                    group_data->get_internal_power() +
+                                    group_data->get_switch_power();
+      }
+    }
+    return group_powers;
+  };
+
+  Power incr_power(the_sta_graph);
+  setup_power(incr_power);
+
+  // upsize inst_3 from X2 to X4, then update the power incrementally.
+  timing_engine->repowerInstance("inst_3", "NAND2_X4");
+  timing_engine->updateTiming();
+  auto* inst =
+      timing_engine->get_ista()->get_netlist()->findInstance("inst_3");
+  incr_power.incrUpdatePower({inst});
+
+  // the incremental power should be the same as the full recompute.
+  Power full_power(the_sta_graph);
+  setup_power(full_power);
+
+  auto incr_group_powers = get_group_powers(incr_power);
+  auto full_group_powers = get_group_powers(full_power);
+  ASSERT_EQ(incr_group_powers.size(), full_group_powers.size());
+  for (auto& [group_type, full_group_power] : full_group_powers) {
+    EXPECT_NEAR(incr_group_powers[group_type], full_group_power,
+                std::abs(full_group_power) * 1e-9);
+  }
+}
+
 }  // namespace
\ No newline at end of file
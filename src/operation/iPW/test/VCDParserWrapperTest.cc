@@ -14,6 +14,10 @@
 //
 // See the Mulan PSL v2 for more details.
 // ***************************************************************************************
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
 #include "gtest/gtest.h"
 #include "log/Log.hh"
 #include "ops/read_vcd/VCDParserWrapper.hh"
@@ -74,4 +78,143 @@ TEST_F(VCDParserWrapperTest, print_saif) {
   out_file.close();
 }
 
-}  // namespace
\ No newline at end of file
+const char* kStreamVcd = R"($timescale 1ps $end
+$scope module tb $end
+$var wire 1 ! clk $end
+$scope module top_i $end
+$var wire 1 ! clk $end
+$var wire 1 " a $end
+$var wire 4 # d [3:0] $end
+$var wire 1 % b[3] $end
+$scope module u0 $end
+$var wire 1 $ y $end
+$upscope $end
+$upscope $end
+$upscope $end
+$enddefinitions $end
+#0
+$dumpvars
+0!
+x"
+b0000 #
+0$
+0%
+$end
+#5
+1!
+1"
+#10
+0!
+b0101 #
+1$
+#15
+1!
+0"
+1%
+#20
+0!
+bzzzz #
+#25
+1!
+0%
+#30
+0!
+0$
+)";
+
+std::pair<int64_t, double> getSignalTcSp(VcdParserWrapper& vcd_parser_wrapper,
+                                         std::vector<std::string_view> parent_instance_names,
+                                         std::string_view signal_name) {
+  auto* record_data = vcd_parser_wrapper.get_annotate_db()->findSignalRecord(
+      parent_instance_names, signal_name);
+  return record_data->get_record_tc_sp();
+}
+
+TEST_F(VCDParserWrapperTest, stream_read) {
+  auto vcd_path = std::string(testing::TempDir()) + "stream_read.vcd";
+  {
+    std::ofstream out_file(vcd_path);
+    out_file << kStreamVcd;
+  }
+
+  auto read_vcd = [&vcd_path](VcdParserWrapper& vcd_parser_wrapper,
+                              std::optional<std::pair<int64_t, int64_t>>
+                                  begin_end_time = std::nullopt) {
+    EXPECT_TRUE(vcd_parser_wrapper.readVCD(vcd_path, begin_end_time));
+    vcd_parser_wrapper.buildAnnotateDB("top_i");
+    vcd_parser_wrapper.calcScopeToggleAndSp();
+  };
+
+  VcdParserWrapper parse_wrapper;
+  parse_wrapper.set_is_stream_read(false);
+  read_vcd(parse_wrapper);
+
+  // split the value changes to time ranges as much as possible.
+  VcdParserWrapper stream_wrapper;
+  stream_wrapper.set_num_threads(4);
+  stream_wrapper.set_min_chunk_size(1);
+  read_vcd(stream_wrapper);
+
+  // the signals are the same with the parsed vcd.
+  auto expect_same_signals = [](VcdParserWrapper& expect_wrapper,
+                                VcdParserWrapper& actual_wrapper) {
+    for (auto [parent_instance_names, signal_name] :
+         std::vector<std::pair<std::vector<std::string_view>, std::string_view>>{
+             {{}, "clk"},
+             {{}, "a"},
+             {{}, "d[3]"},
+             {{}, "d[2]"},
+             {{}, "d[1]"},
+             {{}, "d[0]"},
+             {{}, "b[3]"},
+             {{"u0"}, "y"}}) {
+      auto [expect_tc, expect_sp] =
+          getSignalTcSp(expect_wrapper, parent_instance_names, signal_name);
+      auto [actual_tc, actual_sp] =
+          getSignalTcSp(actual_wrapper, parent_instance_names, signal_name);
+      EXPECT_EQ(expect_tc, actual_tc) << signal_name;
+      EXPECT_DOUBLE_EQ(expect_sp, actual_sp) << signal_name;
+    }
+  };
+  expect_same_signals(parse_wrapper, stream_wrapper);
+
+  EXPECT_EQ(getSignalTcSp(stream_wrapper, {}, "clk"),
+            std::make_pair(int64_t(6), 0.5));
+  EXPECT_EQ(getSignalTcSp(stream_wrapper, {}, "a").first, 1);
+  // only x is not transition, the z is counted as 1 in sp.
+  EXPECT_EQ(getSignalTcSp(stream_wrapper, {}, "d[3]").first, 1);
+  EXPECT_DOUBLE_EQ(getSignalTcSp(stream_wrapper, {}, "d[3]").second, 1.0 / 3);
+  EXPECT_EQ(getSignalTcSp(stream_wrapper, {}, "d[2]").first, 2);
+  EXPECT_DOUBLE_EQ(getSignalTcSp(stream_wrapper, {}, "d[2]").second, 2.0 / 3);
+  EXPECT_EQ(getSignalTcSp(stream_wrapper, {}, "d[0]").first, 2);
+
+  // only count the value changes within the begin and end time.
+  VcdParserWrapper window_wrapper;
+  window_wrapper.set_min_chunk_size(1);
+  read_vcd(window_wrapper, std::make_pair(10, 25));
+  auto [window_tc, window_sp] = getSignalTcSp(window_wrapper, {}, "clk");
+  EXPECT_EQ(window_tc, 4);
+  EXPECT_DOUBLE_EQ(window_sp, 1.0 / 3);
+
+  VcdParserWrapper parse_window_wrapper;
+  parse_window_wrapper.set_is_stream_read(false);
+  read_vcd(parse_window_wrapper, std::make_pair(10, 25));
+  expect_same_signals(parse_window_wrapper, window_wrapper);
+
+  // the bit select attached to the reference is split from the name.
+  VcdStreamReader stream_reader(vcd_path);
+  auto header = stream_reader.readHeader(std::nullopt);
+  ASSERT_NE(header, nullptr);
+  auto& top_signals = header->get_scope("top_i")->signals;
+  auto bit_signal = std::find_if(
+      top_signals.begin(), top_signals.end(),
+      [](VCDSignal* signal) { return signal->hash == "%"; });
+  ASSERT_NE(bit_signal, top_signals.end());
+  EXPECT_EQ((*bit_signal)->reference, "b");
+  EXPECT_EQ((*bit_signal)->lindex, 3);
+  EXPECT_EQ((*bit_signal)->rindex, -1);
+
+  std::remove(vcd_path.c_str());
+}
+
+}  // namespace
@@ -26,8 +26,10 @@
 
 #include <iostream>
 #include <optional>
+#include <queue>
 
 #include "FlatSet.hh"
+#include "ThreadPool/ThreadPool.h"
 #include "TimingIDBAdapter.hh"
 #include "delay/ElmoreDelayCalc.hh"
 #include "liberty/Liberty.hh"
@@ -363,7 +365,8 @@ RctNode* TimingEngine::makeOrFindRCTreeNode(Net* net, int id) {
   }
 
   auto* rc_tree = rc_net->rct();
-  std::string node_name = Str::printf("%s:%d", net->get_name(), id);
+  // not use Str::printf, the node may be made in parallel for different net.
+  std::string node_name = std::string(net->get_name()) + ":" + std::to_string(id);
 
   auto* node = rc_tree->node(node_name);
   if (!node) {
@@ -442,6 +445,19 @@ void TimingEngine::updateRCTreeInfo(Net* net) {
   }
 }
 
+/**
+ * @brief update rc info of the nets in parallel, the rc tree of the nets should
+ * have been made.
+ *
+ * @param nets
+ */
+void TimingEngine::updateRCTreeInfo(const std::vector<Net*>& nets) {
+  ThreadPool pool(_ista->get_num_threads());
+  for (auto* net : nets) {
+    pool.enqueue([this](Net* net) { updateRCTreeInfo(net); }, net);
+  }
+}
+
 /**
  * @brief build balanced rc tree of the net and update rc tree info.
  *
@@ -750,6 +766,42 @@ void TimingEngine::insertBuffer(const char* instance_name) {
   for (auto* net : buffer_nets) {
     build_graph.buildNet(&the_graph, net);
   }
+
+  /*levelize the buffer and its fanout for the incremental update*/
+  std::queue<StaVertex*> level_queue;
+  FOREACH_INSTANCE_PIN(instance, pin) {
+    if (pin->isInput() && pin->get_net()) {
+      auto the_vertex = the_graph.findVertex(pin);
+      LOG_FATAL_IF(!the_vertex);
+      level_queue.push(*the_vertex);
+    }
+  }
+
+  while (!level_queue.empty()) {
+    auto* the_vertex = level_queue.front();
+    level_queue.pop();
+    if (the_vertex->is_start()) {
+      continue;
+    }
+
+    unsigned level = 1;
+    FOREACH_SNK_ARC(the_vertex, snk_arc) {
+      if (!snk_arc->is_loop_disable()) {
+        level = std::max(level, snk_arc->get_src()->get_level() + 1);
+      }
+    }
+
+    if (level <= the_vertex->get_level()) {
+      continue;
+    }
+
+    the_vertex->set_level(level);
+    FOREACH_SRC_ARC(the_vertex, src_arc) {
+      if (!src_arc->is_loop_disable()) {
+        level_queue.push(src_arc->get_snk());
+      }
+    }
+  }
 }
 
 /**
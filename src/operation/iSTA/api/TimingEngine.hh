@@ -208,6 +208,7 @@ class TimingEngine {
   void incrCap(RctNode *node, double cap, bool is_incremental = false);
   void makeResistor(Net *net, RctNode *from_node, RctNode *to_node, double res);
   void updateRCTreeInfo(Net *net);
+  void updateRCTreeInfo(const std::vector<Net *> &nets);
   void buildRcTreeAndUpdateRcTreeInfo(
       const char *net_name, std::map<std::string, double> &loadname2wl);
 
@@ -327,6 +328,10 @@ class TimingEngine {
                                           TransType trans_type) {
     return _ista->getWorstSeqData(std::nullopt, mode, trans_type);
   }
+  std::vector<StaSeqPathData *> getViolatedSeqPaths(AnalysisMode mode,
+                                                    double slack_margin) {
+    return _ista->getViolatedSeqPaths(mode, slack_margin);
+  }
   std::priority_queue<StaSeqPathData *, std::vector<StaSeqPathData *>,
                       decltype(seq_data_cmp)>
   getViolatedSeqPathsBetweenTwoSinks(const char *pin1_name,
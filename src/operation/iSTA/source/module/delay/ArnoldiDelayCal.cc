@@ -226,11 +226,7 @@ void ArnoldiNet::updateRcTiming(const spef::Net& spef_net) {
 
   if (_rct.index() != 0) {
     auto& rct = std::get<RcTree>(_rct);
-    rct.initData();
-    if (rct._root) {
-      rct.updateLoad(nullptr, rct.get_root());
-      rct.updateDelay(nullptr, rct.get_root());
-    }
+    rct.updateRcTiming();
 
     assignRcNodeID();
   }
@@ -256,40 +252,22 @@ void ArnoldiNet::constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
     // set_is_reduce(true);
   }
 
-  // construct the matrix C and diagonal G.
+  // the network node id is the same as the assigned rc node id.
+  auto& network = rct.get_network();
+  LOG_FATAL_IF(network.numNodes() != node_num)
+      << "rc network is not updated for net " << name();
+
+  // construct the matrix C.
   std::vector<double> nodal_caps(node_num);
-  MatrixXd conductances(node_num, node_num);
-  conductances.setZero();
-
-  FOREACH_RCTREE_NODE(rct, name, rc_node) {
-    // construct the matrix C.
-    double cap = rc_node.get_cap(analysis_mode, trans_type);
-    unsigned node_id = getNodeID(&rc_node);
-    nodal_caps[node_id] = PF_TO_F(cap);  // convert PF to standard F.
-
-    // construct the G diagonal part.
-    double conductance = 0.0;
-    FOREACH_RCNODE_FANIN_EDGE(&rc_node, fanin_edge) {
-      conductance += fanin_edge->getG(analysis_mode, trans_type);
-    }
-    conductances(node_id, node_id) =
-        conductance;  // conductance is resistance inv.
+  for (decltype(node_num) i = 0; i < node_num; ++i) {
+    double cap = network.groundCap(i, analysis_mode, trans_type);
+    nodal_caps[i] = PF_TO_F(cap);  // convert PF to standard F.
   }
 
   set_nodal_caps(std::move(nodal_caps));
 
-  // construct the matrix G other part.
-  for (decltype(node_num) i = 0; i < node_num; ++i) {
-    auto* rc_node = getIDNode(i);
-    FOREACH_RCNODE_FANOUT_EDGE(rc_node, fanout_edge) {
-      auto& fanout_rc_node = fanout_edge->get_to();
-      unsigned node_id = getNodeID(&fanout_rc_node);
-      conductances(i, node_id) = -(fanout_edge->getG(
-          analysis_mode, trans_type));  // get the opposite val.
-    }
-  }
-
-  _conductances_matrix = conductances;
+  // construct the matrix G, conductance is resistance inv.
+  _conductances_matrix = network.conductanceMatrix();
 
   // consturct nodal cap matrix.
   auto cap_size = _nodal_caps.size();
@@ -316,11 +294,12 @@ void ArnoldiNet::constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
  * @brief construct arnoldi orthogonal basis use
  *
  */
-unsigned ArnoldiNet::constructArnoldiOrthogonalBasis() {
+unsigned ArnoldiNet::constructArnoldiOrthogonalBasis(
+    AnalysisMode analysis_mode, TransType trans_type) {
   constexpr int arnoldi_reduce_order = 3;
-  ArnoldiROM arnoldi_rom;
-  auto arnoldi_basis = arnoldi_rom.orthogonalBasis(
-      _conductances_matrix, _cap_matrix, _input_vec, arnoldi_reduce_order);
+  auto& network = std::get<RcTree>(_rct).get_network();
+  auto arnoldi_basis = network.arnoldiBasis(analysis_mode, trans_type,
+                                            arnoldi_reduce_order);
 
   if (!arnoldi_basis) {
     LOG_ERROR << "no suitable arnoldi basis.";
@@ -336,12 +315,14 @@ unsigned ArnoldiNet::constructArnoldiOrthogonalBasis() {
  * @brief Reduce rc equation use arnoldi basis.
  *
  */
-void ArnoldiNet::reduceRCEquation() {
+void ArnoldiNet::reduceRCEquation(AnalysisMode analysis_mode,
+                                  TransType trans_type) {
   ArnoldiROM arnoldi_rom;
+  auto& network = std::get<RcTree>(_rct).get_network();
 
-  _reduce_conductances_matrix =
-      arnoldi_rom.GTrans(_arnoldi_basis, _conductances_matrix);
-  _reduce_cap_matrix = arnoldi_rom.CTrans(_arnoldi_basis, _cap_matrix);
+  _reduce_conductances_matrix = network.reduceConductance(_arnoldi_basis);
+  _reduce_cap_matrix = PF_TO_F(
+      network.reduceCap(_arnoldi_basis, analysis_mode, trans_type));
   _reduce_input_vec = arnoldi_rom.BTrans(_arnoldi_basis, _input_vec);
 
   DVERBOSE_VLOG(1) << "reduce_conductances_matrix\n"
@@ -526,8 +507,8 @@ MatrixXd ArnoldiNet::calcDelayAndSlew(
           _diag_B_W = constructRCEquation(_cap_matrix, _conductances_matrix,
                                           _input_vec);
         } else {
-          if (constructArnoldiOrthogonalBasis()) {
-            reduceRCEquation();
+          if (constructArnoldiOrthogonalBasis(analysis_mode, trans_type)) {
+            reduceRCEquation(analysis_mode, trans_type);
             _diag_B_W = constructRCEquation(_reduce_cap_matrix,
                                             _reduce_conductances_matrix,
                                             _reduce_input_vec);
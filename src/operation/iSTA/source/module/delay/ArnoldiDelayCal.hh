@@ -149,8 +149,9 @@ class ArnoldiNet : public RcNet {
 
   void constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
                                        TransType trans_type);
-  unsigned constructArnoldiOrthogonalBasis();
-  void reduceRCEquation();
+  unsigned constructArnoldiOrthogonalBasis(AnalysisMode analysis_mode,
+                                           TransType trans_type);
+  void reduceRCEquation(AnalysisMode analysis_mode, TransType trans_type);
 
   auto constructRCEquation(const MatrixXd& cap_matrix,
                            const MatrixXd& conductances_matrix,
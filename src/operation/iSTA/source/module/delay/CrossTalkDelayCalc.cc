@@ -198,4 +198,31 @@ double CrossTalkDelayCalc::calcNoiseVoltage(double time) const {
   return voltage;
 }
 
+/**
+ * @brief calc noise voltage of the time points i * step_time, the same as
+ * calcNoiseVoltage of each point, but evaluated on the whole vector.
+ *
+ * @param step_time
+ * @param waveform
+ */
+void CrossTalkDelayCalc::calcNoiseWaveform(
+    double step_time, Eigen::Ref<Eigen::VectorXd> waveform) const {
+  if (IsDoubleEqual(_tv_coeff, 0.0) || !_two_pi_model) {
+    waveform.setZero();
+    return;
+  }
+
+  auto num_point = waveform.size();
+  Eigen::ArrayXd time =
+      Eigen::ArrayXd::LinSpaced(num_point, 0, step_time * (num_point - 1));
+  Eigen::ArrayXd fall_exp = (-time / _tv_coeff).exp();
+  Eigen::ArrayXd rise_exp = (-(time - _tr_coeff) / _tv_coeff).exp();
+
+  double amplitude = _tx_coeff / _tr_coeff;
+  waveform = (time < _tr_coeff)
+                 .select(amplitude * (1 - fall_exp),
+                         amplitude * (rise_exp - fall_exp))
+                 .matrix();
+}
+
 }  // namespace ista
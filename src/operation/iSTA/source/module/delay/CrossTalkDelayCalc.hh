@@ -23,6 +23,8 @@
  */
 #pragma once
 
+#include <Eigen/Core>
+
 #include "ElmoreDelayCalc.hh"
 
 namespace ista {
@@ -91,6 +93,8 @@ class CrossTalkDelayCalc {
   void reduceRCTreeToTwoPiModel(RcNet* rc_net, RctNode* coupled_point);
   void calcNoiseAmplitude(double input_arrive_time, double input_transition);
   double calcNoiseVoltage(double time) const;
+  void calcNoiseWaveform(double step_time,
+                         Eigen::Ref<Eigen::VectorXd> waveform) const;
 
   auto* get_remote_net() { return _remote_net; }
   auto* get_local_net() { return _local_net; }
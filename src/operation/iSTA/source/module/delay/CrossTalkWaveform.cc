@@ -0,0 +1,152 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file CrossTalkWaveform.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The implemention of the aggressor noise waveforms.
+ * @version 0.1
+ * @date 2025-03-28
+ */
+#include "CrossTalkWaveform.hh"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ista {
+
+/**
+ * @brief reset the waveforms to the victim time step, the buffer capacity is
+ * kept for the next victim.
+ *
+ * @param step_time_ns
+ * @param num_point
+ */
+void CrossTalkWaveforms::reset(double step_time_ns, Eigen::Index num_point) {
+  _step_time_ns = step_time_ns;
+  _num_point = num_point;
+
+  Eigen::Index stride =
+      (num_point + c_stride_align - 1) / c_stride_align * c_stride_align;
+  if (stride != _stride) {
+    _stride = stride;
+    _waveforms.resize(_stride, _waveforms.cols());
+  }
+
+  _start_times.clear();
+}
+
+/**
+ * @brief judge whether the aggressor noise waveform is overlap with the
+ * victim waveform, the both waveforms last num_point steps.
+ *
+ * @param victim_start_time
+ * @param aggressor_start_time
+ * @return true if overlap.
+ */
+bool CrossTalkWaveforms::isOverlap(double victim_start_time,
+                                   double aggressor_start_time) const {
+  if (_num_point < 2) {
+    return false;
+  }
+
+  double span = _step_time_ns * (_num_point - 1);
+  return (aggressor_start_time <= victim_start_time + span) &&
+         (victim_start_time <= aggressor_start_time + span);
+}
+
+/**
+ * @brief alloc the aggressor waveform column, the padding is zero.
+ *
+ * @param aggressor_start_time
+ * @return Eigen::Ref<Eigen::VectorXd> The num_point waveform to be filled.
+ */
+Eigen::Ref<Eigen::VectorXd> CrossTalkWaveforms::allocAggressor(
+    double aggressor_start_time) {
+  auto column = static_cast<Eigen::Index>(_start_times.size());
+  if (column == _waveforms.cols()) {
+    _waveforms.conservativeResize(_stride,
+                                  std::max<Eigen::Index>(4, column * 2));
+  }
+
+  auto waveform = _waveforms.col(column);
+  waveform.tail(_stride - _num_point).setZero();
+
+  _start_times.push_back(aggressor_start_time);
+  return waveform.head(_num_point);
+}
+
+/**
+ * @brief add the aggressor noise waveform sampled from the noise arrive time.
+ *
+ * @param crosstalk_model
+ * @param aggressor_start_time
+ */
+void CrossTalkWaveforms::addAggressor(const CrossTalkDelayCalc& crosstalk_model,
+                                      double aggressor_start_time) {
+  crosstalk_model.calcNoiseWaveform(_step_time_ns,
+                                    allocAggressor(aggressor_start_time));
+}
+
+/**
+ * @brief superimpose the aggressor noise on the victim waveform. The victim
+ * point time is victim_start_time + i * step, the noise voltage is linear
+ * interpolated, both waveforms are on the same step, so the interpolate
+ * position of all the points is the same, only the start index is shifted.
+ *
+ * @param victim_start_time
+ * @param victim_waveform
+ */
+void CrossTalkWaveforms::superimpose(double victim_start_time,
+                                     Eigen::VectorXd& victim_waveform) const {
+  for (std::size_t column = 0; column < _start_times.size(); ++column) {
+    double aggressor_start_time = _start_times[column];
+    if (!isOverlap(victim_start_time, aggressor_start_time)) {
+      continue;
+    }
+
+    // The victim point i is at the aggressor point i + shift + frac.
+    double offset = (victim_start_time - aggressor_start_time) / _step_time_ns;
+    if (double round_offset = std::round(offset);
+        std::abs(offset - round_offset) < c_grid_epsilon) {
+      offset = round_offset;  // on the same time grid.
+    }
+    auto shift = static_cast<Eigen::Index>(std::floor(offset));
+    double frac = offset - shift;
+
+    // The noise is zero before the aggressor start, and after the last point.
+    Eigen::Index begin = std::max<Eigen::Index>(0, -shift);
+    Eigen::Index end = (frac > 0.0) ? (_num_point - 1 - shift)
+                                    : (_num_point - shift);
+    end = std::min(end, _num_point);
+    if (end <= begin) {
+      continue;
+    }
+
+    auto length = end - begin;
+    auto waveform = _waveforms.col(column);
+    if (frac > 0.0) {
+      victim_waveform.segment(begin, length) +=
+          (1.0 - frac) * waveform.segment(begin + shift, length) +
+          frac * waveform.segment(begin + shift + 1, length);
+    } else {
+      victim_waveform.segment(begin, length) +=
+          waveform.segment(begin + shift, length);
+    }
+  }
+}
+
+}  // namespace ista
@@ -0,0 +1,72 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file CrossTalkWaveform.hh
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The aggressor noise waveforms of the victim net.
+ * @version 0.1
+ * @date 2025-03-28
+ */
+#pragma once
+
+#include <Eigen/Core>
+#include <vector>
+
+#include "CrossTalkDelayCalc.hh"
+
+namespace ista {
+
+/**
+ * @brief The aggressor noise waveforms superimposed on the victim waveform.
+ *
+ * The waveforms are sampled on the victim time step, each aggressor is one
+ * column of the buffer, the column stride is padded to the cache line, so
+ * the superimposition is the vectorized column expression of eigen.
+ */
+class CrossTalkWaveforms {
+ public:
+  static constexpr Eigen::Index c_stride_align = 8;  //!< 64 byte of double.
+  static constexpr double c_grid_epsilon = 1e-9;  //!< The step fraction.
+
+  CrossTalkWaveforms() = default;
+  ~CrossTalkWaveforms() = default;
+
+  void reset(double step_time_ns, Eigen::Index num_point);
+
+  [[nodiscard]] double get_step_time_ns() const { return _step_time_ns; }
+  [[nodiscard]] Eigen::Index get_num_point() const { return _num_point; }
+  [[nodiscard]] Eigen::Index get_stride() const { return _stride; }
+  [[nodiscard]] std::size_t size() const { return _start_times.size(); }
+
+  [[nodiscard]] bool isOverlap(double victim_start_time,
+                               double aggressor_start_time) const;
+  Eigen::Ref<Eigen::VectorXd> allocAggressor(double aggressor_start_time);
+  void addAggressor(const CrossTalkDelayCalc& crosstalk_model,
+                    double aggressor_start_time);
+  void superimpose(double victim_start_time,
+                   Eigen::VectorXd& victim_waveform) const;
+
+ private:
+  double _step_time_ns = 0.0;
+  Eigen::Index _num_point = 0;
+  Eigen::Index _stride = 0;
+
+  Eigen::MatrixXd _waveforms;  //!< The stride x capacity noise waveforms.
+  std::vector<double> _start_times;  //!< The aggressor noise arrive time.
+};
+
+}  // namespace ista
@@ -24,6 +24,7 @@
 
 #include "ElmoreDelayCalc.hh"
 
+#include <algorithm>
 #include <numeric>
 #include <queue>
 #include <utility>
@@ -55,35 +56,34 @@ void RctNode::calNodePIModel() {
 }
 
 double RctNode::nodeLoad(AnalysisMode mode, TransType trans_type) {
-  return _nload[ModeTransPair(mode, trans_type)];
+  return _network ? _network->load(_network_id, mode, trans_type) : 0.0;
 }
 
 double RctNode::cap(AnalysisMode mode, TransType trans_type) {
-  return _obj ? _obj->cap(mode, trans_type) +
-                    _ncap[ModeTransPair(mode, trans_type)]
-              : _ncap[ModeTransPair(mode, trans_type)];
+  int index = ModeTransToIndex(mode, trans_type);
+  return _obj ? _obj->cap(mode, trans_type) + _ncap[index] : _ncap[index];
 }
 
 void RctNode::setCap(double cap) {
   _cap = cap;
-  FOREACH_MODE_TRANS(mode, trans) { _ncap[ModeTransPair(mode, trans)] = cap; }
+  _ncap.fill(cap);
 }
 
 void RctNode::incrCap(double cap) {
   _cap += cap;
-  FOREACH_MODE_TRANS(mode, trans) { _ncap[ModeTransPair(mode, trans)] += cap; }
+  for (auto& ncap : _ncap) {
+    ncap += cap;
+  }
 }
 
 double RctNode::delay(AnalysisMode mode, TransType trans_type) {
-  return _ndelay[ModeTransPair(mode, trans_type)];
+  return _network ? _network->delay(_network_id, mode, trans_type) : 0.0;
 }
 
 double RctNode::slew(AnalysisMode mode, TransType trans_type,
                      double input_slew) {
-  auto si = input_slew;
-  return si < 0.0
-             ? -std::sqrt(si * si + _impulse[ModeTransPair(mode, trans_type)])
-             : std::sqrt(si * si + _impulse[ModeTransPair(mode, trans_type)]);
+  return _network ? _network->slew(_network_id, mode, trans_type, input_slew)
+                  : input_slew;
 }
 
 RctEdge::RctEdge(RctNode& from, RctNode& to, double res)
@@ -122,10 +122,7 @@ RctNode* RcTree::insertNode(const std::string& name, double cap) {
   auto& node = _str2nodes[name];
   node._name = name;
   node._cap = cap;
-
-  FOREACH_MODE_TRANS(mode, trans) {
-    node._ncap[ModeTransPair(mode, trans)] = cap;
-  }
+  node._ncap.fill(cap);
 
   return &node;
 }
@@ -197,27 +194,11 @@ void RcTree::insertSegment(const std::string& name1, const std::string& name2,
  *
  */
 void RcTree::initData() {
-  auto init_zero_value = [](auto& the_map) {
-    for (auto it = the_map.begin(); it != the_map.end(); it++) {
-      it->second = 0.0;
-    }
-  };
-
   for (auto& kvp : _str2nodes) {
-    kvp.second._load = 0.0;
-    kvp.second._delay = 0.0;
-
     kvp.second._is_update_load = 0;
     kvp.second._is_update_delay = 0;
     kvp.second._is_update_ldelay = 0;
     kvp.second._is_update_response = 0;
-
-    init_zero_value(kvp.second._ures);
-    init_zero_value(kvp.second._nload);
-    init_zero_value(kvp.second._beta);
-    init_zero_value(kvp.second._ndelay);
-    init_zero_value(kvp.second._ldelay);
-    init_zero_value(kvp.second._impulse);
   }
 }
 
@@ -231,126 +212,6 @@ void RcTree::initMoment() {
   wave_form.reduceRCTreeToPIModel(_root, load_nodes_pin_cap_sum);
 }
 
-/**
- * @brief calculate and update the each node's load of a rctree
- *
- * @param parent
- * @param from
- *
- */
-void RcTree::updateLoad(RctNode* parent, RctNode* from) {
-  if (from->isUpdateLoad()) {
-    LOG_ERROR << "found loop in rc tree " << from->get_name();
-    // printGraphViz();
-    return;
-  }
-
-  from->set_is_update_load(true);
-
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      updateLoad(from, &to);
-
-      from->_load += to._load;
-
-      FOREACH_MODE_TRANS(mode, trans) {
-        from->_nload[ModeTransPair(mode, trans)] +=
-            to._nload[ModeTransPair(mode, trans)];
-      }
-    }
-  }
-  from->_load += from->cap();
-
-  FOREACH_MODE_TRANS(mode, trans) {
-    from->_nload[ModeTransPair(mode, trans)] += from->cap(mode, trans);
-  }
-}
-
-/**
- * @brief upadate the delay from net root to each node
- *
- * @param parent
- * @param from
- */
-void RcTree::updateDelay(RctNode* parent, RctNode* from) {
-  if (from->isUpdateDelay()) {
-    return;
-  }
-
-  from->set_is_update_delay(true);
-
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      to._delay = from->_delay + e->_res * to._load;
-
-      FOREACH_MODE_TRANS(mode, trans) {
-        to._ndelay[ModeTransPair(mode, trans)] =
-            from->_ndelay[ModeTransPair(mode, trans)] +
-            e->_res * to._nload[ModeTransPair(mode, trans)];
-
-        // Update the upstream resistance.
-        to._ures[ModeTransPair(mode, trans)] =
-            from->_ures[ModeTransPair(mode, trans)] + e->_res;
-      }
-      updateDelay(from, &to);
-    }
-  }
-}
-
-// Procedure: _update_ldelay
-// Compute the load delay of each rctree node along the downstream traversal of
-// the rctree.
-void RcTree::updateLDelay(RctNode* parent, RctNode* from) {
-  if (from->isUpdateLdelay()) {
-    return;
-  }
-
-  from->set_is_update_Ldelay(true);
-
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      updateLDelay(from, &to);
-      FOREACH_MODE_TRANS(mode, trans) {
-        from->_ldelay[ModeTransPair(mode, trans)] +=
-            to._ldelay[ModeTransPair(mode, trans)];
-      }
-    }
-  }
-
-  FOREACH_MODE_TRANS(mode, trans) {
-    from->_ldelay[ModeTransPair(mode, trans)] +=
-        from->cap(mode, trans) * from->_ndelay[ModeTransPair(mode, trans)];
-  }
-}
-
-// Procedure: _update_response
-// Compute the impulse and second moment of the input response for each rctree
-// node.
-void RcTree::updateResponse(RctNode* parent, RctNode* from) {
-  if (from->isUpdateResponse()) {
-    return;
-  }
-
-  from->set_is_update_response(true);
-
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      FOREACH_MODE_TRANS(mode, trans) {
-        to._beta[ModeTransPair(mode, trans)] =
-            from->_beta[ModeTransPair(mode, trans)] +
-            e->_res * to._ldelay[ModeTransPair(mode, trans)];
-      }
-      updateResponse(from, &to);
-    }
-  }
-
-  FOREACH_MODE_TRANS(mode, trans) {
-    from->_impulse[ModeTransPair(mode, trans)] =
-        2.0 * from->_beta[ModeTransPair(mode, trans)] -
-        std::pow(from->_ndelay[ModeTransPair(mode, trans)], 2);
-  }
-}
-
 void RcTree::updateDelayECM(RctNode* parent, RctNode* from) {
   if (from->isUpdateDelayECM()) {
     return;
@@ -381,7 +242,7 @@ void RcTree::updateMC(RctNode* parent, RctNode* from) {
       from->_mc += to._mc;
     }
   }
-  from->_mc += from->_delay * from->cap();
+  from->_mc += from->delay() * from->cap();
 }
 
 /**
@@ -445,9 +306,42 @@ void RcTree::updateM2C(RctNode* parent, RctNode* from) {
   }
 }
 
+/**
+ * @brief build the flat rc network from the tree, the root is node 0, the
+ * others are numbered in name order, the broken edges are not included.
+ */
+void RcTree::buildNetwork() {
+  _network.clear();
+  _network.reserve(_str2nodes.size(), _edges.size());
+
+  auto add_network_node = [this](RctNode& node) {
+    node._network = &_network;
+    node._network_id = _network.addNode(node._cap);
+    _network.setNodeCap(node._network_id, node._cap, node._ncap);
+    _network.set_obj(node._network_id, node._obj);
+  };
+
+  add_network_node(*_root);
+  for (auto& [name, node] : _str2nodes) {
+    if (&node != _root) {
+      add_network_node(node);
+    }
+  }
+
+  for (auto& edge : _edges) {
+    if (!edge.isBreak()) {
+      _network.addEdge(edge._from._network_id, edge._to._network_id,
+                       edge._res);
+    }
+  }
+
+  _network.set_root(_root->_network_id);
+}
+
 /**
  * @brief calculate and update the load of each node,calculate and update the
- * delay from net root to each node.
+ * delay from net root to each node, the calculation is on the flat rc network,
+ * the tree node reads the result from the network by the node id.
  */
 void RcTree::updateRcTiming() {
   if (!_root) {
@@ -457,10 +351,8 @@ void RcTree::updateRcTiming() {
 
   initData();
 
-  updateLoad(nullptr, _root);
-  updateDelay(nullptr, _root);
-  updateLDelay(nullptr, _root);
-  updateResponse(nullptr, _root);
+  buildNetwork();
+  _network.updateTiming();
 
   if (c_print_delay_yaml) {
     updateMC(nullptr, _root);
@@ -489,7 +381,7 @@ double RcTree::delay(const std::string& name, AnalysisMode mode,
   if (itr == _str2nodes.end()) {
     LOG_FATAL << "RCTree node " << name << " can not found." << std::endl;
   }
-  return itr->second._ndelay[ModeTransPair(mode, trans_type)];
+  return itr->second.delay(mode, trans_type);
 }
 
 double RcTree::slew(const std::string& name, AnalysisMode mode,
@@ -748,6 +640,8 @@ void RcNet::updateRcTreeInfo() {
                         [this, driver](double v, DesignObject* pin) {
                           return pin == driver ? v : v + pin->cap();
                         });
+  } else if (auto* rc_network = network(); rc_network) {
+    rc_network->bindNet(_net);
   } else {
     auto& rct = std::get<RcTree>(_rct);
     for (auto* pin : pin_ports) {
@@ -784,6 +678,20 @@ void RcNet::updateRcTreeInfo() {
  * steps: 1、construce rctree 2、determine the root of rctree 3.update timing
  */
 void RcNet::updateRcTiming(const spef::Net& spef_net) {
+  // the crosstalk needs the coupled nodes of the rc tree, the delay yaml needs
+  // the tree moments, otherwise the network is built from spef directly.
+  bool is_coupled =
+      std::any_of(spef_net.caps.begin(), spef_net.caps.end(),
+                  [](const auto& cap) { return !std::get<1>(cap).empty(); });
+  if (!is_coupled && !c_print_delay_yaml) {
+    auto spef_cap_unit = get_rc_net_common_info()->get_spef_cap_unit();
+    auto& network = _rct.emplace<RcNetwork>();
+    network.buildFromSpef(spef_net, spef_cap_unit);
+    network.bindNet(_net);
+    network.updateTiming();
+    return;
+  }
+
   makeRct(spef_net);
   updateRcTreeInfo();
 
@@ -811,8 +719,10 @@ void RcNet::updateRcTiming(const spef::Net& spef_net) {
 double RcNet::load() {
   if (_rct.index() == 0) {
     return std::get<EmptyRct>(_rct).load;
+  } else if (auto* rc_network = network(); rc_network) {
+    return rc_network->load(rc_network->get_root());
   } else {
-    return std::get<RcTree>(_rct)._root->_load;
+    return std::get<RcTree>(_rct)._root->nodeLoad();
   }
 }
 
@@ -827,10 +737,11 @@ double RcNet::load() {
 double RcNet::load(AnalysisMode mode, TransType trans_type) {
   if (_rct.index() == 0) {
     return std::get<EmptyRct>(_rct).load;
+  } else if (auto* rc_network = network(); rc_network) {
+    return rc_network->load(rc_network->get_root(), mode, trans_type);
   } else {
-    if (std::get<RcTree>(_rct)._root) {
-      return std::get<RcTree>(_rct)
-          ._root->_nload[ModeTransPair(mode, trans_type)];
+    if (auto* root = std::get<RcTree>(_rct)._root; root) {
+      return root->nodeLoad(mode, trans_type);
     } else {
       return 0.0;
     }
@@ -872,6 +783,9 @@ double RcNet::getResistance(AnalysisMode mode, TransType trans_type,
     auto* node = rc_tree->node(node_name);
 
     res = node->get_ures(mode, trans_type);
+  } else if (auto* rc_network = network(); rc_network) {
+    int id = rc_network->findNode(load_obj->getFullName());
+    res = id < 0 ? 0.0 : rc_network->ures(id, mode, trans_type);
   }
 
   return res;
@@ -889,6 +803,15 @@ std::optional<double> RcNet::delay(DesignObject& to, DelayMethod delay_method) {
     return std::nullopt;
   }
 
+  // the network has no moment for the other delay method.
+  if (auto* rc_network = network(); rc_network) {
+    int id = rc_network->findNode(to.getFullName());
+    if (id < 0 || delay_method != DelayMethod::kElmore) {
+      return std::nullopt;
+    }
+    return rc_network->delay(id);
+  }
+
   auto node = std::get<RcTree>(_rct).node(to.getFullName());
   std::optional<double> delay;
   if (delay_method == DelayMethod::kElmore) {
@@ -911,8 +834,15 @@ std::optional<std::pair<double, Eigen::MatrixXd>> RcNet::delay(
     return std::nullopt;
   }
 
-  auto* node = std::get<RcTree>(_rct).node(to.getFullName());
   Eigen::MatrixXd waveform;
+  if (auto* rc_network = network(); rc_network) {
+    int id = rc_network->findNode(to.getFullName());
+    LOG_FATAL_IF(id < 0) << "node " << to.getFullName()
+                         << " not found in the RC network.";
+    return std::make_pair(rc_network->delay(id, mode, trans_type), waveform);
+  }
+
+  auto* node = std::get<RcTree>(_rct).node(to.getFullName());
   return std::make_pair(node->delay(mode, trans_type), waveform);
 }
 
@@ -924,6 +854,13 @@ std::optional<double> RcNet::slew(
     return std::nullopt;
   }
 
+  if (auto* rc_network = network(); rc_network) {
+    int id = rc_network->findNode(to.getFullName());
+    LOG_FATAL_IF(id < 0) << "node " << to.getFullName()
+                         << " not found in the RC network.";
+    return rc_network->slew(id, mode, trans_type, from_slew);
+  }
+
   auto* node = std::get<RcTree>(_rct).node(to.getFullName());
   if (!node) {
     printRctInfo();
@@ -938,14 +875,19 @@ std::optional<double> RcNet::slew(
  *
  */
 void RcNet::printRctInfo() {
+  if (auto* rc_network = network(); rc_network) {
+    DLOG_INFO << "network node num: " << rc_network->numNodes() << "\n";
+    return;
+  }
+
   auto& nodes = std::get<RcTree>(_rct)._str2nodes;
   DLOG_INFO << "node num: " << nodes.size() << "\n";
 
   for (auto& tnode : nodes) {
     DLOG_INFO << tnode.second._name << "\n";
-    DLOG_INFO << "load:" << tnode.second._load << std::endl;
+    DLOG_INFO << "load:" << tnode.second.nodeLoad() << std::endl;
     DLOG_INFO << "cap:" << tnode.second.cap() << std::endl;
-    DLOG_INFO << "delay:" << tnode.second._delay << std::endl;
+    DLOG_INFO << "delay:" << tnode.second.delay() << std::endl;
   }
 }
 }  // namespace ista
@@ -26,6 +26,7 @@
 
 #include <Eigen/Core>
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
 #include <optional>
@@ -34,6 +35,7 @@
 #include <string>
 #include <variant>
 
+#include "RcNetwork.hh"
 #include "WaveformApproximation.hh"
 #include "liberty/Liberty.hh"
 #include "netlist/Net.hh"
@@ -65,19 +67,21 @@ class RctNode {
   void set_is_root() { _is_root = 1; }
   [[nodiscard]] unsigned isRoot() const { return _is_root; }
 
-  [[nodiscard]] double nodeLoad() const { return _load; }
+  [[nodiscard]] double nodeLoad() const {
+    return _network ? _network->load(_network_id) : 0.0;
+  }
   double nodeLoad(AnalysisMode mode, TransType trans_type);
   [[nodiscard]] double cap() const { return _obj ? _obj->cap() + _cap : _cap; }
   [[nodiscard]] double get_cap() const { return _cap; }
   double cap(AnalysisMode mode, TransType trans_type);
   double get_cap(AnalysisMode mode, TransType trans_type) {
-    return _ncap[ModeTransPair(mode, trans_type)];
+    return _ncap[ModeTransToIndex(mode, trans_type)];
   }
   void setCap(double cap);
   void incrCap(double cap);
 
   double get_ures(AnalysisMode mode, TransType trans_type) {
-    return _ures[ModeTransPair(mode, trans_type)];
+    return _network ? _network->ures(_network_id, mode, trans_type) : 0.0;
   }
 
   void calNodePIModel();
@@ -87,10 +91,12 @@ class RctNode {
     _pi.R = pi->R;
   }
 
-  [[nodiscard]] double delay() const { return _delay; }
+  [[nodiscard]] double delay() const {
+    return _network ? _network->delay(_network_id) : 0.0;
+  }
   double delay(AnalysisMode mode, TransType trans_type);
   [[nodiscard]] double delayD2M() const {
-    return _m2 == 0 ? 0 : _delay * _delay / sqrt(_m2) * log(2);
+    return _m2 == 0 ? 0 : delay() * delay() / sqrt(_m2) * log(2);
   }
   [[nodiscard]] double delayECM() const { return _delay_ecm; }
   [[nodiscard]] double delayD2MM() const {
@@ -101,7 +107,8 @@ class RctNode {
     if (_moments.y2 == 0 && _moments.y3 == 0) {
       _ceff = nodeLoad();
     } else {
-      _ceff = _pi.C_near + _pi.C_far * (1 - exp(-_delay / (_pi.R * _pi.C_far)));
+      _ceff =
+          _pi.C_near + _pi.C_far * (1 - exp(-delay() / (_pi.R * _pi.C_far)));
     }
     return _ceff;
   }
@@ -185,8 +192,6 @@ class RctNode {
   std::string _name;
 
   double _cap = 0.0;
-  double _load = 0.0;
-  double _delay = 0.0;
   double _mc = 0.0;    //!< Elmore * cap
   double _m2 = 0.0;    //!< The two moment.
   double _mc_c = 0.0;  //!< Elmore * ceff
@@ -210,13 +215,11 @@ class RctNode {
   unsigned _is_root : 1 = 0;
   unsigned _reserved : 18 = 0;
 
-  std::map<ModeTransPair, double> _ures;
-  std::map<ModeTransPair, double> _nload;
-  std::map<ModeTransPair, double> _beta;
-  std::map<ModeTransPair, double> _ncap;
-  std::map<ModeTransPair, double> _ndelay;
-  std::map<ModeTransPair, double> _ldelay;
-  std::map<ModeTransPair, double> _impulse;
+  // The load, delay and response are kept in the rc network of the tree.
+  const RcNetwork* _network{nullptr};
+  int _network_id = -1;  //!< The node id in the rc network.
+
+  RcNetwork::SplitValue _ncap{};  //!< Indexed by ModeTransToIndex.
 
   std::list<RctEdge*> _fanin;
   std::list<RctEdge*> _fanout;
@@ -333,6 +336,7 @@ class RcTree {
     std::swap(lhs._root, rhs._root);
     std::swap(lhs._str2nodes, rhs._str2nodes);
     std::swap(lhs._edges, rhs._edges);
+    std::swap(lhs._network, rhs._network);
   }
 
  public:
@@ -364,6 +368,7 @@ class RcTree {
   auto get_node_num() { return _str2nodes.size(); }
   auto& get_edges() { return _edges; }
   auto& get_coupled_nodes() { return _coupled_nodes; }
+  auto& get_network() { return _network; }
 
   void removeEdge(RctEdge* the_edge) {
     auto it =
@@ -437,17 +442,17 @@ class RcTree {
 
   std::vector<CoupledRcNode> _coupled_nodes;
 
+  RcNetwork _network;  //!< The flat network for the timing calculation, the
+                       //!< root is node 0, the others are in name order.
+
   void initData();
+  void buildNetwork();
   void initMoment();
-  void updateLoad(RctNode*, RctNode*);
   void updateMC(RctNode* parent, RctNode* from);
   void updateMCC(RctNode* parent, RctNode* from);
-  void updateDelay(RctNode*, RctNode*);
   void updateDelayECM(RctNode* parent, RctNode* from);
   void updateM2(RctNode* parent, RctNode* from);
   void updateM2C(RctNode* parent, RctNode* from);
-  void updateLDelay(RctNode* parent, RctNode* from);
-  void updateResponse(RctNode* parent, RctNode* from);
 
   RctNode* rcNode(const std::string&);
 
@@ -521,8 +526,11 @@ class RcNet {
   [[nodiscard]] size_t numPins() const;
 
   [[nodiscard]] auto* get_net() const { return _net; }
+  // unique for each rc net, a rebuilt rc net never has the stamp of the old.
+  [[nodiscard]] uint64_t get_version() const { return _version; }
 
   RcTree* rct() { return std::get_if<RcTree>(&_rct); }
+  RcNetwork* network() { return std::get_if<RcNetwork>(&_rct); }
   void makeRct() { _rct.emplace<RcTree>(); }
   virtual void makeRct(const spef::Net& spef_net);
   void updateRcTreeInfo();
@@ -571,13 +579,18 @@ class RcNet {
 
  protected:
   Net* _net;
-  std::variant<EmptyRct, RcTree> _rct;
+  // the spef net without coupled cap is built to the flat network directly,
+  // the rc tree is kept for the coupled net and the incremental rc api.
+  std::variant<EmptyRct, RcTree, RcNetwork> _rct;
 
   std::queue<RctNode*> _rc_loop;
   bool _is_found_loop = false;
 
  private:
+  uint64_t _version = _next_version.fetch_add(1, std::memory_order_relaxed);
+
   static std::unique_ptr<RCNetCommonInfo> _rc_net_common_info;
+  static inline std::atomic<uint64_t> _next_version{1};
 };
 
 }  // namespace ista
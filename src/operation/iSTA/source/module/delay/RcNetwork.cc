@@ -0,0 +1,476 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of
+// Sciences Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan
+// PSL v2. You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY
+// KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// NON-INFRINGEMENT, MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file RcNetwork.cc
+ * @author LH (liuh0326@163.com)
+ * @brief The flat rc network implemention.
+ * @version 0.1
+ * @date 2025-03-20
+ */
+
+#include "RcNetwork.hh"
+
+#include <cmath>
+
+#include "log/Log.hh"
+
+namespace ista {
+
+void RcNetwork::clear() {
+  _node_cap.clear();
+  _node_split_cap.clear();
+  _objs.clear();
+  _name_to_id.clear();
+  _edges.clear();
+  _root = -1;
+  _is_adjacency_built = false;
+}
+
+void RcNetwork::reserve(std::size_t num_nodes, std::size_t num_edges) {
+  _node_cap.reserve(num_nodes);
+  _node_split_cap.reserve(num_nodes);
+  _objs.reserve(num_nodes);
+  _edges.reserve(num_edges);
+}
+
+/**
+ * @brief add the node without name, the id is returned.
+ *
+ * @param cap
+ * @return int
+ */
+int RcNetwork::addNode(double cap) {
+  int id = static_cast<int>(_node_cap.size());
+  _node_cap.push_back(cap);
+  _node_split_cap.push_back({cap, cap, cap, cap});
+  _objs.push_back(nullptr);
+  _is_adjacency_built = false;
+  return id;
+}
+
+/**
+ * @brief add the named node, the cap is overwritten if the node exist.
+ *
+ * @param name
+ * @param cap
+ * @return int
+ */
+int RcNetwork::addNode(const std::string& name, double cap) {
+  if (auto it = _name_to_id.find(name); it != _name_to_id.end()) {
+    setNodeCap(it->second, cap, {cap, cap, cap, cap});
+    return it->second;
+  }
+
+  int id = addNode(cap);
+  _name_to_id.emplace(name, id);
+  return id;
+}
+
+int RcNetwork::findNode(const std::string& name) const {
+  auto it = _name_to_id.find(name);
+  return it != _name_to_id.end() ? it->second : -1;
+}
+
+void RcNetwork::setNodeCap(int id, double cap, const SplitValue& split_cap) {
+  _node_cap[id] = cap;
+  _node_split_cap[id] = split_cap;
+}
+
+void RcNetwork::addEdge(int from, int to, double res) {
+  _edges.push_back({from, to, res});
+  _is_adjacency_built = false;
+}
+
+/**
+ * @brief build the network from the spef net directly, the node cap is the
+ * same as RcNet::makeRct, the coupled cap is not belong to the network.
+ *
+ * @param spef_net
+ * @param spef_cap_unit
+ */
+void RcNetwork::buildFromSpef(const spef::Net& spef_net,
+                              CapacitiveUnit spef_cap_unit) {
+  clear();
+  reserve(spef_net.connections.size() + spef_net.caps.size(),
+          spef_net.ress.size() * 2);
+
+  auto uniform_cap_unit = CapacitiveUnit::kPF;
+  for (const auto& conn : spef_net.connections) {
+    addNode(conn.name, (conn.load ? ConvertCapUnit(spef_cap_unit,
+                                                   uniform_cap_unit,
+                                                   *(conn.load))
+                                  : 0.0));
+  }
+
+  for (const auto& [node1, node2, cap] : spef_net.caps) {
+    if (node2.empty()) {
+      addNode(node1, ConvertCapUnit(spef_cap_unit, uniform_cap_unit, cap));
+    }
+  }
+
+  auto get_or_add_node = [this](const std::string& name) {
+    int id = findNode(name);
+    if (id < 0) {
+      LOG_INFO_FIRST_N(10) << "spef node " << name << " is not exist.";
+      id = addNode(name, 0.0001);
+    }
+    return id;
+  };
+
+  for (const auto& [node1, node2, res] : spef_net.ress) {
+    LOG_FATAL_IF(node2.empty());
+    int id1 = get_or_add_node(node1);
+    int id2 = get_or_add_node(node2);
+    addResistor(id1, id2, res);
+  }
+}
+
+/**
+ * @brief bind the pin ports of the net to the node, the driver is the root.
+ *
+ * @param net
+ */
+void RcNetwork::bindNet(Net* net) {
+  auto* driver = net->getDriver();
+  for (auto* pin : net->get_pin_ports()) {
+    int id = findNode(pin->getFullName());
+    LOG_FATAL_IF(id < 0) << "pin " << pin->getFullName()
+                         << " can not found in rc network " << net->get_name();
+    if (pin == driver) {
+      _root = id;
+    }
+    _objs[id] = pin;
+  }
+  LOG_FATAL_IF(_root < 0) << "not found rc network root of net "
+                          << net->get_name();
+}
+
+/**
+ * @brief build the CSR adjacency from the edges, counting sort by from node.
+ *
+ */
+void RcNetwork::buildAdjacency() {
+  auto num_nodes = numNodes();
+  _adj_offset.assign(num_nodes + 1, 0);
+  for (const auto& edge : _edges) {
+    ++_adj_offset[edge.from + 1];
+  }
+  for (std::size_t i = 0; i < num_nodes; ++i) {
+    _adj_offset[i + 1] += _adj_offset[i];
+  }
+
+  _adj_node.resize(_edges.size());
+  _adj_res.resize(_edges.size());
+  std::vector<int> pos(_adj_offset.begin(), _adj_offset.end() - 1);
+  for (const auto& edge : _edges) {
+    int k = pos[edge.from]++;
+    _adj_node[k] = edge.to;
+    _adj_res[k] = edge.res;
+  }
+
+  _is_adjacency_built = true;
+}
+
+/**
+ * @brief build the breadth first order from the root, the edge to the visited
+ * node except the parent closes a loop, it is skipped.
+ *
+ */
+void RcNetwork::buildOrder() {
+  auto num_nodes = numNodes();
+  _order.clear();
+  _order.reserve(num_nodes);
+  _parent.assign(num_nodes, -1);
+  _parent_res.assign(num_nodes, 0.0);
+
+  std::vector<char> is_visited(num_nodes, 0);
+  is_visited[_root] = 1;
+  _order.push_back(_root);
+
+  std::size_t num_loop_edges = 0;
+  for (std::size_t head = 0; head < _order.size(); ++head) {
+    int from = _order[head];
+    for (int k = _adj_offset[from]; k < _adj_offset[from + 1]; ++k) {
+      int to = _adj_node[k];
+      if (to == _parent[from]) {
+        continue;
+      }
+      if (is_visited[to]) {
+        ++num_loop_edges;
+        continue;
+      }
+      is_visited[to] = 1;
+      _parent[to] = from;
+      _parent_res[to] = _adj_res[k];
+      _order.push_back(to);
+    }
+  }
+
+  if (num_loop_edges > 0) {
+    LOG_ERROR << "found loop in rc network, " << num_loop_edges
+              << " edges are skipped.";
+  }
+}
+
+/**
+ * @brief calculate the load, the elmore delay and the second moment response
+ * of each node.
+ *
+ */
+void RcNetwork::updateTiming() {
+  auto num_nodes = numNodes();
+  SplitValue zero{0.0, 0.0, 0.0, 0.0};
+  _load.assign(num_nodes, 0.0);
+  _delay.assign(num_nodes, 0.0);
+  _nload.assign(num_nodes, zero);
+  _ndelay.assign(num_nodes, zero);
+  _ures.assign(num_nodes, zero);
+  _ldelay.assign(num_nodes, zero);
+  _beta.assign(num_nodes, zero);
+  _impulse.assign(num_nodes, zero);
+
+  if (_root < 0 || _root >= static_cast<int>(num_nodes)) {
+    LOG_ERROR << "RC network root can not found";
+    _order.clear();
+    return;
+  }
+
+  if (!_is_adjacency_built) {
+    buildAdjacency();
+  }
+  buildOrder();
+
+  // the node cap with the pin cap.
+  std::vector<double> total_cap(num_nodes);
+  std::vector<SplitValue> total_split_cap(num_nodes);
+  for (int id : _order) {
+    total_cap[id] = _node_cap[id];
+    total_split_cap[id] = _node_split_cap[id];
+    if (auto* obj = _objs[id]; obj) {
+      total_cap[id] += obj->cap();
+      FOREACH_MODE_TRANS(mode, trans) {
+        total_split_cap[id][ModeTransToIndex(mode, trans)] +=
+            obj->cap(mode, trans);
+      }
+    }
+  }
+
+  // upward, the downstream load.
+  for (auto it = _order.rbegin(); it != _order.rend(); ++it) {
+    int id = *it;
+    _load[id] += total_cap[id];
+    for (int k = 0; k < MODE_TRANS_SPLIT; ++k) {
+      _nload[id][k] += total_split_cap[id][k];
+    }
+    if (int parent = _parent[id]; parent >= 0) {
+      _load[parent] += _load[id];
+      for (int k = 0; k < MODE_TRANS_SPLIT; ++k) {
+        _nload[parent][k] += _nload[id][k];
+      }
+    }
+  }
+
+  // downward, the elmore delay and the upstream resistance.
+  for (int id : _order) {
+    int parent = _parent[id];
+    if (parent < 0) {
+      continue;
+    }
+    double res = _parent_res[id];
+    _delay[id] = _delay[parent] + res * _load[id];
+    for (int k = 0; k < MODE_TRANS_SPLIT; ++k) {
+      _ndelay[id][k] = _ndelay[parent][k] + res * _nload[id][k];
+      _ures[id][k] = _ures[parent][k] + res;
+    }
+  }
+
+  // upward, the load delay.
+  for (auto it = _order.rbegin(); it != _order.rend(); ++it) {
+    int id = *it;
+    for (int k = 0; k < MODE_TRANS_SPLIT; ++k) {
+      _ldelay[id][k] += total_split_cap[id][k] * _ndelay[id][k];
+    }
+    if (int parent = _parent[id]; parent >= 0) {
+      for (int k = 0; k < MODE_TRANS_SPLIT; ++k) {
+        _ldelay[parent][k] += _ldelay[id][k];
+      }
+    }
+  }
+
+  // downward, the second moment and the impulse.
+  for (int id : _order) {
+    if (int parent = _parent[id]; parent >= 0) {
+      double res = _parent_res[id];
+      for (int k = 0; k < MODE_TRANS_SPLIT; ++k) {
+        _beta[id][k] = _beta[parent][k] + res * _ldelay[id][k];
+      }
+    }
+    for (int k = 0; k < MODE_TRANS_SPLIT; ++k) {
+      _impulse[id][k] = 2.0 * _beta[id][k] - std::pow(_ndelay[id][k], 2);
+    }
+  }
+}
+
+double RcNetwork::slew(int id, AnalysisMode mode, TransType trans_type,
+                       double input_slew) const {
+  auto si = input_slew;
+  double impulse = _impulse[id][ModeTransToIndex(mode, trans_type)];
+  return si < 0.0 ? -std::sqrt(si * si + impulse)
+                  : std::sqrt(si * si + impulse);
+}
+
+/**
+ * @brief the dense conductance matrix, the same as the RC tree, the diagonal
+ * is the fanin conductance and the off diagonal is the opposite of the fanout
+ * conductance.
+ *
+ * @return Eigen::MatrixXd
+ */
+Eigen::MatrixXd RcNetwork::conductanceMatrix() const {
+  auto num_nodes = static_cast<Eigen::Index>(numNodes());
+  Eigen::MatrixXd conductances = Eigen::MatrixXd::Zero(num_nodes, num_nodes);
+  for (const auto& edge : _edges) {
+    double conductance = 1.0 / edge.res;
+    conductances(edge.to, edge.to) += conductance;
+    conductances(edge.from, edge.to) = -conductance;
+  }
+  return conductances;
+}
+
+/**
+ * @brief solve G * voltage = current on the tree with the root grounded, one
+ * upward pass sums the downstream current, one downward pass accumulates the
+ * voltage drop, so it is O(n) without factorization.
+ *
+ * @param current
+ * @param voltage
+ */
+void RcNetwork::treeSolve(const Eigen::VectorXd& current,
+                          Eigen::VectorXd& voltage) const {
+  Eigen::VectorXd downstream = current;
+  for (auto it = _order.rbegin(); it != _order.rend(); ++it) {
+    if (int parent = _parent[*it]; parent >= 0) {
+      downstream(parent) += downstream(*it);
+    }
+  }
+
+  voltage.setZero(current.size());
+  for (int id : _order) {
+    if (int parent = _parent[id]; parent >= 0) {
+      voltage(id) = voltage(parent) + _parent_res[id] * downstream(id);
+    }
+  }
+}
+
+/**
+ * @brief the arnoldi orthogonal basis of the krylov space of G^-1 * C on the
+ * tree, orthogonalized by modified Gram-Schmidt. The input current is on the
+ * root, the floating network is charged uniformly, so the start vector is
+ * the uniform vector include the root, the following vectors are the moments
+ * relative to the root, solved with the root grounded. The updateTiming
+ * should be called before.
+ *
+ * @param mode
+ * @param trans_type
+ * @param order
+ * @return std::optional<Eigen::MatrixXd>
+ */
+std::optional<Eigen::MatrixXd> RcNetwork::arnoldiBasis(AnalysisMode mode,
+                                                       TransType trans_type,
+                                                       int order) const {
+  if (_order.size() < 2 || order < 0) {
+    return std::nullopt;
+  }
+
+  auto num_nodes = static_cast<Eigen::Index>(numNodes());
+  int index = ModeTransToIndex(mode, trans_type);
+  Eigen::VectorXd cap(num_nodes);
+  for (Eigen::Index i = 0; i < num_nodes; ++i) {
+    cap(i) = _node_split_cap[i][index];
+  }
+
+  Eigen::MatrixXd basis = Eigen::MatrixXd::Zero(num_nodes, order + 1);
+  Eigen::VectorXd start = Eigen::VectorXd::Zero(num_nodes);
+  for (int id : _order) {
+    start(id) = 1.0;
+  }
+  basis.col(0) = start.normalized();
+
+  constexpr double c_break_norm = 1e-12;
+  int num_cols = 1;
+  Eigen::VectorXd next(num_nodes);
+  for (int j = 1; j <= order; ++j) {
+    treeSolve(cap.cwiseProduct(basis.col(j - 1)), next);
+    double norm_before = next.norm();
+    for (int i = 0; i < j; ++i) {
+      next -= basis.col(i).dot(next) * basis.col(i);
+    }
+
+    double norm = next.norm();
+    if (norm <= c_break_norm * norm_before || norm == 0.0) {
+      break;
+    }
+    basis.col(j) = next / norm;
+    ++num_cols;
+  }
+
+  return Eigen::MatrixXd(basis.leftCols(num_cols));
+}
+
+/**
+ * @brief the reduced conductance V^T * G * V, G * V is calculated on the CSR
+ * arrays.
+ *
+ * @param basis
+ * @return Eigen::MatrixXd
+ */
+Eigen::MatrixXd RcNetwork::reduceConductance(
+    const Eigen::MatrixXd& basis) const {
+  LOG_FATAL_IF(!_is_adjacency_built) << "rc network timing is not updated.";
+  Eigen::MatrixXd g_basis = Eigen::MatrixXd::Zero(basis.rows(), basis.cols());
+  auto num_nodes = static_cast<int>(numNodes());
+  for (int from = 0; from < num_nodes; ++from) {
+    for (int k = _adj_offset[from]; k < _adj_offset[from + 1]; ++k) {
+      int to = _adj_node[k];
+      double conductance = 1.0 / _adj_res[k];
+      g_basis.row(from) -= conductance * basis.row(to);
+      g_basis.row(to) += conductance * basis.row(to);
+    }
+  }
+  return basis.transpose() * g_basis;
+}
+
+/**
+ * @brief the reduced ground cap V^T * C * V.
+ *
+ * @param basis
+ * @param mode
+ * @param trans_type
+ * @return Eigen::MatrixXd
+ */
+Eigen::MatrixXd RcNetwork::reduceCap(const Eigen::MatrixXd& basis,
+                                     AnalysisMode mode,
+                                     TransType trans_type) const {
+  int index = ModeTransToIndex(mode, trans_type);
+  Eigen::VectorXd cap(basis.rows());
+  for (Eigen::Index i = 0; i < basis.rows(); ++i) {
+    cap(i) = _node_split_cap[i][index];
+  }
+  return basis.transpose() * cap.asDiagonal() * basis;
+}
+
+}  // namespace ista
@@ -0,0 +1,154 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of
+// Sciences Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan
+// PSL v2. You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY
+// KIND, EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO
+// NON-INFRINGEMENT, MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file RcNetwork.hh
+ * @author LH (liuh0326@163.com)
+ * @brief The flat rc network of a net, the nodes are indexed by integer and the
+ * resistors are stored in CSR arrays.
+ * @version 0.1
+ * @date 2025-03-20
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+#include <array>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Type.hh"
+#include "netlist/DesignObject.hh"
+#include "netlist/Net.hh"
+#include "spef/parser-spef.hpp"
+
+namespace ista {
+
+/**
+ * @brief The flat rc network.
+ *
+ * The nodes are numbered from zero, the resistors are kept in CSR adjacency
+ * arrays, and the values of the split analysis are kept in fixed
+ * [mode][trans] slots, see ModeTransToIndex. The timing is calculated by
+ * iterative passes over the breadth first order from the root, one upward
+ * pass for the load and one downward pass for the delay, so no map is
+ * looked up and no recursion is needed for the large net.
+ */
+class RcNetwork {
+ public:
+  using SplitValue = std::array<double, MODE_TRANS_SPLIT>;
+
+  RcNetwork() = default;
+  ~RcNetwork() = default;
+  RcNetwork(RcNetwork&& other) noexcept = default;
+  RcNetwork& operator=(RcNetwork&& rhs) noexcept = default;
+
+  void clear();
+  void reserve(std::size_t num_nodes, std::size_t num_edges);
+
+  int addNode(double cap);
+  int addNode(const std::string& name, double cap);
+  [[nodiscard]] int findNode(const std::string& name) const;
+  void setNodeCap(int id, double cap, const SplitValue& split_cap);
+  void addEdge(int from, int to, double res);
+  void addResistor(int node1, int node2, double res) {
+    addEdge(node1, node2, res);
+    addEdge(node2, node1, res);
+  }
+
+  void buildFromSpef(const spef::Net& spef_net, CapacitiveUnit spef_cap_unit);
+  void bindNet(Net* net);
+
+  void set_root(int root) { _root = root; }
+  [[nodiscard]] int get_root() const { return _root; }
+  void set_obj(int id, DesignObject* obj) { _objs[id] = obj; }
+  [[nodiscard]] DesignObject* get_obj(int id) const { return _objs[id]; }
+
+  [[nodiscard]] std::size_t numNodes() const { return _node_cap.size(); }
+  [[nodiscard]] std::size_t numEdges() const { return _edges.size(); }
+
+  void updateTiming();
+
+  [[nodiscard]] double load(int id) const { return _load[id]; }
+  [[nodiscard]] double load(int id, AnalysisMode mode,
+                            TransType trans_type) const {
+    return _nload[id][ModeTransToIndex(mode, trans_type)];
+  }
+  [[nodiscard]] double delay(int id) const { return _delay[id]; }
+  [[nodiscard]] double delay(int id, AnalysisMode mode,
+                             TransType trans_type) const {
+    return _ndelay[id][ModeTransToIndex(mode, trans_type)];
+  }
+  [[nodiscard]] double ures(int id, AnalysisMode mode,
+                            TransType trans_type) const {
+    return _ures[id][ModeTransToIndex(mode, trans_type)];
+  }
+  [[nodiscard]] double groundCap(int id, AnalysisMode mode,
+                                 TransType trans_type) const {
+    return _node_split_cap[id][ModeTransToIndex(mode, trans_type)];
+  }
+  double slew(int id, AnalysisMode mode, TransType trans_type,
+              double input_slew) const;
+
+  Eigen::MatrixXd conductanceMatrix() const;
+  std::optional<Eigen::MatrixXd> arnoldiBasis(AnalysisMode mode,
+                                              TransType trans_type,
+                                              int order) const;
+  Eigen::MatrixXd reduceConductance(const Eigen::MatrixXd& basis) const;
+  Eigen::MatrixXd reduceCap(const Eigen::MatrixXd& basis, AnalysisMode mode,
+                            TransType trans_type) const;
+
+ private:
+  struct Edge {
+    int from;
+    int to;
+    double res;
+  };
+
+  void buildAdjacency();
+  void buildOrder();
+  void treeSolve(const Eigen::VectorXd& current,
+                 Eigen::VectorXd& voltage) const;
+
+  std::vector<double> _node_cap;             //!< The ground cap.
+  std::vector<SplitValue> _node_split_cap;   //!< The split ground cap.
+  std::vector<DesignObject*> _objs;          //!< The pin or port of the node.
+  std::unordered_map<std::string, int> _name_to_id;
+  std::vector<Edge> _edges;  //!< The resistors before build the adjacency.
+  int _root = -1;
+
+  std::vector<int> _adj_offset;   //!< The CSR row offset of each node.
+  std::vector<int> _adj_node;     //!< The CSR adjacent node.
+  std::vector<double> _adj_res;   //!< The CSR resistance.
+  std::vector<int> _order;        //!< The breadth first order from root.
+  std::vector<int> _parent;       //!< The parent node, -1 for root.
+  std::vector<double> _parent_res;  //!< The resistance to the parent.
+
+  std::vector<double> _load;
+  std::vector<double> _delay;
+  std::vector<SplitValue> _nload;
+  std::vector<SplitValue> _ndelay;
+  std::vector<SplitValue> _ures;    //!< The upstream resistance.
+  std::vector<SplitValue> _ldelay;  //!< The downstream sum of cap * delay.
+  std::vector<SplitValue> _beta;
+  std::vector<SplitValue> _impulse;
+
+  bool _is_adjacency_built = false;
+};
+
+}  // namespace ista
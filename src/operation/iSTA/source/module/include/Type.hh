@@ -64,6 +64,18 @@ enum class ModeTransIndex : int {
   kMinFall = 3
 };
 
+/**
+ * @brief Get the [mode][trans] slot index of the split value array.
+ */
+constexpr int ModeTransToIndex(AnalysisMode mode, TransType trans_type) {
+  return static_cast<int>(
+      (mode == AnalysisMode::kMax)
+          ? ((trans_type == TransType::kRise) ? ModeTransIndex::kMaxRise
+                                              : ModeTransIndex::kMaxFall)
+          : ((trans_type == TransType::kRise) ? ModeTransIndex::kMinRise
+                                              : ModeTransIndex::kMinFall));
+}
+
 using ModeTransPair = std::pair<AnalysisMode, TransType>;
 
 #define FOREACH_MODE_TRANS(mode, trans) for (auto [mode, trans] : g_split_trans)
@@ -42,6 +42,7 @@
 #include "StaClockPropagation.hh"
 #include "StaConstPropagation.hh"
 #include "StaCrossTalkPropagation.hh"
+#include "StaDataPool.hh"
 #include "StaDataPropagation.hh"
 #include "StaDelayPropagation.hh"
 #include "StaDump.hh"
@@ -49,6 +50,7 @@
 #include "StaGraph.hh"
 #include "StaLevelization.hh"
 #include "StaPathData.hh"
+#include "StaPathEnumerator.hh"
 #include "StaReport.hh"
 #include "StaSlewPropagation.hh"
 #include "ThreadPool/ThreadPool.h"
@@ -108,6 +110,7 @@ Sta *Sta::getOrCreateSta() {
 void Sta::destroySta() {
   delete _sta;
   _sta = nullptr;
+  StaDataPool::releaseSlabs();
 }
 
 /**
@@ -119,6 +122,21 @@ void Sta::set_design_work_space(const char *design_work_space) {
   _design_work_space = design_work_space;
 }
 
+/**
+ * @brief Get the thread pool kept between the propagations, the pool is
+ * recreated when the thread num is changed.
+ *
+ * @return ThreadPool&
+ */
+ThreadPool &Sta::getThreadPool() {
+  if (!_thread_pool || _thread_pool_size != _num_threads) {
+    _thread_pool.reset();
+    _thread_pool_size = _num_threads;
+    _thread_pool = std::make_unique<ThreadPool>(_thread_pool_size);
+  }
+  return *_thread_pool;
+}
+
 /**
  * @brief Get the constrains, if not, create one.
  *
@@ -1213,36 +1231,57 @@ void Sta::setReportSpec(std::vector<std::string> &&prop_froms,
  * @return unsigned 1 if success, 0 else fail.
  */
 unsigned Sta::reportPath(const char *rpt_file_name, bool is_derate /*=true*/) {
-  auto report_path =
-      [this](StaReportPathSummary &report_path_func) -> unsigned {
-    unsigned is_ok = 1;
+  // the reported path groups, the clock gate group is the last one.
+  auto get_report_groups = [this]() -> std::vector<StaSeqPathGroup *> {
+    std::vector<StaSeqPathGroup *> report_groups;
 
     auto path_group = get_path_group();  // specify path group.
 
     for (auto &&[capture_clock, seq_path_group] : _clock_groups) {
       if (!path_group ||
           path_group.value() == capture_clock->get_clock_name()) {
-        is_ok = report_path_func(seq_path_group.get());
-        if (!is_ok) {
-          break;
-        }
+        report_groups.push_back(seq_path_group.get());
       }
     }
 
     if (_clock_gate_group) {
-      is_ok = report_path_func(_clock_gate_group.get());
+      report_groups.push_back(_clock_gate_group.get());
+    }
+
+    return report_groups;
+  };
+
+  auto report_path = [](StaReportPathSummary &report_path_func,
+                        std::vector<StaSeqPathGroup *> &report_groups)
+      -> unsigned {
+    unsigned is_ok = 1;
+
+    for (auto *seq_path_group : report_groups) {
+      // the clock gate group is reported even if the clock group failed.
+      if (!is_ok && !seq_path_group->isStaClockGatePathGroup()) {
+        continue;
+      }
+      is_ok = report_path_func(seq_path_group);
     }
 
     return is_ok;
   };
 
-  auto report_path_of_mode = [&report_path, this, rpt_file_name,
+  auto report_path_of_mode = [&report_path, &get_report_groups, this,
+                              rpt_file_name,
                               is_derate](AnalysisMode mode) -> unsigned {
     unsigned is_ok = 1;
     if ((get_analysis_mode() == mode) ||
         (get_analysis_mode() == AnalysisMode::kMaxMin)) {
       unsigned n_worst = get_n_worst_path_per_clock();
 
+      // enumerate the worst paths once, shared by all the reports.
+      auto report_groups = get_report_groups();
+      StaPathEnumerator path_enumerator(mode, n_worst,
+                                        get_n_worst_path_per_endpoint(),
+                                        &getThreadPool(), get_num_threads());
+      path_enumerator(report_groups);
+
       StaReportPathSummary report_path_summary(rpt_file_name, mode, n_worst);
       report_path_summary.set_significant_digits(get_significant_digits());
 
@@ -1264,7 +1303,8 @@ unsigned Sta::reportPath(const char *rpt_file_name, bool is_derate /*=true*/) {
       }
 
       for (auto *report_fun : report_funcs) {
-        is_ok = report_path(*report_fun);
+        report_fun->set_path_enumerator(&path_enumerator);
+        is_ok = report_path(*report_fun, report_groups);
       }
     }
 
@@ -1768,6 +1808,47 @@ StaSeqPathData *Sta::getWorstSeqData(AnalysisMode mode, TransType trans_type) {
   return getWorstSeqData(std::nullopt, mode, trans_type);
 }
 
+/**
+ * @brief Get the worst path of each end vertex whose slack is less than the
+ * slack margin, sorted by slack from worst to best.
+ *
+ * @param mode
+ * @param slack_margin (ns)
+ * @return std::vector<StaSeqPathData*>
+ */
+std::vector<StaSeqPathData *> Sta::getViolatedSeqPaths(AnalysisMode mode,
+                                                       double slack_margin) {
+  // end vertex -> index of its worst path, paths keep the visiting order.
+  std::map<StaVertex *, std::size_t> end_path_index;
+  std::vector<StaSeqPathData *> violated_paths;
+  for (const auto &[clk, seq_path_group] : _clock_groups) {
+    StaPathEnd *path_end;
+    StaPathData *path_data;
+    FOREACH_PATH_GROUP_END(seq_path_group.get(), path_end) {
+      FOREACH_PATH_END_DATA(path_end, mode, path_data) {
+        auto *seq_path_data = dynamic_cast<StaSeqPathData *>(path_data);
+        if (seq_path_data->getSlackNs() >= slack_margin) {
+          continue;
+        }
+        auto [it, is_new] = end_path_index.emplace(path_end->get_end_vertex(),
+                                                   violated_paths.size());
+        if (is_new) {
+          violated_paths.push_back(seq_path_data);
+        } else if (seq_path_data->getSlack() <
+                   violated_paths[it->second]->getSlack()) {
+          violated_paths[it->second] = seq_path_data;
+        }
+      }
+    }
+  }
+
+  std::stable_sort(violated_paths.begin(), violated_paths.end(),
+                   [](StaSeqPathData *left, StaSeqPathData *right) {
+                     return left->getSlack() < right->getSlack();
+                   });
+  return violated_paths;
+}
+
 /**
  * @brief Get the violated StaSeqPathDatas of the two specified sinks that form
  * the timing path.
@@ -1955,6 +2036,14 @@ unsigned Sta::resetGraphData() {
   return 1;
 }
 
+/**
+ * @brief Release the data pool slabs of the freed graph data, call it after
+ * reset graph data when the memory is not reused by the next propagation.
+ *
+ * @return std::size_t The released slab num.
+ */
+std::size_t Sta::releaseDataPool() { return StaDataPool::releaseSlabs(); }
+
 /**
  * @brief reset path data.
  *
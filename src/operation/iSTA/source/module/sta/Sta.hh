@@ -29,6 +29,7 @@
 #include <mutex>
 #include <optional>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 
@@ -47,6 +48,8 @@
 #include "sdc/SdcSetIODelay.hh"
 #include "verilog/VerilogReader.hh"
 
+class ThreadPool;
+
 namespace ista {
 
 class SdcConstrain;
@@ -168,6 +171,7 @@ class Sta {
 
   void set_num_threads(unsigned num_thread) { _num_threads = num_thread; }
   [[nodiscard]] unsigned get_num_threads() const { return _num_threads; }
+  ThreadPool& getThreadPool();
 
   void set_n_worst_path_per_clock(unsigned n_worst) {
     _n_worst_path_per_clock = n_worst;
@@ -236,21 +240,31 @@ class Sta {
 
   Vector<std::unique_ptr<LibertyLibrary>>& getAllLib() { return _libs; }
 
+  // the rc net of different nets can be created or reset in parallel.
   void resetRcNet(Net* the_net) {
+    std::unique_lock<std::shared_mutex> lk(_rc_net_mt);
     if (_net_to_rc_net.contains(the_net)) {
       _net_to_rc_net.erase(the_net);
     }
   }
 
   void addRcNet(Net* the_net, std::unique_ptr<RcNet> rc_net) {
+    std::unique_lock<std::shared_mutex> lk(_rc_net_mt);
     _net_to_rc_net[the_net] = std::move(rc_net);
   }
-  void removeRcNet(Net* the_net) { _net_to_rc_net.erase(the_net); }
+  void removeRcNet(Net* the_net) {
+    std::unique_lock<std::shared_mutex> lk(_rc_net_mt);
+    _net_to_rc_net.erase(the_net);
+  }
   RcNet* getRcNet(Net* the_net) {
-    return _net_to_rc_net.contains(the_net) ? _net_to_rc_net[the_net].get()
-                                            : nullptr;
+    std::shared_lock<std::shared_mutex> lk(_rc_net_mt);
+    auto it = _net_to_rc_net.find(the_net);
+    return it != _net_to_rc_net.end() ? it->second.get() : nullptr;
+  }
+  void resetAllRcNet() {
+    std::unique_lock<std::shared_mutex> lk(_rc_net_mt);
+    _net_to_rc_net.clear();
   }
-  void resetAllRcNet() { _net_to_rc_net.clear(); }
 
   LibertyCell* findLibertyCell(const char* cell_name);
   std::optional<AocvObjectSpecSet*> findDataAocvObjectSpecSet(
@@ -434,6 +448,8 @@ class Sta {
                                   AnalysisMode mode, TransType trans_type);
 
   StaSeqPathData* getWorstSeqData(AnalysisMode mode, TransType trans_type);
+  std::vector<StaSeqPathData*> getViolatedSeqPaths(AnalysisMode mode,
+                                                   double slack_margin);
 
   std::priority_queue<StaSeqPathData*, std::vector<StaSeqPathData*>,
                       decltype(seq_data_cmp)>
@@ -450,6 +466,7 @@ class Sta {
                     std::set<std::string>& exclude_cell_names);
 
   unsigned resetGraphData();
+  std::size_t releaseDataPool();
   unsigned resetPathData();
   unsigned updateTiming();
   unsigned updateClockTiming();
@@ -491,6 +508,8 @@ class Sta {
   std::string _design_work_space;
 
   unsigned _num_threads = 48;  //!< The num of thread for propagation.
+  std::unique_ptr<ThreadPool> _thread_pool;  //!< The persistent thread pool.
+  unsigned _thread_pool_size = 0;            //!< The thread num of the pool.
   unsigned _n_worst_path_per_clock =
       3;  //!< The top n worst path config for each clock.
   unsigned _n_worst_path_per_endpoint = 1;    //!< The top n worst path
@@ -524,6 +543,7 @@ class Sta {
   StaGraph _graph;  //!< The graph mapped to netlist.
   std::map<Net*, std::unique_ptr<RcNet>>
       _net_to_rc_net;                         //!< The net to rc net.
+  std::shared_mutex _rc_net_mt;               //!< The rc net map lock.
   Vector<std::unique_ptr<StaClock>> _clocks;  //!< The clock domain.
   Multimap<StaVertex*, SdcSetIODelay*>
       _io_delays;  //!< The port vertex io delay constrain.
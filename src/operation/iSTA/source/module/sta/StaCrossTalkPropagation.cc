@@ -23,294 +23,286 @@
  */
 #include "StaCrossTalkPropagation.hh"
 
+#include <algorithm>
+#include <future>
+#include <map>
+#include <vector>
+
 #include "ThreadPool/ThreadPool.h"
 #include "delay/ArnoldiDelayCal.hh"
 #include "delay/CrossTalkDelayCalc.hh"
-#include "solver/Interpolation.hh"
+#include "delay/CrossTalkWaveform.hh"
 #include "string/Str.hh"
 
 namespace ista {
 
 /**
- * @brief calc the specify point voltage of waveform.
+ * @brief Judge whether the driver vertex drive a net coupled with other nets.
  *
- * @param waveform
- * @param step_time
- * @param start_arrive_time
- * @param point_time
- * @return std::optional<double>
+ * @param the_vertex
+ * @return true if the net is victim.
  */
-std::optional<double> calcWaveformPointVoltage(const VectorXd& waveform,
-                                               double step_time,
-                                               double start_arrive_time,
-                                               double point_time) {
-  double time1;
-  double time2;
-  double v1;
-  double v2;
-  bool is_found = false;
-  auto num_point = waveform.rows();
-  for (int i = 1; i < num_point; ++i) {
-    if (double tmp = start_arrive_time + i * step_time; tmp >= point_time) {
-      time1 = tmp;
-      v1 = waveform(i);
-      time2 = tmp - step_time;
-      v2 = waveform(i - 1);
-      is_found = true;
-      break;
+bool StaCrossTalkPropagation::isVictimDriver(StaVertex* the_vertex) {
+  auto* ista = getSta();
+  FOREACH_SRC_ARC(the_vertex, src_arc) {
+    if (!src_arc->isNetArc()) {
+      continue;
     }
-  }
 
-  std::optional<double> time;
-  if (is_found) {
-    time = LinearInterpolate(time2, time1, v2, v1, point_time);
+    auto* the_net = dynamic_cast<StaNetArc*>(src_arc)->get_net();
+    auto* rc_net = ista->getRcNet(the_net);
+    auto* rc_tree = rc_net ? rc_net->rct() : nullptr;
+    return rc_tree && rc_tree->isHaveCoupledNodes();
   }
-  return time;
+
+  return false;
 }
 
 /**
- * @brief The timing arc propagation, we need calc net arc crosstalk.
+ * @brief Calc the crosstalk delay of the victim net arc, the aggressor noise
+ * is superimposed on the load pin waveform.
  *
- * @param the_arc
+ * @param local_net_arc
+ * @param crosstalk_waveforms The aggressor waveform buffer, reused between
+ * the arcs of the same thread.
  * @return unsigned
  */
-unsigned StaCrossTalkPropagation::operator()(StaArc* the_arc) {
-  unsigned is_ok = 1;
+unsigned StaCrossTalkPropagation::calcNetArcCrossTalk(
+    StaNetArc* local_net_arc, CrossTalkWaveforms& crosstalk_waveforms) {
   auto* ista = getSta();
   auto* nl = ista->get_netlist();
 
-  if (the_arc->isNetArc()) {
-    auto* snk_vertex = the_arc->get_snk();
-    auto* design_obj = snk_vertex->get_design_obj();
-    if (design_obj->isPort()) {
-      return 1;
-    }
+  auto* snk_vertex = local_net_arc->get_snk();
+  auto* design_obj = snk_vertex->get_design_obj();
+  if (design_obj->isPort()) {
+    return 1;
+  }
 
-    auto* load_pin = dynamic_cast<Pin*>(design_obj);
-    auto* local_net_arc = dynamic_cast<StaNetArc*>(the_arc);
+  auto* load_pin = dynamic_cast<Pin*>(design_obj);
 
-    auto* the_net = local_net_arc->get_net();
-    auto* local_rc_net = ista->getRcNet(the_net);
-    if (!local_rc_net) {
-      return 1;
+  auto* the_net = local_net_arc->get_net();
+  auto* local_rc_net = ista->getRcNet(the_net);
+  if (!local_rc_net) {
+    return 1;
+  }
+  auto* local_rc_tree = local_rc_net->rct();
+  if (!local_rc_tree || !local_rc_tree->isHaveCoupledNodes()) {
+    return 1;
+  }
+
+  auto* local_arnoldi_rc_net = dynamic_cast<ArnoldiNet*>(local_rc_net);
+  auto* pin_node = local_rc_tree->node(load_pin->getFullName());
+  LOG_FATAL_IF(!pin_node) << "not found pin rc node" << load_pin->getFullName();
+
+  auto* src_vertex = local_net_arc->get_src();
+  auto& coupled_nodes = local_rc_tree->get_coupled_nodes();
+
+  // for arc waveform data, how we choose which data to propagated, GBA should
+  // be choosed.
+  StaData* local_arc_waveform_data;
+  FOREACH_ARC_WAVEFORM_DATA(local_net_arc, local_arc_waveform_data) {
+    auto local_arc_delay_type = local_arc_waveform_data->get_delay_type();
+    if (local_arc_delay_type != get_analysis_mode() &&
+        (AnalysisMode::kMaxMin != get_analysis_mode())) {
+      continue;
     }
-    auto* local_rc_tree = local_rc_net->rct();
-    if (!local_rc_tree || !local_rc_tree->isHaveCoupledNodes()) {
-      return 1;
+
+    TransType local_trans_type = local_arc_waveform_data->get_trans_type();
+    // TODO(to taosimin) fix fall trans type.
+    if (local_trans_type != TransType::kRise) {
+      continue;
+    }
+
+    auto local_arrive_time =
+        src_vertex->getArriveTimeNs(local_arc_delay_type, local_trans_type);
+    if (!local_arrive_time) {
+      LOG_INFO << "The drive vertex " << src_vertex->getName()
+               << " has no time.";
+      continue;
     }
 
-    auto* local_arnoldi_rc_net = dynamic_cast<ArnoldiNet*>(local_rc_net);
-    auto* pin_node = local_rc_tree->node(load_pin->getFullName());
-    LOG_FATAL_IF(!pin_node)
-        << "not found pin rc node" << load_pin->getFullName();
-
-    std::vector<CrossTalkDelayCalc> crosstalk_models;
-    // for arc waveform data, how we choose which data to propagated, GBA should
-    // be choosed.
-    StaData* local_arc_waveform_data;
-    FOREACH_ARC_WAVEFORM_DATA(local_net_arc, local_arc_waveform_data) {
-      auto local_arc_delay_type = local_arc_waveform_data->get_delay_type();
-      if (local_arc_delay_type != get_analysis_mode() &&
-          (AnalysisMode::kMaxMin != get_analysis_mode())) {
+    auto& load_waveform =
+        ((StaArcWaveformData*)local_arc_waveform_data)
+            ->getWaveform(local_arnoldi_rc_net->getNodeID(pin_node));
+
+    auto step_time_ns = load_waveform.get_step_time_ns();
+    auto& load_pin_waveform_vec = load_waveform.get_waveform_vector();
+    crosstalk_waveforms.reset(step_time_ns, load_pin_waveform_vec.size());
+
+    // The coupled node should be on the net, and act as victim or aggressor.
+    // As victim, should calc the two-pi model and the noise waveform.
+    // As aggressor, should calc the input slew.
+    for (auto& couple_node : coupled_nodes) {
+      auto& local_node_name = couple_node.get_local_node();
+      auto* local_rc_node = local_rc_tree->node(local_node_name);
+      if (!local_rc_node) {
+        LOG_INFO_EVERY_N(100) << local_node_name << " node is not exist.";
         continue;
       }
-
-      TransType local_trans_type = local_arc_waveform_data->get_trans_type();
-      // TODO(to taosimin) fix fall trans type.
-      if (local_trans_type != TransType::kRise) {
+      auto& remote_node_name = couple_node.get_remote_node();
+
+      LOG_INFO_EVERY_N(100)
+          << "calc couple node noise local : " << local_node_name
+          << " remote : " << remote_node_name;
+
+      // Firstly, from remote node, we get the remote rc net according the net
+      // name.
+      auto [remote_net_or_instance_name, remote_node_point] =
+          Str::splitTwoPart(remote_node_name.c_str(), ":");
+      Net* remote_design_net;
+      DesignObject* remote_pin{nullptr};
+
+      if (std::isdigit(remote_node_point[0])) {
+        remote_design_net = nl->findNet(remote_net_or_instance_name.c_str());
+      } else {
+        auto found_pins = nl->findPin(remote_node_name.c_str(), false, false);
+        LOG_FATAL_IF(found_pins.empty())
+            << "pin " << remote_node_name << " is empty";
+        remote_pin = found_pins.front();
+        remote_design_net = remote_pin->get_net();
+      }
+      LOG_FATAL_IF(!remote_design_net)
+          << "remote design net " << remote_node_name << " is null.";
+
+      auto* remote_rc_net = ista->getRcNet(remote_design_net);
+      // Then, we get the input slew waveform.
+      auto* remote_rc_tree = remote_rc_net->rct();
+      auto* remote_driver_node = remote_rc_tree->get_root();
+      auto* remote_rc_node = remote_rc_tree->node(remote_node_name);
+      if (!remote_rc_node) {
+        LOG_INFO << remote_node_name << " node is not exist.";
         continue;
       }
 
-      auto& load_waveform =
-          ((StaArcWaveformData*)local_arc_waveform_data)
-              ->getWaveform(local_arnoldi_rc_net->getNodeID(pin_node));
-
-      auto step_time_ns = load_waveform.get_step_time_ns();
-      auto& load_pin_waveform_vec = load_waveform.get_waveform_vector();
+      auto* remote_driver_pin = remote_design_net->getDriver();
+      auto* remote_driver_vertex = ista->findVertex(remote_driver_pin);
+      LOG_FATAL_IF(!remote_driver_vertex) << "remote driver vertex not found"
+                                          << remote_driver_pin->get_name();
+      auto* remote_net_arc = remote_driver_vertex->get_src_arcs().front();
 
-      auto& coupled_nodes = local_rc_tree->get_coupled_nodes();
+      auto remote_arrive_time = remote_driver_vertex->getArriveTimeNs(
+          local_arc_delay_type, local_trans_type);
+      if (!remote_arrive_time) {
+        LOG_INFO << remote_node_name << " arrive time is not exist.";
+        continue;
+      }
 
-      // The coupled node should be on the net, and act as victim or aggressor.
-      // As victim, should calc the two-pi model and the noise waveform.
-      // As aggressor, should calc the input slew.
-      for (auto& couple_node : coupled_nodes) {
-        auto& local_node_name = couple_node.get_local_node();
-        auto* local_rc_node = local_rc_tree->node(local_node_name);
-        if (!local_rc_node) {
-          LOG_INFO_EVERY_N(100) << local_node_name << " node is not exist.";
+      auto* remote_arnoldi_net = dynamic_cast<ArnoldiNet*>(remote_rc_net);
+      LOG_FATAL_IF(!remote_arnoldi_net)
+          << remote_node_name << " arnolid net is not created.";
+
+      StaData* remote_arc_waveform_data;
+      FOREACH_ARC_WAVEFORM_DATA(remote_net_arc, remote_arc_waveform_data) {
+        auto remote_arc_delay_type = remote_arc_waveform_data->get_delay_type();
+        TransType remote_trans_type =
+            remote_arc_waveform_data->get_trans_type();
+        if ((local_arc_delay_type != remote_arc_delay_type) ||
+            (local_trans_type != remote_trans_type)) {
           continue;
         }
-        auto& remote_node_name = couple_node.get_remote_node();
-
-        LOG_INFO_EVERY_N(100)
-            << "calc couple node noise local : " << local_node_name
-            << " remote : " << remote_node_name;
-
-        // Firstly, from remote node, we get the remote rc net according the net
-        // name.
-        auto [remote_net_or_instance_name, remote_node_point] =
-            Str::splitTwoPart(remote_node_name.c_str(), ":");
-        Net* remote_design_net;
-        DesignObject* remote_pin{nullptr};
-
-        if (std::isdigit(remote_node_point[0])) {
-          remote_design_net = nl->findNet(remote_net_or_instance_name.c_str());
-        } else {
-          auto found_pins = nl->findPin(remote_node_name.c_str(), false, false);
-          LOG_FATAL_IF(found_pins.empty())
-              << "pin " << remote_node_name << " is empty";
-          remote_pin = found_pins.front();
-          remote_design_net = remote_pin->get_net();
-        }
-        LOG_FATAL_IF(!remote_design_net)
-            << "remote design net " << remote_node_name << " is null.";
-
-        auto* remote_rc_net = ista->getRcNet(remote_design_net);
-        // Then, we get the input slew waveform.
-        auto* remote_rc_tree = remote_rc_net->rct();
-        auto* remote_driver_node = remote_rc_tree->get_root();
-        auto* remote_rc_node = remote_rc_tree->node(remote_node_name);
-        if (!remote_rc_node) {
-          LOG_INFO << remote_node_name << " node is not exist.";
+
+        unsigned remote_rc_node_id =
+            remote_arnoldi_net->getNodeID(remote_rc_node);
+        auto& remote_rc_node_waveform =
+            ((StaArcWaveformData*)remote_arc_waveform_data)
+                ->getWaveform(remote_rc_node_id);
+        unsigned remote_driver_node_id =
+            remote_arnoldi_net->getNodeID(remote_driver_node);
+        auto& remote_driver_waveform =
+            ((StaArcWaveformData*)remote_arc_waveform_data)
+                ->getWaveform(remote_driver_node_id);
+
+        auto remote_rc_node_arrive_time = remote_arnoldi_net->delay(
+            remote_driver_waveform, remote_rc_node_waveform, remote_pin);
+        if (!remote_rc_node_arrive_time) {
+          LOG_INFO << remote_node_name << " arrive time is not exist.";
           continue;
         }
 
-        auto* remote_driver_pin = remote_design_net->getDriver();
-        auto* remote_driver_vertex = ista->findVertex(remote_driver_pin);
-        LOG_FATAL_IF(!remote_driver_vertex) << "remote driver vertex not found"
-                                            << remote_driver_pin->get_name();
-        auto* remote_net_arc = remote_driver_vertex->get_src_arcs().front();
-
-        auto remote_arrive_time = remote_driver_vertex->getArriveTimeNs(
-            local_arc_delay_type, local_trans_type);
-
-        auto* remote_arnoldi_net = dynamic_cast<ArnoldiNet*>(remote_rc_net);
-        LOG_FATAL_IF(!remote_arnoldi_net)
-            << remote_node_name << " arnolid net is not created.";
-
-        StaData* remote_arc_waveform_data;
-        FOREACH_ARC_WAVEFORM_DATA(remote_net_arc, remote_arc_waveform_data) {
-          auto remote_arc_delay_type =
-              local_arc_waveform_data->get_delay_type();
-          TransType remote_trans_type =
-              local_arc_waveform_data->get_trans_type();
-          if ((local_arc_delay_type != remote_arc_delay_type) ||
-              (local_trans_type != remote_trans_type)) {
-            continue;
-          }
-
-          unsigned remote_rc_node_id =
-              remote_arnoldi_net->getNodeID(remote_rc_node);
-          auto& remote_rc_node_waveform =
-              ((StaArcWaveformData*)remote_arc_waveform_data)
-                  ->getWaveform(remote_rc_node_id);
-          unsigned remote_driver_node_id =
-              remote_arnoldi_net->getNodeID(remote_driver_node);
-          auto& remote_driver_waveform =
-              ((StaArcWaveformData*)remote_arc_waveform_data)
-                  ->getWaveform(remote_driver_node_id);
-
-          auto remote_rc_node_arrive_time = remote_arnoldi_net->delay(
-              remote_driver_waveform, remote_rc_node_waveform, remote_pin);
-
-          auto slew =
-              remote_arnoldi_net->slew(remote_rc_node_waveform, remote_pin);
-          if (!slew) {
-            LOG_INFO_EVERY_N(100) << remote_node_name << " slew is not exist.";
-            continue;
-          }
-
-          // Thirdly, we reduced the local net to 2-pi model. Finally, we calc
-          // the output noise waveform.
-
-          CrossTalkDelayCalc crosstalk_delay_calc(remote_design_net, the_net);
-          crosstalk_delay_calc.reduceRCTreeToTwoPiModel(local_rc_net,
-                                                        local_rc_node);
-          if (!remote_arrive_time || !remote_rc_node_arrive_time) {
-            LOG_INFO << remote_node_name << " arrive time is not exist.";
-            continue;
-          }
-          double noise_arrive_time =
-              remote_arrive_time.value() + remote_rc_node_arrive_time.value();
-          crosstalk_delay_calc.calcNoiseAmplitude(noise_arrive_time, *slew);
-
-          crosstalk_models.emplace_back(std::move(crosstalk_delay_calc));
+        // The aggressor noise out of the victim waveform window has no
+        // effect, skip it before the two pi model reduction.
+        double noise_arrive_time =
+            remote_arrive_time.value() + remote_rc_node_arrive_time.value();
+        if (!crosstalk_waveforms.isOverlap(local_arrive_time.value(),
+                                           noise_arrive_time)) {
+          continue;
         }
-      }
 
-      // The crosstalk waveform and ccs waveform overlap.
-      std::vector<std::pair<double, VectorXd>> crosstalk_waveforms;
-      auto waveform_num_point = load_pin_waveform_vec.size();
-      for (auto& crosstalk_model : crosstalk_models) {
-        VectorXd the_model_crosstalk_waveform(waveform_num_point);
-        for (int i = 0; i < waveform_num_point; ++i) {
-          double point_voltage =
-              crosstalk_model.calcNoiseVoltage(step_time_ns * i);
-          the_model_crosstalk_waveform(i) = point_voltage;
+        auto slew =
+            remote_arnoldi_net->slew(remote_rc_node_waveform, remote_pin);
+        if (!slew) {
+          LOG_INFO_EVERY_N(100) << remote_node_name << " slew is not exist.";
+          continue;
         }
 
-        double arrive_time = crosstalk_model.get_input_arrive_time();
-        crosstalk_waveforms.emplace_back(
-            arrive_time, std::move(the_model_crosstalk_waveform));
-      }
+        // Thirdly, we reduced the local net to 2-pi model. Finally, we calc
+        // the output noise waveform.
+        CrossTalkDelayCalc crosstalk_delay_calc(remote_design_net, the_net);
+        crosstalk_delay_calc.reduceRCTreeToTwoPiModel(local_rc_net,
+                                                      local_rc_node);
+        crosstalk_delay_calc.calcNoiseAmplitude(noise_arrive_time, *slew);
 
-      auto* src_vertex = the_arc->get_src();
-      auto local_arrive_time =
-          src_vertex->getArriveTimeNs(local_arc_delay_type, local_trans_type);
-      if (!local_arrive_time) {
-        LOG_INFO << "The drive vertex " << src_vertex->getName()
-                 << " has no time.";
-        continue;
+        crosstalk_waveforms.addAggressor(crosstalk_delay_calc,
+                                         noise_arrive_time);
       }
+    }
 
-      // The overlap waveform need consider the arrive time of the first point.
-      for (auto& [crosstalk_start_time, crosstalk_waveform] :
-           crosstalk_waveforms) {
-        // LOG_INFO << "crosstalk waveform \n" << crosstalk_waveform;
-        for (int i = 0; i < waveform_num_point; ++i) {
-          // need to consider the arrive time
-          double local_waveform_time =
-              local_arrive_time.value() + i * step_time_ns;
-
-          auto crosstalk_voltage = calcWaveformPointVoltage(
-              crosstalk_waveform, step_time_ns, crosstalk_start_time,
-              local_waveform_time);
-          load_pin_waveform_vec(i) += crosstalk_voltage.value_or(0.0);
-        }
-      }
+    if (crosstalk_waveforms.size() == 0) {
+      continue;
+    }
 
-      // Update the crosstalk delay to load pin vertex.
-      Waveform local_driver_waveform =
-          ((StaArcWaveformData*)local_arc_waveform_data)
-              ->getWaveform(0);  // driver node id is zero.
-      auto& driver_waveform_vec = local_driver_waveform.get_waveform_vector();
-      // LOG_INFO << "load pin waveform \n" << load_pin_waveform_vec;
-
-      local_arnoldi_rc_net->set_is_debug(true);
-      auto new_delay_with_crosstalk_ps = local_arnoldi_rc_net->calcDelay(
-          driver_waveform_vec, load_pin_waveform_vec, step_time_ns, load_pin);
-
-      if (new_delay_with_crosstalk_ps &&
-          new_delay_with_crosstalk_ps.value() != 0) {
-        auto origin_net_delay_fs =
-            the_arc->get_arc_delay(local_arc_delay_type, local_trans_type);
-        double crosstalk_delay_fs =
-            PS_TO_FS(new_delay_with_crosstalk_ps.value()) - origin_net_delay_fs;
-        LOG_INFO << "the net " << the_net->get_name() << " crosstalk delay "
-                 << FS_TO_NS(crosstalk_delay_fs) / 1e6 << " ns";
-
-        // Set the crosstalk delay to net.
-        local_net_arc->updateCrosstalkDelay(
-            local_arc_delay_type, local_trans_type, crosstalk_delay_fs);
-
-        // TODO(to taosimin) fix fall trans type.
-        local_net_arc->updateCrosstalkDelay(
-            local_arc_delay_type, TransType::kFall, crosstalk_delay_fs);
-      }
+    // The crosstalk waveform and ccs waveform overlap, the load waveform is
+    // kept, the overlap is on the copy.
+    VectorXd crosstalk_load_waveform_vec = load_pin_waveform_vec;
+    crosstalk_waveforms.superimpose(local_arrive_time.value(),
+                                    crosstalk_load_waveform_vec);
+
+    // Update the crosstalk delay to load pin vertex.
+    auto& local_driver_waveform =
+        ((StaArcWaveformData*)local_arc_waveform_data)
+            ->getWaveform(0);  // driver node id is zero.
+    auto& driver_waveform_vec = local_driver_waveform.get_waveform_vector();
+
+    auto new_delay_with_crosstalk_ps = local_arnoldi_rc_net->calcDelay(
+        driver_waveform_vec, crosstalk_load_waveform_vec, step_time_ns,
+        load_pin);
+
+    if (new_delay_with_crosstalk_ps &&
+        new_delay_with_crosstalk_ps.value() != 0) {
+      auto origin_net_delay_fs =
+          local_net_arc->get_arc_delay(local_arc_delay_type, local_trans_type);
+      double crosstalk_delay_fs =
+          PS_TO_FS(new_delay_with_crosstalk_ps.value()) - origin_net_delay_fs;
+      LOG_INFO << "the net " << the_net->get_name() << " crosstalk delay "
+               << FS_TO_NS(crosstalk_delay_fs) / 1e6 << " ns";
+
+      // Set the crosstalk delay to net.
+      local_net_arc->updateCrosstalkDelay(local_arc_delay_type,
+                                          local_trans_type, crosstalk_delay_fs);
+
+      // TODO(to taosimin) fix fall trans type.
+      local_net_arc->updateCrosstalkDelay(local_arc_delay_type,
+                                          TransType::kFall, crosstalk_delay_fs);
     }
   }
 
-  return is_ok;
+  return 1;
+}
+
+/**
+ * @brief The timing arc propagation, we need calc net arc crosstalk.
+ *
+ * @param the_arc
+ * @return unsigned
+ */
+unsigned StaCrossTalkPropagation::operator()(StaArc* the_arc) {
+  if (!the_arc->isNetArc()) {
+    return 1;
+  }
+
+  CrossTalkWaveforms crosstalk_waveforms;
+  return calcNetArcCrossTalk(dynamic_cast<StaNetArc*>(the_arc),
+                             crosstalk_waveforms);
 }
 
 /**
@@ -357,7 +349,8 @@ unsigned StaCrossTalkPropagation::operator()(StaVertex* the_vertex) {
 }
 
 /**
- * @brief The crosstalk delay calc propagation.
+ * @brief The crosstalk delay calc propagation, the victim nets are calculated
+ * level by level on the sta thread pool.
  *
  * @param the_graph
  * @return unsigned
@@ -366,24 +359,44 @@ unsigned StaCrossTalkPropagation::operator()(StaGraph* the_graph) {
   LOG_INFO << "crosstalk delay propagation start";
   unsigned is_ok = 1;
 
-  // create thread pool
+  std::map<unsigned, std::vector<StaVertex*>> level_to_drivers;
+  StaVertex* the_vertex;
+  FOREACH_VERTEX(the_graph, the_vertex) {
+    if (isVictimDriver(the_vertex)) {
+      level_to_drivers[the_vertex->get_level()].push_back(the_vertex);
+    }
+  }
+
+  auto calc_drivers = [this](StaVertex** begin, StaVertex** end) -> unsigned {
+    unsigned is_ok = 1;
+    CrossTalkWaveforms crosstalk_waveforms;
+    for (auto* driver_vertex = begin; driver_vertex != end; ++driver_vertex) {
+      FOREACH_SRC_ARC((*driver_vertex), src_arc) {
+        if (src_arc->isNetArc()) {
+          is_ok &= calcNetArcCrossTalk(dynamic_cast<StaNetArc*>(src_arc),
+                                       crosstalk_waveforms);
+        }
+      }
+    }
+    return is_ok;
+  };
+
   unsigned num_threads = getNumThreads();
-  ThreadPool pool(num_threads);
-  StaVertex* end_vertex;
+  auto& pool = getSta()->getThreadPool();
+  for (auto& [level, drivers] : level_to_drivers) {
+    std::size_t chunk_size =
+        std::max<std::size_t>(1, drivers.size() / (num_threads * 4));
+
+    std::vector<std::future<unsigned>> results;
+    for (std::size_t i = 0; i < drivers.size(); i += chunk_size) {
+      auto* begin = drivers.data() + i;
+      auto* end = drivers.data() + std::min(drivers.size(), i + chunk_size);
+      results.emplace_back(pool.enqueue(calc_drivers, begin, end));
+    }
 
-  FOREACH_END_VERTEX(the_graph, end_vertex) {
-    if (end_vertex->get_snk_arcs().empty()) {
-      continue;
+    for (auto& result : results) {
+      is_ok &= result.get();
     }
-#if 1
-    // enqueue and store future
-    pool.enqueue([](StaFunc& func,
-                    StaVertex* end_vertex) { return end_vertex->exec(func); },
-                 *this, end_vertex);
-#else
-    is_ok = end_vertex->exec(*this);
-
-#endif
   }
 
   LOG_INFO << "crosstalk delay propagation end";
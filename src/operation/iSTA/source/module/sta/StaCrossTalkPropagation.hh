@@ -29,14 +29,21 @@
 namespace ista {
 
 class StaArc;
+class StaNetArc;
 class StaVertex;
 class StaGraph;
+class CrossTalkWaveforms;
 
 class StaCrossTalkPropagation : public StaFunc {
  public:
   unsigned operator()(StaArc* the_arc) override;
   unsigned operator()(StaVertex* the_vertex) override;
   unsigned operator()(StaGraph* the_graph) override;
+
+ private:
+  bool isVictimDriver(StaVertex* the_vertex);
+  unsigned calcNetArcCrossTalk(StaNetArc* local_net_arc,
+                               CrossTalkWaveforms& crosstalk_waveforms);
 };
 
 }  // namespace ista
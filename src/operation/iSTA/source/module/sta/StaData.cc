@@ -23,6 +23,7 @@
  */
 #include "StaData.hh"
 
+#include <algorithm>
 #include <utility>
 
 #include "StaClock.hh"
@@ -418,17 +419,79 @@ unsigned StaArcWaveformData::compareSignature(const StaData* data) const {
 StaDataBucket::StaDataBucket(unsigned n_worst) : _n_worst(n_worst) {}
 
 StaDataBucket::StaDataBucket(StaDataBucket&& other) noexcept
-    : _data_list(std::move(other._data_list)),
-      _n_worst(other._n_worst),
-      _next(std::move(other._next)) {}
+    : _datas(std::move(other._datas)),
+      _groups(std::move(other._groups)),
+      _slot_heads(other._slot_heads),
+      _n_worst(other._n_worst) {
+  other._groups.clear();
+  other._slot_heads.fill(-1);
+}
 
 StaDataBucket& StaDataBucket::operator=(StaDataBucket&& rhs) noexcept {
-  _data_list = std::move(rhs._data_list);
+  _datas = std::move(rhs._datas);
+  _groups = std::move(rhs._groups);
+  _slot_heads = rhs._slot_heads;
   _n_worst = rhs._n_worst;
-  _next = std::move(rhs._next);
+  rhs._groups.clear();
+  rhs._slot_heads.fill(-1);
   return *this;
 }
 
+/**
+ * @brief Find the group which has the same signature of the data, only the
+ * groups linked from the mode trans slot of the data are compared, that is the
+ * groups of the different clock.
+ *
+ * @param data
+ * @return std::optional<std::size_t> The group index.
+ */
+std::optional<std::size_t> StaDataBucket::findGroup(StaData* data) {
+  int mode_trans_index =
+      ModeTransToIndex(data->get_delay_type(), data->get_trans_type());
+  for (int i = _slot_heads[mode_trans_index]; i != -1;
+       i = _groups[i]._next_group) {
+    if (_datas[_groups[i]._begin]->compareSignature(data)) {
+      return i;
+    }
+  }
+
+  return std::nullopt;
+}
+
+/**
+ * @brief Insert the data to the group at the pos.
+ *
+ * @param group_index
+ * @param pos The pos in the group.
+ * @param data
+ */
+void StaDataBucket::insertData(std::size_t group_index, uint32_t pos,
+                               StaData* data) {
+  auto& group = _groups[group_index];
+  _datas.emplace(_datas.begin() + group._begin + pos, data);
+  ++group._count;
+
+  for (auto i = group_index + 1; i < _groups.size(); ++i) {
+    ++_groups[i]._begin;
+  }
+}
+
+/**
+ * @brief Erase the data of the group at the pos.
+ *
+ * @param group_index
+ * @param pos The pos in the group.
+ */
+void StaDataBucket::eraseData(std::size_t group_index, uint32_t pos) {
+  auto& group = _groups[group_index];
+  _datas.erase(_datas.begin() + group._begin + pos);
+  --group._count;
+
+  for (auto i = group_index + 1; i < _groups.size(); ++i) {
+    --_groups[i]._begin;
+  }
+}
+
 /**
  * @brief Add data to bucket.
  *
@@ -448,74 +511,76 @@ void StaDataBucket::addData(StaData* data, int track_stack_deep) {
 
   track_stack_deep++;
 
-  // if (track_stack_deep > 4 && data->isPathDelayData()) {
-  //   LOG_INFO << "Debug";
-  // }
-
-  if (_data_list.empty()) {
-    insertData(data);
-  } else {
-    auto& top_data = _data_list.front();
-
-    if (top_data->compareSignature(data)) {
-      auto q = _data_list.begin();
-      bool is_insert = false;
-      // q is the previous data.
-      for (auto p = _data_list.begin(); p != _data_list.end(); q = p++) {
-        // whether more critical than data.
-        if (cmp(data, p->get())) {
-          if (p == _data_list.begin()) {
-            _data_list.emplace_front(data);
-          } else {
-            _data_list.emplace_after(q, data);
-          }
-          is_insert = true;
-          ++_count;
-          break;
-        }
-      }
+  auto group_index = findGroup(data);
+  if (!group_index) {
+    // the new signature group is appended at the end, and linked to the slot.
+    auto& slot_head = _slot_heads[ModeTransToIndex(data->get_delay_type(),
+                                                   data->get_trans_type())];
+    _groups.push_back({static_cast<uint32_t>(_datas.size()), 1, slot_head});
+    slot_head = static_cast<int>(_groups.size() - 1);
+    _datas.emplace_back(data);
+    return;
+  }
 
-      if (!is_insert) {
-        if (data->isSlewData() || data->isPathDelayData()) {
-          if (_count < _n_worst) {
-            _data_list.emplace_after(q, data);
-            ++_count;
-          }
-        } else {
-          _data_list.emplace_after(q, data);
-          ++_count;
-        }
-      }
+  auto& group = _groups[*group_index];
+  bool is_limit_data = data->isSlewData() || data->isPathDelayData();
+  if (is_limit_data && group._count == _n_worst) {
+    // the full group replace the least critical data in place, the later
+    // groups are not shifted.
+    auto group_begin = _datas.begin() + group._begin;
+    auto group_end = group_begin + group._count;
+    auto insert_pos = std::find_if(
+        group_begin, group_end,
+        [&data](auto& group_data) { return cmp(data, group_data.get()); });
+    if (insert_pos == group_end) {
+      return;
+    }
 
-      // erase the beyond limit data.
-      if (data->isSlewData() || data->isPathDelayData()) {
-        if (_count > _n_worst) {
-          auto begin_pos = _data_list.begin();
-          auto delete_prev_pos = std::next(begin_pos, _n_worst - 1);
-          auto& delete_data = *(std::next(delete_prev_pos));
+    auto& delete_data = *(group_end - 1);
+    if (delete_data->get_bwd()) {
+      delete_data->get_bwd()->erase_fwd(delete_data.get());
+    }
+    std::move_backward(insert_pos, group_end - 1, group_end);
+    insert_pos->reset(data);
+    return;
+  }
 
-          if (delete_data->get_bwd()) {
-            delete_data->get_bwd()->erase_fwd(delete_data.get());
-          }
+  bool is_insert = false;
+  for (uint32_t pos = 0; pos < group._count; ++pos) {
+    // whether more critical than data.
+    if (cmp(data, _datas[group._begin + pos].get())) {
+      insertData(*group_index, pos, data);
+      is_insert = true;
+      break;
+    }
+  }
 
-          _data_list.erase_after(delete_prev_pos);
-          --_count;
-        }
+  if (!is_insert) {
+    if (is_limit_data) {
+      if (group._count < _n_worst) {
+        insertData(*group_index, group._count, data);
       }
-
     } else {
-      if (_next) {
-        _next->addData(data, track_stack_deep);
-      } else {
-        _next = std::make_unique<StaDataBucket>(_n_worst);
-        _next->insertData(data);
+      insertData(*group_index, group._count, data);
+    }
+  }
+
+  // erase the beyond limit data.
+  if (is_limit_data) {
+    if (group._count > _n_worst) {
+      auto& delete_data = _datas[group._begin + _n_worst];
+
+      if (delete_data->get_bwd()) {
+        delete_data->get_bwd()->erase_fwd(delete_data.get());
       }
+
+      eraseData(*group_index, _n_worst);
     }
   }
 }
 
 StaDataBucketIterator::StaDataBucketIterator(StaDataBucket& data_bucket)
-    : _data_bucket(&data_bucket), _iter(data_bucket._data_list.begin()) {}
+    : _data_bucket(&data_bucket) {}
 
 /**
  * @brief Judge whether has next data.
@@ -524,20 +589,7 @@ StaDataBucketIterator::StaDataBucketIterator(StaDataBucket& data_bucket)
  * @return false
  */
 bool StaDataBucketIterator::hasNext() {
-  if (_iter != _data_bucket->_data_list.end()) {
-    return true;
-  }
-
-  bool is_ok = false;
-
-  auto* data_bucket = _data_bucket->_next.get();
-  if (data_bucket) {
-    _data_bucket = data_bucket;
-    _iter = data_bucket->_data_list.begin();
-    is_ok = true;
-  }
-
-  return is_ok;
+  return _index < _data_bucket->_datas.size();
 }
 
 /**
@@ -545,6 +597,8 @@ bool StaDataBucketIterator::hasNext() {
  *
  * @return StaData* The next data.
  */
-std::unique_ptr<StaData>& StaDataBucketIterator::next() { return *_iter++; }
+std::unique_ptr<StaData>& StaDataBucketIterator::next() {
+  return _data_bucket->_datas[_index++];
+}
 
 }  // namespace ista
@@ -24,7 +24,7 @@
  */
 #pragma once
 
-#include <forward_list>
+#include <array>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -36,6 +36,7 @@
 #include <vector>
 
 #include "BTreeSet.hh"
+#include "StaDataPool.hh"
 #include "Type.hh"
 #include "delay/WaveformInfo.hh"
 #include "log/Log.hh"
@@ -74,6 +75,14 @@ class StaData {
 
   virtual StaData* copy() { return new StaData(*this); }
 
+  // The data is allocated from the data pool, the size is the derived size.
+  static void* operator new(std::size_t size) {
+    return StaDataPool::allocate(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) {
+    StaDataPool::deallocate(ptr, size);
+  }
+
   virtual unsigned isSlewData() const { return 0; }
   virtual unsigned isClockData() const { return 0; }
   virtual unsigned isPathDelayData() const { return 0; }
@@ -286,6 +295,7 @@ class StaPathDelayData : public StaData {
   unsigned isPathDelayData() const override { return 1; }
   std::optional<int> get_req_time() const override { return _req_time; }
   void set_req_time(int req_time) override { _req_time = req_time; }
+  void reset_req_time() { _req_time.reset(); }
 
   StaClockData* get_launch_clock_data() const { return _launch_clock_data; }
 
@@ -339,7 +349,15 @@ class StaClockData : public StaData {
 
 /**
  * @brief The data bucket for store sta data for every vertex.
- * The bucket can pop out the beyond limit data.
+ * The bucket can pop out the beyond limit data. The data of the same signature
+ * is a group, the groups are stored contiguous in the data vector by the group
+ * create order, the data of group is sorted by critical. The vector is kept
+ * when free data, so the reset graph data reuse the memory.
+ *
+ * The groups of the same mode trans are linked from the slot head, so the find
+ * only compare the signature of the groups of different clock. The full group
+ * replace the data in place, only the group growth shift the begin of the
+ * later groups, the groups of a vertex are a few mode trans of a few clocks.
  */
 class StaDataBucket {
  public:
@@ -350,44 +368,40 @@ class StaDataBucket {
   StaDataBucket(StaDataBucket&& other) noexcept;
   StaDataBucket& operator=(StaDataBucket&& rhs) noexcept;
 
-  unsigned bucket_size() const { return _count; }
-  bool empty() { return _data_list.empty(); }
+  unsigned bucket_size() const { return _datas.size(); }
+  bool empty() { return _datas.empty(); }
   void addData(StaData* data, int track_stack_deep);
   StaData* frontData() {
-    return !_data_list.empty() ? _data_list.front().get() : nullptr;
+    return !_datas.empty() ? _datas.front().get() : nullptr;
   }
 
   void freeData() {
-    _data_list.clear();
-    _count = 0;
-    _next.reset(nullptr);
-  }
-
-  unsigned isFreeData() {
-    return (_data_list.empty() && _count == 0 && _next == nullptr);
+    _datas.clear();
+    _groups.clear();
+    _slot_heads.fill(-1);
   }
 
-  // insert data to the data list directly.
-  void insertData(StaData* data) {
-    _data_list.emplace_front(data);
-    _count++;
-  }
-
-  void set_next(std::unique_ptr<StaDataBucket>&& next_bucket) {
-    _next = std::move(next_bucket);
-  }
-  StaDataBucket* get_next() { return _next.get(); }
+  unsigned isFreeData() { return _datas.empty(); }
 
  private:
-  std::forward_list<std::unique_ptr<StaData>>
-      _data_list;  //!< The sta data list store the data
-                   //!< that has the same signature.
+  /*The data group of the same signature.*/
+  struct DataGroup {
+    uint32_t _begin;       //!< The first data index of the group.
+    uint32_t _count;       //!< The data num of the group.
+    int _next_group;       //!< The next group of the same mode trans.
+  };
+
+  std::optional<std::size_t> findGroup(StaData* data);
+  void insertData(std::size_t group_index, uint32_t pos, StaData* data);
+  void eraseData(std::size_t group_index, uint32_t pos);
 
-  unsigned _n_worst;    //!< Store the top n worst data.
-  unsigned _count = 0;  //!<  For the fwd list do not provide cout.
+  std::vector<std::unique_ptr<StaData>>
+      _datas;  //!< The sta data of the all groups.
+  std::vector<DataGroup> _groups;  //!< The data groups of different signature.
+  std::array<int, MODE_TRANS_SPLIT> _slot_heads{
+      -1, -1, -1, -1};  //!< The first group of the mode trans.
 
-  std::unique_ptr<StaDataBucket>
-      _next;  //!< The next data bucket which has different signature.
+  unsigned _n_worst;  //!< Store the top n worst data.
 
   DISALLOW_COPY_AND_ASSIGN(StaDataBucket);
 };
@@ -406,8 +420,7 @@ class StaDataBucketIterator {
 
  private:
   StaDataBucket* _data_bucket;
-  std::forward_list<std::unique_ptr<StaData>>::iterator
-      _iter;  //!< The related data bucket.
+  std::size_t _index = 0;  //!< The next data index of the bucket.
 };
 
 };  // namespace ista
@@ -0,0 +1,285 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file StaDataPool.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The implemention of the sta data memory pool.
+ * @version 0.1
+ * @date 2025-04-02
+ */
+#include "StaDataPool.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+
+namespace ista {
+
+namespace {
+// The thread cache is destroyed at the thread exit, the data freed after that
+// is returned to the pool directly.
+thread_local bool t_is_cache_destroyed = false;
+}  // namespace
+
+/**
+ * @brief The free lists of the thread, returned to the pool at thread exit.
+ *
+ */
+class StaDataPool::ThreadCache {
+ public:
+  ThreadCache() = default;
+  ~ThreadCache() {
+    t_is_cache_destroyed = true;
+    releaseAll();
+  }
+
+  void releaseAll() {
+    auto& pool = getPool();
+    for (std::size_t size_class = 0; size_class < c_num_size_class;
+         ++size_class) {
+      auto& free_list = _free_lists[size_class];
+      if (free_list._num > 0) {
+        pool.releaseBatch(size_class, free_list, free_list._num);
+      }
+    }
+  }
+
+  std::array<FreeList, c_num_size_class> _free_lists;
+};
+
+/**
+ * @brief Get the pool, the pool is not destroyed, the data may be freed in the
+ * static destruction.
+ *
+ * @return StaDataPool&
+ */
+StaDataPool& StaDataPool::getPool() {
+  static auto* pool = new StaDataPool();
+  return *pool;
+}
+
+/**
+ * @brief Get the thread cache of the current thread.
+ *
+ * @return ThreadCache* nullptr if the cache is destroyed.
+ */
+StaDataPool::ThreadCache* StaDataPool::getThreadCache() {
+  if (t_is_cache_destroyed) {
+    return nullptr;
+  }
+  thread_local ThreadCache thread_cache;
+  return &thread_cache;
+}
+
+/**
+ * @brief Move a batch of blocks to the free list, carve a new slab if the pool
+ * is empty.
+ *
+ * @param size_class
+ * @param free_list
+ */
+void StaDataPool::fetchBatch(std::size_t size_class, FreeList& free_list) {
+  std::lock_guard lk(_mutex);
+  auto& pool_free_list = _free_lists[size_class];
+  if (pool_free_list._num == 0) {
+    std::size_t block_size = (size_class + 1) * c_block_align;
+    auto& slab = _slabs.emplace_back(
+        Slab{std::make_unique<std::byte[]>(c_slab_size), size_class});
+    for (std::size_t offset = 0; offset + block_size <= c_slab_size;
+         offset += block_size) {
+      pool_free_list.push(
+          reinterpret_cast<FreeBlock*>(slab._memory.get() + offset));
+    }
+  }
+
+  std::size_t num_block = std::min(c_batch_num, pool_free_list._num);
+  for (std::size_t i = 0; i < num_block; ++i) {
+    free_list.push(pool_free_list.pop());
+  }
+}
+
+/**
+ * @brief Return the blocks of the free list to the pool.
+ *
+ * @param size_class
+ * @param free_list
+ * @param num_block
+ */
+void StaDataPool::releaseBatch(std::size_t size_class, FreeList& free_list,
+                               std::size_t num_block) {
+  std::lock_guard lk(_mutex);
+  auto& pool_free_list = _free_lists[size_class];
+  for (std::size_t i = 0; i < num_block; ++i) {
+    pool_free_list.push(free_list.pop());
+  }
+}
+
+/**
+ * @brief Allocate the memory of the data.
+ *
+ * @param size The data size.
+ * @return void*
+ */
+void* StaDataPool::allocate(std::size_t size) {
+  if (size > c_max_block_size) {
+    return ::operator new(size);
+  }
+
+  auto size_class = sizeClass(size);
+  auto& pool = getPool();
+  if (auto* thread_cache = getThreadCache(); thread_cache) {
+    auto& free_list = thread_cache->_free_lists[size_class];
+    if (free_list._num == 0) {
+      pool.fetchBatch(size_class, free_list);
+    }
+    return free_list.pop();
+  }
+
+  FreeList free_list;
+  pool.fetchBatch(size_class, free_list);
+  void* block = free_list.pop();
+  pool.releaseBatch(size_class, free_list, free_list._num);
+  return block;
+}
+
+/**
+ * @brief Free the memory of the data, the block is kept for reuse.
+ *
+ * @param ptr
+ * @param size The data size, should be the same as allocate.
+ */
+void StaDataPool::deallocate(void* ptr, std::size_t size) {
+  if (!ptr) {
+    return;
+  }
+
+  if (size > c_max_block_size) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto size_class = sizeClass(size);
+  auto& pool = getPool();
+  if (auto* thread_cache = getThreadCache(); thread_cache) {
+    auto& free_list = thread_cache->_free_lists[size_class];
+    free_list.push(static_cast<FreeBlock*>(ptr));
+    if (free_list._num > 2 * c_batch_num) {
+      pool.releaseBatch(size_class, free_list, c_batch_num);
+    }
+    return;
+  }
+
+  FreeList free_list;
+  free_list.push(static_cast<FreeBlock*>(ptr));
+  pool.releaseBatch(size_class, free_list, 1);
+}
+
+/**
+ * @brief Free the slabs of which all the blocks are returned to the pool, the
+ * free list cache of the calling thread is returned first. The blocks cached
+ * by the other live threads keep their slabs, so call it after the data is
+ * freed and the propagation threads exit, such as the sta is destroyed.
+ *
+ * @return std::size_t The freed slab num.
+ */
+std::size_t StaDataPool::releaseSlabs() {
+  if (auto* thread_cache = getThreadCache(); thread_cache) {
+    thread_cache->releaseAll();
+  }
+
+  auto& pool = getPool();
+  std::lock_guard lk(pool._mutex);
+  auto& slabs = pool._slabs;
+  if (slabs.empty()) {
+    return 0;
+  }
+
+  // the slab index sorted by the address, to find the slab of the block.
+  std::vector<std::size_t> slab_order(slabs.size());
+  for (std::size_t i = 0; i < slabs.size(); ++i) {
+    slab_order[i] = i;
+  }
+  std::sort(slab_order.begin(), slab_order.end(),
+            [&slabs](std::size_t left, std::size_t right) {
+              return slabs[left]._memory.get() < slabs[right]._memory.get();
+            });
+  auto find_slab = [&slabs, &slab_order](FreeBlock* block) {
+    auto* address = reinterpret_cast<std::byte*>(block);
+    auto iter = std::upper_bound(
+        slab_order.begin(), slab_order.end(), address,
+        [&slabs](std::byte* block_address, std::size_t slab_index) {
+          return block_address < slabs[slab_index]._memory.get();
+        });
+    return *std::prev(iter);
+  };
+
+  std::vector<std::size_t> slab_free_nums(slabs.size(), 0);
+  for (auto& free_list : pool._free_lists) {
+    for (auto* block = free_list._head; block; block = block->_next) {
+      ++slab_free_nums[find_slab(block)];
+    }
+  }
+
+  std::vector<bool> is_release(slabs.size(), false);
+  std::size_t num_release = 0;
+  for (std::size_t i = 0; i < slabs.size(); ++i) {
+    std::size_t block_size = (slabs[i]._size_class + 1) * c_block_align;
+    if (slab_free_nums[i] == c_slab_size / block_size) {
+      is_release[i] = true;
+      ++num_release;
+    }
+  }
+
+  if (num_release == 0) {
+    return 0;
+  }
+
+  // remove the blocks of the released slab from the free lists.
+  for (auto& free_list : pool._free_lists) {
+    FreeList keep_list;
+    while (free_list._num > 0) {
+      auto* block = free_list.pop();
+      if (!is_release[find_slab(block)]) {
+        keep_list.push(block);
+      }
+    }
+    free_list = keep_list;
+  }
+
+  std::size_t keep_index = 0;
+  for (std::size_t i = 0; i < slabs.size(); ++i) {
+    if (!is_release[i]) {
+      slabs[keep_index++] = std::move(slabs[i]);
+    }
+  }
+  slabs.resize(keep_index);
+
+  return num_release;
+}
+
+/**
+ * @brief Get the slab num of the pool.
+ *
+ * @return std::size_t
+ */
+std::size_t StaDataPool::get_num_slab() {
+  auto& pool = getPool();
+  std::lock_guard lk(pool._mutex);
+  return pool._slabs.size();
+}
+
+}  // namespace ista
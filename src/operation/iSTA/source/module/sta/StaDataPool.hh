@@ -0,0 +1,108 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file StaDataPool.hh
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The memory pool of the sta data.
+ * @version 0.1
+ * @date 2025-04-02
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ista {
+
+/**
+ * @brief The slab memory pool of the sta data.
+ *
+ * The sta data is allocated and freed by every propagation, the pool carve
+ * the slab to the blocks of the same size class, the freed block is kept in
+ * the free list and reused by the next propagation. The slab is kept until
+ * releaseSlabs, which free the slabs of all blocks returned to the pool.
+ * Each thread keep a free list cache, so the propagation threads only lock the
+ * pool when move a batch of blocks.
+ */
+class StaDataPool {
+ public:
+  static constexpr std::size_t c_block_align = 16;
+  static constexpr std::size_t c_max_block_size = 512;
+  static constexpr std::size_t c_num_size_class =
+      c_max_block_size / c_block_align;
+  static constexpr std::size_t c_slab_size = 64 * 1024;
+  static constexpr std::size_t c_batch_num = 64;  //!< The blocks of a move.
+
+  static void* allocate(std::size_t size);
+  static void deallocate(void* ptr, std::size_t size);
+
+  static std::size_t releaseSlabs();
+
+  [[nodiscard]] static std::size_t get_num_slab();
+
+ private:
+  struct FreeBlock {
+    FreeBlock* _next;
+  };
+
+  struct FreeList {
+    FreeBlock* _head = nullptr;
+    std::size_t _num = 0;
+
+    void push(FreeBlock* block) {
+      block->_next = _head;
+      _head = block;
+      ++_num;
+    }
+    FreeBlock* pop() {
+      auto* block = _head;
+      _head = block->_next;
+      --_num;
+      return block;
+    }
+  };
+
+  /*The slab carved to the blocks of one size class.*/
+  struct Slab {
+    std::unique_ptr<std::byte[]> _memory;
+    std::size_t _size_class;
+  };
+
+  class ThreadCache;
+
+  StaDataPool() = default;
+  ~StaDataPool() = default;
+
+  static StaDataPool& getPool();
+  static ThreadCache* getThreadCache();
+  static std::size_t sizeClass(std::size_t size) {
+    return (size + c_block_align - 1) / c_block_align - 1;
+  }
+
+  void fetchBatch(std::size_t size_class, FreeList& free_list);
+  void releaseBatch(std::size_t size_class, FreeList& free_list,
+                    std::size_t num_block);
+
+  std::mutex _mutex;
+  std::array<FreeList, c_num_size_class> _free_lists;
+  std::vector<Slab> _slabs;
+};
+
+}  // namespace ista
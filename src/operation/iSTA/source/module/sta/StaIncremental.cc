@@ -126,6 +126,7 @@ unsigned StaIncremental::applyFwdQueue() {
       break;
     }
 
+    the_vertex->reset_is_fwd_reset();
     _fwd_queue.pop();
   }
 
@@ -140,8 +141,8 @@ unsigned StaIncremental::applyFwdQueue() {
 unsigned StaIncremental::applyBwdQueue() {
   unsigned is_ok = 1;
 
-  while (!_fwd_queue.empty()) {
-    auto* the_vertex = _fwd_queue.top();
+  while (!_bwd_queue.empty()) {
+    auto* the_vertex = _bwd_queue.top();
 
     // need to parallel execute the follow task.
     is_ok &= propagateRT(the_vertex);
@@ -150,12 +151,26 @@ unsigned StaIncremental::applyBwdQueue() {
       break;
     }
 
-    _fwd_queue.pop();
+    the_vertex->reset_is_bwd_reset();
+    _bwd_queue.pop();
   }
 
   return is_ok;
 }
 
+/**
+ * @brief reset the req time of the vertex, the req time is merged by the
+ * min/max in bwd propagation, so the relaxed req need to be reset first.
+ *
+ * @param the_vertex
+ */
+void StaResetPropagation::resetReqTime(StaVertex* the_vertex) {
+  StaData* delay_data;
+  FOREACH_DELAY_DATA(the_vertex, delay_data) {
+    dynamic_cast<StaPathDelayData*>(delay_data)->reset_req_time();
+  }
+}
+
 /**
  * @brief reset the vertex propgagation.
  *
@@ -179,8 +194,20 @@ unsigned StaResetPropagation::operator()(StaVertex* the_vertex) {
     the_vertex->reset_is_fwd();
     the_vertex->set_is_fwd_reset();
 
+    // the fanin of the vertex may be changed(such as buffer insertion), the
+    // data of the vertex is rebuilt instead of updated.
+    if (!the_vertex->is_start()) {
+      the_vertex->resetSlewBucket();
+      the_vertex->resetPathDelayBucket();
+    }
+
     _incr_func->insertFwdQueue(the_vertex);
 
+    // the req time depend on the fwd slew, need bwd propagate again.
+    the_vertex->reset_is_bwd();
+    resetReqTime(the_vertex);
+    _incr_func->insertBwdQueue(the_vertex);
+
     if (the_vertex->is_end()) {
       return 1;
     }
@@ -203,6 +230,7 @@ unsigned StaResetPropagation::operator()(StaVertex* the_vertex) {
 
     the_vertex->reset_is_bwd();
     the_vertex->set_is_bwd_reset();
+    resetReqTime(the_vertex);
 
     _incr_func->insertBwdQueue(the_vertex);
 
@@ -235,7 +263,6 @@ unsigned StaResetPropagation::operator()(StaArc* the_arc) {
   StaVertex* the_vertex;
   if (_is_fwd) {
     the_vertex = the_arc->get_snk();
-
   } else {
     the_vertex = the_arc->get_src();
   }
@@ -99,6 +99,8 @@ class StaResetPropagation : public StaFunc {
   unsigned operator()(StaArc* the_arc) override;
 
  private:
+  void resetReqTime(StaVertex* the_vertex);
+
   bool _is_fwd = true;                     //!< Whether fwd propagation reset.
   std::optional<unsigned> _max_min_level;  //!< The max level of the graph.
   StaIncremental* _incr_func = nullptr;    //!< The incremental function.
@@ -178,6 +178,8 @@ class StaPortSeqPathData : public StaSeqPathData {
                      int constrain_value, Port* output_port);
   ~StaPortSeqPathData() override = default;
 
+  Port* get_output_port() { return _output_port; }
+
  private:
   Port* _output_port;
 };
@@ -0,0 +1,438 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file StaPathEnumerator.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The k worst timing path enumerator implemention.
+ * @version 0.1
+ * @date 2025-03-24
+ */
+
+#include "StaPathEnumerator.hh"
+
+#include <algorithm>
+#include <future>
+#include <set>
+#include <utility>
+
+#include "StaArc.hh"
+#include "StaCppr.hh"
+#include "StaVertex.hh"
+#include "ThreadPool/ThreadPool.h"
+#include "log/Log.hh"
+
+namespace ista {
+
+StaPathEnumerator::StaPathEnumerator(AnalysisMode analysis_mode,
+                                     unsigned n_worst,
+                                     unsigned n_worst_per_endpoint,
+                                     ThreadPool* thread_pool,
+                                     unsigned num_threads)
+    : _analysis_mode(analysis_mode),
+      _n_worst(n_worst),
+      _n_worst_per_endpoint(std::max(n_worst_per_endpoint, 1U)),
+      _thread_pool(thread_pool),
+      _num_threads(thread_pool ? std::max(num_threads, 1U) : 1U) {}
+
+StaPathEnumerator::~StaPathEnumerator() {
+  // The built data is not added to the fwd set of the bwd data, break the bwd
+  // link before release, the release order is not the path order.
+  for (auto& [seq_path_group, group_state] : _group_states) {
+    for (auto& path_delay_data : group_state->path_delay_datas) {
+      path_delay_data->set_bwd(nullptr);
+    }
+  }
+}
+
+/**
+ * @brief Run the tasks on the thread pool and wait them finish.
+ *
+ * @param tasks
+ */
+void StaPathEnumerator::runTasks(std::vector<std::function<void()>>& tasks) {
+  if (!_thread_pool || tasks.size() == 1) {
+    for (auto& task : tasks) {
+      task();
+    }
+    return;
+  }
+
+  std::vector<std::future<void>> results;
+  results.reserve(tasks.size());
+  for (auto& task : tasks) {
+    results.emplace_back(_thread_pool->enqueue(task));
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+}
+
+/**
+ * @brief Enumerate the worst paths of the path groups.
+ *
+ * @param seq_path_groups
+ * @return unsigned
+ */
+unsigned StaPathEnumerator::operator()(
+    const std::vector<StaSeqPathGroup*>& seq_path_groups) {
+  constexpr std::size_t c_min_chunk_size = 256;
+
+  std::vector<GroupState*> group_states;
+  std::vector<std::function<void()>> tasks;
+  for (auto* seq_path_group : seq_path_groups) {
+    auto& group_state = _group_states[seq_path_group];
+    group_state = std::make_unique<GroupState>();
+    group_states.push_back(group_state.get());
+
+    auto& path_ends = group_state->path_ends;
+    StaPathEnd* path_end;
+    FOREACH_PATH_GROUP_END(seq_path_group, path_end) {
+      path_ends.push_back(path_end);
+    }
+
+    std::size_t num_chunks = std::min<std::size_t>(
+        _num_threads, path_ends.size() / c_min_chunk_size);
+    num_chunks = std::max<std::size_t>(num_chunks, 1);
+    std::size_t chunk_size = (path_ends.size() + num_chunks - 1) / num_chunks;
+
+    auto& chunk_heaps = group_state->chunk_heaps;
+    chunk_heaps.resize(num_chunks);
+    for (std::size_t i = 0; i < num_chunks; ++i) {
+      std::size_t begin = i * chunk_size;
+      std::size_t end = std::min(path_ends.size(), begin + chunk_size);
+      tasks.emplace_back([this, &path_ends, &chunk_heaps, begin, end, i]() {
+        collectChunk(path_ends, begin, end, chunk_heaps[i]);
+      });
+    }
+  }
+  runTasks(tasks);
+
+  tasks.clear();
+  for (auto* group_state : group_states) {
+    tasks.emplace_back([this, group_state]() {
+      mergeWorstOrigins(*group_state);
+      enumerate(*group_state);
+    });
+  }
+  runTasks(tasks);
+
+  return 1;
+}
+
+/**
+ * @brief Find the enumerated worst paths of the group, in slack order.
+ *
+ * @param seq_path_group
+ * @return const std::vector<StaSeqPathData*>* nullptr if not enumerated.
+ */
+const std::vector<StaSeqPathData*>* StaPathEnumerator::findWorstPaths(
+    StaSeqPathGroup* seq_path_group) const {
+  if (auto it = _group_states.find(seq_path_group);
+      it != _group_states.end()) {
+    return &(it->second->worst_paths);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Collect the n worst path data of the chunk path ends to the bounded
+ * heap, the heap top is the least critical one.
+ *
+ * @param path_ends
+ * @param begin
+ * @param end
+ * @param heap
+ */
+void StaPathEnumerator::collectChunk(const std::vector<StaPathEnd*>& path_ends,
+                                     std::size_t begin, std::size_t end,
+                                     std::vector<SlackPath>& heap) {
+  StaPathData* path_data;
+  for (std::size_t i = begin; i < end; ++i) {
+    FOREACH_PATH_END_DATA(path_ends[i], _analysis_mode, path_data) {
+      auto* seq_path_data = dynamic_cast<StaSeqPathData*>(path_data);
+      SlackPath slack_path{seq_path_data->getSlack(), i, seq_path_data};
+      if (heap.size() < _n_worst) {
+        heap.push_back(slack_path);
+        std::push_heap(heap.begin(), heap.end(), lessSlackPath);
+      } else if (!heap.empty() && lessSlackPath(slack_path, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), lessSlackPath);
+        heap.back() = slack_path;
+        std::push_heap(heap.begin(), heap.end(), lessSlackPath);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Merge the chunk heaps to the n worst origin paths in slack order.
+ *
+ * @param group_state
+ */
+void StaPathEnumerator::mergeWorstOrigins(GroupState& group_state) {
+  std::vector<SlackPath> merged;
+  for (auto& chunk_heap : group_state.chunk_heaps) {
+    merged.insert(merged.end(), chunk_heap.begin(), chunk_heap.end());
+  }
+  std::size_t num_worst = std::min<std::size_t>(_n_worst, merged.size());
+  std::partial_sort(merged.begin(), merged.begin() + num_worst, merged.end(),
+                    lessSlackPath);
+
+  auto& origin_paths = group_state.origin_paths;
+  origin_paths.reserve(num_worst);
+  for (std::size_t i = 0; i < num_worst; ++i) {
+    origin_paths.push_back(std::get<2>(merged[i]));
+  }
+}
+
+/**
+ * @brief Enumerate the group worst paths in slack order, the candidates are
+ * bounded by the remain path num.
+ *
+ * @param group_state
+ */
+void StaPathEnumerator::enumerate(GroupState& group_state) {
+  auto cmp = [](const PathRecord* left, const PathRecord* right) {
+    return std::tie(left->slack, left->id) < std::tie(right->slack, right->id);
+  };
+  std::set<PathRecord*, decltype(cmp)> candidates(cmp);
+
+  auto& origin_paths = group_state.origin_paths;
+  auto& records = group_state.records;
+  for (unsigned i = 0; i < origin_paths.size(); ++i) {
+    auto& record = records.emplace_back(std::make_unique<PathRecord>());
+    record->id = records.size() - 1;
+    record->slack = origin_paths[i]->getSlack();
+    record->origin_index = i;
+    record->path_data = origin_paths[i];
+    record->is_exact = true;
+    candidates.insert(record.get());
+  }
+
+  group_state.num_endpoint_paths.assign(origin_paths.size(), 0);
+  auto& worst_paths = group_state.worst_paths;
+  std::vector<PathRecord*> deviations;
+  while (!candidates.empty() && worst_paths.size() < _n_worst) {
+    auto* record = *candidates.begin();
+    candidates.erase(candidates.begin());
+
+    auto& num_endpoint_path =
+        group_state.num_endpoint_paths[record->origin_index];
+    if (num_endpoint_path >= _n_worst_per_endpoint) {
+      continue;
+    }
+
+    // The deviation slack is estimated by the arrive time, the cppr of the
+    // new launch clock is known after the path is built.
+    if (!record->is_exact) {
+      record->path_data = buildPath(group_state, record);
+      record->is_exact = true;
+      int exact_slack = record->path_data->getSlack();
+      if (exact_slack > record->slack) {
+        record->slack = exact_slack;
+        candidates.insert(record);
+        continue;
+      }
+      record->slack = exact_slack;
+    }
+
+    worst_paths.push_back(record->path_data);
+    ++num_endpoint_path;
+
+    if (num_endpoint_path < _n_worst_per_endpoint) {
+      deviations.clear();
+      expandDeviation(group_state, record, deviations);
+      candidates.insert(deviations.begin(), deviations.end());
+    }
+
+    std::size_t num_remain = _n_worst - worst_paths.size();
+    while (candidates.size() > num_remain) {
+      candidates.erase(std::prev(candidates.end()));
+    }
+  }
+}
+
+/**
+ * @brief Generate the deviation of the path, the deviation is only before the
+ * last deviation point, that is the origin data chain from the fanin data, so
+ * each path is generated once.
+ *
+ * @param group_state
+ * @param record
+ * @param deviations
+ */
+void StaPathEnumerator::expandDeviation(GroupState& group_state,
+                                        const PathRecord* record,
+                                        std::vector<PathRecord*>& deviations) {
+  int64_t launch_clock_arrive_time =
+      record->path_data->get_launch_clock_data()->get_arrive_time();
+  auto* path_delay_data = record->parent ? record->fanin_data
+                                         : record->path_data->get_delay_data();
+
+  while (path_delay_data) {
+    auto* bwd_data =
+        dynamic_cast<StaPathDelayData*>(path_delay_data->get_bwd());
+    if (!bwd_data) {
+      break;
+    }
+
+    auto* own_vertex = path_delay_data->get_own_vertex();
+    auto trans_type = path_delay_data->get_trans_type();
+    auto* launch_clock_data = path_delay_data->get_launch_clock_data();
+    auto derate = path_delay_data->get_derate();
+
+    FOREACH_SNK_ARC(own_vertex, snk_arc) {
+      if (!snk_arc->isDelayArc() || snk_arc->is_loop_disable()) {
+        continue;
+      }
+
+      auto* src_vertex = snk_arc->get_src();
+      bool is_both_trans = !snk_arc->isUnateArc() && !src_vertex->is_clock();
+
+      StaData* data;
+      FOREACH_DELAY_DATA(src_vertex, data) {
+        if (data == bwd_data || data->get_delay_type() != _analysis_mode) {
+          continue;
+        }
+
+        auto fanin_trans_type = snk_arc->isNegativeArc()
+                                    ? FLIP_TRANS(data->get_trans_type())
+                                    : data->get_trans_type();
+        if (!is_both_trans && fanin_trans_type != trans_type) {
+          continue;
+        }
+
+        // The launch clock could be another start point of the same clock
+        // edge, the clock relation is the same.
+        auto* fanin_data = dynamic_cast<StaPathDelayData*>(data);
+        auto* fanin_launch_clock_data = fanin_data->get_launch_clock_data();
+        if ((fanin_launch_clock_data->get_prop_clock() !=
+             launch_clock_data->get_prop_clock()) ||
+            (fanin_launch_clock_data->get_clock_wave_type() !=
+             launch_clock_data->get_clock_wave_type())) {
+          continue;
+        }
+
+        int arc_delay = snk_arc->get_arc_delay(_analysis_mode, trans_type);
+        if (derate) {
+          arc_delay *= derate.value();
+        }
+
+        int64_t shift = fanin_data->get_arrive_time() + arc_delay -
+                        path_delay_data->get_arrive_time();
+        int64_t clock_shift = fanin_launch_clock_data->get_arrive_time() -
+                              launch_clock_arrive_time;
+
+        auto& deviation = group_state.records.emplace_back(
+            std::make_unique<PathRecord>());
+        deviation->id = group_state.records.size() - 1;
+        deviation->slack =
+            record->slack + static_cast<int>(
+                                (_analysis_mode == AnalysisMode::kMax)
+                                    ? -(shift + clock_shift)
+                                    : (shift + clock_shift));
+        deviation->origin_index = record->origin_index;
+        deviation->parent = record;
+        deviation->dev_data = path_delay_data;
+        deviation->fanin_data = fanin_data;
+        deviation->shift = shift;
+        deviations.push_back(deviation.get());
+      }
+    }
+
+    path_delay_data = bwd_data;
+  }
+}
+
+/**
+ * @brief Build the path data of the deviation, the data from the deviation
+ * point to the end is copied from the parent path with the arrive time
+ * shifted, the data before is the fanin data chain.
+ *
+ * @param group_state
+ * @param record
+ * @return StaSeqPathData*
+ */
+StaSeqPathData* StaPathEnumerator::buildPath(GroupState& group_state,
+                                             PathRecord* record) {
+  auto* parent_path = record->parent->path_data;
+
+  std::vector<StaPathDelayData*> parent_datas;
+  auto* path_delay_data = parent_path->get_delay_data();
+  while (path_delay_data != record->dev_data) {
+    parent_datas.push_back(path_delay_data);
+    path_delay_data =
+        dynamic_cast<StaPathDelayData*>(path_delay_data->get_bwd());
+    LOG_FATAL_IF(!path_delay_data) << "deviation point is not on the path.";
+  }
+  parent_datas.push_back(record->dev_data);
+
+  auto* launch_clock_data = record->fanin_data->get_launch_clock_data();
+  StaPathDelayData* bwd_data = record->fanin_data;
+  for (auto it = parent_datas.rbegin(); it != parent_datas.rend(); ++it) {
+    auto* parent_data = *it;
+    auto& new_data = group_state.path_delay_datas.emplace_back(
+        std::make_unique<StaPathDelayData>(
+            parent_data->get_delay_type(), parent_data->get_trans_type(),
+            parent_data->get_arrive_time() + record->shift, launch_clock_data,
+            parent_data->get_own_vertex()));
+    new_data->set_derate(parent_data->get_derate());
+    new_data->set_bwd(bwd_data);
+    bwd_data = new_data.get();
+  }
+
+  auto* capture_clock_data = parent_path->get_capture_clock_data();
+  std::optional<int> cppr = parent_path->get_cppr();
+  if (launch_clock_data != parent_path->get_launch_clock_data()) {
+    cppr.reset();
+    auto* capture_clock = capture_clock_data->get_prop_clock();
+    if (launch_clock_data->get_prop_clock() == capture_clock) {
+      StaCppr find_cppr(launch_clock_data, capture_clock_data);
+      if (capture_clock->exec(find_cppr)) {
+        cppr = find_cppr.get_cppr();
+      }
+    }
+  }
+
+  StaClockPair clock_pair = parent_path->get_clock_pair();
+  std::unique_ptr<StaSeqPathData> seq_path_data;
+  if (parent_path->isStaClockGatePathData()) {
+    seq_path_data = std::make_unique<StaClockGatePathData>(
+        bwd_data, launch_clock_data, capture_clock_data, std::move(clock_pair),
+        cppr, parent_path->get_constrain_value());
+  } else if (auto* port_path_data =
+                 dynamic_cast<StaPortSeqPathData*>(parent_path);
+             port_path_data) {
+    seq_path_data = std::make_unique<StaPortSeqPathData>(
+        bwd_data, launch_clock_data, capture_clock_data, std::move(clock_pair),
+        cppr, parent_path->get_constrain_value(),
+        port_path_data->get_output_port());
+  } else {
+    seq_path_data = std::make_unique<StaSeqPathData>(
+        bwd_data, launch_clock_data, capture_clock_data, std::move(clock_pair),
+        cppr, parent_path->get_constrain_value());
+  }
+
+  seq_path_data->set_check_arc(parent_path->get_check_arc());
+  if (auto uncertainty = parent_path->get_uncertainty(); uncertainty) {
+    seq_path_data->set_uncertainty(uncertainty.value());
+  }
+
+  return group_state.seq_path_datas.emplace_back(std::move(seq_path_data))
+      .get();
+}
+
+}  // namespace ista
@@ -0,0 +1,128 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+/**
+ * @file StaPathEnumerator.hh
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The k worst timing path enumerator of the path groups.
+ * @version 0.1
+ * @date 2025-03-24
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "StaPathData.hh"
+
+class ThreadPool;
+
+namespace ista {
+
+/**
+ * @brief The k worst timing path enumerator.
+ *
+ * The path data stored at the path end is the worst path of the endpoint
+ * data. The enumerator collects the n worst of them per path group by bounded
+ * heaps, the path ends of all the groups are split to chunks, the chunks and
+ * then the groups are run on the same thread pool. When more than one path
+ * per endpoint data is required, the next worse paths are found lazily by
+ * deviation: a path deviates at one vertex of its path to another fanin
+ * data, the slack increase is the arrive time difference, so the candidate is
+ * only the deviation record, the path object is built only when the path is
+ * emitted.
+ */
+class StaPathEnumerator {
+ public:
+  StaPathEnumerator(AnalysisMode analysis_mode, unsigned n_worst,
+                    unsigned n_worst_per_endpoint, ThreadPool* thread_pool,
+                    unsigned num_threads);
+  ~StaPathEnumerator();
+
+  StaPathEnumerator(const StaPathEnumerator&) = delete;
+  StaPathEnumerator& operator=(const StaPathEnumerator&) = delete;
+
+  unsigned operator()(const std::vector<StaSeqPathGroup*>& seq_path_groups);
+
+  const std::vector<StaSeqPathData*>* findWorstPaths(
+      StaSeqPathGroup* seq_path_group) const;
+
+ private:
+  /*The enumerated path, the origin path is the path data of the path end,
+   * the other path is the deviation from the parent path.*/
+  struct PathRecord {
+    std::size_t id = 0;            //!< The record index, for stable order.
+    int slack = 0;                 //!< The path slack, unit is fs.
+    unsigned origin_index = 0;     //!< The origin path index in the group.
+    const PathRecord* parent = nullptr;  //!< The parent path, nullptr for
+                                         //!< origin.
+    StaPathDelayData* dev_data = nullptr;  //!< The parent path data which
+                                           //!< fanin is replaced.
+    StaPathDelayData* fanin_data = nullptr;  //!< The new fanin data.
+    int64_t shift = 0;  //!< The arrive time shift from the dev data.
+    StaSeqPathData* path_data = nullptr;  //!< The built path data.
+    bool is_exact = false;                //!< Whether the slack is exact.
+  };
+
+  // The slack, the path end index and the path data.
+  using SlackPath = std::tuple<int, std::size_t, StaSeqPathData*>;
+
+  /*The per group enumeration state.*/
+  struct GroupState {
+    std::vector<StaPathEnd*> path_ends;
+    std::vector<std::vector<SlackPath>> chunk_heaps;  //!< The chunk heaps of
+                                                      //!< the path ends.
+    std::vector<StaSeqPathData*> origin_paths;
+    std::vector<unsigned> num_endpoint_paths;
+    std::vector<std::unique_ptr<PathRecord>> records;
+    std::vector<std::unique_ptr<StaPathDelayData>> path_delay_datas;
+    std::vector<std::unique_ptr<StaSeqPathData>> seq_path_datas;
+    std::vector<StaSeqPathData*> worst_paths;
+  };
+
+  // The less critical slack path is the greater, the tie is the path end
+  // index.
+  static bool lessSlackPath(const SlackPath& left, const SlackPath& right) {
+    return std::tie(std::get<0>(left), std::get<1>(left)) <
+           std::tie(std::get<0>(right), std::get<1>(right));
+  }
+
+  void runTasks(std::vector<std::function<void()>>& tasks);
+  void collectChunk(const std::vector<StaPathEnd*>& path_ends,
+                    std::size_t begin, std::size_t end,
+                    std::vector<SlackPath>& heap);
+  void mergeWorstOrigins(GroupState& group_state);
+  void enumerate(GroupState& group_state);
+  void expandDeviation(GroupState& group_state, const PathRecord* record,
+                       std::vector<PathRecord*>& candidates);
+  StaSeqPathData* buildPath(GroupState& group_state, PathRecord* record);
+
+  AnalysisMode _analysis_mode;    //!< The max/min analysis mode.
+  unsigned _n_worst;              //!< The top n path num of group.
+  unsigned _n_worst_per_endpoint;  //!< The top n path num of endpoint data.
+  ThreadPool* _thread_pool;        //!< The thread pool, nullptr run in the
+                                   //!< caller thread.
+  unsigned _num_threads;           //!< The thread num of the pool.
+
+  std::map<StaSeqPathGroup*, std::unique_ptr<GroupState>> _group_states;
+};
+
+}  // namespace ista
@@ -34,6 +34,7 @@
 #include "Sta.hh"
 #include "StaDump.hh"
 #include "StaFunc.hh"
+#include "StaPathEnumerator.hh"
 #include "StaVertex.hh"
 #include "include/Version.hh"
 #include "sta/StaPathData.hh"
@@ -151,32 +152,29 @@ unsigned StaReportPathSummary::operator()(StaSeqPathData* seq_path_data) {
 unsigned StaReportPathSummary::operator()(StaSeqPathGroup* seq_path_group) {
   unsigned is_ok = 1;
 
-  auto cmp = [](StaPathData* left, StaPathData* right) -> bool {
-    int left_slack = left->getSlack();
-    int right_slack = right->getSlack();
-    return left_slack > right_slack;
-  };
-
-  std::priority_queue<StaPathData*, std::vector<StaPathData*>, decltype(cmp)>
-      seq_data_queue(cmp);
+  const std::vector<StaSeqPathData*>* worst_paths = nullptr;
+  if (_path_enumerator) {
+    worst_paths = _path_enumerator->findWorstPaths(seq_path_group);
+  }
 
-  StaPathEnd* path_end;
-  StaPathData* path_data;
-  AnalysisMode analysis_mode = _analysis_mode;
-  FOREACH_PATH_GROUP_END(seq_path_group, path_end)
-  FOREACH_PATH_END_DATA(path_end, analysis_mode, path_data) {
-    seq_data_queue.push(path_data);
+  std::optional<StaPathEnumerator> path_enumerator;
+  if (!worst_paths) {
+    path_enumerator.emplace(_analysis_mode, get_n_worst(), 1, nullptr, 1);
+    (*path_enumerator)({seq_path_group});
+    worst_paths = path_enumerator->findWorstPaths(seq_path_group);
   }
 
   unsigned i = 0;
-  while (!seq_data_queue.empty() && i < get_n_worst()) {
-    auto* seq_path_data = dynamic_cast<StaSeqPathData*>(seq_data_queue.top());
+  for (auto* seq_path_data : *worst_paths) {
+    if (i >= get_n_worst()) {
+      break;
+    }
+
     is_ok = (*this)(seq_path_data);
     if (!is_ok) {
       break;
     }
 
-    seq_data_queue.pop();
     ++i;
   }
   if (seq_path_group->isStaClockGatePathGroup()) {
@@ -31,6 +31,8 @@
 
 namespace ista {
 
+class StaPathEnumerator;
+
 class Sta;
 
 /**
@@ -70,6 +72,9 @@ class StaReportPathSummary {
   void set_significant_digits(unsigned significant_digits) {
     _significant_digits = significant_digits;
   }
+  void set_path_enumerator(StaPathEnumerator* path_enumerator) {
+    _path_enumerator = path_enumerator;
+  }
 
   static std::unique_ptr<StaReportTable> createReportTable(
       const char* tbl_name);
@@ -82,6 +87,8 @@ class StaReportPathSummary {
   AnalysisMode _analysis_mode;       //!< The max/min analysis mode.
   unsigned _n_worst;                 //!< The top n path num.
   unsigned _significant_digits = 3;  //!< The significant digits.
+  StaPathEnumerator* _path_enumerator =
+      nullptr;  //!< The enumerated worst paths shared by the reports.
 };
 
 /**
@@ -0,0 +1,92 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <cmath>
+#include <vector>
+
+#include "delay/CrossTalkWaveform.hh"
+#include "gtest/gtest.h"
+#include "log/Log.hh"
+
+using ieda::Log;
+using ista::CrossTalkWaveforms;
+
+namespace {
+
+class CrossTalkWaveformTest : public testing::Test {
+  void SetUp() {
+    char config[] = "test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() { Log::end(); }
+};
+
+// The noise voltage at the time, point by point linear interpolation.
+double pointVoltage(const Eigen::VectorXd& waveform, double step_time,
+                    double start_time, double time) {
+  auto num_point = waveform.size();
+  for (Eigen::Index i = 1; i < num_point; ++i) {
+    double time1 = start_time + i * step_time;
+    if (time1 >= time && time >= start_time) {
+      double time2 = time1 - step_time;
+      return waveform(i - 1) + (waveform(i) - waveform(i - 1)) *
+                                   (time - time2) / step_time;
+    }
+  }
+  return 0.0;
+}
+
+TEST_F(CrossTalkWaveformTest, superimpose) {
+  const double step_time = 0.01;
+  const Eigen::Index num_point = 37;
+
+  CrossTalkWaveforms crosstalk_waveforms;
+  crosstalk_waveforms.reset(step_time, num_point);
+  EXPECT_EQ(crosstalk_waveforms.get_stride() % CrossTalkWaveforms::c_stride_align,
+            0);
+
+  const double victim_start_time = 1.0;
+  std::vector<double> start_times{0.8, 0.9537, 1.0, 1.123, 1.35, 1.37, 2.0};
+  std::vector<Eigen::VectorXd> aggressor_waveforms;
+  for (std::size_t i = 0; i < start_times.size(); ++i) {
+    Eigen::VectorXd waveform(num_point);
+    for (Eigen::Index j = 0; j < num_point; ++j) {
+      waveform(j) = std::sin(0.1 * j + i) + 0.01 * j;
+    }
+    crosstalk_waveforms.allocAggressor(start_times[i]) = waveform;
+    aggressor_waveforms.emplace_back(std::move(waveform));
+  }
+  EXPECT_EQ(crosstalk_waveforms.size(), start_times.size());
+  EXPECT_FALSE(crosstalk_waveforms.isOverlap(victim_start_time, 2.0));
+
+  Eigen::VectorXd victim_waveform = Eigen::VectorXd::LinSpaced(num_point, 0, 1);
+  Eigen::VectorXd expect_waveform = victim_waveform;
+  for (std::size_t i = 0; i < start_times.size(); ++i) {
+    for (Eigen::Index j = 0; j < num_point; ++j) {
+      expect_waveform(j) +=
+          pointVoltage(aggressor_waveforms[i], step_time, start_times[i],
+                       victim_start_time + j * step_time);
+    }
+  }
+
+  crosstalk_waveforms.superimpose(victim_start_time, victim_waveform);
+  for (Eigen::Index j = 0; j < num_point; ++j) {
+    EXPECT_NEAR(victim_waveform(j), expect_waveform(j), 1e-9);
+  }
+}
+
+}  // namespace
@@ -142,10 +142,12 @@ TEST_F(DelayTest, updateTiming) {
 
     rc_net->updateRcTiming(*spef_net);
     std::string load_name = "";
+    DesignObject* load_obj = nullptr;
     DesignObject* obj;
     FOREACH_NET_PIN(net, obj) {
       if (obj->getFullName() != driver->getFullName()) {
         load_name = obj->getFullName();
+        load_obj = obj;
       }
     }
     std::cout << "Net name:" << net->get_name() << std::endl;
@@ -154,9 +156,7 @@ TEST_F(DelayTest, updateTiming) {
     std::cout << "Load:"
               << " " << load_name << std::endl;
     double load_delay = 0.0f;
-    ista::RcTree* rct = rc_net->rct();
-    auto node = rct->node(load_name);
-    load_delay = node->delay();
+    load_delay = rc_net->delay(*load_obj).value_or(0.0);
     std::cout << driver->getFullName() << " ----> " << load_name << " delay is "
               << load_delay << std::endl;
     std::cout << "--------------------------------" << std::endl;
@@ -200,10 +200,12 @@ TEST_F(DelayTest, updateTiming1) {
       RcNet* rc_net = new RcNet(net);
       DesignObject* driver = net->getDriver();
       std::string load_name = "";
+      DesignObject* load_obj = nullptr;
       DesignObject* obj;
       FOREACH_NET_PIN(net, obj) {
         if (obj->getFullName() != driver->getFullName()) {
           load_name = obj->getFullName();
+          load_obj = obj;
         }
       }
       std::cout << "--------------------------------" << std::endl;
@@ -220,9 +222,7 @@ TEST_F(DelayTest, updateTiming1) {
       rc_net->updateRcTiming(*spef_net);
 
       double load_delay = 0.0f;
-      ista::RcTree* rct = rc_net->rct();
-      auto node = rct->node(load_name);
-      load_delay = node->delay();
+      load_delay = rc_net->delay(*load_obj).value_or(0.0);
       std::cout << driver->getFullName() << " ----> " << load_name
                 << " delay is " << load_delay << std::endl;
       std::cout << "--------------------------------" << std::endl;
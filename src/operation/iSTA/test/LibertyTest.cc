@@ -17,6 +17,8 @@
 
 // #include <gperftools/heap-profiler.h>
 
+#include <map>
+
 #include "gtest/gtest.h"
 #include "liberty/Liberty.hh"
 #include "log/Log.hh"
@@ -117,4 +119,36 @@ TEST_F(LibertyTest, wire_load) {
   }
 }
 
-}  // namespace
\ No newline at end of file
+TEST_F(LibertyTest, when_expr) {
+  LibertyCell lib_cell("AO21", nullptr);
+  for (const char* port_name : {"A", "B", "C"}) {
+    lib_cell.addLibertyPort(std::make_unique<LibertyPort>(port_name));
+  }
+
+  std::map<std::string, double> port_sp = {{"A", 0.3}, {"B", 0.6}, {"C", 0.8}};
+  auto calc_sp = [&port_sp](LibertyPort* port) {
+    return port_sp[port->get_port_name()];
+  };
+
+  auto compile_when = [&lib_cell](const char* when) {
+    LibertyExprBuilder expr_builder(nullptr, when);
+    expr_builder.execute();
+    std::unique_ptr<LibertyExpr> expr(expr_builder.get_result_expr());
+    return LibertyWhenExpr::compile(expr.get(), &lib_cell);
+  };
+
+  auto when_expr = compile_when("A&!B");
+  ASSERT_TRUE(when_expr);
+  EXPECT_DOUBLE_EQ(when_expr->calcSP(calc_sp), 0.3 * (1 - 0.6));
+
+  when_expr = compile_when("(A^B)|!C");
+  ASSERT_TRUE(when_expr);
+  double a_xor_b = 0.3 * (1 - 0.6) + (1 - 0.3) * 0.6;
+  EXPECT_DOUBLE_EQ(when_expr->calcSP(calc_sp),
+                   1 - (1 - a_xor_b) * (1 - (1 - 0.8)));
+
+  // the port not in the cell is left to the runtime lookup.
+  EXPECT_FALSE(compile_when("A&D"));
+}
+
+}  // namespace
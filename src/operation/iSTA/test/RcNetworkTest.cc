@@ -0,0 +1,302 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <Eigen/Dense>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "delay/ElmoreDelayCalc.hh"
+#include "delay/RcNetwork.hh"
+#include "gtest/gtest.h"
+#include "log/Log.hh"
+#include "netlist/Net.hh"
+#include "netlist/Port.hh"
+#include "spef/parser-spef.hpp"
+
+using ieda::Log;
+using ista::AnalysisMode;
+using ista::CapacitiveUnit;
+using ista::g_split_trans;
+using ista::Net;
+using ista::Port;
+using ista::PortDir;
+using ista::RcNet;
+using ista::RCNetCommonInfo;
+using ista::RcNetwork;
+using ista::RcTree;
+using ista::TransType;
+
+namespace {
+
+class RcNetworkTest : public testing::Test {
+  void SetUp() {
+    char config[] = "test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() { Log::end(); }
+};
+
+// a -10- b -20- c, b -5- d, the cap of b c d is 1 2 3.
+const std::vector<std::tuple<const char*, const char*, double>> c_ress = {
+    {"a", "b", 10.0}, {"b", "c", 20.0}, {"b", "d", 5.0}};
+const std::vector<std::pair<const char*, double>> c_caps = {
+    {"a", 0.0}, {"b", 1.0}, {"c", 2.0}, {"d", 3.0}};
+
+void makeNetwork(RcNetwork& network) {
+  for (const auto& [name, cap] : c_caps) {
+    network.addNode(name, cap);
+  }
+  for (const auto& [node1, node2, res] : c_ress) {
+    network.addResistor(network.findNode(node1), network.findNode(node2), res);
+  }
+  network.set_root(network.findNode("a"));
+}
+
+/**
+ * @brief the 50% delay of the output node, the input current pulse charge the
+ * floating network on the root, simulated by backward euler.
+ */
+double pulseDelay(const Eigen::MatrixXd& conductance,
+                  const Eigen::MatrixXd& cap, const Eigen::VectorXd& input,
+                  const Eigen::RowVectorXd& output, double final_voltage) {
+  constexpr double step_time = 0.05;
+  constexpr double pulse_time = 1.0;
+  Eigen::MatrixXd lhs = cap / step_time + conductance;
+  auto solver = lhs.partialPivLu();
+
+  Eigen::VectorXd voltage = Eigen::VectorXd::Zero(input.size());
+  for (int i = 1; i < 100000; ++i) {
+    double time = i * step_time;
+    double current = (time <= pulse_time) ? 1.0 : 0.0;
+    Eigen::VectorXd last_voltage = voltage;
+    voltage = solver.solve(cap / step_time * voltage + input * current);
+
+    double last_out = output.dot(last_voltage);
+    double out = output.dot(voltage);
+    if (out >= 0.5 * final_voltage) {
+      return time - step_time * (out - 0.5 * final_voltage) / (out - last_out);
+    }
+  }
+  return -1.0;
+}
+
+TEST_F(RcNetworkTest, elmore) {
+  RcNetwork network;
+  makeNetwork(network);
+  network.updateTiming();
+
+  int b = network.findNode("b");
+  int c = network.findNode("c");
+  int d = network.findNode("d");
+  auto mode = AnalysisMode::kMax;
+  auto trans = TransType::kRise;
+
+  EXPECT_DOUBLE_EQ(network.load(network.get_root()), 6.0);
+  EXPECT_DOUBLE_EQ(network.delay(b), 60.0);
+  EXPECT_DOUBLE_EQ(network.delay(c, mode, trans), 100.0);
+  EXPECT_DOUBLE_EQ(network.delay(d, mode, trans), 75.0);
+  EXPECT_DOUBLE_EQ(network.ures(c, mode, trans), 30.0);
+
+  // ldelay of c is 200, beta of c is 10 * 485 + 20 * 200.
+  EXPECT_DOUBLE_EQ(network.slew(c, mode, trans, 0.0),
+                   std::sqrt(2.0 * 8850.0 - 100.0 * 100.0));
+}
+
+TEST_F(RcNetworkTest, treeMatchNetwork) {
+  RcTree rct;
+  for (const auto& [name, cap] : c_caps) {
+    rct.insertNode(name, cap);
+  }
+  for (const auto& [node1, node2, res] : c_ress) {
+    rct.insertSegment(node1, node2, res);
+  }
+  rct.set_root(rct.node("a"));
+  rct.updateRcTiming();
+
+  RcNetwork network;
+  makeNetwork(network);
+  network.updateTiming();
+
+  FOREACH_MODE_TRANS(mode, trans) {
+    for (const char* name : {"a", "b", "c", "d"}) {
+      int id = network.findNode(name);
+      EXPECT_DOUBLE_EQ(rct.delay(name, mode, trans),
+                       network.delay(id, mode, trans));
+      EXPECT_DOUBLE_EQ(rct.slew(name, mode, trans, 10.0),
+                       network.slew(id, mode, trans, 10.0));
+    }
+  }
+}
+
+TEST_F(RcNetworkTest, spefMatchNetwork) {
+  spef::Net spef_net("net", 6.0);
+  for (const auto& [name, cap] : c_caps) {
+    spef_net.caps.emplace_back(name, "", cap);
+  }
+  for (const auto& [node1, node2, res] : c_ress) {
+    spef_net.ress.emplace_back(node1, node2, res);
+  }
+  // the node only in the resistor section is added with a tiny cap.
+  spef_net.ress.emplace_back("d", "e", 1.0);
+
+  RcNetwork spef_network;
+  spef_network.buildFromSpef(spef_net, CapacitiveUnit::kPF);
+  spef_network.set_root(spef_network.findNode("a"));
+  spef_network.updateTiming();
+
+  RcNetwork network;
+  makeNetwork(network);
+  network.addResistor(network.findNode("d"), network.addNode("e", 0.0001),
+                      1.0);
+  network.updateTiming();
+
+  ASSERT_EQ(spef_network.numNodes(), network.numNodes());
+  FOREACH_MODE_TRANS(mode, trans) {
+    for (const char* name : {"a", "b", "c", "d", "e"}) {
+      int spef_id = spef_network.findNode(name);
+      int id = network.findNode(name);
+      EXPECT_DOUBLE_EQ(spef_network.delay(spef_id, mode, trans),
+                       network.delay(id, mode, trans));
+      EXPECT_DOUBLE_EQ(spef_network.slew(spef_id, mode, trans, 10.0),
+                       network.slew(id, mode, trans, 10.0));
+    }
+  }
+}
+
+TEST_F(RcNetworkTest, rcNetFromSpef) {
+  auto rc_net_common_info = std::make_unique<RCNetCommonInfo>();
+  rc_net_common_info->set_spef_cap_unit("1 PF");
+  RcNet::set_rc_net_common_info(std::move(rc_net_common_info));
+
+  Net net("net");
+  Port a("a", PortDir::kIn);
+  Port c("c", PortDir::kOut);
+  Port d("d", PortDir::kOut);
+  for (auto* port : {&a, &c, &d}) {
+    net.addPinPort(port);
+  }
+
+  spef::Net spef_net("net", 6.0);
+  for (const auto& [name, cap] : c_caps) {
+    spef_net.caps.emplace_back(name, "", cap);
+  }
+  for (const auto& [node1, node2, res] : c_ress) {
+    spef_net.ress.emplace_back(node1, node2, res);
+  }
+
+  // the net without coupled cap has no rc tree.
+  RcNet rc_net(&net);
+  rc_net.updateRcTiming(spef_net);
+  ASSERT_NE(rc_net.network(), nullptr);
+  EXPECT_EQ(rc_net.rct(), nullptr);
+  EXPECT_DOUBLE_EQ(rc_net.load(), 6.0);
+  EXPECT_DOUBLE_EQ(rc_net.delay(c).value_or(0.0), 100.0);
+  EXPECT_DOUBLE_EQ(rc_net.delay(d).value_or(0.0), 75.0);
+  EXPECT_DOUBLE_EQ(
+      rc_net.getResistance(AnalysisMode::kMax, TransType::kRise, &c), 30.0);
+
+  // the coupled net keeps the rc tree for crosstalk.
+  spef_net.caps.emplace_back("c", "other:1", 0.5);
+  RcNet coupled_rc_net(&net);
+  coupled_rc_net.updateRcTiming(spef_net);
+  ASSERT_NE(coupled_rc_net.rct(), nullptr);
+  EXPECT_TRUE(coupled_rc_net.rct()->isHaveCoupledNodes());
+  EXPECT_DOUBLE_EQ(coupled_rc_net.delay(c).value_or(0.0), 100.0);
+}
+
+TEST_F(RcNetworkTest, arnoldiBasis) {
+  RcNetwork network;
+  makeNetwork(network);
+  network.updateTiming();
+
+  auto basis = network.arnoldiBasis(AnalysisMode::kMax, TransType::kRise, 2);
+  ASSERT_TRUE(basis);
+  EXPECT_EQ(basis->cols(), 3);
+
+  Eigen::MatrixXd identity = basis->transpose() * (*basis);
+  EXPECT_TRUE(identity.isIdentity(1e-9));
+
+  Eigen::MatrixXd reduce_g = network.reduceConductance(*basis);
+  Eigen::MatrixXd full_g =
+      basis->transpose() * network.conductanceMatrix() * (*basis);
+  EXPECT_TRUE(reduce_g.isApprox(full_g, 1e-9));
+
+  // the input current on the root is not lost by the reduction.
+  Eigen::VectorXd input = Eigen::VectorXd::Zero(basis->rows());
+  input(network.get_root()) = 1.0;
+  EXPECT_GT((basis->transpose() * input).norm(), 0.1);
+}
+
+TEST_F(RcNetworkTest, reduceDelay) {
+  // the 30 nodes chain with a branch of 10 nodes at the middle.
+  RcNetwork network;
+  int root = network.addNode(0.1);
+  int last = root;
+  int middle = -1;
+  for (int i = 1; i < 30; ++i) {
+    int id = network.addNode(0.5 + 0.1 * (i % 3));
+    network.addResistor(last, id, 1.0 + 0.2 * (i % 5));
+    last = id;
+    if (i == 15) {
+      middle = id;
+    }
+  }
+  int branch_last = middle;
+  for (int i = 0; i < 10; ++i) {
+    int id = network.addNode(0.8);
+    network.addResistor(branch_last, id, 2.0);
+    branch_last = id;
+  }
+  network.set_root(root);
+  network.updateTiming();
+
+  auto mode = AnalysisMode::kMax;
+  auto trans = TransType::kRise;
+  auto num_nodes = static_cast<Eigen::Index>(network.numNodes());
+  Eigen::MatrixXd conductance = network.conductanceMatrix();
+  Eigen::VectorXd node_cap(num_nodes);
+  for (Eigen::Index i = 0; i < num_nodes; ++i) {
+    node_cap(i) = network.groundCap(i, mode, trans);
+  }
+  Eigen::MatrixXd cap = node_cap.asDiagonal();
+  Eigen::VectorXd input = Eigen::VectorXd::Zero(num_nodes);
+  input(root) = 1.0;
+  double final_voltage = 1.0 / node_cap.sum();
+
+  auto basis = network.arnoldiBasis(mode, trans, 8);
+  ASSERT_TRUE(basis);
+  Eigen::MatrixXd reduce_g = network.reduceConductance(*basis);
+  Eigen::MatrixXd reduce_c = network.reduceCap(*basis, mode, trans);
+  Eigen::VectorXd reduce_input = basis->transpose() * input;
+
+  for (int id : {middle, last, branch_last}) {
+    Eigen::RowVectorXd output = Eigen::RowVectorXd::Zero(num_nodes);
+    output(id) = 1.0;
+    double delay = pulseDelay(conductance, cap, input, output, final_voltage);
+    double reduce_delay =
+        pulseDelay(reduce_g, reduce_c, reduce_input, output * (*basis),
+                   final_voltage);
+    ASSERT_GT(delay, 0.0);
+    EXPECT_NEAR(reduce_delay, delay, 0.005 * delay);
+  }
+}
+
+}  // namespace
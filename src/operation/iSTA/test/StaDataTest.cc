@@ -0,0 +1,128 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "liberty/Liberty.hh"
+#include "log/Log.hh"
+#include "sta/StaData.hh"
+#include "sta/StaDataPool.hh"
+
+using ieda::Log;
+using ista::AnalysisMode;
+using ista::StaData;
+using ista::StaDataBucket;
+using ista::StaDataBucketIterator;
+using ista::StaDataPool;
+using ista::StaSlewData;
+using ista::TransType;
+
+namespace {
+
+class StaDataTest : public testing::Test {
+  void SetUp() {
+    char config[] = "test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() { Log::end(); }
+};
+
+std::vector<int> bucketSlews(StaDataBucket& bucket) {
+  std::vector<int> slews;
+  StaData* data;
+  for (StaDataBucketIterator iter(bucket);
+       iter.hasNext() ? data = iter.next().get(), true : false;) {
+    slews.push_back(dynamic_cast<StaSlewData*>(data)->get_slew());
+  }
+  return slews;
+}
+
+TEST_F(StaDataTest, bucketGroup) {
+  StaDataBucket bucket(2);
+  auto add_slew = [&bucket](AnalysisMode mode, TransType trans, int slew) {
+    bucket.addData(new StaSlewData(mode, trans, nullptr, slew), 0);
+  };
+  add_slew(AnalysisMode::kMax, TransType::kRise, 10);
+  add_slew(AnalysisMode::kMax, TransType::kFall, 5);
+  add_slew(AnalysisMode::kMax, TransType::kRise, 30);
+  add_slew(AnalysisMode::kMax, TransType::kRise, 20);
+  add_slew(AnalysisMode::kMin, TransType::kRise, 7);
+  add_slew(AnalysisMode::kMax, TransType::kFall, 8);
+
+  // the groups are in create order, the max data keep the 2 largest.
+  EXPECT_EQ(bucketSlews(bucket), (std::vector<int>{30, 20, 8, 5, 7}));
+  EXPECT_EQ(dynamic_cast<StaSlewData*>(bucket.frontData())->get_slew(), 30);
+
+  // the full group replace the data in place.
+  add_slew(AnalysisMode::kMax, TransType::kRise, 25);
+  add_slew(AnalysisMode::kMax, TransType::kFall, 40);
+  EXPECT_EQ(bucketSlews(bucket), (std::vector<int>{30, 25, 40, 8, 7}));
+
+  bucket.freeData();
+  EXPECT_TRUE(bucket.isFreeData());
+  EXPECT_EQ(bucket.frontData(), nullptr);
+}
+
+TEST_F(StaDataTest, poolReuse) {
+  std::vector<StaDataBucket> buckets(1000);
+  auto add_datas = [&buckets]() {
+    for (auto& bucket : buckets) {
+      bucket.addData(
+          new StaSlewData(AnalysisMode::kMax, TransType::kRise, nullptr, 1), 0);
+      bucket.addData(
+          new StaSlewData(AnalysisMode::kMin, TransType::kFall, nullptr, 1), 0);
+    }
+  };
+
+  add_datas();
+  auto num_slab = StaDataPool::get_num_slab();
+  EXPECT_GT(num_slab, 0);
+
+  // the reset data is recycled by the pool.
+  for (auto& bucket : buckets) {
+    bucket.freeData();
+  }
+  add_datas();
+  EXPECT_EQ(StaDataPool::get_num_slab(), num_slab);
+}
+
+TEST_F(StaDataTest, poolRelease) {
+  std::vector<StaDataBucket> buckets(1000);
+  for (auto& bucket : buckets) {
+    bucket.addData(
+        new StaSlewData(AnalysisMode::kMax, TransType::kRise, nullptr, 1), 0);
+  }
+  auto num_slab = StaDataPool::get_num_slab();
+
+  // the slab of the used data is kept.
+  StaDataPool::releaseSlabs();
+  EXPECT_GT(StaDataPool::get_num_slab(), 0);
+
+  for (auto& bucket : buckets) {
+    bucket.freeData();
+  }
+  EXPECT_GT(StaDataPool::releaseSlabs(), 0);
+  EXPECT_LT(StaDataPool::get_num_slab(), num_slab);
+
+  // the pool carve the new slab after release.
+  buckets.front().addData(
+      new StaSlewData(AnalysisMode::kMax, TransType::kRise, nullptr, 2), 0);
+  EXPECT_EQ(bucketSlews(buckets.front()), (std::vector<int>{2}));
+}
+
+}  // namespace
@@ -0,0 +1,259 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ThreadPool/ThreadPool.h"
+#include "gtest/gtest.h"
+#include "log/Log.hh"
+#include "netlist/Port.hh"
+#include "sta/StaArc.hh"
+#include "sta/StaClock.hh"
+#include "sta/StaData.hh"
+#include "sta/StaPathData.hh"
+#include "sta/StaPathEnumerator.hh"
+#include "sta/StaVertex.hh"
+
+using ieda::Log;
+using namespace ista;
+
+namespace {
+
+class StaPathEnumeratorTest : public testing::Test {
+  void SetUp() {
+    char config[] = "test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() { Log::end(); }
+};
+
+constexpr int c_capture_edge_ps = 1000;
+
+/**
+ * @brief The reconvergent graph, the data is propagated from the start vertex
+ * l, every vertex keep the max rise data.
+ *
+ *   l -100- a -50- c -70- d -20- f
+ *   l -130- b -10- c -40- e -65- f
+ *           a -300- h      c -5- g
+ *
+ * The f has four paths, the g has two paths, the h has one path.
+ */
+class ReconvergentGraph {
+ public:
+  ReconvergentGraph() {
+    for (const char* name : {"l", "a", "b", "c", "d", "e", "f", "g", "h"}) {
+      auto& port = _ports.emplace_back(std::make_unique<Port>(name, PortDir::kIn));
+      _vertexes[name] = std::make_unique<StaVertex>(port.get());
+    }
+
+    addArc("l", "a", 100);
+    addArc("l", "b", 130);
+    addArc("a", "c", 50);
+    addArc("b", "c", 10);
+    addArc("c", "d", 70);
+    addArc("c", "e", 40);
+    addArc("d", "f", 20);
+    addArc("e", "f", 65);
+    addArc("c", "g", 5);
+    addArc("a", "h", 300);
+
+    _launch_clock_data = std::make_unique<StaClockData>(
+        AnalysisMode::kMax, TransType::kRise, 0, vertex("l"), &_clock);
+    for (const char* name : {"l", "a", "b", "c", "d", "e", "f", "g", "h"}) {
+      propagate(vertex(name));
+    }
+
+    for (const char* name : {"f", "g", "h"}) {
+      auto& capture_clock_data = _capture_clock_datas.emplace_back(
+          std::make_unique<StaClockData>(AnalysisMode::kMax, TransType::kRise,
+                                         0, vertex(name), &_clock));
+      auto* path_data = new StaSeqPathData(
+          delayData(vertex(name)), _launch_clock_data.get(),
+          capture_clock_data.get(),
+          StaClockPair(0, c_capture_edge_ps, 0, 0), std::nullopt, 0);
+      _group.insertPathData(vertex(name), path_data);
+    }
+  }
+
+  StaVertex* vertex(const char* name) { return _vertexes[name].get(); }
+  StaSeqPathGroup* group() { return &_group; }
+
+  static StaPathDelayData* delayData(StaVertex* the_vertex) {
+    StaData* data;
+    FOREACH_DELAY_DATA(the_vertex, data) {
+      return dynamic_cast<StaPathDelayData*>(data);
+    }
+    return nullptr;
+  }
+
+  /*The slack of all the paths to the end vertex, by depth first search.*/
+  std::vector<int> allPathSlacks(StaVertex* end_vertex) {
+    std::vector<int> slacks;
+    std::function<void(StaVertex*, int)> dfs = [&](StaVertex* the_vertex,
+                                                   int arrive_time) {
+      if (the_vertex->get_snk_arcs().empty()) {
+        slacks.push_back(PS_TO_FS(c_capture_edge_ps) - arrive_time);
+        return;
+      }
+      FOREACH_SNK_ARC(the_vertex, snk_arc) {
+        dfs(snk_arc->get_src(),
+            arrive_time +
+                snk_arc->get_arc_delay(AnalysisMode::kMax, TransType::kRise));
+      }
+    };
+    dfs(end_vertex, 0);
+    std::sort(slacks.begin(), slacks.end());
+    return slacks;
+  }
+
+ private:
+  void addArc(const char* src, const char* snk, int delay) {
+    auto& arc = _arcs.emplace_back(
+        std::make_unique<StaNetArc>(vertex(src), vertex(snk), nullptr));
+    arc->addData(new StaArcDelayData(AnalysisMode::kMax, TransType::kRise,
+                                     arc.get(), delay));
+    vertex(src)->addSrcArc(arc.get());
+    vertex(snk)->addSnkArc(arc.get());
+  }
+
+  void propagate(StaVertex* the_vertex) {
+    StaPathDelayData* worst_fanin_data = nullptr;
+    int64_t arrive_time = 0;
+    FOREACH_SNK_ARC(the_vertex, snk_arc) {
+      auto* fanin_data = delayData(snk_arc->get_src());
+      int64_t fanin_arrive_time =
+          fanin_data->get_arrive_time() +
+          snk_arc->get_arc_delay(AnalysisMode::kMax, TransType::kRise);
+      if (!worst_fanin_data || fanin_arrive_time > arrive_time) {
+        worst_fanin_data = fanin_data;
+        arrive_time = fanin_arrive_time;
+      }
+    }
+
+    auto* delay_data =
+        new StaPathDelayData(AnalysisMode::kMax, TransType::kRise,
+                             arrive_time, _launch_clock_data.get(), the_vertex);
+    delay_data->set_bwd(worst_fanin_data);
+    the_vertex->addData(delay_data);
+  }
+
+  StaClock _clock{"clk", StaClock::ClockType::kIdeal, c_capture_edge_ps};
+  std::vector<std::unique_ptr<Port>> _ports;
+  std::map<std::string, std::unique_ptr<StaVertex>> _vertexes;
+  std::vector<std::unique_ptr<StaNetArc>> _arcs;
+  std::unique_ptr<StaClockData> _launch_clock_data;
+  std::vector<std::unique_ptr<StaClockData>> _capture_clock_datas;
+  StaSeqPathGroup _group{&_clock};
+};
+
+/*The vertexes of the path from the start to the end.*/
+std::vector<StaVertex*> pathVertexes(StaSeqPathData* seq_path_data) {
+  std::vector<StaVertex*> path_vertexes;
+  auto* path_delay_data = seq_path_data->get_delay_data();
+  while (path_delay_data) {
+    path_vertexes.push_back(path_delay_data->get_own_vertex());
+    path_delay_data =
+        dynamic_cast<StaPathDelayData*>(path_delay_data->get_bwd());
+  }
+  std::reverse(path_vertexes.begin(), path_vertexes.end());
+  return path_vertexes;
+}
+
+TEST_F(StaPathEnumeratorTest, samePathsAsPriorityQueue) {
+  ReconvergentGraph graph;
+  ThreadPool pool(2);
+
+  for (unsigned n_worst : {1U, 2U, 3U, 10U}) {
+    StaPathEnumerator path_enumerator(AnalysisMode::kMax, n_worst, 1, &pool,
+                                      2);
+    path_enumerator({graph.group()});
+    auto* worst_paths = path_enumerator.findWorstPaths(graph.group());
+    ASSERT_NE(worst_paths, nullptr);
+
+    // the priority queue of the report before the enumerator.
+    auto cmp = [](StaPathData* left, StaPathData* right) -> bool {
+      return left->getSlack() > right->getSlack();
+    };
+    std::priority_queue<StaPathData*, std::vector<StaPathData*>, decltype(cmp)>
+        seq_data_queue(cmp);
+    StaPathEnd* path_end;
+    StaPathData* path_data;
+    FOREACH_PATH_GROUP_END(graph.group(), path_end)
+    FOREACH_PATH_END_DATA(path_end, AnalysisMode::kMax, path_data) {
+      seq_data_queue.push(path_data);
+    }
+
+    std::vector<StaSeqPathData*> queue_paths;
+    while (!seq_data_queue.empty() && queue_paths.size() < n_worst) {
+      queue_paths.push_back(
+          dynamic_cast<StaSeqPathData*>(seq_data_queue.top()));
+      seq_data_queue.pop();
+    }
+
+    EXPECT_EQ(*worst_paths, queue_paths) << "n_worst " << n_worst;
+  }
+}
+
+TEST_F(StaPathEnumeratorTest, worstPathsPerEndpoint) {
+  ReconvergentGraph graph;
+  ThreadPool pool(2);
+
+  constexpr unsigned n_worst_per_endpoint = 3;
+  StaPathEnumerator path_enumerator(AnalysisMode::kMax, 10,
+                                    n_worst_per_endpoint, &pool, 2);
+  path_enumerator({graph.group()});
+  auto* worst_paths = path_enumerator.findWorstPaths(graph.group());
+  ASSERT_NE(worst_paths, nullptr);
+
+  // the expected slacks are the n worst paths of each end by enumerate all.
+  std::vector<int> expect_slacks;
+  for (const char* name : {"f", "g", "h"}) {
+    auto slacks = graph.allPathSlacks(graph.vertex(name));
+    slacks.resize(std::min<std::size_t>(slacks.size(), n_worst_per_endpoint));
+    expect_slacks.insert(expect_slacks.end(), slacks.begin(), slacks.end());
+  }
+  std::sort(expect_slacks.begin(), expect_slacks.end());
+
+  std::vector<int> slacks;
+  std::set<std::vector<StaVertex*>> paths;
+  std::map<StaVertex*, unsigned> num_end_paths;
+  for (auto* seq_path_data : *worst_paths) {
+    slacks.push_back(seq_path_data->getSlack());
+
+    auto path_vertexes = pathVertexes(seq_path_data);
+    EXPECT_EQ(path_vertexes.front(), graph.vertex("l"));
+    EXPECT_TRUE(paths.insert(path_vertexes).second) << "duplicate path";
+    ++num_end_paths[path_vertexes.back()];
+  }
+
+  EXPECT_TRUE(std::is_sorted(slacks.begin(), slacks.end()));
+  EXPECT_EQ(slacks, expect_slacks);
+  for (auto& [end_vertex, num_end_path] : num_end_paths) {
+    EXPECT_LE(num_end_path, n_worst_per_endpoint);
+  }
+  EXPECT_EQ(num_end_paths[graph.vertex("f")], n_worst_per_endpoint);
+}
+
+}  // namespace
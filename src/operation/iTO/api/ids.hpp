@@ -25,6 +25,7 @@ class TimingIDBAdapter;
 class TimingDBAdapter;
 class DesignObject;
 class RctNode;
+class RcNet;
 class Net;
 class Pin;
 class Instance;
@@ -64,6 +64,7 @@ class ToConfig {
   }
   void set_rebuffer_max_fanout(int num) { _rebuffer_max_fanout = num; }
   void set_split_load_min_fanout(int num) { _split_load_min_fanout = num; }
+  void set_setup_batch_size(int num) { _setup_batch_size = num; }
 
   // getter
   const vector<string> &get_lef_files() const { return _lef_files_path; }
@@ -94,6 +95,7 @@ class ToConfig {
   }
   int get_rebuffer_max_fanout() { return _rebuffer_max_fanout; }
   int get_split_load_min_fanout() { return _split_load_min_fanout; }
+  int get_setup_batch_size() { return _setup_batch_size; }
 
  private:
   // input
@@ -120,6 +122,9 @@ class ToConfig {
   int _number_passes_allowed_decreasing_slack = 50;
   int _rebuffer_max_fanout = 20;
   int _split_load_min_fanout = 8; // Don't split loads on low fanout nets.
+  // the maximum number of violated paths repaired in one pass when fix setup,
+  // 1: only repair the worst path.
+  int _setup_batch_size = 1;
 
   // output
   string _out_def_path;
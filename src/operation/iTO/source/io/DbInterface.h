@@ -85,6 +85,7 @@ class DbInterface {
   }
   int get_rebuffer_max_fanout() { return _config->get_rebuffer_max_fanout(); }
   int get_split_load_min_fanout() { return _config->get_split_load_min_fanout(); }
+  int get_setup_batch_size() { return _config->get_setup_batch_size(); }
 
   TgtSlews get_target_slews() { return _target_slews; }
 
@@ -117,29 +117,34 @@ void Reporter::reportNetInfo(ista::Net *net, double max_cap) {
 
 void Reporter::reportHoldResult(vector<double> hold_slacks,
                                 vector<int> hold_vio_num,
-                                vector<int> insert_buf_num, double slack,
+                                vector<int> insert_buf_num,
+                                vector<double> pass_runtimes, double slack,
                                 int insert_buf) {
   if (!_outfile.is_open()) {
     _outfile.open(_output_path, ios::app);
   }
   _outfile << "\n#buf : number of inserted buffer\n";
   _outfile << "#vio : number of hold violation endpoints\n";
-  _outfile << "------------------------------------------------------" << endl;
+  _outfile << "------------------------------------------------------------------------"
+           << endl;
   _outfile << setiosflags(ios::left) << setw(18) << "#buf"
            << resetiosflags(ios::left) << setiosflags(ios::right) << setw(18) << "Hold WNS"
-           << setw(18) << "#vio" << resetiosflags(ios::right) << endl;
-  _outfile << "------------------------------------------------------" << endl;
+           << setw(18) << "#vio" << setw(18) << "Runtime(s)" << resetiosflags(ios::right)
+           << endl;
+  _outfile << "------------------------------------------------------------------------"
+           << endl;
   _outfile << setiosflags(ios::left) << setw(18) << 0 << resetiosflags(ios::left)
            << setiosflags(ios::right) << setw(18) << hold_slacks[0] << setw(18)
-           << hold_vio_num[0] << resetiosflags(ios::right) << endl;
+           << hold_vio_num[0] << setw(18) << 0 << resetiosflags(ios::right) << endl;
 
   for (size_t i = 0; i < insert_buf_num.size(); ++i) {
     _outfile << setiosflags(ios::left) << setw(18) << insert_buf_num[i]
              << resetiosflags(ios::left) << setiosflags(ios::right) << setw(18)
-             << hold_slacks[i + 1] << setw(18) << hold_vio_num[i + 1]
-             << resetiosflags(ios::right) << endl;
+             << hold_slacks[i + 1] << setw(18) << hold_vio_num[i + 1] << setw(18)
+             << pass_runtimes[i] << resetiosflags(ios::right) << endl;
   }
-  _outfile << "------------------------------------------------------" << endl;
+  _outfile << "------------------------------------------------------------------------"
+           << endl;
   _outfile.close();
 }
 
@@ -48,7 +48,8 @@ class Reporter {
                        int cap_violations, int fanout_violations, bool before);
   void reportSetupResult(std::vector<double> slack_store);
   void reportHoldResult(vector<double> hold_slacks, vector<int> hold_vio_num,
-                        vector<int> insert_buf_num, double slack, int insert_buf);
+                        vector<int> insert_buf_num, vector<double> pass_runtimes,
+                        double slack, int insert_buf);
 
   void reportNetInfo(ista::Net *net, double max_cap);
 
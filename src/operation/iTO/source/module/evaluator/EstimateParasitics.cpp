@@ -15,10 +15,32 @@
 // See the Mulan PSL v2 for more details.
 // ***************************************************************************************
 #include "EstimateParasitics.h"
+
+#include <algorithm>
+
 #include "api/TimingEngine.hh"
 #include "api/TimingIDBAdapter.hh"
+#include "usage/usage.hh"
 
 namespace ito {
+namespace {
+/**
+ * @brief flute builds the LUT of the max degree at the first use, which is not
+ * thread safe, build it before the parallel region.
+ *
+ */
+void initFluteLUT() {
+  int x[FLUTE_D];
+  int y[FLUTE_D];
+  for (int i = 0; i < FLUTE_D; ++i) {
+    x[i] = i;
+    y[i] = (i * 5) % FLUTE_D;
+  }
+  Flute::Tree tree = Flute::flute(FLUTE_D, x, y, FLUTE_ACCURACY);
+  Flute::free_tree(tree);
+}
+} // namespace
+
 EstimateParasitics::EstimateParasitics(DbInterface *dbintreface)
     : _db_interface(dbintreface) {
   _timing_engine = _db_interface->get_timing_engine();
@@ -41,15 +63,15 @@ EstimateParasitics::EstimateParasitics(TimingEngine *timing_engine, int dbu)
  */
 void EstimateParasitics::excuteParasiticsEstimate() {
   if (_have_estimated_parasitics) {
+    vector<Net *> nets;
     for (Net *net : _parasitics_invalid) {
-      DesignObject *driver = net->getDriver();
-      if (driver) {
-        if (_timing_engine->get_ista()->getRcNet(net)) {
-          _timing_engine->resetRcTree(net);
-        }
-        excuteWireParasitic(driver, net, _db_adapter);
+      if (net->getDriver()) {
+        nets.push_back(net);
+      } else {
+        _topologies.erase(net);
       }
     }
+    estimateNetsParasitics(nets);
     _parasitics_invalid.clear();
   } else {
     estimateAllNetParasitics();
@@ -62,14 +84,96 @@ void EstimateParasitics::excuteParasiticsEstimate() {
  */
 void EstimateParasitics::estimateAllNetParasitics() {
   LOG_INFO << "estimate all net parasitics start";
-  Netlist *design_nl = _timing_engine->get_netlist();
-  Net *    net;
-  FOREACH_NET(design_nl, net) {
-    estimateNetParasitics(net);
-  }
+  Netlist     *design_nl = _timing_engine->get_netlist();
+  vector<Net *> nets;
+  Net          *net;
+  FOREACH_NET(design_nl, net) { nets.push_back(net); }
+
+  // the topologies of the removed nets.
+  std::unordered_set<Net *> design_nets(nets.begin(), nets.end());
+  std::erase_if(_topologies, [&design_nets](const auto &net_topology) {
+    return !design_nets.contains(net_topology.first);
+  });
+
+  estimateNetsParasitics(nets);
+
   _have_estimated_parasitics = true;
   _parasitics_invalid.clear();
-  LOG_INFO << "estimate all net parasitics end";
+  LOG_INFO << "estimate all net parasitics end, nets " << _stats.num_nets
+           << ", reused steiner trees " << _stats.num_reused << ", kept rc trees "
+           << _stats.num_kept << ", steiner runtime " << _stats.steiner_runtime
+           << "s, rc runtime " << _stats.rc_runtime << "s";
+}
+
+/**
+ * @brief update rc tree of the nets in parallel.
+ *
+ * The steiner topology of a net is reused if its pins are not changed (same
+ * pins at the same locations), and the rc tree built from the topology is kept
+ * if the rc net is not rebuilt since, only the rc info is updated since the pin
+ * cap may be changed.
+ *
+ * @param nets
+ */
+void EstimateParasitics::estimateNetsParasitics(const vector<Net *> &nets) {
+  _stats = Stats();
+  _stats.num_nets = nets.size();
+  if (nets.empty()) {
+    return;
+  }
+
+  // steiner topology, only read the design.
+  ieda::Stats steiner_stats;
+  initFluteLUT();
+
+  int                     num_nets = nets.size();
+  vector<SteinerTopology> new_topologies(num_nets);
+  vector<char>            is_reused(num_nets, 0);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < num_nets; ++i) {
+    size_t pin_hash = calcPinHash(nets[i]);
+    auto   iter = _topologies.find(nets[i]);
+    if (iter != _topologies.end() && iter->second.pin_hash == pin_hash) {
+      is_reused[i] = 1;
+      continue;
+    }
+    makeTopology(nets[i], new_topologies[i]);
+    new_topologies[i].pin_hash = pin_hash;
+  }
+
+  for (int i = 0; i < num_nets; ++i) {
+    if (is_reused[i]) {
+      _stats.num_reused++;
+    } else {
+      _topologies[nets[i]] = std::move(new_topologies[i]);
+    }
+  }
+  _stats.steiner_runtime = steiner_stats.elapsedRunTime();
+
+  // rc tree, each net is built by one thread.
+  ieda::Stats rc_stats;
+  Sta         *ista = _timing_engine->get_ista();
+  vector<char> is_kept(num_nets, 0);
+#pragma omp parallel for schedule(dynamic, 64)
+  for (int i = 0; i < num_nets; ++i) {
+    Net             *net = nets[i];
+    SteinerTopology &topology = _topologies.find(net)->second;
+    RcNet           *rc_net = ista->getRcNet(net);
+    if (is_reused[i] && rc_net && rc_net->get_version() == topology.rc_version) {
+      is_kept[i] = 1;
+      _timing_engine->updateRCTreeInfo(net);
+      continue;
+    }
+
+    if (rc_net) {
+      _timing_engine->resetRcTree(net);
+    }
+    updateRcTree(net, topology, _db_adapter);
+    rc_net = ista->getRcNet(net);
+    topology.rc_version = rc_net ? rc_net->get_version() : 0;
+  }
+  _stats.num_kept = std::count(is_kept.begin(), is_kept.end(), 1);
+  _stats.rc_runtime = rc_stats.elapsedRunTime();
 }
 
 /**
@@ -106,67 +210,119 @@ void EstimateParasitics::estimateInvalidNetParasitics(DesignObject *drvr_pin_por
 
 void EstimateParasitics::excuteWireParasitic(DesignObject *drvr_pin_port, Net *curr_net,
                                              TimingDBAdapter *db_adapter) {
-  RoutingTree *tree = makeRoutingTree(curr_net, db_adapter, RoutingType::kSteiner);
+  SteinerTopology topology;
+  makeTopology(curr_net, topology);
+  topology.pin_hash = calcPinHash(curr_net);
 
-  if (tree) {
-    vector<int> segment_idx;
-    vector<int> length_wire;
-    tree->drvrToLoadLength(tree->get_root(), segment_idx, length_wire, 0);
+  updateRcTree(curr_net, topology, db_adapter);
+  RcNet *rc_net = _timing_engine->get_ista()->getRcNet(curr_net);
+  topology.rc_version = rc_net ? rc_net->get_version() : 0;
+  _topologies[curr_net] = std::move(topology);
+}
 
-    std::vector<std::pair<int, int>> wire_segment_idx;
-    std::vector<int>                 length_per_wire;
+/**
+ * @brief hash of the pins and their locations of the net.
+ *
+ * @param net
+ * @return size_t
+ */
+size_t EstimateParasitics::calcPinHash(Net *net) {
+  TimingIDBAdapter *idb_adapter = dynamic_cast<TimingIDBAdapter *>(_db_adapter);
 
-    tree->segmentIndexAndLength(tree->get_root(), wire_segment_idx, length_per_wire);
+  auto hash_combine = [](size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+  };
 
-    int numb = wire_segment_idx.size();
-    for (int i = 0; i != numb; ++i) {
-      int      index1 = wire_segment_idx[i].first;
-      int      index2 = wire_segment_idx[i].second;
-      RctNode *n1 = _timing_engine->makeOrFindRCTreeNode(curr_net, index1);
-      RctNode *n2 = _timing_engine->makeOrFindRCTreeNode(curr_net, index2);
+  size_t        pin_hash = 0;
+  DesignObject *obj;
+  FOREACH_NET_PIN(net, obj) {
+    IdbCoordinate<int32_t> *loc = idb_adapter->idbLocation(obj);
+    pin_hash = hash_combine(pin_hash, std::hash<DesignObject *>()(obj));
+    pin_hash = hash_combine(pin_hash, loc ? std::hash<int32_t>()(loc->get_x()) : 0);
+    pin_hash = hash_combine(pin_hash, loc ? std::hash<int32_t>()(loc->get_y()) : 0);
+  }
+  return pin_hash;
+}
 
-      int length_dbu = length_per_wire[i];
-      if (length_dbu == 0) {
-        _timing_engine->makeResistor(curr_net, n1, n2, 1.0e-3);
-      } else {
-        std::optional<double> width = std::nullopt;
-        double                cap = dynamic_cast<TimingIDBAdapter *>(db_adapter)
-                         ->getCapacitance(1, (double)length_dbu / _dbu, width);
-        double res = dynamic_cast<TimingIDBAdapter *>(db_adapter)
-                         ->getResistance(1, (double)length_dbu / _dbu, width);
-
-        if (curr_net->isClockNet()) {
-          cap /= 10.0;
-          res /= 10.0;
-        // } else {
-        //   cap /= 2.0;
-        //   res /= 2.0;
-        }
-
-        _timing_engine->incrCap(n1, cap / 2.0, true);
-        _timing_engine->makeResistor(curr_net, n1, n2, res);
-        _timing_engine->incrCap(n2, cap / 2.0, true);
-      }
-      RctNodeConnectPin(curr_net, index1, n1, tree);
-      RctNodeConnectPin(curr_net, index2, n2, tree);
-    }
+/**
+ * @brief make the steiner topology of the net, it is empty if the net has no
+ * driver or less than two pins.
+ *
+ * @param net
+ * @param topology
+ */
+void EstimateParasitics::makeTopology(Net *net, SteinerTopology &topology) {
+  RoutingTree *tree = makeRoutingTree(net, _db_adapter, RoutingType::kSteiner);
+  if (!tree) {
+    return;
+  }
 
-    _timing_engine->updateRCTreeInfo(curr_net);
+  topology.pins = tree->get_pins();
+  topology.root_id = tree->get_root()->get_id();
+  tree->segmentIndexAndLength(tree->get_root(), topology.segments, topology.lengths);
 
-    delete tree;
-  }
+  delete tree;
 }
 
-void EstimateParasitics::RctNodeConnectPin(Net *net, int index, RctNode *rcnode,
-                                           RoutingTree *tree) {
-  int num_pins = tree->get_pins().size();
-  if (tree->get_pin_visit(index) == 1) {
+/**
+ * @brief build the rc tree of the net from its steiner topology.
+ *
+ * @param curr_net
+ * @param topology
+ * @param db_adapter
+ */
+void EstimateParasitics::updateRcTree(Net *curr_net, const SteinerTopology &topology,
+                                      TimingDBAdapter *db_adapter) {
+  if (topology.segments.empty()) {
     return;
   }
-  if (index < num_pins) {
-    tree->set_pin_visit(index);
-    RctNode *pin_node = _timing_engine->makeOrFindRCTreeNode(tree->get_pin(index));
-    if (index == tree->get_root()->get_id()) {
+
+  vector<bool> pin_visit(topology.pins.size(), false);
+
+  int numb = topology.segments.size();
+  for (int i = 0; i != numb; ++i) {
+    int      index1 = topology.segments[i].first;
+    int      index2 = topology.segments[i].second;
+    RctNode *n1 = _timing_engine->makeOrFindRCTreeNode(curr_net, index1);
+    RctNode *n2 = _timing_engine->makeOrFindRCTreeNode(curr_net, index2);
+
+    int length_dbu = topology.lengths[i];
+    if (length_dbu == 0) {
+      _timing_engine->makeResistor(curr_net, n1, n2, 1.0e-3);
+    } else {
+      std::optional<double> width = std::nullopt;
+      double                cap = dynamic_cast<TimingIDBAdapter *>(db_adapter)
+                       ->getCapacitance(1, (double)length_dbu / _dbu, width);
+      double res = dynamic_cast<TimingIDBAdapter *>(db_adapter)
+                       ->getResistance(1, (double)length_dbu / _dbu, width);
+
+      if (curr_net->isClockNet()) {
+        cap /= 10.0;
+        res /= 10.0;
+      // } else {
+      //   cap /= 2.0;
+      //   res /= 2.0;
+      }
+
+      _timing_engine->incrCap(n1, cap / 2.0, true);
+      _timing_engine->makeResistor(curr_net, n1, n2, res);
+      _timing_engine->incrCap(n2, cap / 2.0, true);
+    }
+    RctNodeConnectPin(curr_net, index1, n1, topology, pin_visit);
+    RctNodeConnectPin(curr_net, index2, n2, topology, pin_visit);
+  }
+
+  _timing_engine->updateRCTreeInfo(curr_net);
+}
+
+void EstimateParasitics::RctNodeConnectPin(Net *net, int index, RctNode *rcnode,
+                                           const SteinerTopology &topology,
+                                           vector<bool>          &pin_visit) {
+  int num_pins = topology.pins.size();
+  if (index < num_pins && !pin_visit[index]) {
+    pin_visit[index] = true;
+    RctNode *pin_node = _timing_engine->makeOrFindRCTreeNode(topology.pins[index]);
+    if (index == topology.root_id) {
       _timing_engine->makeResistor(net, pin_node, rcnode, 1.0e-3);
     } else {
       _timing_engine->makeResistor(net, rcnode, pin_node, 1.0e-3);
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include <unordered_map>
 #include <unordered_set>
 
 #include "DbInterface.h"
@@ -32,6 +33,14 @@ using ito::metersToDbu;
 
 class EstimateParasitics {
  public:
+  struct Stats {
+    int    num_nets = 0;
+    int    num_reused = 0;        // steiner topology reused
+    int    num_kept = 0;          // rc tree kept, only rc info updated
+    double steiner_runtime = 0.0; // s
+    double rc_runtime = 0.0;      // s
+  };
+
   EstimateParasitics(DbInterface *dbintreface);
 
   EstimateParasitics(TimingEngine *timing_engine, int dbu);
@@ -42,6 +51,8 @@ class EstimateParasitics {
 
   void estimateAllNetParasitics();
 
+  void estimateNetsParasitics(const vector<Net *> &nets);
+
   void estimateNetParasitics(Net *net);
 
   void parasiticsInvalid(Net *net);
@@ -51,8 +62,26 @@ class EstimateParasitics {
   void excuteWireParasitic(DesignObject *drvr_pin_port, Net *curr_net,
                            TimingDBAdapter *db_adapter);
 
+  // stats of the last estimation of nets
+  const Stats &get_stats() const { return _stats; }
+
  private:
-  void RctNodeConnectPin(Net *net, int index, RctNode *rcnode, RoutingTree *tree);
+  // steiner topology of a net, the first nodes of the segments are the pins.
+  struct SteinerTopology {
+    size_t                pin_hash = 0;
+    DesignObjSeq          pins;
+    int                   root_id = -1;
+    vector<pair<int, int>> segments;
+    vector<int>           lengths;
+    uint64_t              rc_version = 0; // version of the rc net built from the topology
+  };
+
+  size_t calcPinHash(Net *net);
+  void   makeTopology(Net *net, SteinerTopology &topology);
+  void   updateRcTree(Net *curr_net, const SteinerTopology &topology,
+                      TimingDBAdapter *db_adapter);
+  void   RctNodeConnectPin(Net *net, int index, RctNode *rcnode,
+                           const SteinerTopology &topology, vector<bool> &pin_visit);
 
   DbInterface     *_db_interface = nullptr;
   TimingEngine    *_timing_engine = nullptr;
@@ -62,6 +91,9 @@ class EstimateParasitics {
   std::unordered_set<ista::Net *> _parasitics_invalid;
 
   bool _have_estimated_parasitics = false;
+
+  std::unordered_map<ista::Net *, SteinerTopology> _topologies;
+  Stats                                            _stats;
 };
 
 } // namespace ito
\ No newline at end of file
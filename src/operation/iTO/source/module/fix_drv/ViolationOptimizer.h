@@ -133,6 +133,7 @@ class ViolationOptimizer {
   LibertyCell *_insert_buffer_cell;
 
   friend class SetupOptimizer;
+  friend class BufferingEngine;
   friend class HoldOptimizer;
 };
 
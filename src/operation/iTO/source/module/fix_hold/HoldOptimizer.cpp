@@ -16,6 +16,8 @@
 // ***************************************************************************************
 #include "HoldOptimizer.h"
 
+#include <chrono>
+
 #include "api/TimingEngine.hh"
 #include "api/TimingIDBAdapter.hh"
 
@@ -67,13 +69,19 @@ void HoldOptimizer::optimizeHold() {
   int   iteration = 1;
   int   insert_buf_count = 1;
   while (insert_buf_count > 0 && worst_hold_slack < _slack_margin) {
+    auto start = std::chrono::steady_clock::now();
     insert_buf_count = checkAndOptimizeHold(end_points, insert_buf_cell);
-    _parasitics_estimator->estimateAllNetParasitics();
+    // the passes update timing incrementally, check it by a full update.
+    _parasitics_estimator->excuteParasiticsEstimate();
     _timing_engine->updateTiming();
+    _incr_buffers.clear();
     worst_hold_slack = getWorstSlack(AnalysisMode::kMin);
+    double runtime =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     _db_interface->report()->get_ofstream()
         << "\nThe " << iteration << "-th timing check." << endl
-        << "\tworst hold slack: " << worst_hold_slack << endl;
+        << "\tworst hold slack: " << worst_hold_slack << endl
+        << "\truntime: " << runtime << "s" << endl;
     iteration++;
   }
 
@@ -113,6 +121,8 @@ int HoldOptimizer::checkAndOptimizeHold(VertexSet    end_points,
   vector<int> hold_vio_num;
   // store inserted hold buffer number
   vector<int> insert_buf_num;
+  // store runtime of each pass
+  vector<double> pass_runtimes;
 
   int insert_buf_count = 0;
 
@@ -135,6 +145,8 @@ int HoldOptimizer::checkAndOptimizeHold(VertexSet    end_points,
     while (!end_pts_hold_violation.empty() &&
            _inserted_buffer_count < _max_numb_insert_buf &&
            !_db_interface->overMaxArea() && repair_count > 0) {
+      auto start = std::chrono::steady_clock::now();
+
       VertexSet fanins = getFanins(end_pts_hold_violation);
 
       VertexSeq sorted_fanins = sortFanins(fanins);
@@ -144,20 +156,25 @@ int HoldOptimizer::checkAndOptimizeHold(VertexSet    end_points,
       insert_buf_count += repair_count;
       insert_buf_num.push_back(repair_count);
       if (repair_count > 0) {
+        // only the nets around the inserted buffers are estimated.
         _parasitics_estimator->excuteParasiticsEstimate();
-        _timing_engine->updateTiming();
+        updateTimingIncr();
       }
 
       findEndpointsWithHoldViolation(end_points, worst_slack, end_pts_hold_violation);
       hold_slacks.push_back(worst_slack);
       hold_vio_num.push_back(end_pts_hold_violation.size());
+      pass_runtimes.push_back(
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+              .count());
       pass++;
     }
   } else {
     _db_interface->report()->get_ofstream() << "No hold violations found.\n";
   }
   _db_interface->report()->reportHoldResult(hold_slacks, hold_vio_num, insert_buf_num,
-                                            worst_slack, _inserted_buffer_count);
+                                            pass_runtimes, worst_slack,
+                                            _inserted_buffer_count);
 
   _db_interface->report()->get_ofstream()
       << "Inserted " << insert_buf_count << " hold buffers.\n";
@@ -338,6 +355,7 @@ void HoldOptimizer::insertLoadBuffer(LibertyCell *load_buffer, StaVertex *drvr_v
     setLocation(buffer, loc_x, loc_y);
 
     _timing_engine->insertBuffer(buffer->get_name());
+    _incr_buffers.push_back(buffer);
   }
 
   _parasitics_estimator->parasiticsInvalid(drvr->get_net());
@@ -459,6 +477,7 @@ void HoldOptimizer::insertBufferDelay(StaVertex *drvr_vertex, int insert_number,
 
     _timing_engine->insertBuffer(buffer->get_name());
     insert_inst_name.push_back(buffer->get_name());
+    _incr_buffers.push_back(buffer);
 
     // increase design area
     idb::IdbCellMaster *idb_master = idb_adapter->staToDb(insert_buffer_cell);
@@ -748,6 +767,19 @@ void HoldOptimizer::insertHoldDelay(string insert_buf_name, string pin_name,
   idb_builder->saveDef(defWritePath);
 }
 
+/**
+ * @brief update the timing of the fanin and fanout of the buffers inserted
+ * after the last timing update.
+ *
+ */
+void HoldOptimizer::updateTimingIncr() {
+  for (auto *buffer : _incr_buffers) {
+    _timing_engine->moveInstance(buffer->get_name());
+  }
+  _incr_buffers.clear();
+  _timing_engine->incrUpdateTiming();
+}
+
 void HoldOptimizer::reportWNSAndTNS() {
   _db_interface->report()->get_ofstream()
       << "\n---------------------------------------------------------------------------\n"
@@ -76,6 +76,8 @@ class HoldOptimizer {
   void insertLoadBuffer(LibertyCell *load_buffer, StaVertex *drvr_vtx, int insert_num);
   void insertLoadBuffer(VertexSeq fanins);
 
+  void updateTimingIncr();
+
   void reportWNSAndTNS();
 
   // data
@@ -97,6 +99,9 @@ class HoldOptimizer {
   int _inserted_buffer_count = 0;
   int _inserted_load_buffer_count = 0;
 
+  // buffers inserted after the last timing update
+  vector<Instance *> _incr_buffers;
+
   // to name the instance
   int _insert_instance_index = 1;
   int _insert_load_instance_index = 1;
@@ -21,6 +21,7 @@
 #include "DbInterface.h"
 
 namespace ito {
+using ista::DesignObject;
 using ista::Pin;
 using ista::StaSeqPathData;
 using ista::LibertyCell;
@@ -36,7 +37,7 @@ class BufferedOption {
   BufferedOption(BufferedOptionType type,
                  Point location,
                  float cap,
-                 ista::Pin *load_pin,
+                 DesignObject *load_pin,
                  Delay required_delay,
                  LibertyCell *buffer,
                  BufferedOption *left,
@@ -68,7 +69,8 @@ class BufferedOption {
 
   LibertyCell *get_buffer_cell() const { return _buffer_cell; }
 
-  Pin *get_load_pin() const { return _load_pin; }
+  // load pin of instance, or output port of the design
+  DesignObject *get_load_pin() const { return _load_pin; }
   // junction  left
   // buffer    wire
   // wire      end of wire
@@ -84,7 +86,7 @@ class BufferedOption {
   // Capacitance looking into Net.
   float _cap = 0.0;
   // Type load.
-  Pin *_load_pin = nullptr;
+  DesignObject *_load_pin = nullptr;
 
   // Delay from this BufferedOption to the load.
   Delay _required_delay = 0.0;
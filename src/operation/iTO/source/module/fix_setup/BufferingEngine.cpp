@@ -0,0 +1,387 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#include "BufferingEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+
+#include "api/TimingEngine.hh"
+#include "api/TimingIDBAdapter.hh"
+#include "liberty/Liberty.hh"
+
+using namespace std;
+
+namespace ito {
+
+BufferingEngine::BufferingEngine(DbInterface *dbinterface,
+                                 ViolationOptimizer *violation_fixer)
+    : _db_interface(dbinterface), _violation_fixer(violation_fixer) {
+  _timing_engine = _db_interface->get_timing_engine();
+  _dbu = _db_interface->get_dbu();
+
+  // wire parasitics are affine in length
+  TimingIDBAdapter *idb_adapter =
+      dynamic_cast<TimingIDBAdapter *>(_timing_engine->get_db_adapter());
+  std::optional<double> width = std::nullopt;
+  _wire_cap_base = idb_adapter->getCapacitance(1, 0.0, width);
+  width = std::nullopt;
+  _wire_cap_per_um = idb_adapter->getCapacitance(1, 1.0, width) - _wire_cap_base;
+  width = std::nullopt;
+  _wire_res_per_um = idb_adapter->getResistance(1, 1.0, width);
+}
+
+void BufferingEngine::set_buffer_cells(const LibertyCellSeq &buf_cells) {
+  _buffer_models.clear();
+  for (auto *buf_cell : buf_cells) {
+    LibertyPort *input, *output;
+    buf_cell->bufferPorts(input, output);
+    float input_cap = input->get_port_cap();
+    // sample at the input cap of the buffer, about one load per step
+    float cap_step = input_cap > 0 ? input_cap : 1e-3;
+    _buffer_models.push_back({buf_cell, input_cap, cap_step, {}});
+  }
+}
+
+/**
+ * @brief buffer the net from the loads to the driver, return the option with
+ * the max required arrival time at the driver input, taking the driver delay into
+ * account.
+ *
+ * @param drvr_pin
+ * @param tree updated branch
+ * @return BufferedOption* nullptr if the net can not be buffered
+ */
+BufferedOption *BufferingEngine::findBestOption(Pin *drvr_pin, RoutingTree *tree) {
+  auto start_time = chrono::steady_clock::now();
+  resetPool();
+  _max_frontier = 0;
+
+  int                drvr_id = tree->get_root()->get_id();
+  BufferedOptionSeq *options = acquireSeq();
+  bottomUp(tree, tree->left(drvr_id), drvr_id, *options);
+
+  LibertyPort    *drvr_port = drvr_pin->get_cell_port();
+  Required        best_slack = -kInf;
+  BufferedOption *best_option = nullptr;
+  for (auto *opt : *options) {
+    Slack slack =
+        opt->get_required_arrival_time() - calcGateDelay(drvr_port, opt->get_cap());
+    if (fuzzyGreater(slack, best_slack)) {
+      best_slack = slack;
+      best_option = opt;
+    }
+  }
+  releaseSeq(options);
+
+  double runtime =
+      chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
+  _net_stats.push_back({static_cast<int>(tree->get_pins_count()) - 1, _num_options,
+                        _max_frontier, runtime});
+  return best_option;
+}
+
+void BufferingEngine::bottomUp(RoutingTree *tree, int curr_id, int prev_id,
+                               BufferedOptionSeq &options) {
+  options.clear();
+  if (curr_id == RoutingTree::_null_pt) {
+    return;
+  }
+  Point curr_loc = tree->get_location(curr_id);
+  Point prev_loc = tree->get_location(prev_id);
+
+  auto *obj_pin = tree->get_pin(curr_id);
+  if (obj_pin) {
+    // the loads are input pins of instances and output ports of the design
+    bool is_load = obj_pin->isPin() ? obj_pin->isInput() : obj_pin->isOutput();
+    if (!is_load) {
+      return;
+    }
+    StaVertex *vertex = _timing_engine->get_ista()->findVertex(obj_pin);
+    if (!vertex) {
+      return;
+    }
+    auto   req_ns_r = vertex->getReqTimeNs(AnalysisMode::kMax, TransType::kRise);
+    double req_r = req_ns_r ? *req_ns_r : 0.0;
+    auto   req_ns_f = vertex->getReqTimeNs(AnalysisMode::kMax, TransType::kFall);
+    double req_f = req_ns_f ? *req_ns_f : 0.0;
+    double req = min(req_r, req_f);
+
+    options.push_back(makeOption(BufferedOptionType::kLoad, curr_loc, obj_pin->cap(), obj_pin,
+                                 0.0, nullptr, nullptr, nullptr, req));
+  } else {
+    // steiner point
+    int left_id = tree->left(curr_id);
+    int middle_id = tree->middle(curr_id);
+    if (left_id == RoutingTree::_null_pt || middle_id == RoutingTree::_null_pt) {
+      bottomUp(tree, left_id == RoutingTree::_null_pt ? middle_id : left_id, curr_id,
+               options);
+    } else {
+      BufferedOptionSeq *left = acquireSeq();
+      BufferedOptionSeq *middle = acquireSeq();
+      bottomUp(tree, left_id, curr_id, *left);
+      bottomUp(tree, middle_id, curr_id, *middle);
+      mergeBranch(*left, *middle, curr_loc, options);
+      releaseSeq(left);
+      releaseSeq(middle);
+    }
+  }
+
+  addWire(options, curr_loc, prev_loc);
+  addBuffer(options, prev_loc);
+  prune(options);
+}
+
+/**
+ * @brief both branches are frontiers, the merged option is limited by the branch
+ * with smaller required time, only advancing that branch may improve it.
+ *
+ * @param left
+ * @param right
+ * @param curr_loc
+ * @param options
+ */
+void BufferingEngine::mergeBranch(BufferedOptionSeq &left, BufferedOptionSeq &right,
+                                  Point curr_loc, BufferedOptionSeq &options) {
+  options.clear();
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    BufferedOption *left_opt = left[i];
+    BufferedOption *right_opt = right[j];
+    Required        left_req = left_opt->get_required_arrival_time();
+    Required        right_req = right_opt->get_required_arrival_time();
+    BufferedOption *min_opt = fuzzyLess(left_req, right_req) ? left_opt : right_opt;
+
+    float cap = left_opt->get_cap() + right_opt->get_cap();
+    options.push_back(makeOption(BufferedOptionType::kJunction, curr_loc, cap, nullptr,
+                                 min_opt->get_required_delay(), nullptr, left_opt,
+                                 right_opt, min_opt->get_req()));
+
+    if (fuzzyLess(left_req, right_req)) {
+      i++;
+    } else if (fuzzyLess(right_req, left_req)) {
+      j++;
+    } else {
+      i++;
+      j++;
+    }
+  }
+}
+
+void BufferingEngine::addWire(BufferedOptionSeq &options, Point curr_loc,
+                              Point prev_loc) {
+  int wire_length_dbu =
+      abs(curr_loc.get_x() - prev_loc.get_x()) + abs(curr_loc.get_y() - prev_loc.get_y());
+  double wire_length = (double)wire_length_dbu / _dbu;
+  double wire_cap = _wire_cap_base + _wire_cap_per_um * wire_length;
+  double wire_res = _wire_res_per_um * wire_length;
+
+  for (auto &opt : options) {
+    double wire_delay = wire_res * (wire_cap / 2 + opt->get_cap());
+    opt = makeOption(BufferedOptionType::kWire, prev_loc, opt->get_cap() + wire_cap,
+                     nullptr, opt->get_required_delay() + wire_delay, nullptr, opt,
+                     nullptr, opt->get_req());
+  }
+}
+
+/**
+ * @brief for each buffer, drive the option with max required time after the
+ * buffer delay.
+ *
+ * @param options wire options, buffer options are appended
+ * @param loc
+ */
+void BufferingEngine::addBuffer(BufferedOptionSeq &options, Point loc) {
+  size_t num_wire_options = options.size();
+  if (num_wire_options == 0) {
+    return;
+  }
+  for (auto &model : _buffer_models) {
+    Required        best_req = -kInf;
+    Delay           best_delay = 0.0;
+    BufferedOption *best_option = nullptr;
+    for (size_t i = 0; i < num_wire_options; i++) {
+      BufferedOption *opt = options[i];
+      Delay           buffer_delay = bufferDelay(model, opt->get_cap());
+      Required        req = opt->get_required_arrival_time() - buffer_delay;
+      if (fuzzyGreater(req, best_req)) {
+        best_req = req;
+        best_delay = buffer_delay;
+        best_option = opt;
+      }
+    }
+    if (best_option) {
+      Delay required_delay = best_option->get_required_delay() + best_delay;
+      options.push_back(makeOption(BufferedOptionType::kBuffer, loc, model.input_cap,
+                                   nullptr, required_delay, model.cell, best_option,
+                                   nullptr, best_option->get_req()));
+    }
+  }
+}
+
+/**
+ * @brief keep the frontier of the options, cap ascending and required ascending.
+ * Options dominated by another one (no less cap and no greater required time)
+ * and options below the convex hull of the frontier are removed.
+ *
+ * @param options
+ */
+void BufferingEngine::prune(BufferedOptionSeq &options) {
+  sort(options.begin(), options.end(), [](BufferedOption *opt1, BufferedOption *opt2) {
+    if (opt1->get_cap() != opt2->get_cap()) {
+      return opt1->get_cap() < opt2->get_cap();
+    }
+    return opt1->get_required_arrival_time() > opt2->get_required_arrival_time();
+  });
+
+  size_t   size = 0;
+  Required max_req = -kInf;
+  for (auto *opt : options) {
+    Required req = opt->get_required_arrival_time();
+    if (!fuzzyGreater(req, max_req)) {
+      continue;
+    }
+    max_req = req;
+    // upper convex hull, the last kept option is removed if it is not above the
+    // segment between its predecessor and the new option
+    while (size >= 2) {
+      BufferedOption *opt_a = options[size - 2];
+      BufferedOption *opt_b = options[size - 1];
+      double          cap_a = opt_a->get_cap();
+      double          req_a = opt_a->get_required_arrival_time();
+      double          cross =
+          (opt_b->get_cap() - cap_a) * (req - req_a) -
+          (opt_b->get_required_arrival_time() - req_a) * (opt->get_cap() - cap_a);
+      if (cross < 0) {
+        break;
+      }
+      size--;
+    }
+    options[size++] = opt;
+  }
+  options.resize(size);
+  _max_frontier = max(_max_frontier, size);
+}
+
+/**
+ * @brief max of rise and fall delay, interpolated from the sampled table, the
+ * table is extended when a larger load cap is queried.
+ *
+ * @param model
+ * @param load_cap
+ * @return Delay
+ */
+Delay BufferingEngine::bufferDelay(BufferModel &model, float load_cap) {
+  double pos = max(load_cap, 0.0f) / model.cap_step;
+  size_t idx = static_cast<size_t>(pos);
+  if (idx + 1 >= model.delays.size()) {
+    LibertyPort *input, *output;
+    model.cell->bufferPorts(input, output);
+    while (idx + 1 >= model.delays.size()) {
+      model.delays.push_back(calcGateDelay(output, model.delays.size() * model.cap_step));
+    }
+  }
+  double frac = pos - idx;
+  return model.delays[idx] * (1 - frac) + model.delays[idx + 1] * frac;
+}
+
+Delay BufferingEngine::calcGateDelay(LibertyPort *drvr_port, float load_cap) {
+  Delay delays[2];
+  Slew  slews[2];
+  _violation_fixer->calcGateRiseFallDelays(drvr_port, load_cap, delays, slews);
+  return max(delays[0], delays[1]);
+}
+
+BufferedOption *BufferingEngine::makeOption(BufferedOptionType type, Point location,
+                                            float cap, DesignObject *load_pin,
+                                            Delay required_delay, LibertyCell *buffer,
+                                            BufferedOption *left, BufferedOption *right,
+                                            double req) {
+  if (_chunk_index < _chunks.size() && _chunks[_chunk_index].size() == kChunkSize) {
+    _chunk_index++;
+  }
+  if (_chunk_index == _chunks.size()) {
+    _chunks.emplace_back();
+    _chunks.back().reserve(kChunkSize);
+  }
+  _num_options++;
+  return &_chunks[_chunk_index].emplace_back(type, location, cap, load_pin,
+                                             required_delay, buffer, left, right, req);
+}
+
+void BufferingEngine::resetPool() {
+  for (auto &chunk : _chunks) {
+    chunk.clear();
+  }
+  _chunk_index = 0;
+  _num_options = 0;
+}
+
+BufferedOptionSeq *BufferingEngine::acquireSeq() {
+  if (_free_seqs.empty()) {
+    _seqs.push_back(std::make_unique<BufferedOptionSeq>());
+    return _seqs.back().get();
+  }
+  BufferedOptionSeq *seq = _free_seqs.back();
+  _free_seqs.pop_back();
+  return seq;
+}
+
+void BufferingEngine::releaseSeq(BufferedOptionSeq *seq) {
+  seq->clear();
+  _free_seqs.push_back(seq);
+}
+
+/**
+ * @brief options generated and runtime per net, grouped by fanout.
+ *
+ * @param os
+ */
+void BufferingEngine::reportStats(std::ostream &os) const {
+  const vector<int> fanout_bounds = {2, 4, 8, 16, 32, 64, 128};
+  os << "Buffering nets " << _net_stats.size() << "\n";
+  os << "fanout\tnets\toptions/net\tmax frontier\truntime/net(us)\tmax runtime(us)\n";
+  for (size_t b = 0; b < fanout_bounds.size(); b++) {
+    int    lower = fanout_bounds[b];
+    int    upper = b + 1 < fanout_bounds.size() ? fanout_bounds[b + 1] : INT_MAX;
+    size_t num_nets = 0;
+    size_t num_options = 0;
+    size_t max_frontier = 0;
+    double runtime = 0.0;
+    double max_runtime = 0.0;
+    for (auto &stats : _net_stats) {
+      if (stats.fanout < lower || stats.fanout >= upper) {
+        continue;
+      }
+      num_nets++;
+      num_options += stats.num_options;
+      max_frontier = max(max_frontier, stats.max_frontier);
+      runtime += stats.runtime;
+      max_runtime = max(max_runtime, stats.runtime);
+    }
+    if (num_nets == 0) {
+      continue;
+    }
+    os << "[" << lower << ", " << (upper == INT_MAX ? "inf" : to_string(upper)) << ")\t"
+       << num_nets << "\t" << num_options / num_nets << "\t" << max_frontier << "\t"
+       << runtime / num_nets * 1e6 << "\t" << max_runtime * 1e6 << "\n";
+  }
+}
+
+} // namespace ito
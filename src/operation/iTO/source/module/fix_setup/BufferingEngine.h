@@ -0,0 +1,118 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "BufferedOption.h"
+#include "RoutingTree.h"
+#include "ViolationOptimizer.h"
+
+#include "ids.hpp"
+
+namespace ito {
+/**
+ * @brief van Ginneken buffering on the steiner tree of a net.
+ *
+ * The options of a tree node are kept as a frontier of (cap, required arrival
+ * time): cap ascending and required ascending, dominated options and the
+ * options below the convex hull of the frontier are pruned, so merging two
+ * branches is linear in the number of options.
+ * Options are allocated from a pool which is reused between nets, they are
+ * valid until the next net is buffered.
+ * Buffer delays are looked up from per cell tables sampled by load cap.
+ */
+class BufferingEngine {
+ public:
+  struct NetStats {
+    int    fanout;
+    size_t num_options;  // options generated
+    size_t max_frontier; // max options kept at a tree node
+    double runtime;      // s
+  };
+
+  BufferingEngine(DbInterface *dbinterface, ViolationOptimizer *violation_fixer);
+  ~BufferingEngine() = default;
+  BufferingEngine(const BufferingEngine &other) = delete;
+  BufferingEngine(BufferingEngine &&other) = delete;
+
+  void set_buffer_cells(const LibertyCellSeq &buf_cells);
+
+  BufferedOption *findBestOption(Pin *drvr_pin, RoutingTree *tree);
+
+  const vector<NetStats> &get_net_stats() const { return _net_stats; }
+  void                    reportStats(std::ostream &os) const;
+
+ private:
+  struct BufferModel {
+    LibertyCell  *cell;
+    float         input_cap;
+    float         cap_step;
+    vector<Delay> delays; // delays[i] is the delay driving load cap i * cap_step
+  };
+
+  void bottomUp(RoutingTree *tree, int curr_id, int prev_id,
+                // return values
+                BufferedOptionSeq &options);
+  void mergeBranch(BufferedOptionSeq &left, BufferedOptionSeq &right, Point curr_loc,
+                   // return values
+                   BufferedOptionSeq &options);
+  void addWire(BufferedOptionSeq &options, Point curr_loc, Point prev_loc);
+  void addBuffer(BufferedOptionSeq &options, Point loc);
+  void prune(BufferedOptionSeq &options);
+
+  Delay bufferDelay(BufferModel &model, float load_cap);
+  Delay calcGateDelay(LibertyPort *drvr_port, float load_cap);
+
+  BufferedOption *makeOption(BufferedOptionType type, Point location, float cap,
+                             DesignObject *load_pin, Delay required_delay, LibertyCell *buffer,
+                             BufferedOption *left, BufferedOption *right, double req);
+  void            resetPool();
+
+  BufferedOptionSeq *acquireSeq();
+  void               releaseSeq(BufferedOptionSeq *seq);
+
+  DbInterface        *_db_interface;
+  TimingEngine       *_timing_engine;
+  ViolationOptimizer *_violation_fixer;
+  int                 _dbu;
+
+  // wire cap = _wire_cap_base + _wire_cap_per_um * length,
+  // wire res = _wire_res_per_um * length
+  double _wire_cap_base = 0.0;
+  double _wire_cap_per_um = 0.0;
+  double _wire_res_per_um = 0.0;
+
+  vector<BufferModel> _buffer_models;
+
+  // option pool, chunks are never reallocated so the options do not move
+  static constexpr size_t        kChunkSize = 4096;
+  vector<vector<BufferedOption>> _chunks;
+  size_t                         _chunk_index = 0;
+  size_t                         _num_options = 0;
+
+  // option lists of the tree nodes being visited
+  vector<std::unique_ptr<BufferedOptionSeq>> _seqs;
+  vector<BufferedOptionSeq *>                 _free_seqs;
+  size_t                                      _max_frontier = 0;
+
+  vector<NetStats> _net_stats;
+};
+
+} // namespace ito
@@ -16,6 +16,8 @@
 // ***************************************************************************************
 #include "SetupOptimizer.h"
 
+#include <chrono>
+
 #include "api/TimingIDBAdapter.hh"
 #include "api/TimingEngine.hh"
 #include "liberty/Liberty.hh"
@@ -35,6 +37,7 @@ SetupOptimizer::SetupOptimizer(DbInterface *dbinterface)
   _db_adapter = _timing_engine->get_db_adapter();
   _parasitics_estimator = new EstimateParasitics(_db_interface);
   _violation_fixer = new ViolationOptimizer(_db_interface);
+  _buffering_engine = new BufferingEngine(_db_interface, _violation_fixer);
 }
 
 void SetupOptimizer::initBufferCell() {
@@ -60,6 +63,7 @@ void SetupOptimizer::initBufferCell() {
 void SetupOptimizer::optimizeSetup() {
   // to store slack each time
   vector<Slack> slack_store;
+  auto start_time = chrono::steady_clock::now();
 
   _parasitics_estimator->estimateAllNetParasitics();
   _timing_engine->updateTiming();
@@ -67,14 +71,16 @@ void SetupOptimizer::optimizeSetup() {
 
   initBufferCell();
   LOG_ERROR_IF(_buf_cells.empty()) << "Can not found specified buffers.\n";
+  _buffering_engine->set_buffer_cells(_buf_cells);
 
   Slack prev_worst_slack = -kInf;
-  int   pass = 1;
+  int   pass = 0;
   int   decreasing_slack_passes = 0;
 
   float slack_margin = _db_interface->get_setup_slack_margin();
   int   _number_passes_allowed_decreasing_slack =
       _db_interface->get_number_passes_allowed_decreasing_slack();
+  int batch_size = _db_interface->get_setup_batch_size();
 
   StaSeqPathData *worst_path = worstRequiredPath();
   Slack worst_slack = worst_path->getSlackNs();
@@ -82,12 +88,15 @@ void SetupOptimizer::optimizeSetup() {
 
   // slack violation
   while (worst_slack < slack_margin) {
+    pass++;
 
-    optimizeSetup(worst_path, worst_slack);
-
+    if (batch_size > 1) {
+      optimizeSetupBatch(slack_margin, batch_size);
+    } else {
+      optimizeSetup(worst_path, worst_slack);
+    }
     _parasitics_estimator->excuteParasiticsEstimate();
-
-    _timing_engine->updateTiming();
+    updateTimingIncr();
 
     worst_path = worstRequiredPath();
     worst_slack = worst_path->getSlackNs();
@@ -113,18 +122,22 @@ void SetupOptimizer::optimizeSetup() {
     // if (_db_interface->overMaxArea()) {
     //   break;
     // }
-    pass++;
   }
   _db_interface->report()->reportSetupResult(slack_store);
+  double runtime =
+      chrono::duration<double>(chrono::steady_clock::now() - start_time).count();
 
   _parasitics_estimator->estimateAllNetParasitics();
   _timing_engine->reportTiming();
 
   printf("Inserted {%d} buffers.\n", _inserted_buffer_count);
   printf("Resized {%d} instances.\n", _resize_instance_count);
+  printf("Setup optimization passes {%d}, runtime {%.3f}s.\n", pass, runtime);
   _db_interface->report()->get_ofstream()
       << "Inserted " << _inserted_buffer_count << " buffers."
-      << "\nResized " << _resize_instance_count << " instances.\n";
+      << "\nResized " << _resize_instance_count << " instances."
+      << "\nSetup optimization passes " << pass << ", runtime " << runtime << "s.\n";
+  _buffering_engine->reportStats(_db_interface->report()->get_ofstream());
   _db_interface->report()->get_ofstream().close();
 
   if (worst_slack < slack_margin) {
@@ -190,6 +203,7 @@ void SetupOptimizer::optimizeSetup(StaSeqPathData *worst_path, Slack path_slack)
           Instance *drvr_inst = drvr_pin->get_own_instance();
           if (_violation_fixer->repowerInstance(drvr_inst, upsize)) {
             _resize_instance_count++;
+            _incr_instances.push_back(drvr_inst);
             _parasitics_estimator->estimateNetParasitics(drvr_pin->get_net());
           }
           break;
@@ -218,232 +232,95 @@ void SetupOptimizer::optimizeSetup(StaSeqPathData *worst_path, Slack path_slack)
   }
 }
 
-void SetupOptimizer::buffering(Pin *pin) {
-  Net         *net = pin->get_net();
-  LibertyPort *drvr_port = pin->get_cell_port();
-
-  if (drvr_port && net) {
-    RoutingTree *tree = makeRoutingTree(net, _db_adapter, RoutingType::kSteiner);
-    if (tree) {
-      int drvr_id = tree->get_root()->get_id();
-      tree->updateBranch();
-      BufferedOptionSeq buf_opts =
-          bottomUpBuffering(tree, tree->left(drvr_id), drvr_id, 1);
-
-      Required        best_slack = -kInf;
-      BufferedOption *best_option = nullptr;
-      for (BufferedOption *opt : buf_opts) {
-        Slack slack = opt->get_required_arrival_time();
-        if (fuzzyGreater(slack, best_slack)) {
-          best_slack = slack;
-          best_option = opt;
-        }
-      }
-      if (best_option) {
-        // for DEBUG
-        // best_option->printBuffered(0);
-        topDownImplementBuffering(best_option, net, 1);
-      }
+/**
+ * @brief repair the violated paths in one pass, the paths are picked from the
+ * worst one and skipped if their driver cones overlap with the picked paths, so
+ * the repairs do not interfere with each other.
+ *
+ * @param slack_margin
+ * @param batch_size the maximum number of paths repaired in one pass
+ */
+void SetupOptimizer::optimizeSetupBatch(float slack_margin, int batch_size) {
+  vector<StaSeqPathData *> violated_paths =
+      _timing_engine->getViolatedSeqPaths(AnalysisMode::kMax, slack_margin);
+
+  std::set<Net *> touched_nets;
+  int             repaired_count = 0;
+  for (auto *path : violated_paths) {
+    if (repaired_count >= batch_size) {
+      break;
     }
-    delete tree;
-  }
-}
-
-BufferedOptionSeq SetupOptimizer::bottomUpBuffering(RoutingTree *tree, int curr_id,
-                                                    int prev_id, int level) {
-  if (curr_id != RoutingTree::_null_pt) {
-    auto *obj_pin = tree->get_pin(curr_id);
-    Point curr_loc = tree->get_location(curr_id);
-    Point prev_loc = tree->get_location(prev_id);
-
-    if (obj_pin) {
-      auto *pin = dynamic_cast<Pin *>(obj_pin);
-
-      if (_timing_engine->isLoad(pin->getFullName().c_str())) {
-        StaVertex      *vertex = _timing_engine->findVertex(pin->getFullName().c_str());
-        auto   req_ns_r = vertex->getReqTimeNs(AnalysisMode::kMax, TransType::kRise);
-        double req_r = req_ns_r ? *req_ns_r : 0.0;
-        auto   req_ns_f = vertex->getReqTimeNs(AnalysisMode::kMax, TransType::kFall);
-        double req_f = req_ns_f ? *req_ns_f : 0.0;
-        double req = min(req_r, req_f);
-
-        BufferedOption *buffered_option = new BufferedOption(
-            BufferedOptionType::kLoad,
-            curr_loc,   // load pin loc
-            pin->cap(), // load pin cap
-            pin,        // load pin
-            0.0, nullptr, nullptr, nullptr, req);
-        BufferedOptionSeq buf_option_seq;
-        buf_option_seq.emplace_back(buffered_option);
-
-        return addWireAndBuffer(buf_option_seq, curr_loc, prev_loc, level);
-      }
+    std::set<Net *> path_nets = getPathDriverNets(path);
+    bool            overlap =
+        any_of(path_nets.begin(), path_nets.end(),
+               [&touched_nets](Net *net) { return touched_nets.count(net) > 0; });
+    if (overlap) {
+      continue;
     }
-    // curr -> steiner point
-    else if (obj_pin == nullptr) {
-      BufferedOptionSeq buf_opt_left =
-          bottomUpBuffering(tree, tree->left(curr_id), curr_id, level + 1);
-      BufferedOptionSeq buf_opt_mid =
-          bottomUpBuffering(tree, tree->middle(curr_id), curr_id, level + 1);
-
-      BufferedOptionSeq buf_opt_merger = mergeBranch(buf_opt_left, buf_opt_mid, curr_loc);
+    touched_nets.insert(path_nets.begin(), path_nets.end());
 
-      return addWireAndBuffer(buf_opt_merger, curr_loc, prev_loc, level);
-    }
+    optimizeSetup(path, path->getSlackNs());
+    repaired_count++;
   }
-  return BufferedOptionSeq();
 }
 
-BufferedOptionSeq SetupOptimizer::mergeBranch(BufferedOptionSeq buf_opt_left,
-                                              BufferedOptionSeq buf_opt_right,
-                                              Point             curr_loc) {
-  BufferedOptionSeq buf_opt_merger;
-  for (auto left : buf_opt_left) {
-    for (auto right : buf_opt_right) {
-      Required left_req = left->get_required_arrival_time();
-      float    left_cap = left->get_cap();
-      Required right_req = right->get_required_arrival_time();
-      float    right_cap = right->get_cap();
-
-      BufferedOption *min_opt = fuzzyLess(left_req, right_req) ? left : right;
-
-      BufferedOption *buffered_option =
-          new BufferedOption(BufferedOptionType::kJunction,
-                             curr_loc,             // load pin loc
-                             left_cap + right_cap, // load pin cap
-                             nullptr,              // load pin
-                             min_opt->get_required_delay(),
-                             nullptr, left, right, min_opt->get_req());
-      buf_opt_merger.emplace_back(buffered_option);
-    }
+/**
+ * @brief update timing from the instances resized or inserted in the pass, the
+ * inserted buffers are levelized when they are inserted to the timing graph.
+ */
+void SetupOptimizer::updateTimingIncr() {
+  for (auto *inst : _incr_instances) {
+    _timing_engine->moveInstance(inst->get_name());
   }
-  sort(buf_opt_merger.begin(), buf_opt_merger.end(),
-       [=](BufferedOption *opt1, BufferedOption *opt2) {
-         return fuzzyGreater(opt1->get_required_arrival_time(),
-                             opt2->get_required_arrival_time());
-       });
-  int si = 0;
-  for (size_t pi = 0; pi < buf_opt_merger.size(); pi++) {
-    BufferedOption *p = buf_opt_merger[pi];
-    float           Lp = p->get_cap();
-    // Remove options by shifting down with index si.
-    si = pi + 1;
-    // Because the options are sorted we don't have to look
-    // beyond the first option.
-    for (size_t qi = pi + 1; qi < buf_opt_merger.size(); qi++) {
-      BufferedOption *q = buf_opt_merger[qi];
-      float           Lq = q->get_cap();
-      if (fuzzyLess(Lq, Lp)) {
-        buf_opt_merger[si++] = q;
-      }
-    }
-    buf_opt_merger.resize(si);
-  }
-  return buf_opt_merger;
+  _incr_instances.clear();
+  _timing_engine->incrUpdateTiming();
 }
 
-BufferedOptionSeq SetupOptimizer::addWireAndBuffer(BufferedOptionSeq buf_opt_seq,
-                                                   Point curr_loc, Point prev_loc,
-                                                   int level) {
-  int wire_length_dbu =
-      abs(curr_loc.get_x() - prev_loc.get_x()) + abs(curr_loc.get_y() - prev_loc.get_y());
-
-  BufferedOptionSeq buf_option_seq;
-  for (BufferedOption *buf_opt : buf_opt_seq) {
-    std::optional<double> width = std::nullopt;
-    double                wire_cap = dynamic_cast<TimingIDBAdapter *>(_db_adapter)
-                          ->getCapacitance(1, (double)wire_length_dbu / _dbu, width);
-    double wire_res = dynamic_cast<TimingIDBAdapter *>(_db_adapter)
-                          ->getResistance(1, (double)wire_length_dbu / _dbu, width);
-    // double wire_delay = wire_res * wire_cap;
-    double wire_delay = wire_res * (wire_cap / 2 + buf_opt->get_cap());
-
-    float update_cap = buf_opt->get_cap() + wire_cap;
-    Delay update_req_delay = buf_opt->get_required_delay() + wire_delay;
-
-    BufferedOption *buffered_option =
-        new BufferedOption(BufferedOptionType::kWire,
-                           prev_loc,   // load pin loc
-                           update_cap, // load pin cap
-                           nullptr,    // load pin
-                           update_req_delay, // plus wire delay
-                           nullptr,          // no buf
-                           buf_opt, nullptr, buf_opt->get_req());
-
-    buf_option_seq.push_back(buffered_option);
-  }
-  // Determine if a buffer needs to be inserted after adding wire
-  if (!buf_option_seq.empty()) {
-    BufferedOptionSeq buf_options = addBuffer(buf_option_seq, prev_loc);
-    for (BufferedOption *buf_opt : buf_options) {
-      buf_option_seq.push_back(buf_opt);
+/**
+ * @brief the nets connected to the driver instances of the path, a repair on
+ * the path only changes the parasitics and timing of these nets.
+ *
+ * @param path
+ * @return std::set<Net *>
+ */
+std::set<Net *> SetupOptimizer::getPathDriverNets(StaSeqPathData *path) {
+  std::set<Net *> path_nets;
+  for (auto &path_net : _timing_engine->getPathDriverVertexs(path)) {
+    auto *obj = path_net.driver->get_design_obj();
+    if (!obj->isPin()) {
+      if (obj->get_net()) {
+        path_nets.insert(obj->get_net());
+      }
+      continue;
+    }
+    Instance *inst = dynamic_cast<Pin *>(obj)->get_own_instance();
+    Pin      *pin;
+    FOREACH_INSTANCE_PIN(inst, pin) {
+      if (pin->get_net()) {
+        path_nets.insert(pin->get_net());
+      }
     }
   }
-  return buf_option_seq;
+  return path_nets;
 }
 
-BufferedOptionSeq SetupOptimizer::addBuffer(BufferedOptionSeq buf_opt_seq,
-                                            Point             prev_loc) {
-  BufferedOptionSeq buf_option_seq;
-
-  for (LibertyCell *buf_cell : _buf_cells) {
-    Required better_req_time = -kInf;
-    // "wire" option
-    BufferedOption *better_buf_option = nullptr;
-
-    // "wire" option
-    for (BufferedOption *buf_opt : buf_opt_seq) {
-      Required        req_time = kInf;
-      // buffer delay, related to load capacitance
-      Delay buffer_delay = calcBufferDelay(buf_cell, buf_opt->get_cap());
-
-      req_time = buf_opt->get_required_arrival_time() - buffer_delay;
+void SetupOptimizer::buffering(Pin *pin) {
+  Net         *net = pin->get_net();
+  LibertyPort *drvr_port = pin->get_cell_port();
 
-      // Find greater required arrival time and it's corresponding "wire" option
-      if (fuzzyGreater(req_time, better_req_time)) {
-        better_req_time = req_time;
-        better_buf_option = buf_opt;
-      }
-    }
-    if (better_buf_option) {
-      Required        req_time = kInf;
-      float           buffer_cap = 0.0;
-      Delay           buffer_delay = 0.0;
-
-      LibertyPort *intput_port, *output_port;
-      buf_cell->bufferPorts(intput_port, output_port);
-      buffer_cap = intput_port->get_port_cap();
-
-      // buffer delay, related to load capacitance
-      buffer_delay = calcBufferDelay(buf_cell, better_buf_option->get_cap());
-
-      req_time = better_buf_option->get_required_arrival_time() - buffer_delay;
-
-      // Don't add this buffer option if it has bigger input cap and smaller req
-      // than another existing buffer option.
-      bool prune = false;
-      for (BufferedOption *buffer_option : buf_option_seq) {
-        if (buffer_option->get_cap() <= buffer_cap &&
-            buffer_option->get_required_arrival_time() >= req_time) {
-          prune = true;
-          break;
-        }
-      }
-      if (!prune) {
-        Delay update_req_delay = better_buf_option->get_required_delay() + buffer_delay;
-        BufferedOption *buffered_option = new BufferedOption(
-            BufferedOptionType::kBuffer,
-            prev_loc,   // load pin loc
-            buffer_cap, // load pin cap
-            nullptr,    // load pin
-            update_req_delay, // plus buf delay
-            buf_cell, better_buf_option, nullptr, better_buf_option->get_req());
-
-        buf_option_seq.push_back(buffered_option);
+  if (drvr_port && net) {
+    RoutingTree *tree = makeRoutingTree(net, _db_adapter, RoutingType::kSteiner);
+    if (tree) {
+      tree->updateBranch();
+      BufferedOption *best_option = _buffering_engine->findBestOption(pin, tree);
+      if (best_option) {
+        // for DEBUG
+        // best_option->printBuffered(0);
+        topDownImplementBuffering(best_option, net, 1);
       }
     }
+    delete tree;
   }
-  return buf_option_seq;
 }
 
 void SetupOptimizer::topDownImplementBuffering(BufferedOption *buf_opt, Net *net,
@@ -473,6 +350,7 @@ void SetupOptimizer::topDownImplementBuffering(BufferedOption *buf_opt, Net *net
     LOG_ERROR_IF(!debug_buf_out);
 
     _timing_engine->insertBuffer(buffer->get_name());
+    _incr_instances.push_back(buffer);
     // _timing_engine->updateTiming();
 
     Point loc = buf_opt->get_location();
@@ -507,15 +385,29 @@ void SetupOptimizer::topDownImplementBuffering(BufferedOption *buf_opt, Net *net
   }
   case BufferedOptionType::kLoad: {
     TimingIDBAdapter *idb_adapter = dynamic_cast<TimingIDBAdapter *>(_db_adapter);
-    Pin              *load_pin = buf_opt->get_load_pin();
+    DesignObject     *load_pin = buf_opt->get_load_pin();
     Net              *load_net = load_pin->get_net();
     if (load_net != net) {
-      Instance    *load_inst = load_pin->get_own_instance();
-      idb_adapter->disconnectPin(load_pin);
-      auto debug = idb_adapter->connect(load_inst, load_pin->get_name(), net);
-      LOG_ERROR_IF(!debug);
-
-      _timing_engine->insertBuffer(load_inst->get_name());
+      idb_adapter->disconnectPinPort(load_pin);
+      if (load_pin->isPin()) {
+        Instance *load_inst = dynamic_cast<Pin *>(load_pin)->get_own_instance();
+        auto      debug = idb_adapter->connect(load_inst, load_pin->get_name(), net);
+        LOG_ERROR_IF(!debug);
+
+        _timing_engine->insertBuffer(load_inst->get_name());
+        _incr_instances.push_back(load_inst);
+      } else {
+        // output port, the net arcs are rebuilt from the driver instance of the net
+        auto *port = dynamic_cast<Port *>(load_pin);
+        idb_adapter->connect(port, port->get_name(), net);
+
+        auto *drvr_pin = net->getDriver();
+        if (drvr_pin && drvr_pin->isPin()) {
+          Instance *drvr_inst = dynamic_cast<Pin *>(drvr_pin)->get_own_instance();
+          _timing_engine->insertBuffer(drvr_inst->get_name());
+          _incr_instances.push_back(drvr_inst);
+        }
+      }
       // _timing_engine->updateTiming();
 
       _parasitics_estimator->parasiticsInvalid(load_net);
@@ -603,6 +495,7 @@ void SetupOptimizer::insertBufferSeparateLoads(StaVertex *drvr_vertex, Slack drv
   Point                   drvr_loc = Point(idb_loc->get_x(), idb_loc->get_y());
 
   _timing_engine->insertBuffer(buffer->get_name());
+  _incr_instances.push_back(buffer);
   Pin *buffer_out_pin = buffer->findPin(output);
   _violation_fixer->repowerInstance(buffer_out_pin);
   setLocation(buffer, drvr_loc.get_x(), drvr_loc.get_y());
@@ -614,23 +507,6 @@ void SetupOptimizer::insertBufferSeparateLoads(StaVertex *drvr_vertex, Slack drv
   _parasitics_estimator->estimateInvalidNetParasitics(out_net->getDriver(), out_net);
 }
 
-float SetupOptimizer::calcBufferDelay(LibertyCell *buffer_cell, float load_cap) {
-  auto delay_rise = calcBufferDelay(buffer_cell, load_cap, TransType::kRise);
-  auto delay_fall = calcBufferDelay(buffer_cell, load_cap, TransType::kFall);
-  return max(delay_rise, delay_fall);
-}
-
-float SetupOptimizer::calcBufferDelay(LibertyCell *buffer_cell, float load_cap,
-                                      TransType rf) {
-  LibertyPort *input, *output;
-  buffer_cell->bufferPorts(input, output);
-  Delay delays[2];
-  Slew  slews[2];
-  _violation_fixer->calcGateRiseFallDelays(output, load_cap, delays, slews);
-  int rise_fall = (int)rf - 1;
-  return delays[rise_fall];
-}
-
 float SetupOptimizer::calcGateDelay(LibertyPort *drvr_port, float load_cap,
                                     TransType rf) {
   Delay delays[2];
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "BufferedOption.h"
+#include "BufferingEngine.h"
 #include "ViolationOptimizer.h"
 
 #include "ids.hpp"
@@ -34,6 +35,7 @@ class SetupOptimizer {
   SetupOptimizer(DbInterface *dbinterface);
 
   ~SetupOptimizer() {
+    delete _buffering_engine;
     delete _parasitics_estimator;
     delete _violation_fixer;
   }
@@ -48,6 +50,12 @@ class SetupOptimizer {
 
   void optimizeSetup(StaSeqPathData *worst_path, Slack path_slack);
 
+  void optimizeSetupBatch(float slack_margin, int batch_size);
+
+  void updateTimingIncr();
+
+  std::set<Net *> getPathDriverNets(StaSeqPathData *path);
+
   void buffering(Pin *pin);
 
   void insertBufferSeparateLoads(StaVertex *drvr_vertex, Slack drvr_slack);
@@ -55,23 +63,8 @@ class SetupOptimizer {
   LibertyCell *upsizeCell(LibertyPort *in_port, LibertyPort *drvr_port, float load_cap,
                           float prev_drive);
 
-  BufferedOptionSeq bottomUpBuffering(RoutingTree *tree, int curr_id, int prev_id,
-                                      int level);
-
-  BufferedOptionSeq mergeBranch(BufferedOptionSeq buf_opt_left,
-                                BufferedOptionSeq buf_opt_right, Point curr_loc);
-
-  BufferedOptionSeq addWireAndBuffer(BufferedOptionSeq buf_opt_seq,
-                                     //  RoutingTree *tree,
-                                     Point curr_loc, Point prev_loc, int level);
-
-  BufferedOptionSeq addBuffer(BufferedOptionSeq buf_opt_seq, Point prev_loc);
-
   void topDownImplementBuffering(BufferedOption *buf_opt, Net *net, int level);
 
-  float calcBufferDelay(LibertyCell *buffer_cell, float load_cap);
-  float calcBufferDelay(LibertyCell *buffer_cell, float load_cap, TransType rf);
-
   float calcGateDelay(LibertyPort *drvr_port, float load_cap, TransType rf);
 
   float calcGateDelay(LibertyPort *drvr_port, float load_cap);
@@ -91,10 +84,14 @@ class SetupOptimizer {
 
   EstimateParasitics *_parasitics_estimator;
   ViolationOptimizer *_violation_fixer;
+  BufferingEngine    *_buffering_engine;
 
   int _resize_instance_count;
   int _inserted_buffer_count;
 
+  // instances resized or inserted in the current pass, for incremental timing update
+  std::vector<Instance *> _incr_instances;
+
   // to name the instance
   int _insert_instance_index;
   // to name the net
@@ -0,0 +1,94 @@
+// ***************************************************************************************
+// Copyright (c) 2023-2025 Peng Cheng Laboratory
+// Copyright (c) 2023-2025 Institute of Computing Technology, Chinese Academy of Sciences
+// Copyright (c) 2023-2025 Beijing Institute of Open Source Chip
+//
+// iEDA is licensed under Mulan PSL v2.
+// You can use this software according to the terms and conditions of the Mulan PSL v2.
+// You may obtain a copy of Mulan PSL v2 at:
+// http://license.coscl.org.cn/MulanPSL2
+//
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+//
+// See the Mulan PSL v2 for more details.
+// ***************************************************************************************
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ieda_solver {
+/**
+ * @brief Pack a sequence pair to the lower left, O(n log n).
+ *
+ * Block a is left of block b if a is before b in both sequences, and below b if a is after b in the positive sequence and before b
+ * in the negative sequence. So visiting blocks in the positive sequence order, x of a block is the max right edge of the visited
+ * blocks before it in the negative sequence, a prefix max over the negative sequence index kept in a Fenwick tree. y is the same
+ * visiting in the reversed positive sequence order.
+ *
+ * The buffers are kept between calls, no allocation after the first pack of the same size. Shared by the sequence pair of the
+ * iPL macro placer and iMP.
+ */
+class SequencePairPacker
+{
+ public:
+  /**
+   * @param pos positive sequence of block index
+   * @param neg negative sequence of block index
+   * @param width, height size of block index
+   * @param x, y lower left of block index (output)
+   * @param total_width, total_height bounding box of the packing (output)
+   */
+  template <typename T>
+  void pack(const std::vector<int>& pos, const std::vector<int>& neg, const T* width, const T* height, T* x, T* y, T& total_width,
+            T& total_height)
+  {
+    const int num = pos.size();
+    _neg_index.resize(num);
+    _tree.resize(num + 1);
+    for (int i = 0; i < num; ++i) {
+      _neg_index[neg[i]] = i;
+    }
+
+    std::fill(_tree.begin(), _tree.end(), 0);
+    for (int i = 0; i < num; ++i) {
+      int b = pos[i];
+      x[b] = static_cast<T>(query(_neg_index[b]));
+      insert(_neg_index[b], static_cast<int64_t>(x[b]) + width[b]);
+    }
+    total_width = static_cast<T>(query(num));
+
+    std::fill(_tree.begin(), _tree.end(), 0);
+    for (int i = num - 1; i >= 0; --i) {
+      int b = pos[i];
+      y[b] = static_cast<T>(query(_neg_index[b]));
+      insert(_neg_index[b], static_cast<int64_t>(y[b]) + height[b]);
+    }
+    total_height = static_cast<T>(query(num));
+  }
+
+ private:
+  // max of [0, index)
+  int64_t query(int index) const
+  {
+    int64_t max_value = 0;
+    for (; index > 0; index -= index & -index) {
+      max_value = std::max(max_value, _tree[index]);
+    }
+    return max_value;
+  }
+  void insert(int index, int64_t value)
+  {
+    for (++index; index < static_cast<int>(_tree.size()); index += index & -index) {
+      _tree[index] = std::max(_tree[index], value);
+    }
+  }
+
+  std::vector<int> _neg_index;
+  std::vector<int64_t> _tree;
+};
+
+}  // namespace ieda_solver
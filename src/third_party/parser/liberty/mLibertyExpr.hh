@@ -114,7 +114,7 @@ class LibertyExprBuilder
  private:
   LibertyPort* _expr_port;    //!< The port owned the func attribute.
   std::string _expr_str;      //!< The func expr string.
-  LibertyExpr* _result_expr;  //!< The result expr.
+  LibertyExpr* _result_expr = nullptr;  //!< The result expr.
 
   std::string _file_name;    //!< The verilog file name.
   int _line_no = 1;          //!< The verilog file line no.
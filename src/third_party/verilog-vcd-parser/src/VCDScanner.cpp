@@ -3035,6 +3035,8 @@ void VCDFileParser::scan_begin() {
 
 void VCDFileParser::scan_end() {
     // fclose(yyin);
-    yypop_buffer_state();
+    // reset the scanner globals, the next parse may start from a stale buffer
+    // and start condition, such as when the parse is accepted at end time.
+    yylex_destroy();
 }
 